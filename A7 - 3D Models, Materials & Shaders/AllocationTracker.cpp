@@ -0,0 +1,500 @@
+#include "AllocationTracker.h"
+#include "Profiler.h"
+
+#include <Windows.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <unordered_map>
+
+#if defined(TRACK_ALLOCATIONS)
+#include <DbgHelp.h>
+#pragma comment(lib, "dbghelp.lib")
+#endif
+
+// --------------- Basic usage -----------------
+//
+// With TRACK_ALLOCATIONS defined, every operator new and
+// delete in the program goes through this file, as do the
+// engine's malloc calls (AllocationTracker::Malloc() and
+// Free(), which PoolAllocator's chunks and large blocks use
+// too), and each is counted three ways:
+//
+//  - Per frame: allocations, frees and bytes, ended by
+//    AllocationTracker::EndFrame() once per frame
+//  - Per profiler scope: allocations are charged to the
+//    innermost PROFILE_SCOPE open on that thread when they
+//    happen (frees aren't, as they rarely happen in the same
+//    scope as the allocation)
+//  - Per call stack: the first few return addresses above
+//    operator new, resolved to a function name on demand
+//
+// Once past the first few frames, the game should be in a
+// steady state where it allocates little or nothing.  Any
+// frame over the budget (see SetBudget()) is counted, and
+// the first one asserts when asserts are on, which is the
+// moment to look at the profiler window's allocation table.
+//
+// Recording uses atomics and fixed tables only, since it
+// can't allocate itself, and walks the stack every time,
+// so expect a slower game while it's compiled in.
+//
+// ---------------------------------------------
+
+namespace
+{
+	const unsigned int MaxScopes = 256;		// Must be a power of two
+	const unsigned int MaxSites = 4096;		// Must be a power of two
+	const unsigned int SiteSkipFrames = 1;	// RecordAllocation() itself
+
+	// Startup frames load everything, so they never count
+	// against the budget
+	const unsigned long long WarmupFrames = 60;
+
+	// Current frame's counts, from any thread
+	std::atomic<unsigned int> frameAllocations{ 0 };
+	std::atomic<unsigned int> frameFrees{ 0 };
+	std::atomic<unsigned long long> frameBytesAllocated{ 0 };
+	std::atomic<unsigned long long> frameBytesFreed{ 0 };
+
+	// Scopes, found by name pointer.  Allocations outside of
+	// every scope (or with the profiler off) go in noScope
+	struct ScopeSlot
+	{
+		std::atomic<const char*> name;
+		std::atomic<unsigned int> allocations;
+		std::atomic<unsigned long long> bytes;
+	};
+	ScopeSlot scopeSlots[MaxScopes];
+	ScopeSlot noScope;
+
+	// Call stacks, found by a hash of their frames.  The thread
+	// that claims a slot fills in the frames, then marks it ready
+	struct SiteSlot
+	{
+		std::atomic<unsigned long long> hash;
+		std::atomic<bool> ready;
+		void* frames[AllocationSiteStats::MaxFrames];
+		unsigned int frameCount;
+		std::atomic<unsigned long long> allocations;
+		std::atomic<unsigned long long> bytes;
+	};
+	SiteSlot siteSlots[MaxSites];
+
+	// Main thread state
+	AllocationFrameStats lastFrame{};
+	unsigned long long totalFrames = 0;
+	unsigned long long framesSinceReset = 0;
+	unsigned int allocationBudget = 256;
+	unsigned long long byteBudget = 1024 * 1024;
+	bool assertOnBudget = true;
+	unsigned int framesOverBudget = 0;
+
+	std::vector<AllocationScopeStats> scopeStats;
+	std::unordered_map<const char*, unsigned int> scopeLookup;
+	std::unordered_map<unsigned long long, std::string> siteNames;
+	bool symbolsLoaded = false;
+}
+
+#if defined(TRACK_ALLOCATIONS)
+namespace
+{
+	ScopeSlot* FindScope(const char* name)
+	{
+		if (!name)
+			return &noScope;
+
+		unsigned int slot = (unsigned int)(((size_t)name >> 3) * 2654435761u) & (MaxScopes - 1);
+		for (unsigned int probe = 0; probe < MaxScopes; probe++, slot = (slot + 1) & (MaxScopes - 1))
+		{
+			const char* current = scopeSlots[slot].name.load(std::memory_order_acquire);
+			if (current == name)
+				return &scopeSlots[slot];
+
+			if (!current && (scopeSlots[slot].name.compare_exchange_strong(current, name) || current == name))
+				return &scopeSlots[slot];
+		}
+
+		// Table is full
+		return &noScope;
+	}
+
+	SiteSlot* FindSite(void** frames, unsigned int frameCount)
+	{
+		// FNV-1a over the return addresses, never zero since
+		// zero marks an empty slot
+		unsigned long long hash = 14695981039346656037ull;
+		for (unsigned int i = 0; i < frameCount; i++)
+			hash = (hash ^ (unsigned long long)(size_t)frames[i]) * 1099511628211ull;
+		hash |= 1;
+
+		unsigned int slot = (unsigned int)(hash >> 32) & (MaxSites - 1);
+		for (unsigned int probe = 0; probe < MaxSites; probe++, slot = (slot + 1) & (MaxSites - 1))
+		{
+			SiteSlot& site = siteSlots[slot];
+			unsigned long long current = site.hash.load(std::memory_order_acquire);
+			if (current == hash)
+				return &site;
+
+			if (current == 0)
+			{
+				if (site.hash.compare_exchange_strong(current, hash))
+				{
+					for (unsigned int i = 0; i < frameCount; i++)
+						site.frames[i] = frames[i];
+					site.frameCount = frameCount;
+					site.ready.store(true, std::memory_order_release);
+					return &site;
+				}
+				if (current == hash)
+					return &site;
+			}
+		}
+
+		// Table is full
+		return 0;
+	}
+
+	// Standard library and allocator frames (this file's
+	// included) say nothing about who wanted the memory, so
+	// DescribeSite() skips them
+	bool IsLibraryFunction(const char* name)
+	{
+		const char* skipped[] = { "std::", "operator new", "AllocationTracker::Malloc", "`anonymous namespace'::Allocate" };
+		for (const char* prefix : skipped)
+		{
+			if (strncmp(name, prefix, strlen(prefix)) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	void RecordAllocation(size_t size)
+	{
+		frameAllocations.fetch_add(1, std::memory_order_relaxed);
+		frameBytesAllocated.fetch_add(size, std::memory_order_relaxed);
+
+		ScopeSlot* scope = FindScope(Profiler::GetCurrentScope());
+		scope->allocations.fetch_add(1, std::memory_order_relaxed);
+		scope->bytes.fetch_add(size, std::memory_order_relaxed);
+
+		void* frames[AllocationSiteStats::MaxFrames];
+		unsigned int frameCount = CaptureStackBackTrace(SiteSkipFrames, AllocationSiteStats::MaxFrames, frames, 0);
+		SiteSlot* site = FindSite(frames, frameCount);
+		if (site)
+		{
+			site->allocations.fetch_add(1, std::memory_order_relaxed);
+			site->bytes.fetch_add(size, std::memory_order_relaxed);
+		}
+	}
+
+	void RecordFree(size_t size)
+	{
+		frameFrees.fetch_add(1, std::memory_order_relaxed);
+		frameBytesFreed.fetch_add(size, std::memory_order_relaxed);
+	}
+
+	void* Allocate(size_t size)
+	{
+		if (size == 0)
+			size = 1;
+
+		void* memory = malloc(size);
+		if (memory)
+			RecordAllocation(size);
+		return memory;
+	}
+
+	void Free(void* memory)
+	{
+		if (!memory)
+			return;
+
+		RecordFree(_msize(memory));
+		free(memory);
+	}
+
+	void* AllocateAligned(size_t size, std::align_val_t alignment)
+	{
+		if (size == 0)
+			size = 1;
+
+		void* memory = _aligned_malloc(size, (size_t)alignment);
+		if (memory)
+			RecordAllocation(size);
+		return memory;
+	}
+
+	void FreeAligned(void* memory, std::align_val_t alignment)
+	{
+		if (!memory)
+			return;
+
+		RecordFree(_aligned_msize(memory, (size_t)alignment, 0));
+		_aligned_free(memory);
+	}
+}
+
+void* AllocationTracker::Malloc(size_t size) { return Allocate(size); }
+void AllocationTracker::Free(void* memory) { ::Free(memory); }
+
+// Replacements for every global form of new and delete
+void* operator new(size_t size)
+{
+	void* memory = Allocate(size);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	void* memory = Allocate(size);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* memory = AllocateAligned(size, alignment);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	void* memory = AllocateAligned(size, alignment);
+	if (!memory)
+		throw std::bad_alloc();
+	return memory;
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+
+void operator delete(void* memory) noexcept { Free(memory); }
+void operator delete[](void* memory) noexcept { Free(memory); }
+void operator delete(void* memory, size_t) noexcept { Free(memory); }
+void operator delete[](void* memory, size_t) noexcept { Free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { Free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { Free(memory); }
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept { FreeAligned(memory, alignment); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { FreeAligned(memory, alignment); }
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept { FreeAligned(memory, alignment); }
+void operator delete[](void* memory, size_t, std::align_val_t alignment) noexcept { FreeAligned(memory, alignment); }
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { FreeAligned(memory, alignment); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { FreeAligned(memory, alignment); }
+#endif
+
+bool AllocationTracker::IsAvailable()
+{
+#if defined(TRACK_ALLOCATIONS)
+	return true;
+#else
+	return false;
+#endif
+}
+
+// --------------------------------------------------------
+// Ends the frame: moves this frame's counts (per frame and
+// per scope) into the stats, then checks the budget
+// --------------------------------------------------------
+void AllocationTracker::EndFrame()
+{
+	lastFrame.allocations = frameAllocations.exchange(0, std::memory_order_relaxed);
+	lastFrame.frees = frameFrees.exchange(0, std::memory_order_relaxed);
+	lastFrame.bytesAllocated = frameBytesAllocated.exchange(0, std::memory_order_relaxed);
+	lastFrame.bytesFreed = frameBytesFreed.exchange(0, std::memory_order_relaxed);
+	totalFrames++;
+	framesSinceReset++;
+
+	for (unsigned int i = 0; i <= MaxScopes; i++)
+	{
+		ScopeSlot& slot = i < MaxScopes ? scopeSlots[i] : noScope;
+		const char* name = slot.name.load(std::memory_order_acquire);
+		if (!name && &slot != &noScope)
+			continue;
+
+		unsigned int allocations = slot.allocations.exchange(0, std::memory_order_relaxed);
+		unsigned long long bytes = slot.bytes.exchange(0, std::memory_order_relaxed);
+
+		auto found = scopeLookup.find(name);
+		if (found == scopeLookup.end())
+		{
+			if (allocations == 0)
+				continue;
+
+			found = scopeLookup.emplace(name, (unsigned int)scopeStats.size()).first;
+			scopeStats.push_back({ name, 0, 0, 0, 0 });
+		}
+
+		AllocationScopeStats& stats = scopeStats[found->second];
+		stats.lastAllocations = allocations;
+		stats.lastBytes = bytes;
+		stats.totalAllocations += allocations;
+		stats.totalBytes += bytes;
+	}
+
+	if (totalFrames <= WarmupFrames)
+		return;
+
+	if (lastFrame.allocations > allocationBudget || lastFrame.bytesAllocated > byteBudget)
+	{
+		framesOverBudget++;
+		if (assertOnBudget)
+		{
+			// Once is enough to go and look, so the rest of the
+			// run isn't one assert after another
+			assertOnBudget = false;
+			printf("Frame %llu went over its allocation budget: %u allocations (budget %u), %llu bytes (budget %llu)\n",
+				totalFrames, lastFrame.allocations, allocationBudget, lastFrame.bytesAllocated, byteBudget);
+			assert(!"Frame went over its allocation budget (see the console and the profiler window)");
+		}
+	}
+}
+
+const AllocationFrameStats& AllocationTracker::GetLastFrame() { return lastFrame; }
+unsigned long long AllocationTracker::GetFrameCount() { return framesSinceReset; }
+
+void AllocationTracker::SetBudget(unsigned int allocationsPerFrame, unsigned long long bytesPerFrame)
+{
+	allocationBudget = allocationsPerFrame;
+	byteBudget = bytesPerFrame;
+}
+
+unsigned int AllocationTracker::GetAllocationBudget() { return allocationBudget; }
+unsigned long long AllocationTracker::GetByteBudget() { return byteBudget; }
+void AllocationTracker::SetAssertOnBudget(bool enable) { assertOnBudget = enable; }
+bool AllocationTracker::IsAssertOnBudgetEnabled() { return assertOnBudget; }
+unsigned int AllocationTracker::GetFramesOverBudget() { return framesOverBudget; }
+
+const std::vector<AllocationScopeStats>& AllocationTracker::GetScopeStats() { return scopeStats; }
+
+// --------------------------------------------------------
+// Copies out the call stacks with the most allocations
+//
+// sites    - Filled with up to maxCount stacks, busiest first
+// maxCount - How many to keep
+// --------------------------------------------------------
+void AllocationTracker::GetTopSites(std::vector<AllocationSiteStats>& sites, unsigned int maxCount)
+{
+	sites.clear();
+	for (SiteSlot& slot : siteSlots)
+	{
+		if (!slot.ready.load(std::memory_order_acquire))
+			continue;
+
+		unsigned long long allocations = slot.allocations.load(std::memory_order_relaxed);
+		if (allocations == 0)
+			continue;
+
+		AllocationSiteStats site{};
+		site.hash = slot.hash.load(std::memory_order_relaxed);
+		site.frameCount = slot.frameCount;
+		for (unsigned int i = 0; i < slot.frameCount; i++)
+			site.frames[i] = slot.frames[i];
+		site.allocations = allocations;
+		site.bytes = slot.bytes.load(std::memory_order_relaxed);
+		sites.push_back(site);
+	}
+
+	unsigned int count = maxCount < sites.size() ? maxCount : (unsigned int)sites.size();
+	std::partial_sort(sites.begin(), sites.begin() + count, sites.end(),
+		[](const AllocationSiteStats& a, const AllocationSiteStats& b) { return a.allocations > b.allocations; });
+	sites.resize(count);
+}
+
+// --------------------------------------------------------
+// Names a call stack by its first frame outside of the
+// standard library.  Symbols are loaded the first time
+// this is called, and each stack is only looked up once
+// --------------------------------------------------------
+const std::string& AllocationTracker::DescribeSite(const AllocationSiteStats& site)
+{
+	auto found = siteNames.find(site.hash);
+	if (found != siteNames.end())
+		return found->second;
+
+	char text[512] = {};
+	if (site.frameCount > 0)
+		snprintf(text, sizeof(text), "0x%p", site.frames[0]);
+
+#if defined(TRACK_ALLOCATIONS)
+	HANDLE process = GetCurrentProcess();
+	if (!symbolsLoaded)
+	{
+		SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+		SymInitialize(process, 0, TRUE);
+		symbolsLoaded = true;
+	}
+
+	char symbolBuffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME] = {};
+	SYMBOL_INFO* symbol = (SYMBOL_INFO*)symbolBuffer;
+	symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+	symbol->MaxNameLen = MAX_SYM_NAME;
+
+	for (unsigned int i = 0; i < site.frameCount; i++)
+	{
+		// Return addresses point just past the call
+		DWORD64 address = (DWORD64)site.frames[i] - 1;
+		DWORD64 symbolOffset = 0;
+		if (!SymFromAddr(process, address, &symbolOffset, symbol) || IsLibraryFunction(symbol->Name))
+			continue;
+
+		IMAGEHLP_LINE64 line = {};
+		line.SizeOfStruct = sizeof(line);
+		DWORD lineOffset = 0;
+		if (SymGetLineFromAddr64(process, address, &lineOffset, &line))
+		{
+			const char* file = strrchr(line.FileName, '\\');
+			snprintf(text, sizeof(text), "%s (%s:%lu)", symbol->Name, file ? file + 1 : line.FileName, line.LineNumber);
+		}
+		else
+		{
+			snprintf(text, sizeof(text), "%s", symbol->Name);
+		}
+		break;
+	}
+#endif
+
+	return siteNames.emplace(site.hash, text).first->second;
+}
+
+// --------------------------------------------------------
+// Zeroes every total (per scope and per call stack), but
+// not the budget or the count of frames over it
+// --------------------------------------------------------
+void AllocationTracker::ResetCounts()
+{
+	framesSinceReset = 0;
+	for (AllocationScopeStats& stats : scopeStats)
+	{
+		stats.totalAllocations = 0;
+		stats.totalBytes = 0;
+	}
+
+	for (SiteSlot& slot : siteSlots)
+	{
+		slot.allocations.store(0, std::memory_order_relaxed);
+		slot.bytes.store(0, std::memory_order_relaxed);
+	}
+}
+
+void AllocationTracker::ShutDown()
+{
+#if defined(TRACK_ALLOCATIONS)
+	if (symbolsLoaded)
+		SymCleanup(GetCurrentProcess());
+#endif
+	symbolsLoaded = false;
+}
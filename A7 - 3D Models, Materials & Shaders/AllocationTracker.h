@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Define TRACK_ALLOCATIONS for the whole project to replace the
+// global operator new and delete with versions that count
+// every heap allocation.  Without it the tracker compiles to
+// nothing and IsAvailable() returns false
+
+// See AllocationTracker.cpp for usage details
+
+struct AllocationFrameStats
+{
+	unsigned int allocations;
+	unsigned int frees;
+	unsigned long long bytesAllocated;
+	unsigned long long bytesFreed;
+};
+
+// One profiler scope (or "no scope"), by allocations made
+// while it was the innermost open scope
+struct AllocationScopeStats
+{
+	const char* name;	// Null outside of any scope
+	unsigned int lastAllocations;
+	unsigned long long lastBytes;
+	unsigned long long totalAllocations;
+	unsigned long long totalBytes;
+};
+
+// One distinct call stack that reached operator new, counted
+// since the last ResetCounts()
+struct AllocationSiteStats
+{
+	static const unsigned int MaxFrames = 8;
+
+	unsigned long long hash;
+	void* frames[MaxFrames];
+	unsigned int frameCount;
+	unsigned long long allocations;
+	unsigned long long bytes;
+};
+
+namespace AllocationTracker
+{
+	bool IsAvailable();
+
+	// Drop-ins for malloc and free that are counted like new
+	// and delete.  The engine's own malloc calls go through
+	// these; without TRACK_ALLOCATIONS they're malloc and free
+#if defined(TRACK_ALLOCATIONS)
+	void* Malloc(size_t size);
+	void Free(void* memory);
+#else
+	inline void* Malloc(size_t size) { return malloc(size); }
+	inline void Free(void* memory) { free(memory); }
+#endif
+
+	// Call once per frame on the main thread, after the
+	// profiler's EndFrame().  Ends the frame's counts and
+	// checks them against the budget
+	void EndFrame();
+
+	const AllocationFrameStats& GetLastFrame();
+	unsigned long long GetFrameCount();
+
+	// Frames after the first few that allocate more than this
+	// are over budget.  With asserts on, the first one asserts
+	// (then asserts turn off until they're enabled again)
+	void SetBudget(unsigned int allocationsPerFrame, unsigned long long bytesPerFrame);
+	unsigned int GetAllocationBudget();
+	unsigned long long GetByteBudget();
+	void SetAssertOnBudget(bool enable);
+	bool IsAssertOnBudgetEnabled();
+	unsigned int GetFramesOverBudget();
+
+	const std::vector<AllocationScopeStats>& GetScopeStats();
+
+	// The busiest call stacks, by allocation count
+	void GetTopSites(std::vector<AllocationSiteStats>& sites, unsigned int maxCount);
+
+	// First function on the stack outside of the standard
+	// library and operator new, with its file and line
+	// when debug info is available
+	const std::string& DescribeSite(const AllocationSiteStats& site);
+
+	void ResetCounts();
+
+	// Releases the debug symbols loaded by DescribeSite()
+	void ShutDown();
+}
@@ -0,0 +1,379 @@
+#include "Benchmark.h"
+#include "FrameTimes.h"
+#include "PathHelpers.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+// --------------- Basic usage -----------------
+//
+// Launch with a scene name to benchmark it instead of
+// playing:
+//
+//   D3D11Starter.exe -benchmark field
+//
+// The scene's camera path drives the camera, every frame
+// advances by the same time step and input is ignored, so
+// each run does exactly the same work.  Options:
+//
+//   -frames N         Run N frames (default: the path once)
+//   -tolerance P      Allowed slowdown in percent (default 10)
+//   -write-baseline   Save this run as the scene's baseline
+//
+// Stage timings are the profiler's markers, summed per frame
+// by name.  Benchmark_<scene>.csv gets one row per frame with
+// a column per stage, followed by a summary of each stage.
+// Benchmark_<scene>_baseline.csv holds a summary from an
+// earlier run; each stage's median must stay within the
+// tolerance of it or the run fails with exit code 1.
+//
+// Counters (like the culling cache's hit rate) get a column
+// per frame too, and a mean over the same frames as the
+// stage summary, written after it.  They're for reading,
+// not compared against the baseline, though a run where
+// the culling cache never reuses a result fails as well.
+//
+// With GRAPHICS_NULL defined the same benchmark runs without
+// a window or GPU, timing only the CPU side of the frame.
+// That build runs on Linux too (Tools/LinuxShim/LinuxMain.cpp
+// has the command), with results and baselines next to the
+// executable as on Windows.  The exit code works the same,
+// so a CI job can fail on it.
+//
+// ---------------------------------------------
+
+namespace
+{
+	// The first frames pay for first-use costs, so they're
+	// written out but left out of the summary
+	const unsigned int WarmupFrames = 5;
+
+	// Stages this fast are mostly timer noise, so they only
+	// fail if they also get slower than this
+	const double MinComparableMs = 0.02;
+
+	struct Stage
+	{
+		const char* marker;		// Profiler name, matched by pointer first
+		std::string name;
+		std::vector<float> ms;	// One per frame
+	};
+
+	struct StageSummary
+	{
+		std::string name;
+		double mean;
+		double p50;
+		double p99;
+		double max;
+	};
+
+	BenchmarkSettings settings;
+	unsigned int frameCount = 0;
+	unsigned int framesRecorded = 0;
+	std::vector<float> frameMs;
+	std::vector<Stage> stages;
+
+	struct Counter
+	{
+		const char* name;
+		std::vector<double> values;	// One per frame
+	};
+	std::vector<Counter> counters;
+
+	// --------------------------------------------------------
+	// Finds the stage for a marker name, adding it the first
+	// time.  The same text can have more than one pointer
+	// (a literal in two files), so names are compared too
+	// --------------------------------------------------------
+	Stage& FindStage(const char* marker)
+	{
+		for (Stage& stage : stages)
+		{
+			if (stage.marker == marker)
+				return stage;
+		}
+		for (Stage& stage : stages)
+		{
+			if (stage.name == marker)
+				return stage;
+		}
+
+		stages.push_back({ marker, marker, std::vector<float>(frameCount, 0.0f) });
+		return stages.back();
+	}
+
+	StageSummary Summarize(const std::string& name, const std::vector<float>& ms, std::vector<float>& scratch)
+	{
+		unsigned int skip = framesRecorded > WarmupFrames ? WarmupFrames : 0;
+		FrameTimeStats stats = ComputeFrameTimeStats(ms.data() + skip, framesRecorded - skip, scratch);
+		return { name, stats.mean, stats.p50, stats.p99, stats.max };
+	}
+
+	void WriteSummary(std::ostream& csv, const std::vector<StageSummary>& summaries)
+	{
+		csv << "stage,mean_ms,p50_ms,p99_ms,max_ms\n";
+		for (const StageSummary& summary : summaries)
+			csv << summary.name << "," << summary.mean << "," << summary.p50 << "," << summary.p99 << "," << summary.max << "\n";
+	}
+
+	// --------------------------------------------------------
+	// Reads a summary written by WriteSummary().  Anything
+	// before its header line is skipped, so a full results
+	// file works as a baseline too
+	// --------------------------------------------------------
+	bool ReadSummary(const std::string& path, std::vector<StageSummary>& summaries)
+	{
+		std::ifstream file(path);
+		if (!file)
+			return false;
+
+		std::string line;
+		bool inSummary = false;
+		while (std::getline(file, line))
+		{
+			if (!line.empty() && line.back() == '\r')
+				line.pop_back();
+
+			if (!inSummary)
+			{
+				inSummary = line.rfind("stage,", 0) == 0;
+				continue;
+			}
+			if (line.empty())
+				break;
+
+			std::istringstream values(line);
+			StageSummary summary = {};
+			std::string field;
+			std::getline(values, summary.name, ',');
+			std::getline(values, field, ','); summary.mean = atof(field.c_str());
+			std::getline(values, field, ','); summary.p50 = atof(field.c_str());
+			std::getline(values, field, ','); summary.p99 = atof(field.c_str());
+			std::getline(values, field, ','); summary.max = atof(field.c_str());
+			summaries.push_back(summary);
+		}
+		return inSummary;
+	}
+
+	// --------------------------------------------------------
+	// Reads the number after an option, or returns false when
+	// the option isn't on the command line
+	// --------------------------------------------------------
+	bool ReadNumber(const char* commandLine, const char* option, double& value)
+	{
+		const char* found = strstr(commandLine, option);
+		if (!found)
+			return false;
+
+		value = atof(found + strlen(option));
+		return true;
+	}
+}
+
+bool Benchmark::ParseCommandLine(const char* commandLine, BenchmarkSettings& settings)
+{
+	const char* option = commandLine ? strstr(commandLine, "-benchmark") : 0;
+	if (!option)
+		return false;
+
+	settings.scene = "shapes";
+	settings.frames = 0;
+	settings.timeStep = 1.0f / 60.0f;
+	settings.tolerance = 0.1f;
+	settings.writeBaseline = strstr(commandLine, "-write-baseline") != 0;
+
+	// The scene name is the next word, unless that's another option
+	const char* name = option + strlen("-benchmark");
+	while (*name == ' ' || *name == '\t')
+		name++;
+	size_t length = strcspn(name, " \t");
+	if (length > 0 && name[0] != '-')
+		settings.scene.assign(name, length);
+
+	double value = 0;
+	if (ReadNumber(commandLine, "-frames", value) && value > 0)
+		settings.frames = (unsigned int)value;
+	if (ReadNumber(commandLine, "-tolerance", value) && value >= 0)
+		settings.tolerance = (float)(value / 100.0);
+
+	return true;
+}
+
+void Benchmark::Begin(const BenchmarkSettings& newSettings, unsigned int newFrameCount)
+{
+	settings = newSettings;
+	frameCount = newFrameCount;
+	framesRecorded = 0;
+	frameMs.assign(frameCount, 0.0f);
+	stages.clear();
+	counters.clear();
+
+	Profiler::SetEnabled(true);
+	Profiler::ResetStats();
+}
+
+void Benchmark::RecordFrame(const ProfileFrame& frame)
+{
+	if (framesRecorded >= frameCount)
+		return;
+
+	frameMs[framesRecorded] = (float)frame.durationMs;
+	for (const ProfileSample& sample : frame.samples)
+		FindStage(sample.name).ms[framesRecorded] += (float)sample.durationMs;
+
+	framesRecorded++;
+}
+
+void Benchmark::RecordCounter(const char* name, double value)
+{
+	if (framesRecorded >= frameCount)
+		return;
+
+	Counter* counter = 0;
+	for (Counter& existing : counters)
+	{
+		if (existing.name == name || strcmp(existing.name, name) == 0)
+			counter = &existing;
+	}
+	if (!counter)
+	{
+		counters.push_back({ name, std::vector<double>(frameCount, 0.0) });
+		counter = &counters.back();
+	}
+	counter->values[framesRecorded] = value;
+}
+
+int Benchmark::Finish()
+{
+	printf("Benchmark \"%s\": %u frames of %.4f s\n", settings.scene.c_str(), framesRecorded, settings.timeStep);
+	if (framesRecorded == 0)
+		return 2;
+
+	// Every frame, then the summary
+	std::vector<float> scratch;
+	std::vector<StageSummary> summaries;
+	summaries.push_back(Summarize("Frame", frameMs, scratch));
+	for (const Stage& stage : stages)
+		summaries.push_back(Summarize(stage.name, stage.ms, scratch));
+
+	std::string resultsPath = GetResultsPath(settings.scene);
+	std::ofstream csv(resultsPath);
+	csv << "frame,Frame";
+	for (const Stage& stage : stages)
+		csv << "," << stage.name;
+	for (const Counter& counter : counters)
+		csv << "," << counter.name;
+	csv << "\n";
+	for (unsigned int i = 0; i < framesRecorded; i++)
+	{
+		csv << i << "," << frameMs[i];
+		for (const Stage& stage : stages)
+			csv << "," << stage.ms[i];
+		for (const Counter& counter : counters)
+			csv << "," << counter.values[i];
+		csv << "\n";
+	}
+	csv << "\n";
+	WriteSummary(csv, summaries);
+
+	// Counters after a blank line, so ReadSummary() stops
+	// before them
+	if (!counters.empty())
+	{
+		unsigned int skip = framesRecorded > WarmupFrames ? WarmupFrames : 0;
+		csv << "\ncounter,mean\n";
+		for (const Counter& counter : counters)
+		{
+			double sum = 0.0;
+			for (unsigned int i = skip; i < framesRecorded; i++)
+				sum += counter.values[i];
+			double mean = sum / (framesRecorded - skip);
+			csv << counter.name << "," << mean << "\n";
+			printf("  %-24s %12.4f (mean)\n", counter.name, mean);
+		}
+	}
+	if (!csv)
+	{
+		printf("  Could not write %s\n", resultsPath.c_str());
+		return 2;
+	}
+	printf("  Results written to %s\n", resultsPath.c_str());
+
+	std::string baselinePath = GetBaselinePath(settings.scene);
+	if (settings.writeBaseline)
+	{
+		std::ofstream baseline(baselinePath);
+		WriteSummary(baseline, summaries);
+		if (!baseline)
+		{
+			printf("  Could not write %s\n", baselinePath.c_str());
+			return 2;
+		}
+		printf("  Baseline saved to %s\n", baselinePath.c_str());
+		return 0;
+	}
+
+	std::vector<StageSummary> baseline;
+	if (!ReadSummary(baselinePath, baseline))
+	{
+		printf("  No baseline at %s (run with -write-baseline to make one)\n", baselinePath.c_str());
+		return 2;
+	}
+
+	// Medians against the baseline, stage by stage
+	printf("  %-24s %12s %12s %9s\n", "Stage (p50 ms)", "Baseline", "This run", "Change");
+	unsigned int slower = 0;
+	for (const StageSummary& base : baseline)
+	{
+		const StageSummary* current = 0;
+		for (const StageSummary& summary : summaries)
+		{
+			if (summary.name == base.name)
+				current = &summary;
+		}
+		if (!current)
+		{
+			printf("  %-24s %12.4f %12s %9s  missing\n", base.name.c_str(), base.p50, "-", "-");
+			continue;
+		}
+
+		double change = base.p50 > 0.0 ? (current->p50 - base.p50) / base.p50 : 0.0;
+		const char* status = "ok";
+		if (current->p50 > base.p50 * (1.0 + settings.tolerance) && current->p50 > MinComparableMs)
+		{
+			status = "SLOWER";
+			slower++;
+		}
+		else if (current->p50 < base.p50 * (1.0 - settings.tolerance))
+		{
+			status = "faster";
+		}
+		printf("  %-24s %12.4f %12.4f %+8.1f%%  %s\n", base.name.c_str(), base.p50, current->p50, change * 100.0, status);
+	}
+
+	// Stages the baseline never saw aren't compared
+	for (const StageSummary& summary : summaries)
+	{
+		bool known = false;
+		for (const StageSummary& base : baseline)
+			known = known || base.name == summary.name;
+		if (!known)
+			printf("  %-24s %12s %12.4f %9s  new\n", summary.name.c_str(), "-", summary.p50, "-");
+	}
+
+	if (slower > 0)
+	{
+		printf("  FAILED: %u stage(s) more than %.1f%% slower than the baseline\n", slower, settings.tolerance * 100.0f);
+		return 1;
+	}
+	printf("  Passed (tolerance %.1f%%)\n", settings.tolerance * 100.0f);
+	return 0;
+}
+
+std::string Benchmark::GetResultsPath(const std::string& scene) { return FixPath("Benchmark_" + scene + ".csv"); }
+std::string Benchmark::GetBaselinePath(const std::string& scene) { return FixPath("Benchmark_" + scene + "_baseline.csv"); }
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+
+#include "Profiler.h"
+
+// See Benchmark.cpp for usage details
+
+struct BenchmarkSettings
+{
+	std::string scene;		// Scene to load, by name
+	unsigned int frames;	// 0 runs the scene's camera path once
+	float timeStep;			// Seconds per frame, the same every frame
+	float tolerance;		// Allowed slowdown against the baseline (0.1 = 10%)
+	bool writeBaseline;		// Save this run as the new baseline instead of comparing
+};
+
+namespace Benchmark
+{
+	// Fills in the settings from "-benchmark <scene>" and its
+	// options.  Returns false when there's no benchmark flag
+	bool ParseCommandLine(const char* commandLine, BenchmarkSettings& settings);
+
+	// Starts collecting.  Turns the profiler on, since the
+	// stage timings come from its markers
+	void Begin(const BenchmarkSettings& settings, unsigned int frameCount);
+
+	// Call once per frame, after Profiler::EndFrame()
+	void RecordFrame(const ProfileFrame& frame);
+
+	// A value that isn't a time (a count, a rate) for the frame
+	// about to be recorded.  Call before that frame's
+	// RecordFrame(); the name should be a string literal
+	void RecordCounter(const char* name, double value);
+
+	// Writes the results, then compares them with the baseline
+	// (or replaces it).  Returns the process exit code:
+	// 0 within tolerance, 1 slower than the baseline, 2 when
+	// there's no baseline or a file couldn't be written
+	int Finish();
+
+	// Where each scene's results and baseline are kept
+	std::string GetResultsPath(const std::string& scene);
+	std::string GetBaselinePath(const std::string& scene);
+}
@@ -1,11 +1,30 @@
-#pragma once
-#include <DirectXMath.h>
-
-struct VertexShaderData
-{
-public:
-	DirectX::XMFLOAT4 colorTint;
-	DirectX::XMFLOAT4X4 world;
-	DirectX::XMFLOAT4X4 viewMatrix;
-	DirectX::XMFLOAT4X4 projectionMatrix;
+#pragma once
+#include <DirectXMath.h>
+
+// Per-object data, written for every draw (register b0)
+struct VertexShaderData
+{
+public:
+	DirectX::XMFLOAT4 colorTint;
+	DirectX::XMFLOAT4X4 world;
+};
+
+// Per-view data, written and bound once per frame (register b1)
+struct PerFrameData
+{
+public:
+	DirectX::XMFLOAT4X4 viewMatrix;
+	DirectX::XMFLOAT4X4 projectionMatrix;
+	DirectX::XMFLOAT4X4 viewProjectionMatrix;
+	float time;
+	DirectX::XMFLOAT3 padding;
+};
+
+// Per-instance data for the instanced vertex shader, one
+// entry per entity in the frame's instance buffer (slot 1)
+struct InstanceData
+{
+public:
+	DirectX::XMFLOAT4X4 world;
+	DirectX::XMFLOAT4 colorTint;
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "CameraPath.h"
+#include "Camera.h"
+
+#include <fstream>
+#include <sstream>
+
+using namespace DirectX;
+
+void CameraPath::Clear()
+{
+	keys.clear();
+}
+
+void CameraPath::AddKey(float time, XMFLOAT3 position, XMFLOAT3 pitchYawRoll)
+{
+	keys.push_back({ time, position, pitchYawRoll });
+}
+
+size_t CameraPath::GetKeyCount() const { return keys.size(); }
+const CameraKey& CameraPath::GetKey(size_t index) const { return keys[index]; }
+float CameraPath::GetDuration() const { return keys.empty() ? 0.0f : keys.back().time; }
+
+
+// --------------------------------------------------------
+// Finds the segment holding the time and blends the four
+// keys around it.  The first and last keys are repeated
+// to give the end segments their missing neighbour
+//
+// Rotations are blended as plain angles, which is fine for
+// recorded paths since mouse look never wraps the yaw
+// --------------------------------------------------------
+void CameraPath::Evaluate(float time, XMFLOAT3& position, XMFLOAT3& pitchYawRoll) const
+{
+	if (keys.empty())
+	{
+		position = XMFLOAT3(0, 0, 0);
+		pitchYawRoll = XMFLOAT3(0, 0, 0);
+		return;
+	}
+
+	// Hold at either end
+	if (keys.size() == 1 || !(time > keys.front().time))
+	{
+		position = keys.front().position;
+		pitchYawRoll = keys.front().pitchYawRoll;
+		return;
+	}
+	if (time >= keys.back().time)
+	{
+		position = keys.back().position;
+		pitchYawRoll = keys.back().pitchYawRoll;
+		return;
+	}
+
+	// Last key at or before the time.  Paths are short
+	// enough that a linear search isn't worth improving
+	size_t segment = 0;
+	while (segment + 2 < keys.size() && keys[segment + 1].time <= time)
+		segment++;
+
+	const CameraKey& k0 = keys[segment > 0 ? segment - 1 : 0];
+	const CameraKey& k1 = keys[segment];
+	const CameraKey& k2 = keys[segment + 1];
+	const CameraKey& k3 = keys[segment + 2 < keys.size() ? segment + 2 : segment + 1];
+
+	float length = k2.time - k1.time;
+	float t = length > 0.0f ? (time - k1.time) / length : 0.0f;
+
+	XMStoreFloat3(&position, XMVectorCatmullRom(
+		XMLoadFloat3(&k0.position), XMLoadFloat3(&k1.position),
+		XMLoadFloat3(&k2.position), XMLoadFloat3(&k3.position), t));
+	XMStoreFloat3(&pitchYawRoll, XMVectorCatmullRom(
+		XMLoadFloat3(&k0.pitchYawRoll), XMLoadFloat3(&k1.pitchYawRoll),
+		XMLoadFloat3(&k2.pitchYawRoll), XMLoadFloat3(&k3.pitchYawRoll), t));
+}
+
+void CameraPath::Apply(Camera& camera, float time) const
+{
+	XMFLOAT3 position;
+	XMFLOAT3 pitchYawRoll;
+	Evaluate(time, position, pitchYawRoll);
+
+	camera.GetTransform()->SetPosition(position);
+	camera.GetTransform()->SetRotation(pitchYawRoll);
+	camera.UpdateViewMatrix();
+}
+
+bool CameraPath::Save(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file)
+		return false;
+
+	file << "# time  posX posY posZ  pitch yaw roll\n";
+	file.precision(9);
+	for (const CameraKey& key : keys)
+	{
+		file << key.time << "  "
+			<< key.position.x << " " << key.position.y << " " << key.position.z << "  "
+			<< key.pitchYawRoll.x << " " << key.pitchYawRoll.y << " " << key.pitchYawRoll.z << "\n";
+	}
+	return (bool)file;
+}
+
+// --------------------------------------------------------
+// Replaces the keys with the ones in the file.  Blank lines
+// and lines starting with # are skipped.  On failure the
+// path is left empty
+// --------------------------------------------------------
+bool CameraPath::Load(const std::string& path)
+{
+	keys.clear();
+
+	std::ifstream file(path);
+	if (!file)
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+			continue;
+
+		std::istringstream values(line);
+		CameraKey key = {};
+		values >> key.time
+			>> key.position.x >> key.position.y >> key.position.z
+			>> key.pitchYawRoll.x >> key.pitchYawRoll.y >> key.pitchYawRoll.z;
+
+		if (!values || (!keys.empty() && key.time < keys.back().time))
+		{
+			keys.clear();
+			return false;
+		}
+		keys.push_back(key);
+	}
+	return !keys.empty();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+
+class Camera;
+
+// One recorded camera placement
+struct CameraKey
+{
+	float time;						// Seconds from the start of the path
+	DirectX::XMFLOAT3 position;
+	DirectX::XMFLOAT3 pitchYawRoll;
+};
+
+// --------------------------------------------------------
+// A camera flythrough: keys in time order, joined by a
+// Catmull-Rom spline that passes through every key
+//
+// Paths are recorded from a live camera (AddKey() every so
+// often) and saved as text, one key per line:
+//   time  posX posY posZ  pitch yaw roll
+// --------------------------------------------------------
+class CameraPath
+{
+public:
+	void Clear();
+
+	// Keys must be added in time order
+	void AddKey(float time, DirectX::XMFLOAT3 position, DirectX::XMFLOAT3 pitchYawRoll);
+
+	size_t GetKeyCount() const;
+	const CameraKey& GetKey(size_t index) const;
+	float GetDuration() const;
+
+	// Times before the first key or after the last one
+	// hold at that key
+	void Evaluate(float time, DirectX::XMFLOAT3& position, DirectX::XMFLOAT3& pitchYawRoll) const;
+
+	// Places the camera on the path and updates its view
+	void Apply(Camera& camera, float time) const;
+
+	bool Save(const std::string& path) const;
+	bool Load(const std::string& path);
+
+private:
+	std::vector<CameraKey> keys;
+};
@@ -0,0 +1,200 @@
+#include "ConstantBufferRing.h"
+#include "Graphics.h"
+#include "StateCache.h"
+#include "RenderStats.h"
+
+#include <cstring>
+
+namespace
+{
+	// Offsets passed to VSSetConstantBuffers1 are in 16-byte
+	// constants and must be multiples of 16 constants
+	const unsigned int ConstantSize = 16;
+	const unsigned int OffsetAlignment = 256;
+}
+
+ConstantBufferRing::ConstantBufferRing() :
+	supportsOffsets(false),
+	ring(0, OffsetAlignment),
+	needsDiscard(true),
+	mappedData(0),
+	stagingCursor(0),
+	maxBlockSize(0),
+	mapCount(0)
+{
+}
+
+// --------------------------------------------------------
+// Checks what the device supports and creates the buffers
+//
+// capacityBytes - Starting size of the ring (it grows if a
+//                 frame ever needs more)
+// maxBlockSize  - Largest single block that will be written
+// --------------------------------------------------------
+void ConstantBufferRing::Initialize(unsigned int capacityBytes, unsigned int maxBlockSize)
+{
+	this->maxBlockSize = RingAllocator::AlignUp(maxBlockSize, ConstantSize);
+
+	// Both features are needed: binding at an offset, and
+	// mapping a constant buffer without discarding it
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context1;
+	HRESULT hr = Graphics::Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+	supportsOffsets = SUCCEEDED(hr) &&
+		options.ConstantBufferOffsetting &&
+		options.MapNoOverwriteOnDynamicConstantBuffer &&
+		SUCCEEDED(Graphics::Context.As(&context1));
+
+	if (supportsOffsets)
+	{
+		CreateRingBuffer(capacityBytes);
+	}
+	else
+	{
+		D3D11_BUFFER_DESC cbDesc = {};
+		cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		cbDesc.ByteWidth = this->maxBlockSize;
+		cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+		Graphics::Device->CreateBuffer(&cbDesc, 0, fallbackBuffer.GetAddressOf());
+		RenderStats::CountBufferCreated();
+	}
+}
+
+void ConstantBufferRing::CreateRingBuffer(unsigned int capacityBytes)
+{
+	capacityBytes = RingAllocator::AlignUp(capacityBytes > 0 ? capacityBytes : OffsetAlignment, OffsetAlignment);
+
+	D3D11_BUFFER_DESC cbDesc = {};
+	cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	cbDesc.ByteWidth = capacityBytes;
+	cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+
+	ringBuffer.Reset();
+	Graphics::Device->CreateBuffer(&cbDesc, 0, ringBuffer.GetAddressOf());
+	RenderStats::CountBufferCreated();
+	ring.Reset(capacityBytes);
+
+	// A brand new buffer has to be discarded on its first map
+	needsDiscard = true;
+}
+
+// --------------------------------------------------------
+// Reserves room for this frame's blocks and maps the ring
+// once.  Data from the previous frame is never overwritten,
+// since this frame lands after it (or in a fresh buffer
+// from the driver when the ring wraps around)
+// --------------------------------------------------------
+void ConstantBufferRing::BeginFrame(unsigned int blockCount, unsigned int blockSize)
+{
+	unsigned int frameBytes = blockCount * RingAllocator::AlignUp(blockSize, OffsetAlignment);
+	mapCount = 0;
+
+	if (!supportsOffsets)
+	{
+		if (staging.size() < frameBytes)
+			staging.resize(frameBytes);
+		stagingCursor = 0;
+		return;
+	}
+
+	// Grow so a whole frame always fits, with room for two
+	if (!ring.Fits(frameBytes * 2))
+	{
+		unsigned int capacity = ring.GetCapacity();
+		while (capacity < frameBytes * 2)
+			capacity = capacity > 0 ? capacity * 2 : OffsetAlignment;
+		CreateRingBuffer(capacity);
+	}
+
+	bool wrapped = ring.BeginFrame(frameBytes);
+	D3D11_MAP mapType = (wrapped || needsDiscard) ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+	needsDiscard = false;
+
+	D3D11_MAPPED_SUBRESOURCE mapped = {};
+	Graphics::Context->Map(ringBuffer.Get(), 0, mapType, 0, &mapped);
+	mappedData = (unsigned char*)mapped.pData;
+	mapCount++;
+	RenderStats::CountMap();
+}
+
+// --------------------------------------------------------
+// Copies one block of data in and returns its offset, to
+// be handed back to BindVS() later in the frame
+// --------------------------------------------------------
+unsigned int ConstantBufferRing::Write(const void* data, unsigned int size)
+{
+	if (!supportsOffsets)
+	{
+		// Past what BeginFrame() sized the staging copy for
+		if ((size_t)stagingCursor + size > staging.size())
+			return RingAllocator::InvalidOffset;
+
+		unsigned int offset = stagingCursor;
+		memcpy(staging.data() + offset, data, size);
+		stagingCursor += RingAllocator::AlignUp(size, OffsetAlignment);
+		return offset;
+	}
+
+	unsigned int offset = ring.Allocate(size);
+	if (offset == RingAllocator::InvalidOffset || !mappedData)
+		return RingAllocator::InvalidOffset;
+
+	memcpy(mappedData + offset, data, size);
+	RenderStats::CountConstantBytes(size);
+	return offset;
+}
+
+void ConstantBufferRing::EndFrame()
+{
+	if (supportsOffsets && mappedData)
+	{
+		Graphics::Context->Unmap(ringBuffer.Get(), 0);
+		mappedData = 0;
+	}
+}
+
+void ConstantBufferRing::BindVS(unsigned int slot, unsigned int offset, unsigned int size)
+{
+	if (offset == RingAllocator::InvalidOffset)
+		return;
+
+	if (supportsOffsets)
+	{
+		UINT firstConstant = offset / ConstantSize;
+		UINT numConstants = RingAllocator::AlignUp(size, OffsetAlignment) / ConstantSize;
+		StateCache::SetVSConstantBufferRange(slot, ringBuffer.Get(), firstConstant, numConstants);
+		return;
+	}
+
+	// Older devices: one map per draw, like before
+	D3D11_MAPPED_SUBRESOURCE mapped = {};
+	Graphics::Context->Map(fallbackBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+	memcpy(mapped.pData, staging.data() + offset, size);
+	Graphics::Context->Unmap(fallbackBuffer.Get(), 0);
+	StateCache::SetVSConstantBuffer(slot, fallbackBuffer.Get());
+	mapCount++;
+	RenderStats::CountMap();
+	RenderStats::CountConstantBytes(size);
+}
+
+// --------------------------------------------------------
+// Binds a block on some other context, such as a deferred
+// context on a worker thread.  Only the offset path can do
+// this, since the fallback maps on the immediate context
+// --------------------------------------------------------
+void ConstantBufferRing::BindVS(ID3D11DeviceContext1* context, unsigned int slot, unsigned int offset, unsigned int size)
+{
+	if (offset == RingAllocator::InvalidOffset || !supportsOffsets)
+		return;
+
+	UINT firstConstant = offset / ConstantSize;
+	UINT numConstants = RingAllocator::AlignUp(size, OffsetAlignment) / ConstantSize;
+	context->VSSetConstantBuffers1(slot, 1, ringBuffer.GetAddressOf(), &firstConstant, &numConstants);
+	RenderStats::CountBinds();
+}
+
+bool ConstantBufferRing::UsingOffsets() { return supportsOffsets; }
+unsigned int ConstantBufferRing::GetCapacity() { return supportsOffsets ? ring.GetCapacity() : maxBlockSize; }
+unsigned int ConstantBufferRing::GetMapCount() { return mapCount; }
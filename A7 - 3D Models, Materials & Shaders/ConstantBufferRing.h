@@ -0,0 +1,60 @@
+#pragma once
+
+#include <d3d11_1.h>
+#include <wrl/client.h>
+#include <vector>
+
+#include "RingAllocator.h"
+
+// --------------------------------------------------------
+// Per-frame constant data for every draw, packed into one
+// large dynamic buffer that is mapped once per frame
+//
+// Usage each frame:
+//   ring.BeginFrame(drawCount, sizeof(Data));
+//   offset = ring.Write(&data, sizeof(Data));  // per draw
+//   ring.EndFrame();
+//   ring.BindVS(0, offset, sizeof(Data));      // per draw
+//
+// On D3D11.1 each draw binds its own 256-byte aligned window
+// of the big buffer with VSSetConstantBuffers1.  Older devices
+// fall back to re-mapping a small buffer per draw
+// --------------------------------------------------------
+class ConstantBufferRing
+{
+public:
+	ConstantBufferRing();
+
+	void Initialize(unsigned int capacityBytes, unsigned int maxBlockSize);
+
+	void BeginFrame(unsigned int blockCount, unsigned int blockSize);
+	unsigned int Write(const void* data, unsigned int size);
+	void EndFrame();
+
+	void BindVS(unsigned int slot, unsigned int offset, unsigned int size);
+	void BindVS(ID3D11DeviceContext1* context, unsigned int slot, unsigned int offset, unsigned int size);
+
+	bool UsingOffsets();
+	unsigned int GetCapacity();
+	unsigned int GetMapCount();
+
+private:
+	void CreateRingBuffer(unsigned int capacityBytes);
+
+	bool supportsOffsets;
+
+	// Big buffer for the offset path
+	Microsoft::WRL::ComPtr<ID3D11Buffer> ringBuffer;
+	RingAllocator ring;
+	bool needsDiscard;
+	unsigned char* mappedData;
+
+	// Fallback path: the frame's data sits in system memory
+	// and is copied into one small buffer per draw
+	Microsoft::WRL::ComPtr<ID3D11Buffer> fallbackBuffer;
+	std::vector<unsigned char> staging;
+	unsigned int stagingCursor;
+	unsigned int maxBlockSize;
+
+	unsigned int mapCount;
+};
@@ -0,0 +1,156 @@
+#include "D3D11RenderBackend.h"
+#include "Graphics.h"
+#include "StateCache.h"
+#include "RenderResources.h"
+#include "RenderStats.h"
+
+#include <cstring>
+
+void D3D11RenderBackend::Initialize(unsigned int ringCapacity, unsigned int maxConstantSize)
+{
+	cbRing.Initialize(ringCapacity, maxConstantSize);
+}
+
+ConstantBufferRing& D3D11RenderBackend::GetConstantRing()
+{
+	return cbRing;
+}
+
+// --------------------------------------------------------
+// Copies every per-draw constant block in the stream into
+// the ring, remembering where each one landed
+// --------------------------------------------------------
+void D3D11RenderBackend::WriteConstants(const RenderCommandStream& stream)
+{
+	constantOffsets.clear();
+
+	unsigned int largest = 0;
+	RenderCommandReader counter(stream);
+	RenderCommand command;
+	while (counter.Next(command))
+	{
+		if (command.type != RenderCommandType::SetVSConstants)
+			continue;
+		constantOffsets.push_back(0);
+		if (command.payloadSize > largest)
+			largest = command.payloadSize;
+	}
+
+	if (constantOffsets.empty())
+		return;
+
+	cbRing.BeginFrame((unsigned int)constantOffsets.size(), largest);
+
+	size_t index = 0;
+	RenderCommandReader writer(stream);
+	while (writer.Next(command))
+	{
+		if (command.type == RenderCommandType::SetVSConstants)
+			constantOffsets[index++] = cbRing.Write(command.payload, command.payloadSize);
+	}
+
+	cbRing.EndFrame();
+}
+
+void D3D11RenderBackend::Execute(const RenderCommandStream& stream)
+{
+	WriteConstants(stream);
+
+	size_t constantIndex = 0;
+	RenderCommandReader reader(stream);
+	RenderCommand command;
+	while (reader.Next(command))
+	{
+		switch (command.type)
+		{
+		case RenderCommandType::SetTopology:
+			StateCache::SetPrimitiveTopology((D3D11_PRIMITIVE_TOPOLOGY)command.As<SetTopologyCommand>().topology);
+			break;
+
+		case RenderCommandType::SetInputLayout:
+			StateCache::SetInputLayout(RenderResources::GetInputLayout(command.As<SetResourceCommand>().resource));
+			break;
+
+		case RenderCommandType::SetVertexShader:
+			StateCache::SetVertexShader(RenderResources::GetVertexShader(command.As<SetResourceCommand>().resource));
+			break;
+
+		case RenderCommandType::SetPixelShader:
+			StateCache::SetPixelShader(RenderResources::GetPixelShader(command.As<SetResourceCommand>().resource));
+			break;
+
+		case RenderCommandType::SetVertexBuffers:
+		{
+			const SetVertexBuffersCommand& vb = command.As<SetVertexBuffersCommand>();
+			ID3D11Buffer* buffers[MaxStreamVertexBuffers] = {};
+			for (unsigned int i = 0; i < vb.count; i++)
+				buffers[i] = RenderResources::GetBuffer(vb.buffers[i]);
+			StateCache::SetVertexBuffers(vb.startSlot, vb.count, buffers, vb.strides, vb.offsets);
+			break;
+		}
+
+		case RenderCommandType::SetIndexBuffer:
+		{
+			const SetIndexBufferCommand& ib = command.As<SetIndexBufferCommand>();
+			StateCache::SetIndexBuffer(RenderResources::GetBuffer(ib.buffer), (DXGI_FORMAT)ib.format, ib.offset);
+			break;
+		}
+
+		case RenderCommandType::SetVSConstantBuffer:
+		{
+			const SetConstantBufferCommand& cb = command.As<SetConstantBufferCommand>();
+			StateCache::SetVSConstantBuffer(cb.slot, RenderResources::GetBuffer(cb.buffer));
+			break;
+		}
+
+		case RenderCommandType::UploadBuffer:
+		{
+			ID3D11Buffer* buffer = RenderResources::GetBuffer(command.As<UploadBufferCommand>().buffer);
+			if (!buffer)
+				break;
+
+			D3D11_MAPPED_SUBRESOURCE mapped = {};
+			if (SUCCEEDED(Graphics::Context->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+			{
+				memcpy(mapped.pData, command.payload, command.payloadSize);
+				Graphics::Context->Unmap(buffer, 0);
+			}
+
+			D3D11_BUFFER_DESC desc = {};
+			buffer->GetDesc(&desc);
+			if (desc.BindFlags & D3D11_BIND_CONSTANT_BUFFER)
+				RenderStats::CountConstantBytes(command.payloadSize);
+			else
+				RenderStats::CountBufferBytes(command.payloadSize);
+			RenderStats::CountMap();
+			break;
+		}
+
+		case RenderCommandType::SetVSConstants:
+		{
+			const SetConstantsCommand& constants = command.As<SetConstantsCommand>();
+			cbRing.BindVS(constants.slot, constantOffsets[constantIndex++], constants.size);
+			break;
+		}
+
+		case RenderCommandType::DrawIndexed:
+		{
+			const DrawIndexedCommand& draw = command.As<DrawIndexedCommand>();
+			Graphics::Context->DrawIndexed(draw.indexCount, draw.startIndex, draw.baseVertex);
+			RenderStats::CountDraw(draw.indexCount);
+			break;
+		}
+
+		case RenderCommandType::DrawIndexedInstanced:
+		{
+			const DrawIndexedInstancedCommand& draw = command.As<DrawIndexedInstancedCommand>();
+			Graphics::Context->DrawIndexedInstanced(draw.indexCount, draw.instanceCount, draw.startIndex, draw.baseVertex, draw.startInstance);
+			RenderStats::CountDraw(draw.indexCount, draw.instanceCount);
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+}
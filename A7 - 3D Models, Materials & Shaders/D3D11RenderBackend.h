@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+#include "RenderBackend.h"
+#include "ConstantBufferRing.h"
+
+// --------------------------------------------------------
+// Executes command streams on Graphics::Context
+//
+// Binds go through the StateCache, so redundant ones are
+// still dropped.  Per-draw constants (SetVSConstants) are
+// all written into one ConstantBufferRing with a single map
+// before any draw runs, then each draw binds its own slice
+// --------------------------------------------------------
+class D3D11RenderBackend : public RenderBackend
+{
+public:
+	void Initialize(unsigned int ringCapacity, unsigned int maxConstantSize);
+
+	void Execute(const RenderCommandStream& stream) override;
+
+	ConstantBufferRing& GetConstantRing();
+
+private:
+	void WriteConstants(const RenderCommandStream& stream);
+
+	ConstantBufferRing cbRing;
+	std::vector<unsigned int> constantOffsets;
+};
@@ -0,0 +1,154 @@
+#include "DeferredRecorder.h"
+#include "Graphics.h"
+#include "StateCache.h"
+#include "RenderStats.h"
+
+namespace
+{
+	// More contexts than this stop paying off, since they all
+	// end up executed on one thread anyway
+	const unsigned int MaxWorkers = 8;
+}
+
+DeferredRecorder::DeferredRecorder() :
+	supported(false),
+	fallbackReason("Not initialized"),
+	minDrawsPerChunk(128)
+{
+}
+
+// --------------------------------------------------------
+// Checks whether the driver can build command lists itself
+// and sets up one deferred context and ring per worker
+//
+// workerCount   - Most chunks per frame (one is recorded on
+//                 the calling thread)
+// ringCapacity  - Starting size of each worker's ring
+// maxBlockSize  - Largest constant block a draw writes
+// --------------------------------------------------------
+void DeferredRecorder::Initialize(unsigned int workerCount, unsigned int ringCapacity, unsigned int maxBlockSize)
+{
+	workers.clear();
+	supported = false;
+
+	if (workerCount > MaxWorkers) workerCount = MaxWorkers;
+	if (workerCount < 2)
+	{
+		fallbackReason = "Only one hardware thread";
+		return;
+	}
+
+	D3D11_FEATURE_DATA_THREADING threading = {};
+	HRESULT hr = Graphics::Device->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading, sizeof(threading));
+	if (FAILED(hr) || !threading.DriverCommandLists)
+	{
+		fallbackReason = "Driver has no native command lists";
+		return;
+	}
+
+	workers.resize(workerCount);
+	for (Worker& worker : workers)
+	{
+		hr = Graphics::Device->CreateDeferredContext(0, worker.context.GetAddressOf());
+		if (FAILED(hr) || FAILED(worker.context.As(&worker.context1)))
+		{
+			workers.clear();
+			fallbackReason = "Could not create deferred contexts";
+			return;
+		}
+
+		worker.ring.Initialize(ringCapacity, maxBlockSize);
+		if (!worker.ring.UsingOffsets())
+		{
+			workers.clear();
+			fallbackReason = "Constant buffer offsets unavailable";
+			return;
+		}
+	}
+
+	supported = true;
+	fallbackReason = "";
+}
+
+bool DeferredRecorder::ShouldRecord(unsigned int drawCount)
+{
+	return supported && DrawChunks::WorthSplitting(drawCount, (unsigned int)workers.size(), minDrawsPerChunk);
+}
+
+// --------------------------------------------------------
+// Splits the draws into chunks, records them in parallel and
+// executes the command lists in order.  Returns how many
+// chunks were used
+// --------------------------------------------------------
+unsigned int DeferredRecorder::Record(unsigned int drawCount, unsigned int blockSize, const RecordChunkFunction& recordChunk)
+{
+	unsigned int chunkCount = DrawChunks::Split(drawCount, (unsigned int)workers.size(), minDrawsPerChunk, chunks);
+	if (chunkCount == 0)
+		return 0;
+
+	// Deferred contexts start empty, so they get the immediate
+	// context's viewport along with the render targets
+	UINT viewportCount = 1;
+	D3D11_VIEWPORT viewport = {};
+	Graphics::Context->RSGetViewports(&viewportCount, &viewport);
+
+	// The rings are mapped here, on the immediate context.  The
+	// workers only copy into them, which needs no context at all
+	for (unsigned int i = 0; i < chunkCount; i++)
+		workers[i].ring.BeginFrame(chunks[i].count, blockSize);
+
+	// Hand every chunk but the first to another thread, and
+	// record the first one here while they run
+	jobs.clear();
+	for (unsigned int i = 1; i < chunkCount; i++)
+	{
+		jobs.push_back(std::async(std::launch::async, [this, i, &viewport, &recordChunk]()
+			{
+				RecordChunk(i, viewport, recordChunk);
+			}));
+	}
+	RecordChunk(0, viewport, recordChunk);
+
+	for (std::future<void>& job : jobs)
+		job.wait();
+
+	for (unsigned int i = 0; i < chunkCount; i++)
+		workers[i].ring.EndFrame();
+
+	// Chunks were cut from the sorted list in order, so running
+	// them in order keeps the draws in sorted order
+	for (unsigned int i = 0; i < chunkCount; i++)
+	{
+		Graphics::Context->ExecuteCommandList(workers[i].commandList.Get(), FALSE);
+		workers[i].commandList.Reset();
+	}
+
+	// Not restoring state is cheaper, but leaves the immediate
+	// context cleared, so put back what the rest of the frame
+	// expects and forget anything the cache remembered
+	Graphics::Context->OMSetRenderTargets(1, Graphics::BackBufferRTV.GetAddressOf(), Graphics::DepthBufferDSV.Get());
+	Graphics::Context->RSSetViewports(1, &viewport);
+	RenderStats::CountBinds(2);
+	StateCache::Reset();
+
+	return chunkCount;
+}
+
+void DeferredRecorder::RecordChunk(unsigned int index, const D3D11_VIEWPORT& viewport, const RecordChunkFunction& recordChunk)
+{
+	Worker& worker = workers[index];
+
+	worker.context->OMSetRenderTargets(1, Graphics::BackBufferRTV.GetAddressOf(), Graphics::DepthBufferDSV.Get());
+	worker.context->RSSetViewports(1, &viewport);
+	RenderStats::CountBinds(2);
+
+	recordChunk(worker.context1.Get(), worker.ring, chunks[index]);
+
+	worker.context->FinishCommandList(FALSE, worker.commandList.ReleaseAndGetAddressOf());
+}
+
+bool DeferredRecorder::IsSupported() { return supported; }
+const char* DeferredRecorder::GetFallbackReason() { return fallbackReason; }
+unsigned int DeferredRecorder::GetWorkerCount() { return (unsigned int)workers.size(); }
+unsigned int DeferredRecorder::GetMinDrawsPerChunk() { return minDrawsPerChunk; }
+void DeferredRecorder::SetMinDrawsPerChunk(unsigned int minDraws) { minDrawsPerChunk = minDraws > 0 ? minDraws : 1; }
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <d3d11_1.h>
+#include <wrl/client.h>
+#include <vector>
+#include <future>
+#include <functional>
+
+#include "ConstantBufferRing.h"
+#include "DrawChunks.h"
+
+// --------------------------------------------------------
+// Records a frame's draws on several threads at once
+//
+// The sorted draw list is split into chunks (see DrawChunks).
+// Each chunk is recorded into its own deferred context, with
+// its own constant buffer ring, and the resulting command
+// lists are executed in chunk order on the immediate context
+//
+// Usage each frame:
+//   if (recorder.ShouldRecord(drawCount))
+//       recorder.Record(drawCount, sizeof(Data), recordChunk);
+//   else
+//       ... record on the immediate context as usual
+//
+// Recording is only spread out when the driver supports
+// command lists natively (otherwise the runtime emulates
+// them on one thread anyway) and constant buffers can be
+// bound at an offset
+// --------------------------------------------------------
+class DeferredRecorder
+{
+public:
+	// Records every draw in chunk into context.  Called on a
+	// worker thread, so it must only touch its own arguments
+	// and data nobody else is writing this frame.  The context
+	// starts with the render targets and viewport bound, and
+	// nothing else
+	typedef std::function<void(ID3D11DeviceContext1* context, ConstantBufferRing& ring, DrawChunk chunk)> RecordChunkFunction;
+
+	DeferredRecorder();
+
+	void Initialize(unsigned int workerCount, unsigned int ringCapacity, unsigned int maxBlockSize);
+
+	bool ShouldRecord(unsigned int drawCount);
+	unsigned int Record(unsigned int drawCount, unsigned int blockSize, const RecordChunkFunction& recordChunk);
+
+	bool IsSupported();
+	const char* GetFallbackReason();
+	unsigned int GetWorkerCount();
+	unsigned int GetMinDrawsPerChunk();
+	void SetMinDrawsPerChunk(unsigned int minDraws);
+
+private:
+	struct Worker
+	{
+		Microsoft::WRL::ComPtr<ID3D11DeviceContext> context;
+		Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context1;
+		Microsoft::WRL::ComPtr<ID3D11CommandList> commandList;
+		ConstantBufferRing ring;
+	};
+
+	void RecordChunk(unsigned int index, const D3D11_VIEWPORT& viewport, const RecordChunkFunction& recordChunk);
+
+	std::vector<Worker> workers;
+	std::vector<DrawChunk> chunks;
+	std::vector<std::future<void>> jobs;
+
+	bool supported;
+	const char* fallbackReason;
+	unsigned int minDrawsPerChunk;
+};
@@ -0,0 +1,47 @@
+#include "DrawChunks.h"
+
+// --------------------------------------------------------
+// Splits the draws as evenly as possible, so no worker ends
+// up holding the whole frame up on its own
+// --------------------------------------------------------
+unsigned int DrawChunks::Split(
+	unsigned int drawCount,
+	unsigned int maxChunks,
+	unsigned int minDrawsPerChunk,
+	std::vector<DrawChunk>& chunks)
+{
+	chunks.clear();
+	if (drawCount == 0 || maxChunks == 0)
+		return 0;
+
+	if (minDrawsPerChunk == 0)
+		minDrawsPerChunk = 1;
+
+	unsigned int chunkCount = drawCount / minDrawsPerChunk;
+	if (chunkCount > maxChunks)
+		chunkCount = maxChunks;
+	if (chunkCount == 0)
+		chunkCount = 1;
+
+	// The first (drawCount % chunkCount) chunks get one extra
+	unsigned int baseSize = drawCount / chunkCount;
+	unsigned int extra = drawCount % chunkCount;
+
+	unsigned int start = 0;
+	for (unsigned int i = 0; i < chunkCount; i++)
+	{
+		unsigned int count = baseSize + (i < extra ? 1 : 0);
+		chunks.push_back({ start, count, i });
+		start += count;
+	}
+
+	return chunkCount;
+}
+
+bool DrawChunks::WorthSplitting(unsigned int drawCount, unsigned int maxChunks, unsigned int minDrawsPerChunk)
+{
+	if (minDrawsPerChunk == 0)
+		minDrawsPerChunk = 1;
+
+	return maxChunks > 1 && drawCount / minDrawsPerChunk > 1;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+// A contiguous run of the sorted draw list, recorded by one
+// worker.  Chunks are handed out in order, so executing their
+// command lists in order keeps the sorted draw order intact
+struct DrawChunk
+{
+	unsigned int start;
+	unsigned int count;
+	unsigned int index;		// Which chunk, and so which worker records it
+};
+
+// --------------------------------------------------------
+// Decides how a frame's draws are split across workers
+//
+// Recording on another thread has a fixed cost (a command
+// list, a ring map, setting up state from scratch), so a
+// chunk is only worth it when it holds enough draws.  Below
+// that the caller should just record on the immediate
+// context
+//
+// Nothing here touches the GPU, so the logic can be checked
+// on its own
+// --------------------------------------------------------
+class DrawChunks
+{
+public:
+	// Splits drawCount draws into at most maxChunks chunks of
+	// at least minDrawsPerChunk each (the last few chunks may
+	// be one draw smaller than the first).  Returns how many
+	// chunks were written to chunks, which is 0 when there
+	// are no draws or no chunks allowed
+	static unsigned int Split(
+		unsigned int drawCount,
+		unsigned int maxChunks,
+		unsigned int minDrawsPerChunk,
+		std::vector<DrawChunk>& chunks);
+
+	// True when there is enough work for more than one chunk
+	static bool WorthSplitting(unsigned int drawCount, unsigned int maxChunks, unsigned int minDrawsPerChunk);
+};
@@ -0,0 +1,233 @@
+#include "DrawDataMerger.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+	// Largest index a 16-bit index buffer can hold, as indices
+	// are rebased by adding to them
+	const unsigned int MaxIndex = sizeof(ImDrawIdx) == 2 ? 0xFFFF : 0xFFFFFFFF;
+
+	// Screen space bounds of a command's vertices
+	struct Bounds
+	{
+		float minX, minY, maxX, maxY;
+	};
+}
+
+// The merged draw data's list only ever holds copies of the
+// source's buffers, so it needs no shared draw list data
+DrawDataMerger::DrawDataMerger() :
+	combined(nullptr),
+	stats{}
+{
+}
+
+// --------------------------------------------------------
+// Same projection and truncation as ImGui_ImplDX11_
+// RenderDrawData(), so two clip rects compare equal here
+// exactly when they'd set the same scissor
+// --------------------------------------------------------
+DrawDataMerger::Scissor DrawDataMerger::ToScissor(const ImVec4& clipRect, const ImVec2& clipOffset)
+{
+	return {
+		(long)(clipRect.x - clipOffset.x),
+		(long)(clipRect.y - clipOffset.y),
+		(long)(clipRect.z - clipOffset.x),
+		(long)(clipRect.w - clipOffset.y) };
+}
+
+// --------------------------------------------------------
+// One pass over every command: indices are copied across
+// (rebased onto the combined vertex buffer) while their
+// vertices' bounds are worked out, then the command is
+// either added to the previous one or started afresh
+//
+// A command's geometry is "contained" when no pixel outside
+// its scissor could be covered by it: the scissor lets
+// through pixels left..right-1, whose centers run from
+// left+0.5 to right-0.5, so geometry within left..right
+// can't reach the centers of the pixels either side
+// --------------------------------------------------------
+ImDrawData* DrawDataMerger::Merge(ImDrawData* source)
+{
+	auto start = std::chrono::high_resolution_clock::now();
+	stats = {};
+	stats.lists = source->CmdListsCount;
+
+	// Count what's there, and leave anything with callbacks
+	// that may look at their own list alone
+	bool userCallbacks = false;
+	for (int i = 0; i < source->CmdListsCount; i++)
+	{
+		for (const ImDrawCmd& command : source->CmdLists[i]->CmdBuffer)
+		{
+			if (!command.UserCallback)
+				stats.commandsIn++;
+			else if (command.UserCallback != ImDrawCallback_ResetRenderState)
+				userCallbacks = true;
+		}
+	}
+	if (userCallbacks)
+	{
+		stats.commandsOut = stats.commandsIn;
+		stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return source;
+	}
+
+	combined.VtxBuffer.resize(source->TotalVtxCount);
+	combined.IdxBuffer.resize(source->TotalIdxCount);
+	combined.CmdBuffer.resize(0);
+	ImDrawIdx* idxWrite = combined.IdxBuffer.Data;
+	const ImVec2 clipOffset = source->DisplayPos;
+
+	// What the last command added can be joined with
+	bool canJoin = false;
+	Scissor lastScissor = {};
+	bool lastContained = false;
+
+	unsigned int listVtxStart = 0;
+	unsigned int windowStart = 0;
+	for (int i = 0; i < source->CmdListsCount; i++)
+	{
+		const ImDrawList* list = source->CmdLists[i];
+		if (list->VtxBuffer.Size > 0)
+			memcpy(combined.VtxBuffer.Data + listVtxStart, list->VtxBuffer.Data, list->VtxBuffer.Size * sizeof(ImDrawVert));
+
+		for (const ImDrawCmd& command : list->CmdBuffer)
+		{
+			// The backend resets its state between commands, so
+			// nothing carries across
+			if (command.UserCallback)
+			{
+				combined.CmdBuffer.push_back(command);
+				canJoin = false;
+				continue;
+			}
+
+			// The backend skips these too
+			Scissor scissor = ToScissor(command.ClipRect, clipOffset);
+			if (command.ElemCount == 0 || scissor.IsEmpty())
+			{
+				stats.dropped++;
+				continue;
+			}
+
+			const ImDrawIdx* indices = list->IdxBuffer.Data + command.IdxOffset;
+			const ImDrawVert* vertices = list->VtxBuffer.Data + command.VtxOffset;
+			unsigned int maxIndex = 0;
+			Bounds bounds = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+			for (unsigned int n = 0; n < command.ElemCount; n++)
+			{
+				unsigned int index = indices[n];
+				maxIndex = std::max(maxIndex, index);
+				const ImVec2& pos = vertices[index].pos;
+				bounds.minX = std::min(bounds.minX, pos.x);
+				bounds.minY = std::min(bounds.minY, pos.y);
+				bounds.maxX = std::max(bounds.maxX, pos.x);
+				bounds.maxY = std::max(bounds.maxY, pos.y);
+			}
+			bounds.minX -= clipOffset.x; bounds.maxX -= clipOffset.x;
+			bounds.minY -= clipOffset.y; bounds.maxY -= clipOffset.y;
+
+			// Rebased indices have to fit the index type, or a
+			// new window starts at this command's vertices
+			unsigned int vtxStart = listVtxStart + command.VtxOffset;
+			if (stats.vertexWindows == 0 || vtxStart - windowStart > MaxIndex - maxIndex)
+			{
+				windowStart = vtxStart;
+				stats.vertexWindows++;
+				canJoin = false;
+			}
+			unsigned int rebase = vtxStart - windowStart;
+			for (unsigned int n = 0; n < command.ElemCount; n++)
+				idxWrite[n] = (ImDrawIdx)(indices[n] + rebase);
+
+			bool contained =
+				bounds.minX >= scissor.left && bounds.maxX <= scissor.right &&
+				bounds.minY >= scissor.top && bounds.maxY <= scissor.bottom;
+
+			ImDrawCmd* last = combined.CmdBuffer.Size > 0 ? &combined.CmdBuffer.back() : nullptr;
+			bool joined = false;
+			if (canJoin && last->TextureId == command.TextureId)
+			{
+				if (scissor == lastScissor)
+				{
+					stats.joinedSameScissor++;
+					joined = true;
+				}
+				else if (contained && lastContained)
+				{
+					last->ClipRect.x = std::min(last->ClipRect.x, command.ClipRect.x);
+					last->ClipRect.y = std::min(last->ClipRect.y, command.ClipRect.y);
+					last->ClipRect.z = std::max(last->ClipRect.z, command.ClipRect.z);
+					last->ClipRect.w = std::max(last->ClipRect.w, command.ClipRect.w);
+					lastScissor = ToScissor(last->ClipRect, clipOffset);
+					stats.joinedUnion++;
+					joined = true;
+				}
+			}
+
+			if (joined)
+			{
+				last->ElemCount += command.ElemCount;
+				lastContained = lastContained && contained;
+			}
+			else
+			{
+				ImDrawCmd added;
+				added.ClipRect = command.ClipRect;
+				added.TextureId = command.TextureId;
+				added.VtxOffset = windowStart;
+				added.IdxOffset = (unsigned int)(idxWrite - combined.IdxBuffer.Data);
+				added.ElemCount = command.ElemCount;
+
+				// Fits inside the scissor already set, so the
+				// backend needn't change it
+				if (canJoin && contained && !(scissor == lastScissor) &&
+					bounds.minX >= lastScissor.left && bounds.maxX <= lastScissor.right &&
+					bounds.minY >= lastScissor.top && bounds.maxY <= lastScissor.bottom)
+				{
+					added.ClipRect = last->ClipRect;
+					scissor = lastScissor;
+					stats.scissorsShared++;
+				}
+
+				combined.CmdBuffer.push_back(added);
+				lastScissor = scissor;
+				lastContained = contained;
+				canJoin = true;
+			}
+			idxWrite += command.ElemCount;
+		}
+		listVtxStart += list->VtxBuffer.Size;
+	}
+
+	// Less any dropped commands' indices
+	combined.IdxBuffer.resize((int)(idxWrite - combined.IdxBuffer.Data));
+	for (const ImDrawCmd& command : combined.CmdBuffer)
+	{
+		if (!command.UserCallback)
+			stats.commandsOut++;
+	}
+
+	merged.Valid = source->Valid;
+	merged.CmdLists.resize(0);
+	merged.CmdLists.push_back(&combined);
+	merged.CmdListsCount = 1;
+	merged.TotalVtxCount = combined.VtxBuffer.Size;
+	merged.TotalIdxCount = combined.IdxBuffer.Size;
+	merged.DisplayPos = source->DisplayPos;
+	merged.DisplaySize = source->DisplaySize;
+	merged.FramebufferScale = source->FramebufferScale;
+	merged.OwnerViewport = source->OwnerViewport;
+
+	stats.merged = true;
+	stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	return &merged;
+}
+
+const DrawDataMergeStats& DrawDataMerger::GetStats() { return stats; }
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ImGui/imgui.h"
+
+// Counters for the last Merge()
+struct DrawDataMergeStats
+{
+	bool merged;					// False when the source was passed through as is
+	unsigned int lists;
+	unsigned int commandsIn;		// Draw commands (not callbacks) across every list
+	unsigned int commandsOut;
+	unsigned int joinedSameScissor;	// Added to the previous command as is
+	unsigned int joinedUnion;		// Added by growing the previous command's scissor
+	unsigned int scissorsShared;	// Not joined, but reusing the previous command's scissor
+	unsigned int dropped;			// Empty, or with nothing left inside their scissor
+	unsigned int vertexWindows;		// Stretches of vertices one VtxOffset covers
+	double milliseconds;
+};
+
+// --------------------------------------------------------
+// Rewrites ImGui's draw data as a single list whose draw
+// commands are as few as possible, so the backend issues
+// fewer DrawIndexed calls and state changes
+//
+// Every list's vertices go into one combined buffer and
+// their indices are rebased to match, so consecutive
+// commands from different lists (windows) can be joined.  A
+// command joins the one before it when they share a texture
+// and vertex window and either end up with the same scissor,
+// or both have all of their geometry inside their own
+// scissor, in which case the union of the two clips nothing
+// either didn't.  Otherwise it takes the previous command's
+// scissor when that's just as safe, so the backend can skip
+// setting it again.  The pixels drawn, and the order they're
+// drawn in, are unchanged
+//
+// Draw data with user callbacks (besides the reset-render-
+// state one) is returned as is, since those callbacks are
+// handed the list they were added to
+// --------------------------------------------------------
+class DrawDataMerger
+{
+public:
+	DrawDataMerger();
+
+	// The merged draw data lives until the next Merge(); the
+	// source still owns nothing it points to
+	ImDrawData* Merge(ImDrawData* source);
+
+	const DrawDataMergeStats& GetStats();
+
+private:
+	// A scissor rect the way the DX11 backend works it out,
+	// in render target pixels
+	struct Scissor
+	{
+		long left, top, right, bottom;
+
+		bool IsEmpty() const { return right <= left || bottom <= top; }
+		bool operator==(const Scissor& other) const
+		{
+			return left == other.left && top == other.top && right == other.right && bottom == other.bottom;
+		}
+	};
+
+	static Scissor ToScissor(const ImVec4& clipRect, const ImVec2& clipOffset);
+
+	ImDrawList combined;
+	ImDrawData merged;
+	DrawDataMergeStats stats;
+};
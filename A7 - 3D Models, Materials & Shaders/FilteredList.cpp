@@ -0,0 +1,89 @@
+#include "FilteredList.h"
+
+#include <algorithm>
+
+FilteredList::FilteredList() :
+	refining(false),
+	next(0),
+	passEnd(0),
+	scanned(0),
+	complete(false),
+	descending(false)
+{
+}
+
+void FilteredList::Restart()
+{
+	matches.clear();
+	refineSource.clear();
+	refining = false;
+	next = 0;
+	passEnd = 0;
+	scanned = 0;
+	complete = false;
+}
+
+void FilteredList::Refine()
+{
+	if (!complete)
+	{
+		Restart();
+		return;
+	}
+
+	refineSource = rows;
+	matches.clear();
+	refining = true;
+	next = 0;
+	passEnd = refineSource.size();
+	complete = false;
+}
+
+void FilteredList::Clear()
+{
+	rows.clear();
+	Restart();
+}
+
+void FilteredList::SetDescending(bool descending)
+{
+	this->descending = descending;
+}
+
+// --------------------------------------------------------
+// Picks up scanning where the last pass ended, keeping its
+// matches
+// --------------------------------------------------------
+void FilteredList::BeginAppend()
+{
+	refining = false;
+	next = scanned;
+	complete = false;
+}
+
+// --------------------------------------------------------
+// Sorts by key, breaking ties by index so equal keys keep
+// the list's own order in either direction
+// --------------------------------------------------------
+void FilteredList::FinishPass()
+{
+	bool descending = this->descending;
+	std::sort(matches.begin(), matches.end(), [descending](const Candidate& a, const Candidate& b)
+	{
+		if (a.key != b.key)
+			return descending ? a.key > b.key : a.key < b.key;
+		return a.index < b.index;
+	});
+
+	rows.resize(matches.size());
+	for (size_t i = 0; i < matches.size(); i++)
+		rows[i] = matches[i].index;
+
+	refineSource.clear();
+	refining = false;
+	complete = true;
+}
+
+const std::vector<unsigned int>& FilteredList::GetRows() { return rows; }
+bool FilteredList::IsComplete() { return complete; }
+float FilteredList::GetProgress() { return complete || passEnd == 0 ? 1.0f : (float)next / passEnd; }
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// --------------------------------------------------------
+// The rows of a filtered, sorted view over a large list
+// (entities, say), worked out a batch at a time so no single
+// frame pays for the whole list
+//
+// Each frame, Update() tests up to budget more items with the
+// caller's match function and records a sort key for each
+// match.  When the pass reaches the end the matches are
+// sorted and become the new rows; until then GetRows() keeps
+// returning the previous result, so a UI showing them never
+// goes blank.  Items appended to the list later are scanned
+// on their own without starting over
+//
+// Call Restart() when the filter or sort changes, or Refine()
+// when the filter only got stricter (more text typed), which
+// rescans just the current matches
+// --------------------------------------------------------
+class FilteredList
+{
+public:
+	FilteredList();
+
+	// Both forget the current pass; Refine() falls back to a
+	// full restart while a pass is still running
+	void Restart();
+	void Refine();
+
+	// Also drops the rows, for when the list was replaced
+	void Clear();
+
+	void SetDescending(bool descending);
+
+	// Match(index) -> bool, Key(index) -> double.  Returns true
+	// once the rows cover all count items
+	template<typename Match, typename Key>
+	bool Update(size_t count, size_t budget, Match match, Key key);
+
+	const std::vector<unsigned int>& GetRows();
+	bool IsComplete();
+	float GetProgress();
+
+private:
+	struct Candidate
+	{
+		double key;
+		unsigned int index;
+	};
+
+	void BeginAppend();
+	void FinishPass();
+
+	std::vector<unsigned int> rows;
+	std::vector<Candidate> matches;
+
+	// Refining walks the previous matches instead of every item
+	std::vector<unsigned int> refineSource;
+	bool refining;
+
+	size_t next;		// Next item (or refineSource entry) to test
+	size_t passEnd;
+	size_t scanned;		// Items the matches cover, from index 0
+	bool complete;
+	bool descending;
+};
+
+template<typename Match, typename Key>
+bool FilteredList::Update(size_t count, size_t budget, Match match, Key key)
+{
+	// Items were removed, so indices may have moved
+	if (count < scanned || (!refining && next > count))
+		Clear();
+
+	// New items on the end are scanned like a pass of their
+	// own, and merged with the existing matches
+	if (complete && count > scanned)
+		BeginAppend();
+	if (complete)
+		return true;
+
+	size_t end = refining ? refineSource.size() : count;
+	passEnd = end;
+	size_t stop = next + budget < end ? next + budget : end;
+	for (; next < stop; next++)
+	{
+		unsigned int index = refining ? refineSource[next] : (unsigned int)next;
+		if (match(index))
+			matches.push_back({ key(index), index });
+	}
+
+	// A refine only covers what was scanned before, and anything
+	// added since is picked up as an append next time
+	if (next == end)
+	{
+		if (!refining)
+			scanned = count;
+		FinishPass();
+	}
+	return complete;
+}
@@ -0,0 +1,475 @@
+#include "FontAtlasCache.h"
+
+#include "ImGui/imgui.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// --------------- Basic usage -----------------
+//
+// Building ImGui's font atlas rasterizes every glyph with
+// stb_truetype and packs them with stb_rect_pack, which gets
+// slow as fonts, sizes and glyph ranges are added.  The
+// result only depends on the inputs, so it's baked once and
+// kept on disk:
+//
+//   io.Fonts->AddFontDefault();   // and any other fonts
+//   FontAtlasCache::LoadOrBuild(io.Fonts, FixPath("ImGuiFonts.cache"));
+//
+// The file holds the texture pixels, every font's glyphs and
+// lookup tables, and where each custom rect was packed, under
+// a key hashed from the fonts' data and config.  A later
+// launch with the same key reads the file in one go and
+// fills the atlas in directly; anything different (another
+// font, size, range or ImGui version) rebuilds and replaces
+// the file.
+//
+// Only the baked output is cached.  Fonts are still added as
+// usual, so their config and data stay with the atlas.
+//
+// ---------------------------------------------
+
+namespace
+{
+	const char Magic[4] = { 'I', 'F', 'A', 'C' };
+	const unsigned int FormatVersion = 1;
+
+	// --------------------------------------------------------
+	// 64-bit FNV-1a, fed one field at a time
+	// --------------------------------------------------------
+	class KeyHash
+	{
+	public:
+		void AddBytes(const void* data, size_t size)
+		{
+			const unsigned char* bytes = (const unsigned char*)data;
+			for (size_t i = 0; i < size; i++)
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+
+		template<typename T>
+		void Add(const T& value) { AddBytes(&value, sizeof(T)); }
+
+		unsigned long long Get() const { return hash; }
+
+	private:
+		unsigned long long hash = 14695981039346656037ull;
+	};
+
+	int FontIndex(const ImFontAtlas* atlas, const ImFont* font)
+	{
+		for (int i = 0; i < atlas->Fonts.Size; i++)
+		{
+			if (atlas->Fonts[i] == font)
+				return i;
+		}
+		return -1;
+	}
+
+	// Appends fields to a buffer that's written in one go
+	class Writer
+	{
+	public:
+		void PutBytes(const void* data, size_t size)
+		{
+			const unsigned char* bytes = (const unsigned char*)data;
+			buffer.insert(buffer.end(), bytes, bytes + size);
+		}
+
+		template<typename T>
+		void Put(const T& value) { PutBytes(&value, sizeof(T)); }
+
+		std::vector<unsigned char> buffer;
+	};
+
+	// Reads fields back, failing instead of running off the end
+	class Reader
+	{
+	public:
+		Reader(const std::vector<unsigned char>& buffer) : buffer(buffer), offset(0) {}
+
+		bool GetBytes(void* data, size_t size)
+		{
+			if (size > buffer.size() - offset)
+				return false;
+			memcpy(data, buffer.data() + offset, size);
+			offset += size;
+			return true;
+		}
+
+		template<typename T>
+		bool Get(T& value) { return GetBytes(&value, sizeof(T)); }
+
+		// A count followed by that many items
+		template<typename T>
+		bool GetArray(std::vector<T>& items)
+		{
+			int count = 0;
+			if (!Get(count) || count < 0 || (size_t)count > (buffer.size() - offset) / sizeof(T))
+				return false;
+			items.resize(count);
+			return GetBytes(items.data(), count * sizeof(T));
+		}
+
+	private:
+		const std::vector<unsigned char>& buffer;
+		size_t offset;
+	};
+
+	// Packed form of a custom rect, with its font as an index
+	struct CachedRect
+	{
+		unsigned short x, y;
+		unsigned short width, height;
+		unsigned int glyphID;
+		unsigned int glyphColored;
+		float glyphAdvanceX;
+		ImVec2 glyphOffset;
+		int font;
+	};
+
+	// Everything Build() works out for one font
+	struct CachedFontHeader
+	{
+		float fontSize;
+		float ascent;
+		float descent;
+		int metricsTotalSurface;
+		float fallbackAdvanceX;
+		int fallbackGlyph;		// Index into the glyphs, or -1
+		ImWchar fallbackChar;
+		ImWchar ellipsisChar;
+		short ellipsisCharCount;
+		float ellipsisWidth;
+		float ellipsisCharStep;
+		ImU8 used8kPagesMap[sizeof(ImFont::Used8kPagesMap)];
+	};
+
+	struct CachedFont
+	{
+		CachedFontHeader header;
+		std::vector<ImFontGlyph> glyphs;
+		std::vector<float> indexAdvanceX;
+		std::vector<ImWchar> indexLookup;
+	};
+
+	template<typename T>
+	void PutVector(Writer& writer, const ImVector<T>& items)
+	{
+		writer.Put(items.Size);
+		writer.PutBytes(items.Data, (size_t)items.Size * sizeof(T));
+	}
+
+	template<typename T>
+	void CopyToVector(ImVector<T>& items, const std::vector<T>& source)
+	{
+		items.resize((int)source.size());
+		if (!source.empty())
+			memcpy(items.Data, source.data(), source.size() * sizeof(T));
+	}
+}
+
+unsigned long long FontAtlasCache::ComputeKey(const ImFontAtlas* atlas)
+{
+	KeyHash hash;
+	hash.Add(FormatVersion);
+	hash.Add(IMGUI_VERSION_NUM);
+	hash.Add(sizeof(ImWchar));
+	hash.Add(sizeof(ImFontGlyph));
+
+	hash.Add(atlas->Flags);
+	hash.Add(atlas->TexDesiredWidth);
+	hash.Add(atlas->TexGlyphPadding);
+	hash.Add(atlas->FontBuilderFlags);
+	hash.Add(atlas->FontBuilderIO != 0);
+	hash.Add(atlas->Fonts.Size);
+
+	for (const ImFontConfig& config : atlas->ConfigData)
+	{
+		hash.Add(config.FontDataSize);
+		hash.AddBytes(config.FontData, (size_t)config.FontDataSize);
+		hash.Add(config.MergeMode);
+		hash.Add(config.PixelSnapH);
+		hash.Add(config.FontNo);
+		hash.Add(config.OversampleH);
+		hash.Add(config.OversampleV);
+		hash.Add(config.SizePixels);
+		hash.Add(config.GlyphExtraSpacing);
+		hash.Add(config.GlyphOffset);
+		hash.Add(config.GlyphMinAdvanceX);
+		hash.Add(config.GlyphMaxAdvanceX);
+		hash.Add(config.FontBuilderFlags);
+		hash.Add(config.RasterizerMultiply);
+		hash.Add(config.RasterizerDensity);
+		hash.Add(config.EllipsisChar);
+		hash.Add(FontIndex(atlas, config.DstFont));
+
+		// The ranges' contents, not where they happen to live
+		const ImWchar* ranges = config.GlyphRanges;
+		hash.Add(ranges != 0);
+		for (; ranges && ranges[0]; ranges += 2)
+		{
+			hash.Add(ranges[0]);
+			hash.Add(ranges[1]);
+		}
+	}
+
+	// Rects added by the game (Build() adds its own later)
+	hash.Add(atlas->CustomRects.Size);
+	for (const ImFontAtlasCustomRect& rect : atlas->CustomRects)
+	{
+		hash.Add(rect.Width);
+		hash.Add(rect.Height);
+		hash.Add((unsigned int)rect.GlyphID);
+		hash.Add((unsigned int)rect.GlyphColored);
+		hash.Add(rect.GlyphAdvanceX);
+		hash.Add(rect.GlyphOffset);
+		hash.Add(FontIndex(atlas, rect.Font));
+	}
+
+	return hash.Get();
+}
+
+FontAtlasCacheResult FontAtlasCache::LoadOrBuild(ImFontAtlas* atlas, const std::string& path)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	FontAtlasCacheResult result = {};
+	result.key = ComputeKey(atlas);
+	result.loaded = Load(atlas, result.key, path, &result.fileBytes);
+	if (!result.loaded)
+	{
+		atlas->Build();
+		result.saved = Save(atlas, result.key, path, &result.fileBytes);
+	}
+
+	auto end = std::chrono::steady_clock::now();
+	result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+	return result;
+}
+
+bool FontAtlasCache::Save(const ImFontAtlas* atlas, unsigned long long key, const std::string& path, size_t* fileBytes)
+{
+	if (!atlas->IsBuilt() || (!atlas->TexPixelsAlpha8 && !atlas->TexPixelsRGBA32))
+		return false;
+
+	Writer writer;
+	writer.PutBytes(Magic, sizeof(Magic));
+	writer.Put(FormatVersion);
+	writer.Put(key);
+
+	writer.Put(atlas->TexWidth);
+	writer.Put(atlas->TexHeight);
+	writer.Put(atlas->TexUvScale);
+	writer.Put(atlas->TexUvWhitePixel);
+	writer.PutBytes(atlas->TexUvLines, sizeof(atlas->TexUvLines));
+	writer.Put(atlas->TexPixelsUseColors);
+	writer.Put(atlas->PackIdMouseCursors);
+	writer.Put(atlas->PackIdLines);
+
+	writer.Put(atlas->CustomRects.Size);
+	for (const ImFontAtlasCustomRect& rect : atlas->CustomRects)
+	{
+		CachedRect cached = { rect.X, rect.Y, rect.Width, rect.Height, rect.GlyphID, rect.GlyphColored,
+			rect.GlyphAdvanceX, rect.GlyphOffset, FontIndex(atlas, rect.Font) };
+		writer.Put(cached);
+	}
+
+	writer.Put(atlas->Fonts.Size);
+	for (const ImFont* font : atlas->Fonts)
+	{
+		CachedFontHeader header = {};
+		header.fontSize = font->FontSize;
+		header.ascent = font->Ascent;
+		header.descent = font->Descent;
+		header.metricsTotalSurface = font->MetricsTotalSurface;
+		header.fallbackAdvanceX = font->FallbackAdvanceX;
+		header.fallbackGlyph = font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1;
+		header.fallbackChar = font->FallbackChar;
+		header.ellipsisChar = font->EllipsisChar;
+		header.ellipsisCharCount = font->EllipsisCharCount;
+		header.ellipsisWidth = font->EllipsisWidth;
+		header.ellipsisCharStep = font->EllipsisCharStep;
+		memcpy(header.used8kPagesMap, font->Used8kPagesMap, sizeof(header.used8kPagesMap));
+		writer.Put(header);
+
+		PutVector(writer, font->Glyphs);
+		PutVector(writer, font->IndexAdvanceX);
+		PutVector(writer, font->IndexLookup);
+	}
+
+	// Whichever pixel formats the builder produced
+	size_t pixelCount = (size_t)atlas->TexWidth * atlas->TexHeight;
+	writer.Put(atlas->TexPixelsAlpha8 != 0);
+	if (atlas->TexPixelsAlpha8)
+		writer.PutBytes(atlas->TexPixelsAlpha8, pixelCount);
+	writer.Put(atlas->TexPixelsRGBA32 != 0);
+	if (atlas->TexPixelsRGBA32)
+		writer.PutBytes(atlas->TexPixelsRGBA32, pixelCount * 4);
+
+	std::ofstream file(path, std::ios::binary);
+	file.write((const char*)writer.buffer.data(), (std::streamsize)writer.buffer.size());
+	if (fileBytes)
+		*fileBytes = writer.buffer.size();
+	return (bool)file;
+}
+
+// --------------------------------------------------------
+// Reads and checks the whole file before touching the atlas,
+// so a bad file leaves it as it was
+// --------------------------------------------------------
+bool FontAtlasCache::Load(ImFontAtlas* atlas, unsigned long long key, const std::string& path, size_t* fileBytes)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+
+	std::vector<unsigned char> buffer((size_t)file.tellg());
+	file.seekg(0);
+	if (!file.read((char*)buffer.data(), (std::streamsize)buffer.size()))
+		return false;
+	if (fileBytes)
+		*fileBytes = buffer.size();
+
+	Reader reader(buffer);
+	char magic[4] = {};
+	unsigned int version = 0;
+	unsigned long long fileKey = 0;
+	if (!reader.Get(magic) || memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+		!reader.Get(version) || version != FormatVersion ||
+		!reader.Get(fileKey) || fileKey != key)
+		return false;
+
+	int texWidth = 0;
+	int texHeight = 0;
+	ImVec2 texUvScale;
+	ImVec2 texUvWhitePixel;
+	ImVec4 texUvLines[IM_ARRAYSIZE(atlas->TexUvLines)];
+	bool texPixelsUseColors = false;
+	int packIdMouseCursors = -1;
+	int packIdLines = -1;
+	if (!reader.Get(texWidth) || !reader.Get(texHeight) ||
+		!reader.Get(texUvScale) || !reader.Get(texUvWhitePixel) || !reader.Get(texUvLines) ||
+		!reader.Get(texPixelsUseColors) || !reader.Get(packIdMouseCursors) || !reader.Get(packIdLines))
+		return false;
+	if (texWidth <= 0 || texHeight <= 0 || texWidth > 16384 || texHeight > 16384)
+		return false;
+
+	std::vector<CachedRect> rects;
+	if (!reader.GetArray(rects) || rects.size() < (size_t)atlas->CustomRects.Size)
+		return false;
+
+	int fontCount = 0;
+	if (!reader.Get(fontCount) || fontCount != atlas->Fonts.Size)
+		return false;
+
+	std::vector<CachedFont> fonts(fontCount);
+	for (CachedFont& font : fonts)
+	{
+		if (!reader.Get(font.header) ||
+			!reader.GetArray(font.glyphs) ||
+			!reader.GetArray(font.indexAdvanceX) ||
+			!reader.GetArray(font.indexLookup))
+			return false;
+		if (font.glyphs.empty() || font.header.fallbackGlyph >= (int)font.glyphs.size())
+			return false;
+	}
+	for (const CachedRect& rect : rects)
+	{
+		if (rect.font >= fontCount)
+			return false;
+	}
+
+	size_t pixelCount = (size_t)texWidth * texHeight;
+	bool hasAlpha8 = false;
+	bool hasRGBA32 = false;
+	std::vector<unsigned char> alpha8;
+	std::vector<unsigned char> rgba32;
+	if (!reader.Get(hasAlpha8))
+		return false;
+	if (hasAlpha8)
+	{
+		alpha8.resize(pixelCount);
+		if (!reader.GetBytes(alpha8.data(), pixelCount))
+			return false;
+	}
+	if (!reader.Get(hasRGBA32))
+		return false;
+	if (hasRGBA32)
+	{
+		rgba32.resize(pixelCount * 4);
+		if (!reader.GetBytes(rgba32.data(), pixelCount * 4))
+			return false;
+	}
+	if (!hasAlpha8 && !hasRGBA32)
+		return false;
+
+	// Everything checks out, so fill in what Build() would have
+	atlas->ClearTexData();
+	atlas->TexID = (ImTextureID)0;
+	atlas->TexWidth = texWidth;
+	atlas->TexHeight = texHeight;
+	atlas->TexUvScale = texUvScale;
+	atlas->TexUvWhitePixel = texUvWhitePixel;
+	memcpy(atlas->TexUvLines, texUvLines, sizeof(texUvLines));
+	atlas->TexPixelsUseColors = texPixelsUseColors;
+	atlas->PackIdMouseCursors = packIdMouseCursors;
+	atlas->PackIdLines = packIdLines;
+
+	atlas->CustomRects.resize((int)rects.size());
+	for (size_t i = 0; i < rects.size(); i++)
+	{
+		const CachedRect& cached = rects[i];
+		ImFontAtlasCustomRect& rect = atlas->CustomRects[(int)i];
+		rect.X = cached.x;
+		rect.Y = cached.y;
+		rect.Width = cached.width;
+		rect.Height = cached.height;
+		rect.GlyphID = cached.glyphID;
+		rect.GlyphColored = cached.glyphColored;
+		rect.GlyphAdvanceX = cached.glyphAdvanceX;
+		rect.GlyphOffset = cached.glyphOffset;
+		rect.Font = cached.font >= 0 ? atlas->Fonts[cached.font] : 0;
+	}
+
+	for (int i = 0; i < fontCount; i++)
+	{
+		const CachedFont& cached = fonts[i];
+		ImFont* font = atlas->Fonts[i];
+		font->ClearOutputData();
+		font->ContainerAtlas = atlas;
+		font->FontSize = cached.header.fontSize;
+		font->Ascent = cached.header.ascent;
+		font->Descent = cached.header.descent;
+		font->MetricsTotalSurface = cached.header.metricsTotalSurface;
+		font->FallbackAdvanceX = cached.header.fallbackAdvanceX;
+		font->FallbackChar = cached.header.fallbackChar;
+		font->EllipsisChar = cached.header.ellipsisChar;
+		font->EllipsisCharCount = cached.header.ellipsisCharCount;
+		font->EllipsisWidth = cached.header.ellipsisWidth;
+		font->EllipsisCharStep = cached.header.ellipsisCharStep;
+		memcpy(font->Used8kPagesMap, cached.header.used8kPagesMap, sizeof(font->Used8kPagesMap));
+
+		CopyToVector(font->Glyphs, cached.glyphs);
+		CopyToVector(font->IndexAdvanceX, cached.indexAdvanceX);
+		CopyToVector(font->IndexLookup, cached.indexLookup);
+		font->FallbackGlyph = cached.header.fallbackGlyph >= 0 ? &font->Glyphs[cached.header.fallbackGlyph] : 0;
+		font->DirtyLookupTables = false;
+	}
+
+	if (hasAlpha8)
+	{
+		atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(pixelCount);
+		memcpy(atlas->TexPixelsAlpha8, alpha8.data(), pixelCount);
+	}
+	if (hasRGBA32)
+	{
+		atlas->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(pixelCount * 4);
+		memcpy(atlas->TexPixelsRGBA32, rgba32.data(), pixelCount * 4);
+	}
+
+	atlas->TexReady = true;
+	return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+struct ImFontAtlas;
+
+// See FontAtlasCache.cpp for usage details
+
+struct FontAtlasCacheResult
+{
+	bool loaded;				// Came from the cache file
+	bool saved;					// Built, then written to the cache file
+	double milliseconds;		// Loading, or building plus saving
+	unsigned long long key;
+	size_t fileBytes;
+};
+
+namespace FontAtlasCache
+{
+	// Hash of everything that affects the baked atlas: each
+	// font's data, its config and glyph ranges, the atlas
+	// settings and any custom rects.  Call before building
+	unsigned long long ComputeKey(const ImFontAtlas* atlas);
+
+	// Fills in the atlas from the cache file when its key
+	// matches, otherwise builds it and rewrites the file.  Fonts
+	// must already be added
+	FontAtlasCacheResult LoadOrBuild(ImFontAtlas* atlas, const std::string& path);
+
+	// A built atlas's texture, glyphs and custom rect layout
+	bool Save(const ImFontAtlas* atlas, unsigned long long key, const std::string& path, size_t* fileBytes = 0);
+
+	// Fails (leaving the atlas unbuilt) if the file is missing,
+	// damaged or was saved for a different key
+	bool Load(ImFontAtlas* atlas, unsigned long long key, const std::string& path, size_t* fileBytes = 0);
+}
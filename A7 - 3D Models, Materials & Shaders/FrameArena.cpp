@@ -0,0 +1,218 @@
+#include "FrameArena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace
+{
+	// Blocks start on a cache line, so nothing allocated from
+	// different arenas ever shares one between threads
+	const size_t BlockAlignment = 64;
+
+	// Grown blocks are rounded up to whole pages
+	const size_t GrowthGranularity = 4096;
+
+	unsigned char* AllocateBlock(size_t capacity)
+	{
+		if (capacity == 0)
+			return 0;
+		return (unsigned char*)::operator new(capacity, std::align_val_t(BlockAlignment));
+	}
+
+	void FreeBlock(unsigned char* block)
+	{
+		if (block)
+			::operator delete(block, std::align_val_t(BlockAlignment));
+	}
+}
+
+LinearArena::LinearArena() :
+	block(0),
+	capacity(0),
+	cursor(0),
+	highWater(0),
+	stats{}
+{
+}
+
+LinearArena::~LinearArena()
+{
+	Reset(false);
+	FreeBlock(block);
+}
+
+void LinearArena::Initialize(size_t newCapacity)
+{
+	Reset(false);
+	FreeBlock(block);
+
+	block = AllocateBlock(newCapacity);
+	capacity = newCapacity;
+	highWater = 0;
+}
+
+// --------------------------------------------------------
+// Aligns the cursor's address (not its offset), so any
+// alignment works whatever the block's own alignment is.
+// Anything that doesn't fit goes to the heap and is kept
+// until the next Reset()
+// --------------------------------------------------------
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+	if (alignment == 0)
+		alignment = 1;
+
+	stats.used += size;
+	stats.allocations++;
+
+	if (block)
+	{
+		uintptr_t start = (uintptr_t)block;
+		uintptr_t aligned = (start + cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+		size_t offset = (size_t)(aligned - start);
+		if (offset <= capacity && size <= capacity - offset)
+		{
+			cursor = offset + size;
+			return block + offset;
+		}
+	}
+
+	// Over budget this frame.  Reset() grows the block so the
+	// same work fits next time
+	void* memory = ::operator new(size > 0 ? size : 1, std::align_val_t(alignment));
+	overflow.push_back({ memory, size, alignment });
+	stats.overflowBytes += size;
+	stats.overflowAllocations++;
+	return memory;
+}
+
+void LinearArena::Reset(bool poison)
+{
+	// Padding included, so the grown block fits it all
+	size_t held = cursor + stats.overflowBytes + overflow.size() * BlockAlignment;
+	if (held > highWater)
+		highWater = held;
+
+	if (poison && block)
+		memset(block, FrameArena::PoisonByte, cursor);
+
+	for (const Overflow& memory : overflow)
+	{
+		if (poison)
+			memset(memory.memory, FrameArena::PoisonByte, memory.size);
+		::operator delete(memory.memory, std::align_val_t(memory.alignment));
+	}
+	overflow.clear();
+
+	if (highWater > capacity)
+	{
+		FreeBlock(block);
+		capacity = (highWater + GrowthGranularity - 1) / GrowthGranularity * GrowthGranularity;
+		block = AllocateBlock(capacity);
+		if (poison)
+			memset(block, FrameArena::PoisonByte, capacity);
+	}
+
+	cursor = 0;
+	stats = {};
+}
+
+size_t LinearArena::GetCapacity() const { return capacity; }
+size_t LinearArena::GetHighWater() const { return highWater; }
+const FrameArenaStats& LinearArena::GetStats() const { return stats; }
+
+
+FrameArena::FrameArena() :
+	bufferedFrames(0),
+	workerCount(0),
+	currentFrame(0),
+#if defined(DEBUG) || defined(_DEBUG)
+	poison(true),
+#else
+	poison(false),
+#endif
+	lastFrame{},
+	peakUsed(0)
+{
+}
+
+void FrameArena::Initialize(size_t bytesPerFrame, unsigned int newBufferedFrames, unsigned int newWorkerCount, size_t bytesPerWorker)
+{
+	bufferedFrames = newBufferedFrames > 0 ? newBufferedFrames : 1;
+	workerCount = newWorkerCount;
+	currentFrame = 0;
+	lastFrame = {};
+	peakUsed = 0;
+
+	unsigned int perFrame = 1 + workerCount;
+	arenas = std::make_unique<LinearArena[]>((size_t)bufferedFrames * perFrame);
+	for (unsigned int frame = 0; frame < bufferedFrames; frame++)
+	{
+		arenas[frame * perFrame].Initialize(bytesPerFrame);
+		for (unsigned int worker = 0; worker < workerCount; worker++)
+			arenas[frame * perFrame + 1 + worker].Initialize(bytesPerWorker);
+	}
+}
+
+// --------------------------------------------------------
+// Totals up the frame that just ended, then moves on to the
+// set of arenas last used bufferedFrames - 1 frames ago
+// --------------------------------------------------------
+void FrameArena::BeginFrame()
+{
+	if (!arenas)
+		return;
+
+	unsigned int perFrame = 1 + workerCount;
+	LinearArena* finished = &arenas[currentFrame * perFrame];
+	lastFrame = {};
+	for (unsigned int i = 0; i < perFrame; i++)
+	{
+		const FrameArenaStats& stats = finished[i].GetStats();
+		lastFrame.used += stats.used;
+		lastFrame.overflowBytes += stats.overflowBytes;
+		lastFrame.allocations += stats.allocations;
+		lastFrame.overflowAllocations += stats.overflowAllocations;
+	}
+	if (lastFrame.used > peakUsed)
+		peakUsed = lastFrame.used;
+
+	currentFrame = (currentFrame + 1) % bufferedFrames;
+	LinearArena* next = &arenas[currentFrame * perFrame];
+	for (unsigned int i = 0; i < perFrame; i++)
+		next[i].Reset(poison);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	return GetMainArena().Allocate(size, alignment);
+}
+
+LinearArena& FrameArena::GetMainArena()
+{
+	return arenas[currentFrame * (1 + workerCount)];
+}
+
+LinearArena& FrameArena::GetWorkerArena(unsigned int worker)
+{
+	return arenas[currentFrame * (1 + workerCount) + 1 + worker];
+}
+
+void FrameArena::SetPoisonFreedFrames(bool newPoison) { poison = newPoison; }
+bool FrameArena::GetPoisonFreedFrames() { return poison; }
+const FrameArenaStats& FrameArena::GetLastFrameStats() { return lastFrame; }
+size_t FrameArena::GetPeakUsed() { return peakUsed; }
+unsigned int FrameArena::GetBufferedFrames() { return bufferedFrames; }
+unsigned int FrameArena::GetWorkerCount() { return workerCount; }
+
+size_t FrameArena::GetFrameCapacity()
+{
+	if (!arenas)
+		return 0;
+
+	size_t total = 0;
+	for (unsigned int i = 0; i <= workerCount; i++)
+		total += arenas[currentFrame * (1 + workerCount) + i].GetCapacity();
+	return total;
+}
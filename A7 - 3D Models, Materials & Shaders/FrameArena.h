@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// What one frame took from its arenas, summed over the main
+// arena and every worker's
+struct FrameArenaStats
+{
+	size_t used;					// Bytes handed out, including overflow
+	size_t overflowBytes;			// Part of used that came from the heap
+	unsigned int allocations;
+	unsigned int overflowAllocations;
+};
+
+// --------------------------------------------------------
+// A bump allocator over one block: each allocation moves a
+// cursor forward and Reset() frees everything at once
+//
+// An allocation that doesn't fit in the block falls back to
+// the heap instead of failing.  Those are freed by the next
+// Reset(), which also grows the block to the most the arena
+// has ever held, so a steady workload stops touching the
+// heap after its first frame
+//
+// Not thread-safe: every thread needs its own
+// --------------------------------------------------------
+class LinearArena
+{
+public:
+	LinearArena();
+	~LinearArena();
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	// Frees everything and replaces the block
+	void Initialize(size_t capacity);
+
+	// Never returns null.  Alignment must be a power of two
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// Room for count Ts, default-initialized like new T[count]
+	// (so plain structs are left alone).  Nothing is ever
+	// destroyed, only reused, hence the destructor check
+	template<typename T>
+	std::span<T> AllocateSpan(size_t count)
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "Arena memory is reused without running destructors");
+		T* items = (T*)Allocate(count * sizeof(T), alignof(T));
+		std::uninitialized_default_construct_n(items, count);
+		return std::span<T>(items, count);
+	}
+
+	// Frees everything allocated since the last reset.  With
+	// poison, the old contents are overwritten first so a
+	// stale pointer reads obvious garbage
+	void Reset(bool poison);
+
+	size_t GetCapacity() const;
+	size_t GetHighWater() const;
+
+	// Since the last reset
+	const FrameArenaStats& GetStats() const;
+
+private:
+	struct Overflow
+	{
+		void* memory;
+		size_t size;
+		size_t alignment;
+	};
+
+	unsigned char* block;
+	size_t capacity;
+	size_t cursor;
+
+	std::vector<Overflow> overflow;
+	size_t highWater;
+	FrameArenaStats stats;
+};
+
+// --------------------------------------------------------
+// Memory for data that only lives for a frame or two:
+// visible lists, sort scratch, instance data, staging copies
+//
+// Every frame gets a main arena plus one per worker thread,
+// and the last few frames' sets are kept in a ring.  Data
+// allocated in a frame stays valid until BeginFrame() has
+// been called bufferedFrames more times, so it can be read
+// while the next frame is being built
+//
+// Usage:
+//   arena.Initialize(1 << 20, 2, workers, 64 << 10);
+//   each frame:  arena.BeginFrame();
+//                std::span<Item> items = arena.AllocateSpan<Item>(n);
+//   on worker w: arena.GetWorkerArena(w).Allocate(...)
+//
+// Debug builds poison each frame's memory as it's recycled
+// --------------------------------------------------------
+class FrameArena
+{
+public:
+	static const unsigned char PoisonByte = 0xDD;
+
+	FrameArena();
+
+	void Initialize(size_t bytesPerFrame, unsigned int bufferedFrames, unsigned int workerCount, size_t bytesPerWorker);
+
+	// Recycles the oldest frame's memory for this frame.  Call
+	// on the main thread while no worker is allocating
+	void BeginFrame();
+
+	// From this frame's main arena.  Main thread only
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	template<typename T>
+	std::span<T> AllocateSpan(size_t count) { return GetMainArena().AllocateSpan<T>(count); }
+
+	// This frame's arenas.  A worker may only use its own
+	LinearArena& GetMainArena();
+	LinearArena& GetWorkerArena(unsigned int worker);
+
+	void SetPoisonFreedFrames(bool poison);
+	bool GetPoisonFreedFrames();
+
+	// The last finished frame, and the most any frame has used
+	const FrameArenaStats& GetLastFrameStats();
+	size_t GetPeakUsed();
+
+	// Bytes currently reserved for one frame, across all arenas
+	size_t GetFrameCapacity();
+	unsigned int GetBufferedFrames();
+	unsigned int GetWorkerCount();
+
+private:
+	// bufferedFrames sets of (main, worker 0, worker 1, ...)
+	std::unique_ptr<LinearArena[]> arenas;
+	unsigned int bufferedFrames;
+	unsigned int workerCount;
+	unsigned int currentFrame;
+	bool poison;
+
+	FrameArenaStats lastFrame;
+	size_t peakUsed;
+};
@@ -0,0 +1,172 @@
+#include "FrameTimes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+
+// --------------- Basic usage -----------------
+//
+// Record every frame's time once, on the main thread:
+//
+//   FrameTimes::Record(deltaTime * 1000.0f);
+//
+// The last WindowSize frames are kept in a ring, and
+// GetStats() summarizes them: percentiles up to p99.9, the
+// slowest frame, and how many frames took more than twice
+// as long as the median.  An average hides stutters, but
+// they show up clearly in the top percentiles and the
+// stutter count.
+//
+// Recording never locks.  The writer announces which slot it
+// is about to overwrite before touching it, and publishes the
+// new frame count after, so a reader on another thread can
+// copy without waiting and then drop any slot the writer
+// reached while it was copying.
+//
+// ---------------------------------------------
+
+namespace
+{
+	// Sorting the window takes a moment, so stats are only
+	// rebuilt this often
+	const unsigned long long StatsInterval = 32;
+
+	std::atomic<float> times[FrameTimes::WindowSize];
+	std::atomic<unsigned long long> written{ 0 };	// Frames readers may copy
+	std::atomic<unsigned long long> writing{ 0 };	// Frames the writer has started
+
+	FrameTimeStats stats{};
+	unsigned long long statsFrame = 0;
+	std::vector<float> copyBuffer;
+	std::vector<float> scratch;
+
+	// Nearest rank: the smallest value with at least
+	// fraction of the sorted values at or below it
+	double Percentile(const std::vector<float>& sorted, double fraction)
+	{
+		// The small nudge keeps 0.99 * 100 from rounding up to 100
+		size_t rank = (size_t)std::ceil(fraction * sorted.size() - 1e-9);
+		return sorted[rank > 0 ? rank - 1 : 0];
+	}
+}
+
+// --------------------------------------------------------
+// Summarizes a set of frame times (in milliseconds)
+//
+// times   - Frame times in any order
+// count   - How many there are
+// scratch - Reused storage for the sorted copy
+// --------------------------------------------------------
+FrameTimeStats ComputeFrameTimeStats(const float* times, unsigned int count, std::vector<float>& scratch)
+{
+	FrameTimeStats result{};
+	if (count == 0)
+		return result;
+
+	scratch.assign(times, times + count);
+	std::sort(scratch.begin(), scratch.end());
+
+	double total = 0.0;
+	for (float t : scratch)
+		total += t;
+
+	result.count = count;
+	result.mean = total / count;
+	result.p50 = Percentile(scratch, 0.50);
+	result.p90 = Percentile(scratch, 0.90);
+	result.p99 = Percentile(scratch, 0.99);
+	result.p999 = Percentile(scratch, 0.999);
+	result.max = scratch.back();
+
+	// Everything past the first frame over twice the median
+	double stutterTime = result.p50 * 2.0;
+	auto firstStutter = std::upper_bound(scratch.begin(), scratch.end(), stutterTime,
+		[](double limit, float t) { return limit < t; });
+	result.stutters = (unsigned int)(scratch.end() - firstStutter);
+	return result;
+}
+
+void FrameTimes::Record(float milliseconds)
+{
+	unsigned long long index = written.load(std::memory_order_relaxed);
+	writing.store(index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	times[index & (WindowSize - 1)].store(milliseconds, std::memory_order_relaxed);
+	written.store(index + 1, std::memory_order_release);
+}
+
+unsigned long long FrameTimes::GetFrameCount()
+{
+	return written.load(std::memory_order_acquire);
+}
+
+// --------------------------------------------------------
+// Copies the most recent frame times, oldest first
+//
+// times    - Where to copy them
+// maxCount - Room in times; more than WindowSize is ignored
+// --------------------------------------------------------
+unsigned int FrameTimes::CopyRecent(float* out, unsigned int maxCount)
+{
+	unsigned long long end = written.load(std::memory_order_acquire);
+	unsigned long long available = end < WindowSize ? end : WindowSize;
+	unsigned long long count = maxCount < available ? maxCount : available;
+	unsigned long long first = end - count;
+
+	for (unsigned long long i = first; i < end; i++)
+		out[i - first] = times[i & (WindowSize - 1)].load(std::memory_order_relaxed);
+
+	// Frames recorded during the copy may have overwritten
+	// the oldest ones, so drop those
+	std::atomic_thread_fence(std::memory_order_acquire);
+	unsigned long long started = writing.load(std::memory_order_relaxed);
+	unsigned long long oldestIntact = started > WindowSize ? started - WindowSize : 0;
+	unsigned long long lost = oldestIntact > first ? oldestIntact - first : 0;
+	if (lost == 0)
+		return (unsigned int)count;
+	if (lost >= count)
+		return 0;
+
+	std::copy(out + lost, out + count, out);
+	return (unsigned int)(count - lost);
+}
+
+const FrameTimeStats& FrameTimes::GetStats()
+{
+	unsigned long long frame = GetFrameCount();
+	if (frame != statsFrame && (frame - statsFrame >= StatsInterval || frame < StatsInterval))
+	{
+		copyBuffer.resize(WindowSize);
+		unsigned int count = CopyRecent(copyBuffer.data(), WindowSize);
+		stats = ComputeFrameTimeStats(copyBuffer.data(), count, scratch);
+		statsFrame = frame;
+	}
+	return stats;
+}
+
+// --------------------------------------------------------
+// Writes one row per frame in the window, followed by the
+// stats for the same frames
+// --------------------------------------------------------
+bool FrameTimes::WriteCSV(const std::string& path)
+{
+	std::vector<float> recent(WindowSize);
+	unsigned int count = CopyRecent(recent.data(), WindowSize);
+	unsigned long long firstFrame = GetFrameCount() - count;
+
+	std::ofstream csv(path);
+	if (!csv)
+		return false;
+
+	csv << "frame,ms\n";
+	for (unsigned int i = 0; i < count; i++)
+		csv << firstFrame + i << "," << recent[i] << "\n";
+
+	std::vector<float> sorted;
+	FrameTimeStats summary = ComputeFrameTimeStats(recent.data(), count, sorted);
+	csv << "\nframes,mean,p50,p90,p99,p99.9,max,stutters\n";
+	csv << summary.count << "," << summary.mean << "," << summary.p50 << "," << summary.p90 << ","
+		<< summary.p99 << "," << summary.p999 << "," << summary.max << "," << summary.stutters << "\n";
+	return (bool)csv;
+}
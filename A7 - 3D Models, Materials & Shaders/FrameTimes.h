@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// See FrameTimes.cpp for usage details
+
+// Summary of a set of frame times, all in milliseconds.
+// Percentiles use the nearest-rank method, so each one is a
+// frame time that actually happened
+struct FrameTimeStats
+{
+	unsigned int count;
+	double mean;
+	double p50;
+	double p90;
+	double p99;
+	double p999;
+	double max;
+	unsigned int stutters;	// Frames over twice the median
+};
+
+// Works on a copy, so times can be in any order.  Scratch is
+// reused between calls to avoid allocating each time
+FrameTimeStats ComputeFrameTimeStats(const float* times, unsigned int count, std::vector<float>& scratch);
+
+namespace FrameTimes
+{
+	// How many of the most recent frames are kept
+	const unsigned int WindowSize = 4096; // Must be a power of two
+
+	// Call once per frame with that frame's time.  Only one
+	// thread may record, but any thread may read
+	void Record(float milliseconds);
+
+	unsigned long long GetFrameCount();
+
+	// Copies up to maxCount of the most recent frame times,
+	// oldest first, and returns how many were copied
+	unsigned int CopyRecent(float* times, unsigned int maxCount);
+
+	// Stats over the whole window, refreshed every few frames
+	const FrameTimeStats& GetStats();
+
+	// Writes every frame in the window, then the stats
+	bool WriteCSV(const std::string& path);
+}
@@ -0,0 +1,83 @@
+#include "Frustum.h"
+
+#include <cfloat>
+#include <cmath>
+
+using namespace DirectX;
+
+Frustum::Frustum()
+{
+	// Default frustum contains everything
+	for (int i = 0; i < 6; i++)
+		planes[i] = XMFLOAT4(0, 0, 0, 1);
+}
+
+// --------------------------------------------------------
+// Extracts the planes from a row-major, row-vector matrix
+// (the DirectXMath convention), using the columns of the
+// combined view-projection:
+//  - left/right   = col4 +/- col1
+//  - bottom/top   = col4 +/- col2
+//  - near         = col3  (D3D depth goes 0 to 1)
+//  - far          = col4 - col3
+// --------------------------------------------------------
+Frustum::Frustum(DirectX::XMFLOAT4X4 m)
+{
+	planes[0] = XMFLOAT4(m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41);
+	planes[1] = XMFLOAT4(m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41);
+	planes[2] = XMFLOAT4(m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42);
+	planes[3] = XMFLOAT4(m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42);
+	planes[4] = XMFLOAT4(m._13, m._23, m._33, m._43);
+	planes[5] = XMFLOAT4(m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43);
+
+	// Normalize so distances come out in world units
+	for (int i = 0; i < 6; i++)
+	{
+		XMFLOAT4& p = planes[i];
+		float length = sqrtf(p.x * p.x + p.y * p.y + p.z * p.z);
+		if (length > 0.0f)
+		{
+			p.x /= length;
+			p.y /= length;
+			p.z /= length;
+			p.w /= length;
+		}
+	}
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const
+{
+	for (int i = 0; i < 6; i++)
+	{
+		const XMFLOAT4& p = planes[i];
+		float distance = p.x * sphere.center.x + p.y * sphere.center.y + p.z * sphere.center.z + p.w;
+		if (distance < -sphere.radius)
+			return false;
+	}
+	return true;
+}
+
+// --------------------------------------------------------
+// Checks every plane rather than stopping at the first one
+// the sphere is outside of.  Inside, the margin is the
+// smallest gap to any plane; outside, it's how far past the
+// furthest plane the sphere is, since moving back across
+// any single plane isn't enough to make it visible
+// --------------------------------------------------------
+bool Frustum::Intersects(const BoundingSphere& sphere, float& margin) const
+{
+	float inside = FLT_MAX;
+	float outside = 0.0f;
+	for (int i = 0; i < 6; i++)
+	{
+		const XMFLOAT4& p = planes[i];
+		float gap = p.x * sphere.center.x + p.y * sphere.center.y + p.z * sphere.center.z + p.w + sphere.radius;
+		if (gap < 0.0f)
+			outside = -gap > outside ? -gap : outside;
+		else
+			inside = gap < inside ? gap : inside;
+	}
+
+	margin = outside > 0.0f ? outside : inside;
+	return outside == 0.0f;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <DirectXMath.h>
+
+// A world space sphere that fully contains an object
+struct BoundingSphere
+{
+	DirectX::XMFLOAT3 center;
+	float radius;
+};
+
+// --------------------------------------------------------
+// The six planes of a camera's view volume, pulled straight
+// out of a view-projection matrix.  Plane normals point
+// inward, so anything with a negative distance to any
+// plane is outside
+// --------------------------------------------------------
+class Frustum
+{
+public:
+	Frustum();
+	Frustum(DirectX::XMFLOAT4X4 viewProjection);
+
+	bool Intersects(const BoundingSphere& sphere) const;
+
+	// Same answer, plus how far the sphere could move (or the
+	// planes shift) before the answer would change
+	bool Intersects(const BoundingSphere& sphere, float& margin) const;
+
+private:
+	// Left, right, bottom, top, near, far as (a, b, c, d)
+	DirectX::XMFLOAT4 planes[6];
+};
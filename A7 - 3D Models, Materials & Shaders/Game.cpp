@@ -1,620 +1,2006 @@
-// This code assumes files are in "ImGui" subfolder!
-// Adjust as necessary for your own folder structure and project setup
-#include "ImGui/imgui.h"
-#include "ImGui/imgui_impl_dx11.h"
-#include "ImGui/imgui_impl_win32.h"
-
-#include "Game.h"
-#include "Graphics.h"
-#include "Vertex.h"
-#include "Input.h"
-#include "PathHelpers.h"
-#include "Window.h"
-#include "Mesh.h"
-#include "BufferStructs.h"
-
-#include <DirectXMath.h>
-
-
-// Needed for a helper function to load pre-compiled shader files
-#pragma comment(lib, "d3dcompiler.lib")
-#include <d3dcompiler.h>
-#include <memory>
-
-// For the DirectX Math library
-using namespace DirectX;
-
-// --------------------------------------------------------
-// Called once per program, after the window and graphics API
-// are initialized but before the game loop begins
-// --------------------------------------------------------
-void Game::Initialize()
-{
-	// Initialize ImGui itself & platform/renderer backends
-	IMGUI_CHECKVERSION();
-	ImGui::CreateContext();
-	ImGui_ImplWin32_Init(Window::Handle());
-	ImGui_ImplDX11_Init(Graphics::Device.Get(), Graphics::Context.Get());
-	// Pick a style (uncomment one of these 3)
-	ImGui::StyleColorsDark();
-	//ImGui::StyleColorsLight();
-	//ImGui::StyleColorsClassic();
-
-	// Helper methods for loading shaders, creating some basic
-	// geometry to draw and some simple camera matrices.
-	//  - You'll be expanding and/or replacing these later
-	LoadShaders();
-	CreateGeometry();
-
-	// Set initial graphics API state
-	//  - These settings persist until we change them
-	//  - Some of these, like the primitive topology & input layout, probably won't change
-	//  - Others, like setting shaders, will need to be moved elsewhere later
-	{
-		// Tell the input assembler (IA) stage of the pipeline what kind of
-		// geometric primitives (points, lines or triangles) we want to draw.  
-		// Essentially: "What kind of shape should the GPU draw with our vertices?"
-		Graphics::Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-		
-		// Ensure the pipeline knows how to interpret all the numbers stored in
-		// the vertex buffer. For this course, all of your vertices will probably
-		// have the same layout, so we can just set this once at startup.
-		Graphics::Context->IASetInputLayout(inputLayout.Get());
-
-		// Set the active vertex and pixel shaders
-		//  - Once you start applying different shaders to different objects,
-		//    these calls will need to happen multiple times per frame
-		Graphics::Context->VSSetShader(vertexShader.Get(), 0, 0);
-		Graphics::Context->PSSetShader(pixelShader.Get(), 0, 0);
-
-
-
-		unsigned int size = sizeof(VertexShaderData);
-		size = (size + 15) / 16 * 16; // Integer division is necessary here!
-
-		// Describe the constant buffer and create it
-		D3D11_BUFFER_DESC cbDesc = {};
-		cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-		cbDesc.ByteWidth = size;
-		cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-		cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-		cbDesc.MiscFlags = 0;
-		cbDesc.StructureByteStride = 0;
-		Graphics::Device->CreateBuffer(&cbDesc, 0, vsConstantBuffer.GetAddressOf());
-
-		Graphics::Context->VSSetConstantBuffers(
-			0,		// Which slot (register) to bind the buffer to?
-			1,		// How many are we activating?  Can set more than one at a time, if we need
-			vsConstantBuffer.GetAddressOf());
-	}
-	// Create the camera
-	camera = std::make_shared<Camera>(
-		XMFLOAT3(0.0f, 0.0f, -5.0f),	// Position
-		5.0f,					// Move speed
-		0.002f,					// Look speed
-		XM_PIDIV4,				// Field of view
-		Window::AspectRatio(),  // Aspect ratio
-		0.01f,					// Near clip
-		100.0f,					// Far clip
-		CameraProjectionType::Perspective);
-
-	cameraTwo = std::make_shared<Camera>(
-		XMFLOAT3(2.0f, -2.0f, -5.0f),
-		5.0f,					
-		0.002f,					
-		XM_PIDIV2,			
-		Window::AspectRatio(),  
-		0.01f,					
-		100.0f,					
-		CameraProjectionType::Orthographic
-	);
-}
-
-
-
-// --------------------------------------------------------
-// Clean up memory or objects created by this class
-// 
-// Note: Using smart pointers means there probably won't
-//       be much to manually clean up here!
-// --------------------------------------------------------
-Game::~Game()
-{
-	// ImGui clean up
-	ImGui_ImplDX11_Shutdown();
-	ImGui_ImplWin32_Shutdown();
-	ImGui::DestroyContext();
-}
-
-
-// --------------------------------------------------------
-// Loads shaders from compiled shader object (.cso) files
-// and also created the Input Layout that describes our 
-// vertex data to the rendering pipeline. 
-// - Input Layout creation is done here because it must 
-//    be verified against vertex shader byte code
-// - We'll have that byte code already loaded below
-// --------------------------------------------------------
-void Game::LoadShaders()
-{
-	// BLOBs (or Binary Large OBjects) for reading raw data from external files
-	// - This is a simplified way of handling big chunks of external data
-	// - Literally just a big array of bytes read from a file
-	ID3DBlob* pixelShaderBlob;
-	ID3DBlob* vertexShaderBlob;
-
-	// Loading shaders
-	//  - Visual Studio will compile our shaders at build time
-	//  - They are saved as .cso (Compiled Shader Object) files
-	//  - We need to load them when the application starts
-	{
-		// Read our compiled shader code files into blobs
-		// - Essentially just "open the file and plop its contents here"
-		// - Uses the custom FixPath() helper from Helpers.h to ensure relative paths
-		// - Note the "L" before the string - this tells the compiler the string uses wide characters
-		D3DReadFileToBlob(FixPath(L"PixelShader.cso").c_str(), &pixelShaderBlob);
-		D3DReadFileToBlob(FixPath(L"VertexShader.cso").c_str(), &vertexShaderBlob);
-
-		// Create the actual Direct3D shaders on the GPU
-		Graphics::Device->CreatePixelShader(
-			pixelShaderBlob->GetBufferPointer(),	// Pointer to blob's contents
-			pixelShaderBlob->GetBufferSize(),		// How big is that data?
-			0,										// No classes in this shader
-			pixelShader.GetAddressOf());			// Address of the ID3D11PixelShader pointer
-
-		Graphics::Device->CreateVertexShader(
-			vertexShaderBlob->GetBufferPointer(),	// Get a pointer to the blob's contents
-			vertexShaderBlob->GetBufferSize(),		// How big is that data?
-			0,										// No classes in this shader
-			vertexShader.GetAddressOf());			// The address of the ID3D11VertexShader pointer
-	}
-
-	// Create an input layout 
-	//  - This describes the layout of data sent to a vertex shader
-	//  - In other words, it describes how to interpret data (numbers) in a vertex buffer
-	//  - Doing this NOW because it requires a vertex shader's byte code to verify against!
-	//  - Luckily, we already have that loaded (the vertex shader blob above)
-	{
-		D3D11_INPUT_ELEMENT_DESC inputElements[2] = {};
-
-		// Set up the first element - a position, which is 3 float values
-		inputElements[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;				// Most formats are described as color channels; really it just means "Three 32-bit floats"
-		inputElements[0].SemanticName = "POSITION";							// This is "POSITION" - needs to match the semantics in our vertex shader input!
-		inputElements[0].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;	// How far into the vertex is this?  Assume it's after the previous element
-
-		// Set up the second element - a color, which is 4 more float values
-		inputElements[1].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;			// 4x 32-bit floats
-		inputElements[1].SemanticName = "COLOR";							// Match our vertex shader input!
-		inputElements[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;	// After the previous element
-
-		// Create the input layout, verifying our description against actual shader code
-		Graphics::Device->CreateInputLayout(
-			inputElements,							// An array of descriptions
-			2,										// How many elements in that array?
-			vertexShaderBlob->GetBufferPointer(),	// Pointer to the code of a shader that uses this layout
-			vertexShaderBlob->GetBufferSize(),		// Size of the shader code that uses this layout
-			inputLayout.GetAddressOf());			// Address of the resulting ID3D11InputLayout pointer
-	}
-}
-
-
-// --------------------------------------------------------
-// Creates the geometry we're going to draw
-// --------------------------------------------------------
-void Game::CreateGeometry()
-{
-	XMFLOAT4 red = XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f);
-	XMFLOAT4 green = XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
-	XMFLOAT4 blue = XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f);
-	XMFLOAT4 black = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
-	XMFLOAT4 grey = XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f);
-
-	Vertex verticesOne[] =
-	{
-		{ XMFLOAT3(+0.0f, +0.5f, +0.0f), red },
-		{ XMFLOAT3(+0.5f, -0.5f, +0.0f), blue },
-		{ XMFLOAT3(-0.5f, -0.5f, +0.0f), green },
-	};
-
-	unsigned int indicesOne[] = { 0, 1, 2 };
-
-
-	//Shape two
-	Vertex verticesTwo[] =
-	{
-		{ XMFLOAT3(-0.80f, +0.30f, 0.0f), blue },	// Top left
-		{ XMFLOAT3(-0.80f, +0.10f, 0.0f), black },	// Bottom left
-		{ XMFLOAT3(-0.40f, +0.20f, 0.0f), blue },	// Bottom right
-		{ XMFLOAT3(-0.40f, +0.30f, 0.0f), black }		// Top right
-	};
-
-	unsigned int indicesTwo[] =
-	{
-		0, 3, 2,	// Ensure clockwise winding order
-		0, 2, 1		// for both triangles
-	};
-
-	// Shape three
-	Vertex verticesThree[] =
-	{
-		{ XMFLOAT3(+0.50f, +0.50f, 0.0f), blue },
-		{ XMFLOAT3(+0.60f, +0.60f, 0.0f), blue },
-		{ XMFLOAT3(+0.60f, +0.40f, 0.0f), red },
-		{ XMFLOAT3(+0.70f, +0.70f, 0.0f), red },
-		{ XMFLOAT3(+0.80f, +0.60f, 0.0f), red },
-		{ XMFLOAT3(+0.90f, +0.50f, 0.0f), red },
-		{ XMFLOAT3(+0.80f, +0.40f, 0.0f), blue },
-		{ XMFLOAT3(+0.70f, +0.30f, 0.0f), grey },
-	};
-	unsigned int indicesThree[] =
-	{
-		0, 1, 2,	// Ensure clockwise winding order
-		1, 3, 4,
-		4, 5, 6,
-		6, 7, 2,
-		2, 4, 6
-	};
-
-
-	std::shared_ptr<Mesh> triangle = std::make_shared<Mesh>(ARRAYSIZE(indicesOne), ARRAYSIZE(verticesOne), verticesOne, indicesOne, "Triangle");
-	std::shared_ptr<Mesh> shapeTwo = std::make_shared<Mesh>(ARRAYSIZE(indicesTwo), ARRAYSIZE(verticesTwo), verticesTwo, indicesTwo, "Quad");
-	std::shared_ptr<Mesh> shapeThree = std::make_shared<Mesh>(ARRAYSIZE(indicesThree), ARRAYSIZE(verticesThree), verticesThree, indicesThree, "Shape");
-
-	meshes.push_back(triangle);
-	meshes.push_back(shapeTwo);
-	meshes.push_back(shapeThree);
-
-	std::shared_ptr<GameEntity> g1 = std::make_shared<GameEntity>(triangle);
-	std::shared_ptr<GameEntity> g2 = std::make_shared<GameEntity>(triangle);
-	std::shared_ptr<GameEntity> g3 = std::make_shared<GameEntity>(shapeTwo);
-	std::shared_ptr<GameEntity> g4 = std::make_shared<GameEntity>(shapeThree);
-	std::shared_ptr<GameEntity> g5 = std::make_shared<GameEntity>(shapeThree);
-
-
-	// Adjust transforms
-	g1->GetTransform()->Rotate(0, 0, 0.1f);
-	g2->GetTransform()->MoveAbsolute(-1.2f, -0.3f, 0.0f);
-	g4->GetTransform()->MoveAbsolute(-0.5f, 0.1f, 0.0f);
-	g5->GetTransform()->MoveAbsolute(0.1f, -1.0f, 0.0f);
-
-	entities.push_back(g1);
-	entities.push_back(g2);
-	entities.push_back(g3);
-	entities.push_back(g4);
-	entities.push_back(g5);
-}
-
-
-// --------------------------------------------------------
-// Handle resizing to match the new window size
-//  - Eventually, we'll want to update our 3D camera
-// --------------------------------------------------------
-void Game::OnResize()
-{
-	if (camera) camera->UpdateProjectionMatrix(Window::AspectRatio());
-}
-
-
-// --------------------------------------------------------
-// Update your game here - user input, move objects, AI, etc.
-// --------------------------------------------------------
-void Game::Update(float deltaTime, float totalTime)
-{
-
-	// Put this all in a helper method that is called from Game::Update()
-// Feed fresh data to ImGui
-	ImGuiIO& io = ImGui::GetIO();
-	io.DeltaTime = deltaTime;
-	io.DisplaySize.x = (float)Window::Width();
-	io.DisplaySize.y = (float)Window::Height();
-	// Reset the frame
-	ImGui_ImplDX11_NewFrame();
-	ImGui_ImplWin32_NewFrame();
-	ImGui::NewFrame();
-	// Determine new input capture
-	Input::SetKeyboardCapture(io.WantCaptureKeyboard);
-	Input::SetMouseCapture(io.WantCaptureMouse);
-	BuildUI();
-
-	// Example input checking: Quit if the escape key is pressed
-	if (Input::KeyDown(VK_ESCAPE))
-		Window::Quit();
-
-
-	//I,J,K,L to move box around
-	if (Input::KeyPress(75))
-		entities[2]->GetTransform()->MoveRelative(0.0f,-0.1f,0.0f);
-	if (Input::KeyPress(73))
-		entities[2]->GetTransform()->MoveRelative(0.0f, 0.1f, 0.0f);
-	if (Input::KeyPress(74))
-		entities[2]->GetTransform()->MoveRelative(-0.1f, 0.0f, 0.0f);
-	if (Input::KeyPress(76))
-		entities[2]->GetTransform()->MoveRelative(0.1f, 0.0f, 0.0f);
-
-	float scale = (float)sin(totalTime * 5) * 0.5f + 1.0f;
-	entities[0]->GetTransform()->SetScale(scale, scale, scale);
-	entities[0]->GetTransform()->Rotate(0, 0, deltaTime * 1.0f);
-	entities[1]->GetTransform()->SetPosition((float)sin(totalTime), 0, 0);
-
-	// Update the camera this frame
-	camera->Update(deltaTime);
-
-	if (Input::KeyDown('Q')) {
-		cameraTwo->Update(deltaTime);
-	}
-	
-	if (Input::KeyDown('E')) {
-		camera->Update(deltaTime);
-	}
-
-}
-
-float color[4] = { 0.4f, 0.6f, 0.75f, 1.0f };
-int number = 0;
-float colorTint[4] = { 1.0f, 0.5f, 0.5f, 1.0f };
-float offSet[3] = { 0.25f, 0.0f, 0.0f };
-
-void Game::BuildUI() {
-	if (windowOpen)
-	{
-		ImGui::ShowDemoWindow();
-	}
-
-	ImGui::Begin("My First Window"); {
-
-		//ImGui::Text("test");
-		ImGui::Text("Framerate: %f fps", ImGui::GetIO().Framerate);
-		ImGui::Text("Window Resolution: %dx%d", Window::Width(), Window::Height());
-		ImGui::Spacing();
-
-		if (ImGui::Button(windowOpen ? "Hide ImGui Demo Window" : "Show ImGui Demo Window"))
-			windowOpen = !windowOpen;
-
-		ImGui::Spacing();
-
-		if (ImGui::TreeNode("Expand Background Color Picker")) {
-			float red = color[0];
-			float blue = color[1];
-			float green = color[2];
-			float alpha = color[3];
-
-			ImGui::SliderFloat("Red", &red, 0, 1);
-			ImGui::SliderFloat("Blue", &blue, 0, 1);
-			ImGui::SliderFloat("Green", &green, 0, 1);
-			ImGui::SliderFloat("Alpha", &alpha, 0, 1);
-
-			XMFLOAT4 newColor(red, blue, green, alpha);
-			ImGui::ColorEdit4("RGBA color editor", &newColor.x);
-
-			color[0] = newColor.x;
-			color[1] = newColor.y;
-			color[2] = newColor.z;
-			color[3] = newColor.w;
-
-			ImGui::TreePop();
-		}
-
-		ImGui::Spacing();
-
-		if (ImGui::TreeNode("Number Counter")) {
-			// Create a button and test for a click
-			if (ImGui::Button("Press to increment"))
-			{
-				if (number >= 0 && number < 10) {
-					number++; // Adds to number when clicked
-				}
-			}
-			if (ImGui::Button("Press to decrement"))
-			{
-				if (number > 0) {
-					number--; // Subtracts to number when clicked
-				}
-			}
-			if (ImGui::TreeNode("Table")) {
-				if (ImGui::BeginTable("test", 4))
-				{
-					for (int row = 0; row < 4; row++)
-					{
-						ImGui::TableNextRow();
-						for (int column = 0; column < 4; column++)
-						{
-							ImGui::TableSetColumnIndex(column);
-							ImGui::Text("Row %d Column %d", row, column);
-							ImGui::Text("Counter Number: %d", number);
-						}
-					}
-					ImGui::EndTable();
-				}
-				ImGui::Spacing();
-				ImGui::TreePop();
-			}
-			ImGui::TreePop();
-		}
-
-		ImGui::Spacing();
-
-		if (ImGui::TreeNode("Meshes")) {
-			for (int i =0; i < meshes.size(); i++)
-			{
-				int triangles = ((meshes[i]->GetIndexCount()) / 3);
-				ImGui::PushID(entities[i].get());
-				if (ImGui::TreeNode("Mesh Node", "Mesh: %s", meshes[i]->GetName())) {
-					ImGui::Text("Vertice: %d", meshes[i]->GetVertexCount());
-					ImGui::Text("Indices: %d", meshes[i]->GetIndexCount());
-					ImGui::Text("Triangles: %d", triangles);
-					ImGui::TreePop();
-				}
-				ImGui::PopID();
-			}
-			ImGui::TreePop();
-		}
-
-		ImGui::Spacing();
-
-		if (ImGui::TreeNode("VertexShaderExternal")) 
-		{
-
-			XMFLOAT4 newColor(colorTint);
-			ImGui::ColorEdit4("RGBA color editor", &newColor.x);
-			colorTint[0] = newColor.x;
-			colorTint[1] = newColor.y;
-			colorTint[2] = newColor.z;
-			colorTint[3] = newColor.w;
-
-			ImGui::TreePop();
-		}
-
-		if (ImGui::TreeNode("Transform"))
-		{
-			for (int i = 0; i < entities.size(); i++) {
-				ImGui::PushID(entities[i].get());
-
-				if (ImGui::TreeNode("Entity Node", "Entity %d", i))
-				{
-					XMFLOAT3 position = entities[i]->GetTransform()->GetPosition();
-					XMFLOAT3 rotation = entities[i]->GetTransform()->GetPitchYawRoll();
-					XMFLOAT3 scale = entities[i]->GetTransform()->GetScale();
-
-					if (ImGui::DragFloat3("Position", &position.x, 0.01f)) 
-						entities[i]->GetTransform()->SetPosition(position);
-					if (ImGui::DragFloat3("Rotation", &rotation.x, 0.01f)) 
-						entities[i]->GetTransform()->SetRotation(rotation);
-					if (ImGui::DragFloat3("Scale", &scale.x, 0.01f)) 
-						entities[i]->GetTransform()->SetScale(scale);
-					ImGui::TreePop();
-				}
-				ImGui::PopID();
-			}
-			
-			ImGui::TreePop();
-		}
-
-		ImGui::Spacing();
-
-
-		if (ImGui::TreeNode("Camera"))
-		{
-			XMFLOAT3 pos = camera->GetTransform()->GetPosition();
-			XMFLOAT3 rot = camera->GetTransform()->GetPitchYawRoll();
-
-			if (ImGui::DragFloat3("Position", &pos.x, 0.01f))
-				camera->GetTransform()->SetPosition(pos);
-			if (ImGui::DragFloat3("Rotation (Radians)", &rot.x, 0.01f))
-				camera->GetTransform()->SetRotation(rot);
-			ImGui::Spacing();
-
-			float nearClip = camera->GetNearClip();	
-			float farClip = camera->GetFarClip();
-			if (ImGui::DragFloat("Near Clip Distance", &nearClip, 0.01f, 0.001f, 1.0f))
-				camera->SetNearClip(nearClip);
-			if (ImGui::DragFloat("Far Clip Distance", &farClip, 1.0f, 10.0f, 1000.0f))
-				camera->SetFarClip(farClip);
-
-			CameraProjectionType projType = camera->GetProjectionType();
-			int typeIndex = (int)projType;
-			if (ImGui::Combo("Projection Type", &typeIndex, "Perspective\0Orthographic\0Third"))
-			{
-				projType = (CameraProjectionType)typeIndex;
-				camera = std::make_shared<Camera>(
-					XMFLOAT3(0.0f, 0.0f, -5.0f),
-					5.0f,					
-					0.002f,					
-					XM_PIDIV4,				
-					Window::AspectRatio(),  
-					0.01f,					
-					100.0f,					
-					CameraProjectionType::Perspective);
-				camera->SetProjectionType(projType);
-
-				//it's a bit wonky when switching in between the Third Camera View and back to Perspective
-				if (typeIndex == 2) {
-					camera = std::make_shared<Camera>(
-						XMFLOAT3(2.0f, -2.0f, -5.0f),	
-						5.0f,					
-						0.002f,					
-						XM_PIDIV2,				
-						Window::AspectRatio(),  
-						0.01f,					
-						100.0f,					
-						CameraProjectionType::Perspective
-					);
-				}
-			}
-
-
-			if (projType == CameraProjectionType::Perspective)
-			{
-				float fov = camera->GetFieldOfView() * 180.0f / XM_PI;
-				if (ImGui::SliderFloat("Field of View (Degrees)", &fov, 0.01f, 180.0f))
-					camera->SetFieldOfView(fov * XM_PI / 180.0f);
-			}
-			else if (projType == CameraProjectionType::Orthographic)
-			{
-				float wid = camera->GetOrthographicWidth();
-				if (ImGui::SliderFloat("Orthographic Width", &wid, 1.0f, 10.0f))
-					camera->SetOrthographicWidth(wid);
-			}
-		/*	else if (projType == CameraProjectionType::Third) 
-			{
-				float fov = camera->GetFieldOfView() * 180.0f / XM_PI;
-				if (ImGui::SliderFloat("Field of View (Degrees)", &fov, 0.01f, 180.0f))
-					camera->SetFieldOfView(fov * XM_PI / 180.0f);
-			}*/
-
-			ImGui::TreePop();
-		}
-		ImGui::Spacing();
-	}
-	ImGui::End();
-
-}
-
-// --------------------------------------------------------
-// Clear the screen, redraw everything, present to the user
-// --------------------------------------------------------
-
-void Game::Draw(float deltaTime, float totalTime)
-{
-	// Frame START
-		// - These things should happen ONCE PER FRAME
-		// - At the beginning of Game::Draw() before drawing *anything*
-	{
-		// Clear the back buffer (erase what's on screen) and depth buffer
-		const float color[4] = { 0.4f, 0.6f, 0.75f, 0.0f };
-		Graphics::Context->ClearRenderTargetView(Graphics::BackBufferRTV.Get(), color);
-		Graphics::Context->ClearDepthStencilView(Graphics::DepthBufferDSV.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
-	}
-
-	// DRAW geometry
-	// Loop through the game entities and draw each one
-	// - Note: A constant buffer has already been bound to
-	//   the vertex shader stage of the pipeline (see Init above)
-	for (auto& e : entities)
-	{
-		e->gDraw(vsConstantBuffer, camera);
-	}
-
-	// Frame END
-	// - These should happen exactly ONCE PER FRAME
-	// - At the very end of the frame (after drawing *everything*)
-	{
-		// Draw the UI after everything else
-		ImGui::Render();
-		ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
-
-		// Present at the end of the frame
-		bool vsync = Graphics::VsyncState();
-		Graphics::SwapChain->Present(
-			vsync ? 1 : 0,
-			vsync ? 0 : DXGI_PRESENT_ALLOW_TEARING);
-
-		// Re-bind back buffer and depth buffer after presenting
-		Graphics::Context->OMSetRenderTargets(
-			1,
-			Graphics::BackBufferRTV.GetAddressOf(),
-			Graphics::DepthBufferDSV.Get());
-	}
-}
-
-
-
+// This code assumes files are in "ImGui" subfolder!
+// Adjust as necessary for your own folder structure and project setup
+#include "ImGui/imgui.h"
+#include "ImGui/imgui_impl_dx11.h"
+#include "ImGui/imgui_impl_win32.h"
+
+#include "Game.h"
+#include "Graphics.h"
+#include "Vertex.h"
+#include "Input.h"
+#include "PathHelpers.h"
+#include "Window.h"
+#include "Mesh.h"
+#include "BufferStructs.h"
+#include "StateCache.h"
+#include "RenderResources.h"
+#include "Profiler.h"
+#include "TraceWriter.h"
+#include "FrameTimes.h"
+#include "RenderStats.h"
+#include "PoolAllocator.h"
+#include "RetainedUI.h"
+
+#include <DirectXMath.h>
+
+
+// Needed for a helper function to load pre-compiled shader files
+#pragma comment(lib, "d3dcompiler.lib")
+#include <d3dcompiler.h>
+#include <memory>
+#include <thread>
+
+// For the DirectX Math library
+using namespace DirectX;
+
+// --------------------------------------------------------
+// Called once per program, after the window and graphics API
+// are initialized but before the game loop begins
+// --------------------------------------------------------
+void Game::Initialize()
+{
+	// Initialize ImGui itself & platform/renderer backends
+	//  - ImGui allocates and frees lots of small blocks every
+	//    frame, so it gets the pool allocator instead of malloc
+	IMGUI_CHECKVERSION();
+	ImGui::SetAllocatorFunctions(
+		[](size_t size, void*) { return PoolAllocator::Allocate(size); },
+		[](void* memory, void*) { PoolAllocator::Free(memory); });
+	ImGui::CreateContext();
+
+	// Bake the font atlas, or load last run's from disk
+	//  - The backends would build it on the first frame, but
+	//    by then it's too late to use the cache
+	//  - The null build has no backends, and still needs it
+	ImGuiIO& io = ImGui::GetIO();
+	io.Fonts->AddFontDefault();
+	fontAtlasCache = FontAtlasCache::LoadOrBuild(io.Fonts, FixPath("ImGuiFonts.cache"));
+#if !defined(GRAPHICS_NULL)
+	ImGui_ImplWin32_Init(Window::Handle());
+	ImGui_ImplDX11_Init(Graphics::Device.Get(), Graphics::Context.Get());
+#endif
+	// Pick a style (uncomment one of these 3)
+	ImGui::StyleColorsDark();
+	//ImGui::StyleColorsLight();
+	//ImGui::StyleColorsClassic();
+
+	// Helper methods for loading shaders, creating some basic
+	// geometry to draw and some simple camera matrices.
+	//  - You'll be expanding and/or replacing these later
+	LoadShaders();
+	CreateGeometry();
+	LoadScene("shapes");
+
+	// Set initial graphics API state
+	//  - These settings persist until we change them
+	//  - Some of these, like the primitive topology & input layout, probably won't change
+	//  - Others, like setting shaders, will need to be moved elsewhere later
+	{
+		// Tell the input assembler (IA) stage of the pipeline what kind of
+		// geometric primitives (points, lines or triangles) we want to draw.  
+		// Essentially: "What kind of shape should the GPU draw with our vertices?"
+		StateCache::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		
+		// Ensure the pipeline knows how to interpret all the numbers stored in
+		// the vertex buffer. For this course, all of your vertices will probably
+		// have the same layout, so we can just set this once at startup.
+		StateCache::SetInputLayout(inputLayout.Get());
+
+		// Set the active vertex and pixel shaders
+		//  - Once you start applying different shaders to different objects,
+		//    these calls will need to happen multiple times per frame
+		StateCache::SetVertexShader(vertexShader.Get());
+		StateCache::SetPixelShader(pixelShader.Get());
+
+
+
+		// All per-object constants for a frame go into one big
+		// buffer, so start it with room for a few hundred draws
+		renderBackend.Initialize(256 * 256, sizeof(VertexShaderData));
+
+		// One deferred context (and ring) per hardware thread
+		deferredRecorder.Initialize(std::thread::hardware_concurrency(), 256 * 64, sizeof(VertexShaderData));
+
+		// Two frames of transient data, plus a sub-arena for each
+		// recording worker.  Arenas grow to fit the busiest frame
+		frameArena.Initialize(1 << 20, 2, deferredRecorder.GetWorkerCount(), 64 << 10);
+
+		// Camera data only changes once per frame, so it gets
+		// its own small buffer in slot 1
+		D3D11_BUFFER_DESC cbDesc = {};
+		cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		cbDesc.ByteWidth = (sizeof(PerFrameData) + 15) / 16 * 16;
+		cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		cbDesc.Usage = D3D11_USAGE_DYNAMIC;
+		Graphics::Device->CreateBuffer(&cbDesc, 0, perFrameConstantBuffer.GetAddressOf());
+		RenderStats::CountBufferCreated();
+		perFrameBufferHandle = RenderResources::AddBuffer(perFrameConstantBuffer.Get());
+
+		StateCache::SetVSConstantBuffer(1, perFrameConstantBuffer.Get());
+	}
+	// Create the camera
+	camera = std::make_shared<Camera>(
+		XMFLOAT3(0.0f, 0.0f, -5.0f),	// Position
+		5.0f,					// Move speed
+		0.002f,					// Look speed
+		XM_PIDIV4,				// Field of view
+		Window::AspectRatio(),  // Aspect ratio
+		0.01f,					// Near clip
+		100.0f,					// Far clip
+		CameraProjectionType::Perspective);
+
+	cameraTwo = std::make_shared<Camera>(
+		XMFLOAT3(2.0f, -2.0f, -5.0f),
+		5.0f,					
+		0.002f,					
+		XM_PIDIV2,			
+		Window::AspectRatio(),  
+		0.01f,					
+		100.0f,					
+		CameraProjectionType::Orthographic
+	);
+}
+
+
+
+// --------------------------------------------------------
+// Clean up memory or objects created by this class
+// 
+// Note: Using smart pointers means there probably won't
+//       be much to manually clean up here!
+// --------------------------------------------------------
+Game::~Game()
+{
+	// ImGui clean up
+#if !defined(GRAPHICS_NULL)
+	ImGui_ImplDX11_Shutdown();
+	ImGui_ImplWin32_Shutdown();
+#endif
+	ImGui::DestroyContext();
+}
+
+
+// --------------------------------------------------------
+// Loads shaders from compiled shader object (.cso) files
+// and also created the Input Layout that describes our 
+// vertex data to the rendering pipeline. 
+// - Input Layout creation is done here because it must 
+//    be verified against vertex shader byte code
+// - We'll have that byte code already loaded below
+// --------------------------------------------------------
+void Game::LoadShaders()
+{
+	// BLOBs (or Binary Large OBjects) for reading raw data from external files
+	// - This is a simplified way of handling big chunks of external data
+	// - Literally just a big array of bytes read from a file
+	ID3DBlob* pixelShaderBlob;
+	ID3DBlob* vertexShaderBlob;
+
+	// Loading shaders
+	//  - Visual Studio will compile our shaders at build time
+	//  - They are saved as .cso (Compiled Shader Object) files
+	//  - We need to load them when the application starts
+	{
+		// Read our compiled shader code files into blobs
+		// - Essentially just "open the file and plop its contents here"
+		// - Uses the custom FixPath() helper from Helpers.h to ensure relative paths
+		// - Note the "L" before the string - this tells the compiler the string uses wide characters
+		D3DReadFileToBlob(FixPath(L"PixelShader.cso").c_str(), &pixelShaderBlob);
+		D3DReadFileToBlob(FixPath(L"VertexShader.cso").c_str(), &vertexShaderBlob);
+
+		// Create the actual Direct3D shaders on the GPU
+		Graphics::Device->CreatePixelShader(
+			pixelShaderBlob->GetBufferPointer(),	// Pointer to blob's contents
+			pixelShaderBlob->GetBufferSize(),		// How big is that data?
+			0,										// No classes in this shader
+			pixelShader.GetAddressOf());			// Address of the ID3D11PixelShader pointer
+
+		Graphics::Device->CreateVertexShader(
+			vertexShaderBlob->GetBufferPointer(),	// Get a pointer to the blob's contents
+			vertexShaderBlob->GetBufferSize(),		// How big is that data?
+			0,										// No classes in this shader
+			vertexShader.GetAddressOf());			// The address of the ID3D11VertexShader pointer
+	}
+
+	// Create an input layout 
+	//  - This describes the layout of data sent to a vertex shader
+	//  - In other words, it describes how to interpret data (numbers) in a vertex buffer
+	//  - Doing this NOW because it requires a vertex shader's byte code to verify against!
+	//  - Luckily, we already have that loaded (the vertex shader blob above)
+	{
+		D3D11_INPUT_ELEMENT_DESC inputElements[2] = {};
+
+		// Set up the first element - a position, which is 3 float values
+		inputElements[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;				// Most formats are described as color channels; really it just means "Three 32-bit floats"
+		inputElements[0].SemanticName = "POSITION";							// This is "POSITION" - needs to match the semantics in our vertex shader input!
+		inputElements[0].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;	// How far into the vertex is this?  Assume it's after the previous element
+
+		// Set up the second element - a color, which is 4 more float values
+		inputElements[1].Format = DXGI_FORMAT_R32G32B32A32_FLOAT;			// 4x 32-bit floats
+		inputElements[1].SemanticName = "COLOR";							// Match our vertex shader input!
+		inputElements[1].AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;	// After the previous element
+
+		// Create the input layout, verifying our description against actual shader code
+		Graphics::Device->CreateInputLayout(
+			inputElements,							// An array of descriptions
+			2,										// How many elements in that array?
+			vertexShaderBlob->GetBufferPointer(),	// Pointer to the code of a shader that uses this layout
+			vertexShaderBlob->GetBufferSize(),		// Size of the shader code that uses this layout
+			inputLayout.GetAddressOf());			// Address of the resulting ID3D11InputLayout pointer
+	}
+
+	// Instanced vertex shader and its input layout
+	//  - Same per-vertex elements as above in slot 0
+	//  - A world matrix (as four float4 rows) and a tint per
+	//    instance in slot 1, advancing once per instance
+	{
+		ID3DBlob* instancedShaderBlob;
+		D3DReadFileToBlob(FixPath(L"VertexShaderInstanced.cso").c_str(), &instancedShaderBlob);
+
+		Graphics::Device->CreateVertexShader(
+			instancedShaderBlob->GetBufferPointer(),
+			instancedShaderBlob->GetBufferSize(),
+			0,
+			instancedVertexShader.GetAddressOf());
+
+		D3D11_INPUT_ELEMENT_DESC inputElements[7] = {};
+		inputElements[0] = { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 };
+		inputElements[1] = { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 };
+		for (unsigned int row = 0; row < 4; row++)
+			inputElements[2 + row] = { "WORLD", row, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 };
+		inputElements[6] = { "TINT", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1 };
+
+		Graphics::Device->CreateInputLayout(
+			inputElements,
+			7,
+			instancedShaderBlob->GetBufferPointer(),
+			instancedShaderBlob->GetBufferSize(),
+			instancedInputLayout.GetAddressOf());
+
+		instancedShaderBlob->Release();
+	}
+
+	// Handles for recording into command streams
+	pixelShaderHandle = RenderResources::AddPixelShader(pixelShader.Get());
+	vertexShaderHandle = RenderResources::AddVertexShader(vertexShader.Get());
+	inputLayoutHandle = RenderResources::AddInputLayout(inputLayout.Get());
+	instancedVertexShaderHandle = RenderResources::AddVertexShader(instancedVertexShader.Get());
+	instancedInputLayoutHandle = RenderResources::AddInputLayout(instancedInputLayout.Get());
+}
+
+
+// --------------------------------------------------------
+// Creates the geometry we're going to draw
+// --------------------------------------------------------
+void Game::CreateGeometry()
+{
+	XMFLOAT4 red = XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f);
+	XMFLOAT4 green = XMFLOAT4(0.0f, 1.0f, 0.0f, 1.0f);
+	XMFLOAT4 blue = XMFLOAT4(0.0f, 0.0f, 1.0f, 1.0f);
+	XMFLOAT4 black = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+	XMFLOAT4 grey = XMFLOAT4(0.5f, 0.5f, 0.5f, 1.0f);
+
+	Vertex verticesOne[] =
+	{
+		{ XMFLOAT3(+0.0f, +0.5f, +0.0f), red },
+		{ XMFLOAT3(+0.5f, -0.5f, +0.0f), blue },
+		{ XMFLOAT3(-0.5f, -0.5f, +0.0f), green },
+	};
+
+	unsigned int indicesOne[] = { 0, 1, 2 };
+
+
+	//Shape two
+	Vertex verticesTwo[] =
+	{
+		{ XMFLOAT3(-0.80f, +0.30f, 0.0f), blue },	// Top left
+		{ XMFLOAT3(-0.80f, +0.10f, 0.0f), black },	// Bottom left
+		{ XMFLOAT3(-0.40f, +0.20f, 0.0f), blue },	// Bottom right
+		{ XMFLOAT3(-0.40f, +0.30f, 0.0f), black }		// Top right
+	};
+
+	unsigned int indicesTwo[] =
+	{
+		0, 3, 2,	// Ensure clockwise winding order
+		0, 2, 1		// for both triangles
+	};
+
+	// Shape three
+	Vertex verticesThree[] =
+	{
+		{ XMFLOAT3(+0.50f, +0.50f, 0.0f), blue },
+		{ XMFLOAT3(+0.60f, +0.60f, 0.0f), blue },
+		{ XMFLOAT3(+0.60f, +0.40f, 0.0f), red },
+		{ XMFLOAT3(+0.70f, +0.70f, 0.0f), red },
+		{ XMFLOAT3(+0.80f, +0.60f, 0.0f), red },
+		{ XMFLOAT3(+0.90f, +0.50f, 0.0f), red },
+		{ XMFLOAT3(+0.80f, +0.40f, 0.0f), blue },
+		{ XMFLOAT3(+0.70f, +0.30f, 0.0f), grey },
+	};
+	unsigned int indicesThree[] =
+	{
+		0, 1, 2,	// Ensure clockwise winding order
+		1, 3, 4,
+		4, 5, 6,
+		6, 7, 2,
+		2, 4, 6
+	};
+
+
+	std::shared_ptr<Mesh> triangle = std::make_shared<Mesh>(ARRAYSIZE(indicesOne), ARRAYSIZE(verticesOne), verticesOne, indicesOne, "Triangle", true);
+	std::shared_ptr<Mesh> shapeTwo = std::make_shared<Mesh>(ARRAYSIZE(indicesTwo), ARRAYSIZE(verticesTwo), verticesTwo, indicesTwo, "Quad", true);
+	std::shared_ptr<Mesh> shapeThree = std::make_shared<Mesh>(ARRAYSIZE(indicesThree), ARRAYSIZE(verticesThree), verticesThree, indicesThree, "Shape", true);
+
+	meshes.push_back(triangle);
+	meshes.push_back(shapeTwo);
+	meshes.push_back(shapeThree);
+}
+
+
+// --------------------------------------------------------
+// Replaces the entities with a named scene, then loads the
+// scene's camera path.  Returns false for an unknown name,
+// leaving the current scene alone
+//
+//  - "shapes": the original handful of shapes
+//  - "field":  the same shapes, then thousands more in
+//              layers receding from the camera, for
+//              benchmarking culling and drawing
+//
+// Both start with the same five entities, since Update()
+// animates the first three
+// --------------------------------------------------------
+bool Game::LoadScene(const std::string& name)
+{
+	if (name != "shapes" && name != "field")
+		return false;
+
+	std::shared_ptr<Mesh> triangle = meshes[0];
+	std::shared_ptr<Mesh> shapeTwo = meshes[1];
+	std::shared_ptr<Mesh> shapeThree = meshes[2];
+
+	std::shared_ptr<GameEntity> g1 = std::make_shared<GameEntity>(triangle);
+	std::shared_ptr<GameEntity> g2 = std::make_shared<GameEntity>(triangle);
+	std::shared_ptr<GameEntity> g3 = std::make_shared<GameEntity>(shapeTwo);
+	std::shared_ptr<GameEntity> g4 = std::make_shared<GameEntity>(shapeThree);
+	std::shared_ptr<GameEntity> g5 = std::make_shared<GameEntity>(shapeThree);
+
+
+	// Adjust transforms
+	g1->GetTransform()->Rotate(0, 0, 0.1f);
+	g2->GetTransform()->MoveAbsolute(-1.2f, -0.3f, 0.0f);
+	g4->GetTransform()->MoveAbsolute(-0.5f, 0.1f, 0.0f);
+	g5->GetTransform()->MoveAbsolute(0.1f, -1.0f, 0.0f);
+
+	entities.clear();
+	entities.push_back(g1);
+	entities.push_back(g2);
+	entities.push_back(g3);
+	entities.push_back(g4);
+	entities.push_back(g5);
+
+	if (name == "field")
+	{
+		// 32 layers of 16 x 8 shapes, cycling through the meshes
+		const int layers = 32;
+		const int columns = 16;
+		const int rows = 8;
+		for (int layer = 0; layer < layers; layer++)
+		{
+			for (int row = 0; row < rows; row++)
+			{
+				for (int column = 0; column < columns; column++)
+				{
+					int index = (layer * rows + row) * columns + column;
+					std::shared_ptr<GameEntity> entity = std::make_shared<GameEntity>(meshes[index % meshes.size()]);
+					entity->GetTransform()->SetPosition(
+						(column - columns / 2) * 1.5f,
+						(row - rows / 2) * 1.5f,
+						2.0f + layer * 2.0f);
+					entity->GetTransform()->SetRotation(0, 0, index * 0.37f);
+					entities.push_back(entity);
+				}
+			}
+		}
+	}
+
+	sceneName = name;
+	pickedEntity = -1;
+	inspectedEntity = -1;
+	entityRows.Clear();
+	visibilityCache.Invalidate();
+	BuildScenePath(name);
+	return true;
+}
+
+// --------------------------------------------------------
+// Loads the scene's recorded camera path from next to the
+// executable, falling back to a built-in one when no path
+// has been recorded for it
+//
+// The built-in paths mix fast flying with holds and slow
+// creeps, since a camera that never settles is the one case
+// the visibility cache can't help (and a benchmark of only
+// that would never exercise it)
+// --------------------------------------------------------
+void Game::BuildScenePath(const std::string& name)
+{
+	if (cameraPath.Load(FixPath(name + ".campath")))
+		return;
+
+	// The spline only stands still between keys whose
+	// neighbors are the same too, so a hold takes four keys.
+	// The camera eases in and out over the first and last
+	// quarter second
+	auto hold = [this](float start, float seconds, XMFLOAT3 position, XMFLOAT3 pitchYawRoll)
+	{
+		cameraPath.AddKey(start, position, pitchYawRoll);
+		cameraPath.AddKey(start + 0.25f, position, pitchYawRoll);
+		cameraPath.AddKey(start + seconds - 0.25f, position, pitchYawRoll);
+		cameraPath.AddKey(start + seconds, position, pitchYawRoll);
+	};
+
+	cameraPath.Clear();
+	if (name == "field")
+	{
+		// Looks down the layers, creeps forward, then flies down
+		// the middle weaving side to side, and looks back
+		hold(0.0f, 2.0f, XMFLOAT3(0.0f, 0.0f, -5.0f), XMFLOAT3(0.0f, 0.0f, 0.0f));
+		cameraPath.AddKey(4.0f, XMFLOAT3(0.0f, 0.2f, -4.0f), XMFLOAT3(0.0f, 0.05f, 0.0f));
+		cameraPath.AddKey(6.0f, XMFLOAT3(4.0f, 1.0f, 10.0f), XMFLOAT3(0.1f, -0.4f, 0.0f));
+		cameraPath.AddKey(8.0f, XMFLOAT3(-4.0f, -1.0f, 25.0f), XMFLOAT3(-0.1f, 0.4f, 0.0f));
+		cameraPath.AddKey(10.0f, XMFLOAT3(3.0f, 2.0f, 40.0f), XMFLOAT3(0.2f, -0.3f, 0.0f));
+		cameraPath.AddKey(12.0f, XMFLOAT3(0.0f, 0.0f, 55.0f), XMFLOAT3(0.0f, XM_PI, 0.0f));
+		hold(14.0f, 2.0f, XMFLOAT3(0.0f, 0.0f, 30.0f), XMFLOAT3(0.0f, XM_PI, 0.0f));
+	}
+	else
+	{
+		// Swings around the shapes, always facing the origin,
+		// pausing at the start and end of the swing
+		hold(0.0f, 2.0f, XMFLOAT3(0.0f, 0.0f, -5.0f), XMFLOAT3(0.0f, 0.0f, 0.0f));
+		for (int i = 1; i < 8; i++)
+		{
+			float angle = 0.6f * (float)sin(i * XM_PIDIV4);
+			cameraPath.AddKey(2.0f + i, XMFLOAT3(5.0f * (float)sin(angle), 0.0f, -5.0f * (float)cos(angle)), XMFLOAT3(0.0f, -angle, 0.0f));
+		}
+		hold(10.0f, 2.0f, XMFLOAT3(0.0f, 0.0f, -5.0f), XMFLOAT3(0.0f, 0.0f, 0.0f));
+	}
+}
+
+void Game::SetFollowCameraPath(bool follow) { followingCameraPath = follow; }
+const CameraPath& Game::GetCameraPath() { return cameraPath; }
+const VisibilityStats& Game::GetVisibilityStats() { return visibilityCache.GetStats(); }
+
+// --------------------------------------------------------
+// Adds a key from the live camera every quarter second
+// while a path is being recorded
+// --------------------------------------------------------
+void Game::RecordCameraPath(float totalTime)
+{
+	float time = totalTime - recordStartTime;
+	size_t keyCount = recordedPath.GetKeyCount();
+	if (keyCount > 0 && time < recordedPath.GetKey(keyCount - 1).time + 0.25f)
+		return;
+
+	recordedPath.AddKey(time, camera->GetTransform()->GetPosition(), camera->GetTransform()->GetPitchYawRoll());
+}
+
+
+// --------------------------------------------------------
+// Handle resizing to match the new window size
+//  - Eventually, we'll want to update our 3D camera
+// --------------------------------------------------------
+void Game::OnResize()
+{
+	if (camera) camera->UpdateProjectionMatrix(Window::AspectRatio());
+}
+
+
+// --------------------------------------------------------
+// Update your game here - user input, move objects, AI, etc.
+// --------------------------------------------------------
+void Game::Update(float deltaTime, float totalTime)
+{
+	PROFILE_SCOPE("Game::Update");
+
+	// Anything allocated two frames ago is recycled from here
+	frameArena.BeginFrame();
+
+	// Anything the UI shows that can change without input
+	retainedUI.Watch(Window::Width());
+	retainedUI.Watch(Window::Height());
+	retainedUI.Watch(entities.size());
+	retainedUI.Watch(meshes.size());
+	retainedUI.WatchBytes(sceneName.data(), sceneName.size());
+	retainedUI.Watch(pickedEntity);
+	retainedUI.Watch(windowOpen);
+	retainedUI.Watch(followingCameraPath);
+	retainedUI.Watch(recordingCameraPath);
+	retainedUI.Watch(captureFramesLeft > 0);
+	retainedUI.Watch(TraceWriter::IsRecording());
+	retainedUI.Watch(PoolAllocator::IsTracing());
+
+	// Build the UI only when it might look different; otherwise
+	// Draw() shows last frame's draw data again
+	uiBuiltThisFrame = retainedUI.BeginFrame(deltaTime);
+	ImGuiIO& io = ImGui::GetIO();
+	if (uiBuiltThisFrame)
+	{
+		retainedUI.BeginBuildTiming();
+
+		// Put this all in a helper method that is called from Game::Update()
+		// Feed fresh data to ImGui
+		io.DeltaTime = deltaTime;
+		io.DisplaySize.x = (float)Window::Width();
+		io.DisplaySize.y = (float)Window::Height();
+		// Reset the frame
+#if !defined(GRAPHICS_NULL)
+		ImGui_ImplDX11_NewFrame();
+		ImGui_ImplWin32_NewFrame();
+#endif
+		ImGui::NewFrame();
+		BuildUI();
+
+		retainedUI.EndBuildTiming();
+	}
+	// Determine new input capture
+	Input::SetKeyboardCapture(io.WantCaptureKeyboard);
+	Input::SetMouseCapture(io.WantCaptureMouse);
+
+	// Example input checking: Quit if the escape key is pressed
+	if (Input::KeyDown(VK_ESCAPE))
+		Window::Quit();
+
+	// F9 captures the next few seconds of command streams
+	if (Input::KeyPress(VK_F9) && captureFramesLeft == 0)
+	{
+		capture.Clear();
+		captureFramesLeft = 120;
+	}
+
+	// F8 starts and stops a trace of the profiler's markers
+	if (Input::KeyPress(VK_F8))
+	{
+		if (TraceWriter::IsRecording())
+			TraceWriter::Stop();
+		else
+			TraceWriter::Start(FixPath("Trace"));
+	}
+
+
+	//I,J,K,L to move box around
+	if (Input::KeyPress(75))
+		entities[2]->GetTransform()->MoveRelative(0.0f,-0.1f,0.0f);
+	if (Input::KeyPress(73))
+		entities[2]->GetTransform()->MoveRelative(0.0f, 0.1f, 0.0f);
+	if (Input::KeyPress(74))
+		entities[2]->GetTransform()->MoveRelative(-0.1f, 0.0f, 0.0f);
+	if (Input::KeyPress(76))
+		entities[2]->GetTransform()->MoveRelative(0.1f, 0.0f, 0.0f);
+
+	float scale = (float)sin(totalTime * 5) * 0.5f + 1.0f;
+	entities[0]->GetTransform()->SetScale(scale, scale, scale);
+	entities[0]->GetTransform()->Rotate(0, 0, deltaTime * 1.0f);
+	entities[1]->GetTransform()->SetPosition((float)sin(totalTime), 0, 0);
+
+	// Right click picks whatever entity is under the mouse
+	if (Input::MouseRightPress())
+		PickEntity(Input::GetMouseX(), Input::GetMouseY());
+
+	// F7 starts recording a camera path, and saves it as the
+	// scene's path when pressed again
+	if (Input::KeyPress(VK_F7))
+	{
+		if (!recordingCameraPath)
+		{
+			recordedPath.Clear();
+			recordStartTime = totalTime;
+			recordingCameraPath = true;
+		}
+		else
+		{
+			recordingCameraPath = false;
+			recordedPath.AddKey(totalTime - recordStartTime, camera->GetTransform()->GetPosition(), camera->GetTransform()->GetPitchYawRoll());
+			if (recordedPath.GetKeyCount() > 1 && recordedPath.Save(FixPath(sceneName + ".campath")))
+				cameraPath = recordedPath;
+		}
+	}
+
+	// Update the camera this frame, from its path (looping
+	// past the end) or from input
+	if (followingCameraPath)
+	{
+		float duration = cameraPath.GetDuration();
+		cameraPath.Apply(*camera, duration > 0.0f ? (float)fmod(totalTime, duration) : 0.0f);
+	}
+	else
+		camera->Update(deltaTime);
+
+	if (recordingCameraPath)
+		RecordCameraPath(totalTime);
+
+	if (Input::KeyDown('Q')) {
+		cameraTwo->Update(deltaTime);
+	}
+	
+	if (Input::KeyDown('E')) {
+		camera->Update(deltaTime);
+	}
+
+}
+
+// --------------------------------------------------------
+// Casts a ray from the camera through the mouse position and
+// finds the closest entity it hits, down to the exact triangle
+//  - Bounding spheres reject most entities cheaply
+//  - The ray is moved into each entity's local space so the
+//    mesh's BVH never needs rebuilding when things move
+// --------------------------------------------------------
+void Game::PickEntity(int mouseX, int mouseY)
+{
+	pickedEntity = -1;
+
+	// Mouse position to normalized device coordinates
+	float x = 2.0f * mouseX / Window::Width() - 1.0f;
+	float y = 1.0f - 2.0f * mouseY / Window::Height();
+
+	XMFLOAT4X4 view = camera->GetView();
+	XMFLOAT4X4 proj = camera->GetProjection();
+	XMMATRIX invViewProj = XMMatrixInverse(0, XMLoadFloat4x4(&view) * XMLoadFloat4x4(&proj));
+	XMVECTOR rayStart = XMVector3TransformCoord(XMVectorSet(x, y, 0.0f, 1.0f), invViewProj);
+	XMVECTOR rayEnd = XMVector3TransformCoord(XMVectorSet(x, y, 1.0f, 1.0f), invViewProj);
+	XMVECTOR rayDir = XMVector3Normalize(rayEnd - rayStart);
+
+	float closest = FLT_MAX;
+	for (int i = 0; i < (int)entities.size(); i++)
+	{
+		// Skip anything whose bounding sphere the ray misses
+		BoundingSphere bounds = entities[i]->GetWorldBounds();
+		XMVECTOR toCenter = XMLoadFloat3(&bounds.center) - rayStart;
+		float along = XMVectorGetX(XMVector3Dot(toCenter, rayDir));
+		float distSq = XMVectorGetX(XMVector3LengthSq(toCenter)) - along * along;
+		if (distSq > bounds.radius * bounds.radius || along + bounds.radius < 0.0f || along - bounds.radius > closest)
+			continue;
+
+		// The local direction isn't renormalized, so hit
+		// distances stay in world units
+		XMFLOAT4X4 world = entities[i]->GetTransform()->GetWorldMatrix();
+		XMMATRIX invWorld = XMMatrixInverse(0, XMLoadFloat4x4(&world));
+		XMFLOAT3 localStart;
+		XMFLOAT3 localDir;
+		XMStoreFloat3(&localStart, XMVector3TransformCoord(rayStart, invWorld));
+		XMStoreFloat3(&localDir, XMVector3TransformNormal(rayDir, invWorld));
+
+		RayHit hit;
+		if (entities[i]->GetMesh()->Raycast(localStart, localDir, hit, closest))
+		{
+			closest = hit.distance;
+			pickedEntity = i;
+			pickedHit = hit;
+		}
+	}
+}
+
+float color[4] = { 0.4f, 0.6f, 0.75f, 1.0f };
+int number = 0;
+float colorTint[4] = { 1.0f, 0.5f, 0.5f, 1.0f };
+float offSet[3] = { 0.25f, 0.0f, 0.0f };
+
+void Game::BuildUI() {
+	PROFILE_SCOPE("Game::BuildUI");
+
+	if (windowOpen)
+	{
+		ImGui::ShowDemoWindow();
+	}
+
+	ImGui::Begin("My First Window"); {
+
+		//ImGui::Text("test");
+		// io.Framerate counts UI builds, which slow down while the
+		// UI is idle, so this comes from the real frame times
+		const FrameTimeStats& recentFrames = FrameTimes::GetStats();
+		ImGui::Text("Framerate: %f fps", recentFrames.mean > 0.0 ? 1000.0 / recentFrames.mean : ImGui::GetIO().Framerate);
+		ImGui::Text("Window Resolution: %dx%d", Window::Width(), Window::Height());
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Render Stats"))
+		{
+			BuildRenderStatsTable();
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Frame Times"))
+		{
+			const FrameTimeStats& stats = FrameTimes::GetStats();
+			ImGui::Text("Last %u frames (ms)", stats.count);
+			ImGui::Text("p50 %.3f  p90 %.3f  p99 %.3f", stats.p50, stats.p90, stats.p99);
+			ImGui::Text("p99.9 %.3f  Max %.3f", stats.p999, stats.max);
+			ImGui::Text("Stutters (over %.3f ms): %u", stats.p50 * 2.0, stats.stutters);
+
+			// Recent frames in order, then the whole window bucketed
+			// by time up to the slowest frame
+			frameTimePlot.resize(FrameTimes::WindowSize);
+			unsigned int count = FrameTimes::CopyRecent(frameTimePlot.data(), FrameTimes::WindowSize);
+			unsigned int recent = count < 240 ? count : 240;
+			ImGui::PlotLines("Recent", frameTimePlot.data() + count - recent, (int)recent, 0, 0, 0.0f, (float)stats.p999 * 1.25f, ImVec2(0, 60));
+
+			const int bucketCount = 48;
+			float buckets[bucketCount] = {};
+			float bucketWidth = (float)stats.max / bucketCount;
+			for (unsigned int i = 0; i < count && bucketWidth > 0.0f; i++)
+			{
+				float bucket = frameTimePlot[i] / bucketWidth;
+				buckets[bucket < bucketCount ? (int)bucket : bucketCount - 1]++;
+			}
+			ImGui::PlotHistogram("Distribution", buckets, bucketCount, 0, 0, 0.0f, FLT_MAX, ImVec2(0, 60));
+			ImGui::TextDisabled("0 to %.3f ms, %.3f ms per bar", stats.max, bucketWidth);
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::Button(windowOpen ? "Hide ImGui Demo Window" : "Show ImGui Demo Window"))
+			windowOpen = !windowOpen;
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Expand Background Color Picker")) {
+			float red = color[0];
+			float blue = color[1];
+			float green = color[2];
+			float alpha = color[3];
+
+			ImGui::SliderFloat("Red", &red, 0, 1);
+			ImGui::SliderFloat("Blue", &blue, 0, 1);
+			ImGui::SliderFloat("Green", &green, 0, 1);
+			ImGui::SliderFloat("Alpha", &alpha, 0, 1);
+
+			XMFLOAT4 newColor(red, blue, green, alpha);
+			ImGui::ColorEdit4("RGBA color editor", &newColor.x);
+
+			color[0] = newColor.x;
+			color[1] = newColor.y;
+			color[2] = newColor.z;
+			color[3] = newColor.w;
+
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Number Counter")) {
+			// Create a button and test for a click
+			if (ImGui::Button("Press to increment"))
+			{
+				if (number >= 0 && number < 10) {
+					number++; // Adds to number when clicked
+				}
+			}
+			if (ImGui::Button("Press to decrement"))
+			{
+				if (number > 0) {
+					number--; // Subtracts to number when clicked
+				}
+			}
+			if (ImGui::TreeNode("Table")) {
+				if (ImGui::BeginTable("test", 4))
+				{
+					for (int row = 0; row < 4; row++)
+					{
+						ImGui::TableNextRow();
+						for (int column = 0; column < 4; column++)
+						{
+							ImGui::TableSetColumnIndex(column);
+							ImGui::Text("Row %d Column %d", row, column);
+							ImGui::Text("Counter Number: %d", number);
+						}
+					}
+					ImGui::EndTable();
+				}
+				ImGui::Spacing();
+				ImGui::TreePop();
+			}
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Meshes"))
+		{
+			BuildMeshInspector();
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("VertexShaderExternal")) 
+		{
+
+			XMFLOAT4 newColor(colorTint);
+			ImGui::ColorEdit4("RGBA color editor", &newColor.x);
+			colorTint[0] = newColor.x;
+			colorTint[1] = newColor.y;
+			colorTint[2] = newColor.z;
+			colorTint[3] = newColor.w;
+
+			ImGui::TreePop();
+		}
+
+		if (ImGui::TreeNode("Picking"))
+		{
+			ImGui::Text("Right click an entity to pick it");
+			if (pickedEntity >= 0)
+			{
+				ImGui::Text("Entity: %d", pickedEntity);
+				ImGui::Text("Triangle: %u", pickedHit.triangle);
+				ImGui::Text("Distance: %.3f", pickedHit.distance);
+				ImGui::Text("Barycentrics: %.3f, %.3f", pickedHit.u, pickedHit.v);
+			}
+			else
+			{
+				ImGui::Text("Nothing picked");
+			}
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Transform"))
+		{
+			BuildEntityInspector();
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+
+		if (ImGui::TreeNode("Culling"))
+		{
+			bool cacheEnabled = visibilityCache.IsEnabled();
+			if (ImGui::Checkbox("Reuse Last Frame's Visibility", &cacheEnabled))
+				visibilityCache.SetEnabled(cacheEnabled);
+
+			ImGui::SliderFloat("Min Screen Size (px)", &minScreenSize, 0.0f, 32.0f);
+
+			const VisibilityStats& stats = visibilityCache.GetStats();
+			ImGui::Text("Visible: %u / %d", stats.visible, (int)entities.size());
+			ImGui::Text("Too Small To Draw: %u", smallObjectsCulled);
+			ImGui::Text("Tested: %u  Reused: %u  Re-verified: %u  Near Edge: %u", stats.tested, stats.reused, stats.reverified, stats.nearEdge);
+			ImGui::Text("Cache Hit Rate: %.1f%%", stats.HitRate() * 100.0f);
+			ImGui::Text("Test Time: %.3f us  Net Saved: %.3f us", stats.testSeconds * 1000000.0, stats.savedSeconds * 1000000.0);
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Constant Buffers"))
+		{
+			ImGui::Text("Per-Frame Bytes: %u", perFrameBytesUploaded);
+			ImGui::Text("Per-Object Bytes: %u (%u each)", perObjectBytesUploaded, (unsigned int)sizeof(VertexShaderData));
+			ImGui::Text("Total Uploaded / Frame: %u", perFrameBytesUploaded + perObjectBytesUploaded);
+			ConstantBufferRing& cbRing = renderBackend.GetConstantRing();
+			ImGui::Text("Ring: %u bytes, %s", cbRing.GetCapacity(), cbRing.UsingOffsets() ? "D3D11.1 offsets" : "per-draw map fallback");
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Command Stream"))
+		{
+			ImGui::Text("Commands: %u (%u bytes)", frameCommands.GetCommandCount(), (unsigned int)frameCommands.GetSize());
+
+			if (captureFramesLeft > 0)
+				ImGui::Text("Capturing... %u frames left", captureFramesLeft);
+			else if (ImGui::Button("Capture 120 Frames (F9)"))
+			{
+				capture.Clear();
+				captureFramesLeft = 120;
+			}
+
+			if (captureFramesLeft == 0 && capture.GetFrameCount() > 0)
+				ImGui::Text(lastCaptureSaved ? "Saved %u frames to FrameCapture.rcap" : "Could not save %u frames", capture.GetFrameCount());
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Instancing"))
+		{
+			ImGui::Checkbox("Instance Entities Sharing A Mesh", &instancingEnabled);
+			unsigned int drawn = (unsigned int)renderQueue.GetCount();
+			ImGui::Text("Draw Calls: %u for %u entities", drawCallsLastFrame, drawn);
+			ImGui::Text("Draws Saved: %u", drawn - drawCallsLastFrame);
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Deferred Recording"))
+		{
+			ImGui::Checkbox("Record On Worker Threads", &deferredRecordingEnabled);
+			if (deferredRecorder.IsSupported())
+				ImGui::Text("Workers: %u", deferredRecorder.GetWorkerCount());
+			else
+				ImGui::Text("Single-threaded: %s", deferredRecorder.GetFallbackReason());
+
+			int minDraws = (int)deferredRecorder.GetMinDrawsPerChunk();
+			if (ImGui::SliderInt("Min Draws Per Chunk", &minDraws, 1, 1024))
+				deferredRecorder.SetMinDrawsPerChunk((unsigned int)minDraws);
+
+			ImGui::Text("Chunks Last Frame: %u", recordedChunksLastFrame);
+			ImGui::TextDisabled("Only used when instancing is off");
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Frame Arena"))
+		{
+			const FrameArenaStats& stats = frameArena.GetLastFrameStats();
+			ImGui::Text("Used: %.1f / %.1f KB", stats.used / 1024.0, frameArena.GetFrameCapacity() / 1024.0);
+			ImGui::Text("Peak: %.1f KB", frameArena.GetPeakUsed() / 1024.0);
+			ImGui::Text("Allocations: %u", stats.allocations);
+			ImGui::Text("Overflow: %u (%.1f KB)", stats.overflowAllocations, stats.overflowBytes / 1024.0);
+			ImGui::Text("Frames: %u, Workers: %u", frameArena.GetBufferedFrames(), frameArena.GetWorkerCount());
+
+			bool poison = frameArena.GetPoisonFreedFrames();
+			if (ImGui::Checkbox("Poison Freed Frames", &poison))
+				frameArena.SetPoisonFreedFrames(poison);
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Idle UI"))
+		{
+			bool reuse = retainedUI.IsEnabled();
+			if (ImGui::Checkbox("Reuse UI When Idle", &reuse))
+				retainedUI.SetEnabled(reuse);
+			float refresh = retainedUI.GetRefreshInterval();
+			if (ImGui::SliderFloat("Refresh Interval (s)", &refresh, 0.05f, 5.0f))
+				retainedUI.SetRefreshInterval(refresh);
+
+			const RetainedUIStats& stats = retainedUI.GetStats();
+			ImGui::Text("Rebuilt For: %s", stats.reason);
+			ImGui::Text("Reused: %llu of %llu frames (%.1f%%)", stats.framesReused, stats.framesReused + stats.framesBuilt, stats.ReuseRate() * 100.0f);
+			ImGui::Text("Build Time: %.3f ms", stats.averageBuildSeconds * 1000.0);
+			ImGui::Text("Saved: %.1f ms total, %.2f ms per second", stats.savedSeconds * 1000.0,
+				stats.elapsedSeconds > 0.0 ? stats.savedSeconds * 1000.0 / stats.elapsedSeconds : 0.0);
+			ImGui::TextDisabled("Numbers here only update when the UI is rebuilt");
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("UI Draw Merging"))
+		{
+			if (ImGui::Checkbox("Merge UI Draw Commands", &mergeUIDraws))
+				mergedUIDrawData = nullptr;
+
+			const DrawDataMergeStats& stats = uiDrawMerger.GetStats();
+			if (!mergeUIDraws)
+				ImGui::TextDisabled("Off, each list's commands are drawn as is");
+			else if (!stats.merged)
+				ImGui::TextDisabled("Passed through (the UI has user callbacks)");
+			ImGui::Text("Commands: %u lists, %u -> %u", stats.lists, stats.commandsIn, stats.commandsOut);
+			ImGui::Text("Joined: %u same scissor, %u grown scissor", stats.joinedSameScissor, stats.joinedUnion);
+			ImGui::Text("Shared Scissors: %u, Dropped: %u", stats.scissorsShared, stats.dropped);
+			ImGui::Text("Vertex Windows: %u", stats.vertexWindows);
+			ImGui::Text("Merge Time: %.3f ms", stats.milliseconds);
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Font Atlas"))
+		{
+			ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+			ImGui::Text("%s in %.2f ms", fontAtlasCache.loaded ? "Loaded from cache" : "Built", fontAtlasCache.milliseconds);
+			ImGui::Text("Cache File: %.1f KB%s", fontAtlasCache.fileBytes / 1024.0,
+				!fontAtlasCache.loaded && !fontAtlasCache.saved ? " (could not save)" : "");
+			ImGui::Text("Key: %016llx", fontAtlasCache.key);
+			ImGui::Text("Fonts: %d, Texture: %d x %d", fonts->Fonts.Size, fonts->TexWidth, fonts->TexHeight);
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("State Changes"))
+		{
+			StateCacheStats stateStats = StateCache::GetLastFrameStats();
+			unsigned int total = stateStats.issued + stateStats.skipped;
+			ImGui::Text("Issued: %u", stateStats.issued);
+			ImGui::Text("Skipped: %u (%.1f%%)", stateStats.skipped, total > 0 ? 100.0f * stateStats.skipped / total : 0.0f);
+			ImGui::TreePop();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::TreeNode("Camera"))
+		{
+			XMFLOAT3 pos = camera->GetTransform()->GetPosition();
+			XMFLOAT3 rot = camera->GetTransform()->GetPitchYawRoll();
+
+			if (ImGui::DragFloat3("Position", &pos.x, 0.01f))
+				camera->GetTransform()->SetPosition(pos);
+			if (ImGui::DragFloat3("Rotation (Radians)", &rot.x, 0.01f))
+				camera->GetTransform()->SetRotation(rot);
+			ImGui::Spacing();
+
+			float nearClip = camera->GetNearClip();	
+			float farClip = camera->GetFarClip();
+			if (ImGui::DragFloat("Near Clip Distance", &nearClip, 0.01f, 0.001f, 1.0f))
+				camera->SetNearClip(nearClip);
+			if (ImGui::DragFloat("Far Clip Distance", &farClip, 1.0f, 10.0f, 1000.0f))
+				camera->SetFarClip(farClip);
+
+			CameraProjectionType projType = camera->GetProjectionType();
+			int typeIndex = (int)projType;
+			if (ImGui::Combo("Projection Type", &typeIndex, "Perspective\0Orthographic\0Third"))
+			{
+				projType = (CameraProjectionType)typeIndex;
+				camera = std::make_shared<Camera>(
+					XMFLOAT3(0.0f, 0.0f, -5.0f),
+					5.0f,					
+					0.002f,					
+					XM_PIDIV4,				
+					Window::AspectRatio(),  
+					0.01f,					
+					100.0f,					
+					CameraProjectionType::Perspective);
+				camera->SetProjectionType(projType);
+
+				//it's a bit wonky when switching in between the Third Camera View and back to Perspective
+				if (typeIndex == 2) {
+					camera = std::make_shared<Camera>(
+						XMFLOAT3(2.0f, -2.0f, -5.0f),	
+						5.0f,					
+						0.002f,					
+						XM_PIDIV2,				
+						Window::AspectRatio(),  
+						0.01f,					
+						100.0f,					
+						CameraProjectionType::Perspective
+					);
+				}
+			}
+
+
+			if (projType == CameraProjectionType::Perspective)
+			{
+				float fov = camera->GetFieldOfView() * 180.0f / XM_PI;
+				if (ImGui::SliderFloat("Field of View (Degrees)", &fov, 0.01f, 180.0f))
+					camera->SetFieldOfView(fov * XM_PI / 180.0f);
+			}
+			else if (projType == CameraProjectionType::Orthographic)
+			{
+				float wid = camera->GetOrthographicWidth();
+				if (ImGui::SliderFloat("Orthographic Width", &wid, 1.0f, 10.0f))
+					camera->SetOrthographicWidth(wid);
+			}
+		/*	else if (projType == CameraProjectionType::Third) 
+			{
+				float fov = camera->GetFieldOfView() * 180.0f / XM_PI;
+				if (ImGui::SliderFloat("Field of View (Degrees)", &fov, 0.01f, 180.0f))
+					camera->SetFieldOfView(fov * XM_PI / 180.0f);
+			}*/
+
+			ImGui::Spacing();
+			ImGui::Text("Scene \"%s\" path: %zu keys, %.1f s", sceneName.c_str(), cameraPath.GetKeyCount(), cameraPath.GetDuration());
+			ImGui::Checkbox("Follow Path", &followingCameraPath);
+			if (recordingCameraPath)
+				ImGui::Text("Recording: %zu keys (F7 to stop and save)", recordedPath.GetKeyCount());
+			else
+				ImGui::Text("F7 records a new path");
+
+			ImGui::TreePop();
+		}
+		ImGui::Spacing();
+	}
+	ImGui::End();
+
+	BuildProfilerUI();
+}
+
+// --------------------------------------------------------
+// Shows the profiler's markers for one frame as a flame
+// graph (one lane per thread, one row per nesting level),
+// followed by per-scope timings across frames
+// --------------------------------------------------------
+void Game::BuildProfilerUI()
+{
+	ImGui::Begin("Profiler");
+
+	bool profilerEnabled = Profiler::IsEnabled();
+	if (ImGui::Checkbox("Enabled", &profilerEnabled))
+		Profiler::SetEnabled(profilerEnabled);
+
+	bool spikeCapture = Profiler::IsSpikeCaptureEnabled();
+	float spikeThreshold = Profiler::GetSpikeThreshold();
+	ImGui::SameLine();
+	bool spikeChanged = ImGui::Checkbox("Pause On Spike", &spikeCapture);
+	spikeChanged |= ImGui::SliderFloat("Spike Threshold (ms)", &spikeThreshold, 1.0f, 100.0f);
+	if (spikeChanged)
+		Profiler::SetSpikeCapture(spikeCapture, spikeThreshold);
+
+	// Traces open in chrome://tracing or ui.perfetto.dev
+	if (TraceWriter::IsRecording())
+	{
+		if (ImGui::Button("Stop Trace (F8)"))
+			TraceWriter::Stop();
+		ImGui::SameLine();
+		ImGui::Text("Writing %s, %.1f MB", TraceWriter::GetCurrentPath().c_str(), TraceWriter::GetBytesWritten() / (1024.0 * 1024.0));
+	}
+	else if (ImGui::Button("Start Trace (F8)"))
+	{
+		TraceWriter::Start(FixPath("Trace"));
+	}
+
+	const ProfileFrame& frame = Profiler::GetDisplayedFrame();
+	if (Profiler::IsPaused())
+	{
+		ImGui::Text("Paused on frame %llu: %.3f ms", frame.index, frame.durationMs);
+		ImGui::SameLine();
+		if (ImGui::Button("Resume"))
+			Profiler::Resume();
+	}
+	else
+	{
+		ImGui::Text("Frame %llu: %.3f ms, %u markers", frame.index, frame.durationMs, (unsigned int)frame.samples.size());
+	}
+
+	// Each thread's lane is one row for its name plus one
+	// row per nesting level it reached
+	unsigned int threadCount = Profiler::GetThreadCount();
+	std::vector<unsigned int> laneRows(threadCount, 0);
+	for (const ProfileSample& sample : frame.samples)
+	{
+		if (sample.thread < threadCount && sample.depth + 1 > laneRows[sample.thread])
+			laneRows[sample.thread] = sample.depth + 1;
+	}
+
+	std::vector<unsigned int> laneFirstRow(threadCount, 0);
+	unsigned int totalRows = 0;
+	for (unsigned int t = 0; t < threadCount; t++)
+	{
+		laneFirstRow[t] = totalRows;
+		if (laneRows[t] > 0)
+			totalRows += laneRows[t] + 1;
+	}
+
+	float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+	ImVec2 graphSize(ImGui::GetContentRegionAvail().x, rowHeight * (totalRows > 0 ? totalRows : 1));
+	if (graphSize.x < 1.0f)
+		graphSize.x = 1.0f;
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	ImGui::InvisibleButton("Flame Graph", graphSize);
+	bool graphHovered = ImGui::IsItemHovered();
+	ImVec2 mouse = ImGui::GetIO().MousePos;
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	drawList->PushClipRect(origin, ImVec2(origin.x + graphSize.x, origin.y + graphSize.y), true);
+
+	for (unsigned int t = 0; t < threadCount; t++)
+	{
+		if (laneRows[t] > 0)
+			drawList->AddText(ImVec2(origin.x + 2.0f, origin.y + laneFirstRow[t] * rowHeight + 2.0f), IM_COL32(200, 200, 200, 255), Profiler::GetThreadName(t));
+	}
+
+	float msToPixels = frame.durationMs > 0.0 ? graphSize.x / (float)frame.durationMs : 0.0f;
+	const ProfileSample* hovered = 0;
+	for (const ProfileSample& sample : frame.samples)
+	{
+		if (sample.thread >= threadCount)
+			continue;
+
+		float x0 = origin.x + (float)(sample.startMs > 0.0 ? sample.startMs : 0.0) * msToPixels;
+		float x1 = origin.x + (float)(sample.startMs + sample.durationMs) * msToPixels;
+		if (x1 - x0 < 1.0f)
+			continue; // Too small to see
+
+		float y0 = origin.y + (laneFirstRow[sample.thread] + 1 + sample.depth) * rowHeight;
+		float y1 = y0 + rowHeight - 1.0f;
+
+		// Color by name, so a scope looks the same every frame
+		float hue = (float)(((size_t)sample.name >> 4) % 97) / 97.0f;
+		drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), ImColor::HSV(hue, 0.45f, 0.75f));
+		if (x1 - x0 > ImGui::CalcTextSize(sample.name).x + 4.0f)
+			drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), sample.name);
+
+		if (graphHovered && mouse.x >= x0 && mouse.x < x1 && mouse.y >= y0 && mouse.y < y1)
+			hovered = &sample;
+	}
+	drawList->PopClipRect();
+
+	if (hovered)
+		ImGui::SetTooltip("%s\n%.4f ms (starts at %.4f ms)\nThread: %s", hovered->name, hovered->durationMs, hovered->startMs, Profiler::GetThreadName(hovered->thread));
+
+	ImGui::Spacing();
+	if (ImGui::Button("Reset Scope Stats"))
+		Profiler::ResetStats();
+
+	if (ImGui::BeginTable("Scope Stats", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Scope");
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Last (ms)");
+		ImGui::TableSetupColumn("Min (ms)");
+		ImGui::TableSetupColumn("Avg (ms)");
+		ImGui::TableSetupColumn("Max (ms)");
+		ImGui::TableHeadersRow();
+
+		for (const ProfileScopeStats& stats : Profiler::GetScopeStats())
+		{
+			if (stats.frames == 0)
+				continue;
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(stats.name);
+			ImGui::TableNextColumn(); ImGui::Text("%u", stats.calls);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.lastMs);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.minMs);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.totalMs / stats.frames);
+			ImGui::TableNextColumn(); ImGui::Text("%.3f", stats.maxMs);
+		}
+		ImGui::EndTable();
+	}
+
+	ImGui::Spacing();
+	BuildAllocationUI();
+
+	ImGui::Spacing();
+	BuildPoolAllocatorUI();
+
+	ImGui::End();
+}
+
+// --------------------------------------------------------
+// What the last frame sent to the driver, one column per
+// pass plus the total
+// --------------------------------------------------------
+void Game::BuildRenderStatsTable()
+{
+	const int passCount = (int)StatsPass::Count;
+	if (!ImGui::BeginTable("Render Stats", passCount + 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		return;
+
+	RenderPassStats passes[passCount + 1];
+	ImGui::TableSetupColumn("Last Frame");
+	for (int i = 0; i < passCount; i++)
+	{
+		passes[i] = RenderStats::GetLastFrame((StatsPass)i);
+		ImGui::TableSetupColumn(RenderStats::GetPassName((StatsPass)i));
+	}
+	passes[passCount] = RenderStats::GetLastFrameTotal();
+	ImGui::TableSetupColumn("Total");
+	ImGui::TableHeadersRow();
+
+	struct Row
+	{
+		const char* name;
+		unsigned long long (*value)(const RenderPassStats&);
+	};
+	const Row rows[] =
+	{
+		{ "Draw Calls", [](const RenderPassStats& s) { return (unsigned long long)s.draws; } },
+		{ "Instances", [](const RenderPassStats& s) { return (unsigned long long)s.instances; } },
+		{ "Triangles", [](const RenderPassStats& s) { return s.triangles; } },
+		{ "State Binds", [](const RenderPassStats& s) { return (unsigned long long)s.binds; } },
+		{ "Constant Bytes", [](const RenderPassStats& s) { return s.constantBytes; } },
+		{ "Other Buffer Bytes", [](const RenderPassStats& s) { return s.bufferBytes; } },
+		{ "Buffers Created", [](const RenderPassStats& s) { return (unsigned long long)s.buffersCreated; } },
+		{ "Maps", [](const RenderPassStats& s) { return (unsigned long long)s.maps; } },
+	};
+
+	for (const Row& row : rows)
+	{
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn(); ImGui::TextUnformatted(row.name);
+		for (int i = 0; i <= passCount; i++)
+		{
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", row.value(passes[i]));
+		}
+	}
+	ImGui::EndTable();
+}
+
+// --------------------------------------------------------
+// Every entity in a scrolling table that only builds the
+// rows on screen, so its cost doesn't grow with the scene
+//  - Filtering and sorting run a slice of the entities per
+//    frame (see FilteredList), and only when the filter,
+//    sort or entity count changes
+//  - The selected entity's transform is edited below it
+// --------------------------------------------------------
+void Game::BuildEntityInspector()
+{
+	// Typing more of the same filter can only drop rows, so
+	// just the current matches are tested again.  Commas (or)
+	// and a leading '-' (not) can bring rows back
+	char previousFilter[sizeof(entityFilterText)];
+	memcpy(previousFilter, entityFilterText, sizeof(previousFilter));
+	if (ImGui::InputTextWithHint("Filter", "Index or mesh name, e.g. Quad,-Shape", entityFilterText, sizeof(entityFilterText)))
+	{
+		size_t length = strlen(previousFilter);
+		bool stricter = length > 0 &&
+			strncmp(entityFilterText, previousFilter, length) == 0 &&
+			!strpbrk(entityFilterText, ",-");
+		if (stricter)
+			entityRows.Refine();
+		else
+			entityRows.Restart();
+	}
+
+	const std::vector<unsigned int>& rows = entityRows.GetRows();
+	ImGui::Text("Showing %d of %d entities", (int)rows.size(), (int)entities.size());
+	if (!entityRows.IsComplete())
+	{
+		ImGui::SameLine();
+		ImGui::TextDisabled("(filtering %.0f%%)", entityRows.GetProgress() * 100.0f);
+	}
+	else if (entitySortColumn == EntityColumn_Distance)
+	{
+		// Distances are taken when sorting, so moving things
+		// (or the camera) needs a fresh sort
+		ImGui::SameLine();
+		if (ImGui::SmallButton("Sort Again"))
+			entityRows.Restart();
+	}
+
+	ImGuiTableFlags flags =
+		ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg |
+		ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable;
+	float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+	if (ImGui::BeginTable("Entities", 4, flags, ImVec2(0.0f, rowHeight * 12.0f)))
+	{
+		ImGui::TableSetupScrollFreeze(0, 1);
+		ImGui::TableSetupColumn("#", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthFixed, 0.0f, EntityColumn_Index);
+		ImGui::TableSetupColumn("Mesh", ImGuiTableColumnFlags_WidthFixed, 0.0f, EntityColumn_Mesh);
+		ImGui::TableSetupColumn("Distance", ImGuiTableColumnFlags_WidthFixed, 0.0f, EntityColumn_Distance);
+		ImGui::TableSetupColumn("Position", ImGuiTableColumnFlags_NoSort | ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableHeadersRow();
+
+		ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+		if (sortSpecs && sortSpecs->SpecsDirty)
+		{
+			if (sortSpecs->SpecsCount > 0)
+			{
+				entitySortColumn = (int)sortSpecs->Specs[0].ColumnUserID;
+				entityRows.SetDescending(sortSpecs->Specs[0].SortDirection == ImGuiSortDirection_Descending);
+			}
+			entityRows.Restart();
+			sortSpecs->SpecsDirty = false;
+		}
+
+		XMFLOAT3 cameraPosition = camera->GetTransform()->GetPosition();
+		XMVECTOR cameraPos = XMLoadFloat3(&cameraPosition);
+
+		// The next slice of the filter and sort, if one's running.
+		// Meshes sort by name, through each one's rank
+		std::vector<std::pair<const Mesh*, double>> meshRanks;
+		ImGuiTextFilter filter(entityFilterText);
+		char text[128];
+		entityRows.Update(entities.size(), EntityFilterBudget,
+			[&](unsigned int i)
+			{
+				if (!filter.IsActive())
+					return true;
+				snprintf(text, sizeof(text), "%u %s", i, entities[i]->GetMesh()->GetName());
+				return filter.PassFilter(text);
+			},
+			[&](unsigned int i)
+			{
+				if (entitySortColumn == EntityColumn_Mesh)
+				{
+					if (meshRanks.empty())
+					{
+						for (const std::shared_ptr<Mesh>& mesh : meshes)
+						{
+							double rank = 0.0;
+							for (const std::shared_ptr<Mesh>& other : meshes)
+								rank += strcmp(other->GetName(), mesh->GetName()) < 0 ? 1.0 : 0.0;
+							meshRanks.push_back({ mesh.get(), rank });
+						}
+					}
+
+					const Mesh* mesh = entities[i]->GetMesh().get();
+					for (const std::pair<const Mesh*, double>& rank : meshRanks)
+					{
+						if (rank.first == mesh)
+							return rank.second;
+					}
+					return (double)meshes.size();
+				}
+				if (entitySortColumn == EntityColumn_Distance)
+				{
+					XMFLOAT3 position = entities[i]->GetTransform()->GetPosition();
+					return (double)XMVectorGetX(XMVector3Length(XMLoadFloat3(&position) - cameraPos));
+				}
+				return (double)i;
+			});
+
+		// Only the rows in view touch their entities
+		ImGuiListClipper clipper;
+		clipper.Begin((int)rows.size(), rowHeight);
+		while (clipper.Step())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+			{
+				unsigned int i = rows[row];
+				ImGui::TableNextRow();
+				if (i >= entities.size())
+					continue;
+
+				GameEntity* entity = entities[i].get();
+				XMFLOAT3 position = entity->GetTransform()->GetPosition();
+				float distance = XMVectorGetX(XMVector3Length(XMLoadFloat3(&position) - cameraPos));
+
+				char index[16];
+				snprintf(index, sizeof(index), "%u", i);
+				ImGui::TableNextColumn();
+				if (ImGui::Selectable(index, inspectedEntity == (int)i, ImGuiSelectableFlags_SpanAllColumns))
+					inspectedEntity = (int)i;
+				ImGui::TableNextColumn(); ImGui::TextUnformatted(entity->GetMesh()->GetName());
+				ImGui::TableNextColumn(); ImGui::Text("%.2f", distance);
+				ImGui::TableNextColumn(); ImGui::Text("%.2f, %.2f, %.2f", position.x, position.y, position.z);
+			}
+		}
+		ImGui::EndTable();
+	}
+
+	if (inspectedEntity < 0 || inspectedEntity >= (int)entities.size())
+	{
+		ImGui::TextDisabled("Select an entity to edit its transform");
+		return;
+	}
+
+	std::shared_ptr<Transform> transform = entities[inspectedEntity]->GetTransform();
+	XMFLOAT3 position = transform->GetPosition();
+	XMFLOAT3 rotation = transform->GetPitchYawRoll();
+	XMFLOAT3 scale = transform->GetScale();
+
+	ImGui::PushID(entities[inspectedEntity].get());
+	ImGui::Text("Entity %d", inspectedEntity);
+	if (ImGui::DragFloat3("Position", &position.x, 0.01f))
+		transform->SetPosition(position);
+	if (ImGui::DragFloat3("Rotation", &rotation.x, 0.01f))
+		transform->SetRotation(rotation);
+	if (ImGui::DragFloat3("Scale", &scale.x, 0.01f))
+		transform->SetScale(scale);
+	ImGui::PopID();
+}
+
+// --------------------------------------------------------
+// One row per mesh, built only while in view
+// --------------------------------------------------------
+void Game::BuildMeshInspector()
+{
+	ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV;
+	float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+	int visibleRows = meshes.size() < 8 ? (int)meshes.size() : 8;
+	if (!ImGui::BeginTable("Meshes", 5, flags, ImVec2(0.0f, rowHeight * (visibleRows + 1) + 4.0f)))
+		return;
+
+	ImGui::TableSetupScrollFreeze(0, 1);
+	ImGui::TableSetupColumn("Mesh");
+	ImGui::TableSetupColumn("Vertices");
+	ImGui::TableSetupColumn("Indices");
+	ImGui::TableSetupColumn("Triangles");
+	ImGui::TableSetupColumn("BVH Build (ms)");
+	ImGui::TableHeadersRow();
+
+	ImGuiListClipper clipper;
+	clipper.Begin((int)meshes.size(), rowHeight);
+	while (clipper.Step())
+	{
+		for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+		{
+			Mesh* mesh = meshes[i].get();
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(mesh->GetName());
+			ImGui::TableNextColumn(); ImGui::Text("%d", mesh->GetVertexCount());
+			ImGui::TableNextColumn(); ImGui::Text("%d", mesh->GetIndexCount());
+			ImGui::TableNextColumn(); ImGui::Text("%d", mesh->GetIndexCount() / 3);
+			ImGui::TableNextColumn();
+			if (mesh->IsBVHReady())
+				ImGui::Text("%.3f", mesh->GetBVHBuildTime() * 1000.0);
+			else if (mesh->HasBVH())
+				ImGui::TextDisabled("Building...");
+			else
+				ImGui::TextDisabled("None");
+		}
+	}
+	ImGui::EndTable();
+}
+
+// --------------------------------------------------------
+// Heap allocations per frame, per profiler scope and per
+// call stack, when the build counts them (TRACK_ALLOCATIONS)
+// --------------------------------------------------------
+void Game::BuildAllocationUI()
+{
+	if (!ImGui::CollapsingHeader("Allocations"))
+		return;
+
+	if (!AllocationTracker::IsAvailable())
+	{
+		ImGui::TextDisabled("Define TRACK_ALLOCATIONS to count heap allocations");
+		return;
+	}
+
+	const AllocationFrameStats& frame = AllocationTracker::GetLastFrame();
+	ImGui::Text("Last Frame: %u allocations (%llu bytes), %u frees (%llu bytes)",
+		frame.allocations, frame.bytesAllocated, frame.frees, frame.bytesFreed);
+
+	int allocationBudget = (int)AllocationTracker::GetAllocationBudget();
+	int kilobyteBudget = (int)(AllocationTracker::GetByteBudget() / 1024);
+	bool budgetChanged = ImGui::SliderInt("Allocation Budget", &allocationBudget, 0, 1024);
+	budgetChanged |= ImGui::SliderInt("Byte Budget (KB)", &kilobyteBudget, 0, 4096);
+	if (budgetChanged)
+		AllocationTracker::SetBudget((unsigned int)allocationBudget, (unsigned long long)kilobyteBudget * 1024);
+
+	bool assertOnBudget = AllocationTracker::IsAssertOnBudgetEnabled();
+	if (ImGui::Checkbox("Assert When Over Budget", &assertOnBudget))
+		AllocationTracker::SetAssertOnBudget(assertOnBudget);
+	ImGui::SameLine();
+	ImGui::Text("Frames Over Budget: %u", AllocationTracker::GetFramesOverBudget());
+
+	if (ImGui::Button("Reset Allocation Counts"))
+		AllocationTracker::ResetCounts();
+
+	unsigned long long frames = AllocationTracker::GetFrameCount();
+	if (frames == 0)
+		return;
+
+	if (ImGui::BeginTable("Allocation Scopes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Scope");
+		ImGui::TableSetupColumn("Last Frame");
+		ImGui::TableSetupColumn("Last Bytes");
+		ImGui::TableSetupColumn("Avg / Frame");
+		ImGui::TableHeadersRow();
+
+		for (const AllocationScopeStats& stats : AllocationTracker::GetScopeStats())
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(stats.name ? stats.name : "(No Scope)");
+			ImGui::TableNextColumn(); ImGui::Text("%u", stats.lastAllocations);
+			ImGui::TableNextColumn(); ImGui::Text("%llu", stats.lastBytes);
+			ImGui::TableNextColumn(); ImGui::Text("%.1f", (double)stats.totalAllocations / frames);
+		}
+		ImGui::EndTable();
+	}
+
+	// Top call stacks since the last reset
+	AllocationTracker::GetTopSites(allocationSites, 10);
+	if (ImGui::BeginTable("Allocation Sites", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Call Site");
+		ImGui::TableSetupColumn("Avg / Frame");
+		ImGui::TableSetupColumn("Bytes / Frame");
+		ImGui::TableHeadersRow();
+
+		for (const AllocationSiteStats& site : allocationSites)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::TextUnformatted(AllocationTracker::DescribeSite(site).c_str());
+			ImGui::TableNextColumn(); ImGui::Text("%.1f", (double)site.allocations / frames);
+			ImGui::TableNextColumn(); ImGui::Text("%.0f", (double)site.bytes / frames);
+		}
+		ImGui::EndTable();
+	}
+}
+
+// --------------------------------------------------------
+// ImGui's own allocations, which go through the pool
+// allocator rather than malloc
+// --------------------------------------------------------
+void Game::BuildPoolAllocatorUI()
+{
+	if (!ImGui::CollapsingHeader("ImGui Allocator"))
+		return;
+
+	const PoolFrameStats& frame = PoolAllocator::GetLastFrame();
+	ImGui::Text("Last Frame: %llu allocations (%llu bytes), %llu frees (%llu bytes)",
+		frame.allocations, frame.bytesAllocated, frame.frees, frame.bytesFreed);
+	ImGui::Text("Too Large For A Pool: %llu, Shared Pool Refills: %llu", frame.largeAllocations, frame.refills);
+	ImGui::Text("Live: %.1f KB, Reserved: %.1f KB",
+		PoolAllocator::GetBytesLive() / 1024.0, PoolAllocator::GetBytesReserved() / 1024.0);
+
+	// A few seconds of ImGui's calls, for Tools/ReplayAllocations
+	if (PoolAllocator::IsTracing())
+		ImGui::Text("Recording trace, %u frames left", PoolAllocator::GetTraceFramesLeft());
+	else if (ImGui::Button("Record Allocation Trace"))
+		PoolAllocator::StartTrace(FixPath("ImGuiAllocations.trace"), 300);
+	else if (PoolAllocator::LastTraceSaved())
+	{
+		ImGui::SameLine();
+		ImGui::Text("Saved ImGuiAllocations.trace");
+	}
+
+	if (ImGui::BeginTable("Size Classes", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+	{
+		ImGui::TableSetupColumn("Block Size");
+		ImGui::TableSetupColumn("Blocks Live");
+		ImGui::TableHeadersRow();
+
+		for (unsigned int i = 0; i < PoolAllocator::GetSizeClassCount(); i++)
+		{
+			unsigned long long live = PoolAllocator::GetSizeClassBlocksLive(i);
+			if (live == 0)
+				continue;
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::Text("%u", PoolAllocator::GetSizeClassBlockSize(i));
+			ImGui::TableNextColumn(); ImGui::Text("%llu", live);
+		}
+		ImGui::EndTable();
+	}
+}
+
+// --------------------------------------------------------
+// Fills the render queue with a sort key for each visible entity
+//  - Entities outside the camera's frustum are skipped,
+//    as are ones smaller than minScreenSize pixels
+//  - Opaque entities end up grouped by shader and mesh,
+//    and front-to-back within each group
+//  - Only one shader exists so far, so its ID is always 0
+// --------------------------------------------------------
+void Game::BuildRenderQueue()
+{
+	PROFILE_SCOPE("BuildRenderQueue");
+	renderQueue.Clear();
+
+	XMFLOAT3 camPos = camera->GetTransform()->GetPosition();
+	XMFLOAT3 camForward = camera->GetTransform()->GetForward();
+	XMVECTOR eye = XMLoadFloat3(&camPos);
+	XMVECTOR forward = XMLoadFloat3(&camForward);
+
+	float nearClip = camera->GetNearClip();
+	float farClip = camera->GetFarClip();
+	float viewportHeight = (float)Window::Height();
+	smallObjectsCulled = 0;
+
+	XMFLOAT4X4 view = camera->GetView();
+	XMFLOAT4X4 proj = camera->GetProjection();
+	XMFLOAT4X4 viewProj;
+	XMStoreFloat4x4(&viewProj, XMMatrixMultiply(XMLoadFloat4x4(&view), XMLoadFloat4x4(&proj)));
+
+	// The view's own up (its second column), since that's the
+	// roll the frustum actually has
+	XMFLOAT3 camUp(view._12, view._22, view._32);
+	visibilityCache.BeginFrame(entities.size(), camPos, camForward, camUp, proj, viewProj);
+
+	for (unsigned int i = 0; i < entities.size(); i++)
+	{
+		BoundingSphere bounds = entities[i]->GetWorldBounds();
+		if (!visibilityCache.IsVisible(i, entities[i].get(), bounds))
+			continue;
+
+		float viewDepth = XMVectorGetX(XMVector3Dot(XMLoadFloat3(&bounds.center) - eye, forward));
+
+		// Skip anything too small on screen to be worth a draw call
+		if (camera->GetScreenDiameter(bounds.radius, viewDepth, viewportHeight) < minScreenSize)
+		{
+			smallObjectsCulled++;
+			continue;
+		}
+
+		unsigned int depth = RenderQueue::QuantizeDepth(viewDepth, nearClip, farClip);
+		unsigned int meshID = entities[i]->GetMesh()->GetID();
+		renderQueue.Add(RenderQueue::MakeOpaqueKey(0, meshID, depth), i);
+	}
+
+	renderQueue.Sort(frameArena.AllocateSpan<DrawItem>(renderQueue.GetCount()).data());
+}
+
+// --------------------------------------------------------
+// Uploads the camera matrices once for the whole frame,
+// rather than repeating them in every entity's constants
+// --------------------------------------------------------
+void Game::UpdatePerFrameData(float totalTime)
+{
+	PerFrameData frameData = {};
+	frameData.viewMatrix = camera->GetView();
+	frameData.projectionMatrix = camera->GetProjection();
+	XMStoreFloat4x4(&frameData.viewProjectionMatrix,
+		XMLoadFloat4x4(&frameData.viewMatrix) * XMLoadFloat4x4(&frameData.projectionMatrix));
+	frameData.time = totalTime;
+
+	frameCommands.UploadBuffer(perFrameBufferHandle, &frameData, sizeof(frameData));
+
+	perFrameBytesUploaded = sizeof(PerFrameData);
+}
+
+// --------------------------------------------------------
+// Records each entity as its own draw
+//  - The backend puts every entity's constants into the
+//    ring with a single map, then each draw binds its slice
+// --------------------------------------------------------
+void Game::DrawEntities(const std::vector<DrawItem>& drawItems)
+{
+	PROFILE_SCOPE("DrawEntities");
+	frameCommands.SetInputLayout(inputLayoutHandle);
+	frameCommands.SetVertexShader(vertexShaderHandle);
+
+	for (size_t i = 0; i < drawItems.size(); i++)
+	{
+		entities[drawItems[i].entityIndex]->gDraw(frameCommands);
+	}
+
+	perObjectBytesUploaded = (unsigned int)(drawItems.size() * sizeof(VertexShaderData));
+	drawCallsLastFrame = (unsigned int)drawItems.size();
+}
+
+// --------------------------------------------------------
+// Same draws as DrawEntities(), recorded in chunks on worker
+// threads into deferred contexts
+//  - Each chunk writes its own ring, so workers never share
+//    anything they write
+//  - Deferred contexts start from default state, so every
+//    chunk binds the shared state itself
+// --------------------------------------------------------
+void Game::DrawEntitiesDeferred(const std::vector<DrawItem>& drawItems)
+{
+	PROFILE_SCOPE("DrawEntitiesDeferred");
+	ID3D11InputLayout* layout = inputLayout.Get();
+	ID3D11VertexShader* vs = vertexShader.Get();
+	ID3D11PixelShader* ps = pixelShader.Get();
+	ID3D11Buffer* perFrame = perFrameConstantBuffer.Get();
+
+	recordedChunksLastFrame = deferredRecorder.Record(
+		(unsigned int)drawItems.size(),
+		sizeof(VertexShaderData),
+		[&](ID3D11DeviceContext1* context, ConstantBufferRing& ring, DrawChunk chunk)
+		{
+			PROFILE_SCOPE("Record Chunk");
+			context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+			context->IASetInputLayout(layout);
+			context->VSSetShader(vs, 0, 0);
+			context->PSSetShader(ps, 0, 0);
+			context->VSSetConstantBuffers(1, 1, &perFrame);
+			RenderStats::CountBinds(5);
+
+			// Work out the whole chunk's constants first, into this
+			// worker's own arena, then stream them out draw by draw
+			std::span<VertexShaderData> constants =
+				frameArena.GetWorkerArena(chunk.index).AllocateSpan<VertexShaderData>(chunk.count);
+			for (unsigned int i = 0; i < chunk.count; i++)
+				constants[i] = entities[drawItems[chunk.start + i].entityIndex]->GetShaderData();
+
+			for (unsigned int i = 0; i < chunk.count; i++)
+			{
+				unsigned int offset = ring.Write(&constants[i], sizeof(VertexShaderData));
+				ring.BindVS(context, 0, offset, sizeof(VertexShaderData));
+				entities[drawItems[chunk.start + i].entityIndex]->GetMesh()->Draw(context);
+			}
+		});
+
+	perObjectBytesUploaded = (unsigned int)(drawItems.size() * sizeof(VertexShaderData));
+	drawCallsLastFrame = (unsigned int)drawItems.size();
+}
+
+// --------------------------------------------------------
+// Draws every run of entities that share a mesh with one
+// DrawIndexedInstanced call
+//  - The render queue is sorted by shader then mesh, so
+//    entities sharing a mesh are already next to each other
+//  - All instance data for the frame is uploaded at once
+// --------------------------------------------------------
+void Game::DrawEntitiesInstanced(const std::vector<DrawItem>& drawItems)
+{
+	PROFILE_SCOPE("DrawEntitiesInstanced");
+	unsigned int count = (unsigned int)drawItems.size();
+	drawCallsLastFrame = 0;
+	perObjectBytesUploaded = count * sizeof(InstanceData);
+	if (count == 0)
+		return;
+
+	// Grow the instance buffer if this frame needs more room
+	if (count > instanceCapacity)
+	{
+		instanceCapacity = count > instanceCapacity * 2 ? count : instanceCapacity * 2;
+
+		D3D11_BUFFER_DESC ibDesc = {};
+		ibDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		ibDesc.ByteWidth = instanceCapacity * sizeof(InstanceData);
+		ibDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		ibDesc.Usage = D3D11_USAGE_DYNAMIC;
+		instanceBuffer.Reset();
+		Graphics::Device->CreateBuffer(&ibDesc, 0, instanceBuffer.GetAddressOf());
+		RenderStats::CountBufferCreated();
+
+		RenderResources::RemoveBuffer(instanceBufferHandle);
+		instanceBufferHandle = RenderResources::AddBuffer(instanceBuffer.Get());
+	}
+
+	std::span<InstanceData> instanceData = frameArena.AllocateSpan<InstanceData>(count);
+	for (unsigned int i = 0; i < count; i++)
+	{
+		VertexShaderData vsData = entities[drawItems[i].entityIndex]->GetShaderData();
+		instanceData[i].world = vsData.world;
+		instanceData[i].colorTint = vsData.colorTint;
+	}
+	frameCommands.UploadBuffer(instanceBufferHandle, instanceData.data(), count * sizeof(InstanceData));
+
+	frameCommands.SetInputLayout(instancedInputLayoutHandle);
+	frameCommands.SetVertexShader(instancedVertexShaderHandle);
+
+	unsigned int groupStart = 0;
+	while (groupStart < count)
+	{
+		std::shared_ptr<Mesh> mesh = entities[drawItems[groupStart].entityIndex]->GetMesh();
+
+		unsigned int groupEnd = groupStart + 1;
+		while (groupEnd < count && entities[drawItems[groupEnd].entityIndex]->GetMesh() == mesh)
+			groupEnd++;
+
+		mesh->DrawInstanced(frameCommands, instanceBufferHandle, sizeof(InstanceData), groupEnd - groupStart, groupStart);
+		drawCallsLastFrame++;
+		groupStart = groupEnd;
+	}
+}
+
+// --------------------------------------------------------
+// Adds this frame's commands to the running capture, and
+// writes the file once enough frames are in.  Captures can
+// be replayed without a GPU by Tools/ReplayCapture.cpp
+// --------------------------------------------------------
+void Game::CaptureFrame()
+{
+	if (captureFramesLeft == 0)
+		return;
+
+	capture.AddFrame(frameCommands);
+	captureFramesLeft--;
+
+	if (captureFramesLeft == 0)
+		lastCaptureSaved = capture.Save(FixPath("FrameCapture.rcap"));
+}
+
+// --------------------------------------------------------
+// Clear the screen, redraw everything, present to the user
+// --------------------------------------------------------
+
+void Game::Draw(float deltaTime, float totalTime)
+{
+	PROFILE_SCOPE("Game::Draw");
+
+	// Frame START
+		// - These things should happen ONCE PER FRAME
+		// - At the beginning of Game::Draw() before drawing *anything*
+	{
+		StateCache::BeginFrame();
+
+		// Clear the back buffer (erase what's on screen) and depth buffer
+		const float color[4] = { 0.4f, 0.6f, 0.75f, 0.0f };
+		Graphics::Context->ClearRenderTargetView(Graphics::BackBufferRTV.Get(), color);
+		Graphics::Context->ClearDepthStencilView(Graphics::DepthBufferDSV.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+	}
+
+	// DRAW geometry
+	// Sort the visible entities, record them into the frame's
+	// command stream (one at a time or one instanced draw per
+	// mesh), then hand the stream to the backend
+	BuildRenderQueue();
+	const std::vector<DrawItem>& drawItems = renderQueue.GetItems();
+
+	frameCommands.Clear();
+	UpdatePerFrameData(totalTime);
+
+	// State shared by every draw.  The state cache is reset
+	// after the UI each frame, so these go through once per frame
+	frameCommands.SetTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	frameCommands.SetPixelShader(pixelShaderHandle);
+	frameCommands.SetVSConstantBuffer(1, perFrameBufferHandle);
+
+	// Worker threads record straight into deferred contexts,
+	// so that path is skipped while a capture is running
+	bool recordDeferred = !instancingEnabled &&
+		deferredRecordingEnabled &&
+		captureFramesLeft == 0 &&
+		deferredRecorder.ShouldRecord((unsigned int)drawItems.size());
+
+	// Everything that reaches the GPU from here to the end
+	// of the block is the opaque pass
+	{
+		RenderStats::PassScope opaquePass(StatsPass::Opaque);
+
+		recordedChunksLastFrame = 0;
+		if (instancingEnabled)
+			DrawEntitiesInstanced(drawItems);
+		else if (!recordDeferred)
+			DrawEntities(drawItems);
+
+		{
+			PROFILE_SCOPE("Backend Execute");
+			renderBackend.Execute(frameCommands);
+		}
+
+		if (recordDeferred)
+			DrawEntitiesDeferred(drawItems);
+	}
+
+	CaptureFrame();
+
+	// Sampled into the trace (if one is running) at the end of the frame
+	TraceWriter::SetCounter("Entities", (double)entities.size());
+	TraceWriter::SetCounter("Draw Calls", drawCallsLastFrame);
+	TraceWriter::SetCounter("Bytes Uploaded", perFrameBytesUploaded + perObjectBytesUploaded);
+	TraceWriter::SetCounter("Frame Arena Bytes", (double)frameArena.GetLastFrameStats().used);
+	TraceWriter::SetCounter("ImGui Allocations", (double)PoolAllocator::GetLastFrame().allocations);
+	TraceWriter::SetCounter("UI Rebuilt", uiBuiltThisFrame ? 1.0 : 0.0);
+
+	// Frame END
+	// - These should happen exactly ONCE PER FRAME
+	// - At the very end of the frame (after drawing *everything*)
+	{
+		// Draw the UI after everything else
+		{
+			PROFILE_SCOPE("ImGui Render");
+			RenderStats::PassScope uiPass(StatsPass::UI);
+			if (uiBuiltThisFrame)
+			{
+				retainedUI.BeginBuildTiming();
+				ImGui::Render();
+				retainedUI.EndBuildTiming();
+			}
+#if !defined(GRAPHICS_NULL)
+			ImDrawData* drawData = ImGui::GetDrawData();
+			if (mergeUIDraws)
+			{
+				// A reused UI draws the same data as before
+				if (uiBuiltThisFrame || !mergedUIDrawData)
+					mergedUIDrawData = uiDrawMerger.Merge(drawData);
+				drawData = mergedUIDrawData;
+			}
+			ImGui_ImplDX11_RenderDrawData(drawData);
+
+			// The backend's own binds aren't seen from here, but
+			// it draws each command and maps its vertex, index
+			// and constant buffers once per frame
+			for (int i = 0; i < drawData->CmdListsCount; i++)
+			{
+				for (const ImDrawCmd& command : drawData->CmdLists[i]->CmdBuffer)
+				{
+					if (!command.UserCallback)
+						RenderStats::CountDraw(command.ElemCount);
+				}
+			}
+			if (drawData->TotalVtxCount > 0)
+			{
+				for (int i = 0; i < 3; i++)
+					RenderStats::CountMap();
+				RenderStats::CountBufferBytes(drawData->TotalVtxCount * sizeof(ImDrawVert) + drawData->TotalIdxCount * sizeof(ImDrawIdx));
+				RenderStats::CountConstantBytes(sizeof(float) * 16);
+			}
+#endif
+		}
+
+		// The ImGui backend binds its own state behind our back
+		StateCache::Reset();
+
+		// Present at the end of the frame
+		PROFILE_SCOPE("Present");
+		bool vsync = Graphics::VsyncState();
+		Graphics::SwapChain->Present(
+			vsync ? 1 : 0,
+			vsync ? 0 : DXGI_PRESENT_ALLOW_TEARING);
+
+		// Re-bind back buffer and depth buffer after presenting
+		Graphics::Context->OMSetRenderTargets(
+			1,
+			Graphics::BackBufferRTV.GetAddressOf(),
+			Graphics::DepthBufferDSV.Get());
+		RenderStats::CountBinds();
+	}
+
+	RenderStats::EndFrame();
+}
+
+
+
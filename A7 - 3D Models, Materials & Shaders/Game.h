@@ -1,52 +1,180 @@
-#pragma once
-
-#include <d3d11.h>
-#include <wrl/client.h>
-#include <vector>
-#include <memory>
-
-#include "Mesh.h"
-#include "GameEntity.h"
-#include "Camera.h"
-
-class Game
-{
-public:
-	// Basic OOP setup
-	Game() = default;
-	~Game();
-	Game(const Game&) = delete; // Remove copy constructor
-	Game& operator=(const Game&) = delete; // Remove copy-assignment operator
-
-	// Primary functions
-	void Initialize();
-	void Update(float deltaTime, float totalTime);
-	void Draw(float deltaTime, float totalTime);
-	void OnResize();
-
-private:
-
-	void LoadShaders();
-	void CreateGeometry();
-	bool windowOpen;
-	void BuildUI();
-
-	std::vector<std::shared_ptr<GameEntity>> entities;
-	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
-	Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
-
-	//constant buffer
-	Microsoft::WRL::ComPtr<ID3D11Buffer> vsConstantBuffer;
-
-	Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
-	Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShader;
-	Microsoft::WRL::ComPtr<ID3D11InputLayout> inputLayout;
-
-	std::vector<std::shared_ptr<Mesh>> meshes;
-
-	// Camera for the 3D scene
-	std::shared_ptr<Camera> camera;
-	std::shared_ptr<Camera> cameraTwo;
-};
-
-
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <vector>
+#include <memory>
+#include <string>
+
+#include "Mesh.h"
+#include "GameEntity.h"
+#include "Camera.h"
+#include "CameraPath.h"
+#include "RenderQueue.h"
+#include "VisibilityCache.h"
+#include "DeferredRecorder.h"
+#include "D3D11RenderBackend.h"
+#include "RenderCapture.h"
+#include "AllocationTracker.h"
+#include "FrameArena.h"
+#include "FontAtlasCache.h"
+#include "RetainedUI.h"
+#include "FilteredList.h"
+#include "DrawDataMerger.h"
+
+class Game
+{
+public:
+	// Basic OOP setup
+	Game() = default;
+	~Game();
+	Game(const Game&) = delete; // Remove copy constructor
+	Game& operator=(const Game&) = delete; // Remove copy-assignment operator
+
+	// Primary functions
+	void Initialize();
+	void Update(float deltaTime, float totalTime);
+	void Draw(float deltaTime, float totalTime);
+	void OnResize();
+
+	// Replaces the entities with a named scene ("shapes" or
+	// "field") and loads its camera path
+	bool LoadScene(const std::string& name);
+
+	// While following, the camera is placed on the scene's
+	// path at each frame's total time instead of by input
+	void SetFollowCameraPath(bool follow);
+	const CameraPath& GetCameraPath();
+
+	// Culling counters from the last frame drawn
+	const VisibilityStats& GetVisibilityStats();
+
+private:
+
+	void LoadShaders();
+	void CreateGeometry();
+	bool windowOpen;
+	void BuildUI();
+	void BuildProfilerUI();
+	void BuildAllocationUI();
+	void BuildPoolAllocatorUI();
+	void BuildRenderStatsTable();
+	void BuildEntityInspector();
+	void BuildMeshInspector();
+	void BuildRenderQueue();
+	void PickEntity(int mouseX, int mouseY);
+	void UpdatePerFrameData(float totalTime);
+	void DrawEntities(const std::vector<DrawItem>& drawItems);
+	void DrawEntitiesInstanced(const std::vector<DrawItem>& drawItems);
+	void DrawEntitiesDeferred(const std::vector<DrawItem>& drawItems);
+	void CaptureFrame();
+	void BuildScenePath(const std::string& name);
+	void RecordCameraPath(float totalTime);
+
+	std::vector<std::shared_ptr<GameEntity>> entities;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
+
+	// Each frame's draws are recorded into a command stream,
+	// then executed by the backend (or captured to a file)
+	RenderCommandStream frameCommands;
+	D3D11RenderBackend renderBackend;
+	RenderCapture capture;
+	unsigned int captureFramesLeft = 0;
+	bool lastCaptureSaved = false;
+
+	// Copy of FrameTimes' window for the frame time plots
+	std::vector<float> frameTimePlot;
+
+	// Reused by the allocation table each frame
+	std::vector<AllocationSiteStats> allocationSites;
+
+	// Camera matrices and time, bound once per frame at b1
+	Microsoft::WRL::ComPtr<ID3D11Buffer> perFrameConstantBuffer;
+	ResourceHandle perFrameBufferHandle = NoResource;
+
+	// Constant data copied to the GPU last frame
+	unsigned int perFrameBytesUploaded = 0;
+	unsigned int perObjectBytesUploaded = 0;
+
+	Microsoft::WRL::ComPtr<ID3D11PixelShader> pixelShader;
+	Microsoft::WRL::ComPtr<ID3D11VertexShader> vertexShader;
+	Microsoft::WRL::ComPtr<ID3D11InputLayout> inputLayout;
+	ResourceHandle pixelShaderHandle = NoResource;
+	ResourceHandle vertexShaderHandle = NoResource;
+	ResourceHandle inputLayoutHandle = NoResource;
+
+	// Instanced drawing: one draw per mesh, with each entity's
+	// world matrix and tint in a per-frame instance buffer
+	Microsoft::WRL::ComPtr<ID3D11VertexShader> instancedVertexShader;
+	Microsoft::WRL::ComPtr<ID3D11InputLayout> instancedInputLayout;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> instanceBuffer;
+	ResourceHandle instancedVertexShaderHandle = NoResource;
+	ResourceHandle instancedInputLayoutHandle = NoResource;
+	ResourceHandle instanceBufferHandle = NoResource;
+	unsigned int instanceCapacity = 0;
+	bool instancingEnabled = true;
+	unsigned int drawCallsLastFrame = 0;
+
+	// Per-entity draws can be recorded on worker threads
+	DeferredRecorder deferredRecorder;
+	bool deferredRecordingEnabled = true;
+	unsigned int recordedChunksLastFrame = 0;
+
+	std::vector<std::shared_ptr<Mesh>> meshes;
+
+	// Sorted list of what to draw this frame
+	RenderQueue renderQueue;
+
+	// Scratch memory that only lives for a frame or two (sort
+	// scratch, instance data, the workers' staging copies)
+	FrameArena frameArena;
+
+	// How ImGui's font atlas was set up this run
+	FontAtlasCacheResult fontAtlasCache = {};
+
+	// Skips building the UI while nothing it shows has changed
+	RetainedUI retainedUI;
+	bool uiBuiltThisFrame = false;
+
+	// Joins the UI's draw commands before the backend draws
+	// them, redone only when the UI was rebuilt
+	DrawDataMerger uiDrawMerger;
+	bool mergeUIDraws = true;
+	ImDrawData* mergedUIDrawData = nullptr;
+
+	// Frustum culling, reusing last frame's results when nothing moved
+	VisibilityCache visibilityCache;
+
+	// Entities covering fewer pixels than this aren't drawn
+	float minScreenSize = 1.0f;
+	unsigned int smallObjectsCulled = 0;
+
+	// Entity inspector's rows, filtered and sorted a slice of
+	// the entities per frame
+	enum EntityColumn { EntityColumn_Index, EntityColumn_Mesh, EntityColumn_Distance };
+	static const size_t EntityFilterBudget = 8192;
+	FilteredList entityRows;
+	char entityFilterText[64] = {};
+	int entitySortColumn = EntityColumn_Index;
+	int inspectedEntity = -1;
+
+	// Result of the last right-click pick
+	int pickedEntity = -1;
+	RayHit pickedHit = {};
+
+	// Camera for the 3D scene
+	std::shared_ptr<Camera> camera;
+	std::shared_ptr<Camera> cameraTwo;
+
+	// Current scene and the flythrough that goes with it.
+	// F7 records a new path from the live camera
+	std::string sceneName;
+	CameraPath cameraPath;
+	bool followingCameraPath = false;
+	CameraPath recordedPath;
+	bool recordingCameraPath = false;
+	float recordStartTime = 0.0f;
+};
+
+
@@ -1,37 +1,56 @@
-#include "GameEntity.h"
-#include "BufferStructs.h"
-#include "Graphics.h"
-
-GameEntity::GameEntity(std::shared_ptr<Mesh> mesh):
-    gMesh(mesh)
-{
-    gTransform = std::make_shared<Transform>();
-}
-
-std::shared_ptr<Mesh> GameEntity::GetMesh()
-{
-    return gMesh;
-}
-
-std::shared_ptr<Transform> GameEntity::GetTransform()
-{
-    return gTransform;
-}
-
-void GameEntity::SetMesh(std::shared_ptr<Mesh> sMesh) { gMesh = sMesh; }
-
-
-void GameEntity::gDraw(Microsoft::WRL::ComPtr<ID3D11Buffer> vsConstantBuffer, std::shared_ptr<Camera> camera)
-{
-	VertexShaderData vsData = {};
-	vsData.colorTint = DirectX::XMFLOAT4(1.0f, 0.5f, 0.5f, 1.0f);
-	vsData.world = gTransform->GetWorldMatrix();
-	vsData.viewMatrix = camera->GetView();
-	vsData.projectionMatrix = camera->GetProjection();
-
-	D3D11_MAPPED_SUBRESOURCE mappedBuffer = {};
-	Graphics::Context->Map(vsConstantBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedBuffer);
-	memcpy(mappedBuffer.pData, &vsData, sizeof(vsData));
-	Graphics::Context->Unmap(vsConstantBuffer.Get(), 0);
-	gMesh->Draw();
+#include "GameEntity.h"
+#include "BufferStructs.h"
+#include "Graphics.h"
+
+#include <cmath>
+
+GameEntity::GameEntity(std::shared_ptr<Mesh> mesh):
+    gMesh(mesh)
+{
+    gTransform = std::make_shared<Transform>();
+}
+
+std::shared_ptr<Mesh> GameEntity::GetMesh()
+{
+    return gMesh;
+}
+
+std::shared_ptr<Transform> GameEntity::GetTransform()
+{
+    return gTransform;
+}
+
+void GameEntity::SetMesh(std::shared_ptr<Mesh> sMesh) { gMesh = sMesh; }
+
+BoundingSphere GameEntity::GetWorldBounds()
+{
+	DirectX::XMFLOAT4X4 world = gTransform->GetWorldMatrix();
+	DirectX::XMFLOAT3 localCenter = gMesh->GetBoundsCenter();
+	DirectX::XMFLOAT3 scale = gTransform->GetScale();
+
+	BoundingSphere bounds = {};
+	DirectX::XMStoreFloat3(&bounds.center, DirectX::XMVector3Transform(
+		DirectX::XMLoadFloat3(&localCenter),
+		DirectX::XMLoadFloat4x4(&world)));
+
+	// Rotation can't grow a sphere, but the largest scale axis can
+	float maxScale = fmaxf(fabsf(scale.x), fmaxf(fabsf(scale.y), fabsf(scale.z)));
+	bounds.radius = gMesh->GetBoundsRadius() * maxScale;
+	return bounds;
+}
+
+
+VertexShaderData GameEntity::GetShaderData()
+{
+	VertexShaderData vsData = {};
+	vsData.colorTint = DirectX::XMFLOAT4(1.0f, 0.5f, 0.5f, 1.0f);
+	vsData.world = gTransform->GetWorldMatrix();
+	return vsData;
+}
+
+void GameEntity::gDraw(RenderCommandStream& stream)
+{
+	VertexShaderData vsData = GetShaderData();
+	stream.SetVSConstants(0, &vsData, sizeof(VertexShaderData));
+	gMesh->Draw(stream);
 }
\ No newline at end of file
@@ -1,24 +1,34 @@
-#pragma once
-#include "Transform.h"
-#include <memory>
-
-#include "Mesh.h"
-#include "Camera.h"
-class GameEntity
-{
-public:
-	GameEntity(std::shared_ptr<Mesh> mesh);
-
-	std::shared_ptr<Mesh> GetMesh();
-	std::shared_ptr<Transform> GetTransform();
-
-	void SetMesh(std::shared_ptr<Mesh> mesh);
-
-	void gDraw(Microsoft::WRL::ComPtr<ID3D11Buffer> vsConstantBuffer, std::shared_ptr<Camera> camera);
-
-private:
-	std::shared_ptr<Transform> gTransform;
-	std::shared_ptr<Mesh> gMesh;
-
-};
-
+#pragma once
+#include "Transform.h"
+#include <memory>
+
+#include "Mesh.h"
+#include "Camera.h"
+#include "Frustum.h"
+#include "BufferStructs.h"
+#include "RenderCommands.h"
+class GameEntity
+{
+public:
+	GameEntity(std::shared_ptr<Mesh> mesh);
+
+	std::shared_ptr<Mesh> GetMesh();
+	std::shared_ptr<Transform> GetTransform();
+
+	void SetMesh(std::shared_ptr<Mesh> mesh);
+
+	// Mesh bounds moved into world space by the transform
+	BoundingSphere GetWorldBounds();
+
+	// Per-draw constants for this entity (camera data is per frame)
+	VertexShaderData GetShaderData();
+
+	// Records this entity's constants and draw into stream
+	void gDraw(RenderCommandStream& stream);
+
+private:
+	std::shared_ptr<Transform> gTransform;
+	std::shared_ptr<Mesh> gMesh;
+
+};
+
@@ -1,40 +1,46 @@
-#pragma once
-
-#include <Windows.h>
-#include <d3d11.h>
-#include <string>
-#include <wrl/client.h>
-
-#pragma comment(lib, "d3d11.lib")
-#pragma comment(lib, "dxgi.lib")
-
-namespace Graphics
-{
-	// --- GLOBAL VARS ---
-
-	// Primary D3D11 API objects
-	inline Microsoft::WRL::ComPtr<ID3D11Device> Device;
-	inline Microsoft::WRL::ComPtr<ID3D11DeviceContext> Context;
-	inline Microsoft::WRL::ComPtr<IDXGISwapChain> SwapChain;
-
-	// Rendering buffers
-	inline Microsoft::WRL::ComPtr<ID3D11RenderTargetView> BackBufferRTV;
-	inline Microsoft::WRL::ComPtr<ID3D11DepthStencilView> DepthBufferDSV;
-
-	// Debug Layer
-	inline Microsoft::WRL::ComPtr<ID3D11InfoQueue> InfoQueue;
-
-	// --- FUNCTIONS ---
-
-	// Getters
-	bool VsyncState();
-	std::wstring APIName();
-
-	// General functions
-	HRESULT Initialize(unsigned int windowWidth, unsigned int windowHeight, HWND windowHandle, bool vsyncIfPossible);
-	void ShutDown();
-	void ResizeBuffers(unsigned int width, unsigned int height);
-
-	// Debug Layer
-	void PrintDebugMessages();
+#pragma once
+
+#include <Windows.h>
+#include <d3d11.h>
+#include <string>
+#include <wrl/client.h>
+
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "dxgi.lib")
+
+// Define GRAPHICS_NULL for the whole project to swap the real
+// device for the one in NullGraphics.h.  Nothing reaches the
+// GPU or a window, so the game can run headless and the CPU
+// side of each frame can be measured on its own.  That build
+// also runs on Linux, see Tools/LinuxShim/LinuxMain.cpp
+
+namespace Graphics
+{
+	// --- GLOBAL VARS ---
+
+	// Primary D3D11 API objects
+	inline Microsoft::WRL::ComPtr<ID3D11Device> Device;
+	inline Microsoft::WRL::ComPtr<ID3D11DeviceContext> Context;
+	inline Microsoft::WRL::ComPtr<IDXGISwapChain> SwapChain;
+
+	// Rendering buffers
+	inline Microsoft::WRL::ComPtr<ID3D11RenderTargetView> BackBufferRTV;
+	inline Microsoft::WRL::ComPtr<ID3D11DepthStencilView> DepthBufferDSV;
+
+	// Debug Layer
+	inline Microsoft::WRL::ComPtr<ID3D11InfoQueue> InfoQueue;
+
+	// --- FUNCTIONS ---
+
+	// Getters
+	bool VsyncState();
+	std::wstring APIName();
+
+	// General functions
+	HRESULT Initialize(unsigned int windowWidth, unsigned int windowHeight, HWND windowHandle, bool vsyncIfPossible);
+	void ShutDown();
+	void ResizeBuffers(unsigned int width, unsigned int height);
+
+	// Debug Layer
+	void PrintDebugMessages();
 }
\ No newline at end of file
@@ -4121,6 +4121,113 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->PrimRectUV(ImVec2(x + glyph->X0 * scale, y + glyph->Y0 * scale), ImVec2(x + glyph->X1 * scale, y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+// SSE text emission for ImFont::RenderText(), enabled with IMGUI_ENABLE_SSE_TEXT: visible glyphs are queued and emitted 4 at
+// a time, one glyph per lane, so the horizontal rejection and the CPU fine clipping run on all 4 together. The operations are
+// the same as the plain path's, in the same order, so the output is bit-identical. Requires the default ImDrawVert layout.
+#if defined(IMGUI_ENABLE_SSE_TEXT) && defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_USE_SSE_TEXT
+#ifdef _MSC_VER
+#define IM_SSE_TEXT_INLINE  __forceinline
+#else
+#define IM_SSE_TEXT_INLINE  inline __attribute__((always_inline))
+#endif
+IM_STATIC_ASSERT(offsetof(ImDrawVert, uv) == offsetof(ImDrawVert, pos) + 8);
+IM_STATIC_ASSERT(offsetof(ImFontGlyph, Y1) == offsetof(ImFontGlyph, X0) + 12 && offsetof(ImFontGlyph, V1) == offsetof(ImFontGlyph, U0) + 12);
+
+static inline __m128 ImSelect_SSE(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Write one quad from its corners (x1, y1, x2, y2) and texture coordinates (u1, v1, u2, v2), one 16 bytes store of pos+uv per vertex
+static inline void ImFontWriteGlyph_SSE(__m128 glyph_pos, __m128 glyph_uv, ImU32 glyph_col, ImDrawVert*& vtx_write, ImDrawIdx*& idx_write, unsigned int& vtx_index)
+{
+    _mm_storeu_ps(&vtx_write[0].pos.x, _mm_movelh_ps(glyph_pos, glyph_uv));                            vtx_write[0].col = glyph_col;
+    _mm_storeu_ps(&vtx_write[1].pos.x, _mm_shuffle_ps(glyph_pos, glyph_uv, _MM_SHUFFLE(1, 2, 1, 2)));  vtx_write[1].col = glyph_col;
+    _mm_storeu_ps(&vtx_write[2].pos.x, _mm_movehl_ps(glyph_uv, glyph_pos));                            vtx_write[2].col = glyph_col;
+    _mm_storeu_ps(&vtx_write[3].pos.x, _mm_shuffle_ps(glyph_pos, glyph_uv, _MM_SHUFFLE(3, 0, 3, 0)));  vtx_write[3].col = glyph_col;
+    idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
+    idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
+    vtx_write += 4;
+    vtx_index += 4;
+    idx_write += 6;
+}
+
+// Emit the first 'count' (1 to 4) queued glyphs, each drawn at its own pen position (x, y, x, y) in glyph_pen[].
+// Forced inline: as a call it costs more than the batching saves.
+static IM_SSE_TEXT_INLINE void ImFontRenderGlyphs_SSE(const ImFontGlyph* const* glyphs, const __m128* glyph_pen, const ImU32* glyph_col, int count, float scale, const ImVec4& clip_rect, bool cpu_fine_clip, ImDrawVert*& out_vtx_write, ImDrawIdx*& out_idx_write, unsigned int& out_vtx_index)
+{
+    // Unused lanes repeat the first glyph and are masked out below
+    const int i1 = count > 1 ? 1 : 0;
+    const int i2 = count > 2 ? 2 : 0;
+    const int i3 = count > 3 ? 3 : 0;
+
+    // Corners (x1, y1, x2, y2) of each glyph, then transposed to one register per corner coordinate
+    const __m128 scale4 = _mm_set1_ps(scale);
+    __m128 pos0 = _mm_add_ps(glyph_pen[0], _mm_mul_ps(_mm_loadu_ps(&glyphs[0]->X0), scale4));
+    __m128 pos1 = _mm_add_ps(glyph_pen[i1], _mm_mul_ps(_mm_loadu_ps(&glyphs[i1]->X0), scale4));
+    __m128 pos2 = _mm_add_ps(glyph_pen[i2], _mm_mul_ps(_mm_loadu_ps(&glyphs[i2]->X0), scale4));
+    __m128 pos3 = _mm_add_ps(glyph_pen[i3], _mm_mul_ps(_mm_loadu_ps(&glyphs[i3]->X0), scale4));
+    __m128 uv0 = _mm_loadu_ps(&glyphs[0]->U0);
+    __m128 uv1 = _mm_loadu_ps(&glyphs[i1]->U0);
+    __m128 uv2 = _mm_loadu_ps(&glyphs[i2]->U0);
+    __m128 uv3 = _mm_loadu_ps(&glyphs[i3]->U0);
+    __m128 x1 = pos0, y1 = pos1, x2 = pos2, y2 = pos3;
+    _MM_TRANSPOSE4_PS(x1, y1, x2, y2);
+
+    // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
+    const __m128 clip_x = _mm_set1_ps(clip_rect.x);
+    const __m128 clip_z = _mm_set1_ps(clip_rect.z);
+    int lanes = _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(x1, clip_z), _mm_cmpge_ps(x2, clip_x))) & ((1 << count) - 1);
+    if (lanes == 0)
+        return;
+
+    // CPU side clipping. Every lane takes the same path as the plain code, the results are only kept where it crosses the edge.
+    // Most batches cross nothing and skip straight to the writes.
+    if (cpu_fine_clip)
+    {
+        const __m128 clip_y = _mm_set1_ps(clip_rect.y);
+        const __m128 clip_w = _mm_set1_ps(clip_rect.w);
+        const __m128 cross_x1 = _mm_cmplt_ps(x1, clip_x);
+        const __m128 cross_y1 = _mm_cmplt_ps(y1, clip_y);
+        const __m128 cross_x2 = _mm_cmpgt_ps(x2, clip_z);
+        const __m128 cross_y2 = _mm_cmpgt_ps(y2, clip_w);
+        if (_mm_movemask_ps(_mm_or_ps(_mm_or_ps(cross_x1, cross_y1), _mm_or_ps(cross_x2, cross_y2))) & lanes)
+        {
+            const __m128 one = _mm_set1_ps(1.0f);
+            __m128 u1 = uv0, v1 = uv1, u2 = uv2, v2 = uv3;
+            _MM_TRANSPOSE4_PS(u1, v1, u2, v2);
+            u1 = ImSelect_SSE(cross_x1, _mm_add_ps(u1, _mm_mul_ps(_mm_sub_ps(one, _mm_div_ps(_mm_sub_ps(x2, clip_x), _mm_sub_ps(x2, x1))), _mm_sub_ps(u2, u1))), u1);
+            x1 = ImSelect_SSE(cross_x1, clip_x, x1);
+            v1 = ImSelect_SSE(cross_y1, _mm_add_ps(v1, _mm_mul_ps(_mm_sub_ps(one, _mm_div_ps(_mm_sub_ps(y2, clip_y), _mm_sub_ps(y2, y1))), _mm_sub_ps(v2, v1))), v1);
+            y1 = ImSelect_SSE(cross_y1, clip_y, y1);
+            u2 = ImSelect_SSE(cross_x2, _mm_add_ps(u1, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(clip_z, x1), _mm_sub_ps(x2, x1)), _mm_sub_ps(u2, u1))), u2);
+            x2 = ImSelect_SSE(cross_x2, clip_z, x2);
+            v2 = ImSelect_SSE(cross_y2, _mm_add_ps(v1, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(clip_w, y1), _mm_sub_ps(y2, y1)), _mm_sub_ps(v2, v1))), v2);
+            y2 = ImSelect_SSE(cross_y2, clip_w, y2);
+
+            // Back to one register per glyph
+            pos0 = x1; pos1 = y1; pos2 = x2; pos3 = y2;
+            _MM_TRANSPOSE4_PS(pos0, pos1, pos2, pos3);
+            uv0 = u1; uv1 = v1; uv2 = u2; uv3 = v2;
+            _MM_TRANSPOSE4_PS(uv0, uv1, uv2, uv3);
+        }
+        lanes &= _mm_movemask_ps(_mm_cmpnge_ps(y1, y2));
+    }
+
+    ImDrawVert* vtx_write = out_vtx_write;
+    ImDrawIdx* idx_write = out_idx_write;
+    unsigned int vtx_index = out_vtx_index;
+    if (lanes & 1) ImFontWriteGlyph_SSE(pos0, uv0, glyph_col[0], vtx_write, idx_write, vtx_index);
+    if (lanes & 2) ImFontWriteGlyph_SSE(pos1, uv1, glyph_col[1], vtx_write, idx_write, vtx_index);
+    if (lanes & 4) ImFontWriteGlyph_SSE(pos2, uv2, glyph_col[2], vtx_write, idx_write, vtx_index);
+    if (lanes & 8) ImFontWriteGlyph_SSE(pos3, uv3, glyph_col[3], vtx_write, idx_write, vtx_index);
+    out_vtx_write = vtx_write;
+    out_idx_write = idx_write;
+    out_vtx_index = vtx_index;
+}
+#endif
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
 {
@@ -4187,6 +4294,12 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
+#ifdef IMGUI_USE_SSE_TEXT
+    const ImFontGlyph* batch_glyphs[4];
+    __m128 batch_pen[4];
+    ImU32 batch_col[4];
+    int batch_count = 0;
+#endif
 
     while (s < text_end)
     {
@@ -4234,6 +4347,19 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
             continue;
 
         float char_width = glyph->AdvanceX * scale;
+#ifdef IMGUI_USE_SSE_TEXT
+        if (glyph->Visible)
+        {
+            batch_glyphs[batch_count] = glyph;
+            batch_pen[batch_count] = _mm_setr_ps(x, y, x, y);
+            batch_col[batch_count] = glyph->Colored ? col_untinted : col;
+            if (++batch_count == 4)
+            {
+                ImFontRenderGlyphs_SSE(batch_glyphs, batch_pen, batch_col, 4, scale, clip_rect, cpu_fine_clip, vtx_write, idx_write, vtx_index);
+                batch_count = 0;
+            }
+        }
+#else
         if (glyph->Visible)
         {
             // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
@@ -4296,8 +4422,13 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, Im
                 }
             }
         }
+#endif
         x += char_width;
     }
+#ifdef IMGUI_USE_SSE_TEXT
+    if (batch_count > 0)
+        ImFontRenderGlyphs_SSE(batch_glyphs, batch_pen, batch_col, batch_count, scale, clip_rect, cpu_fine_clip, vtx_write, idx_write, vtx_index);
+#endif
 
     // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
     draw_list->VtxBuffer.Size = (int)(vtx_write - draw_list->VtxBuffer.Data); // Same as calling shrink()
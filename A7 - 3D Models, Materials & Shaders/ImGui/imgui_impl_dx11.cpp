@@ -263,6 +263,9 @@ void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
     int global_idx_offset = 0;
     int global_vtx_offset = 0;
     ImVec2 clip_off = draw_data->DisplayPos;
+    bool bound_valid = false; // Scissor and texture set by the previous command, until a callback may have changed them
+    D3D11_RECT bound_scissor = {};
+    ID3D11ShaderResourceView* bound_srv = nullptr;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* draw_list = draw_data->CmdLists[n];
@@ -277,6 +280,7 @@ void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
                     ImGui_ImplDX11_SetupRenderState(draw_data, device);
                 else
                     pcmd->UserCallback(draw_list, pcmd);
+                bound_valid = false;
             }
             else
             {
@@ -286,13 +290,18 @@ void ImGui_ImplDX11_RenderDrawData(ImDrawData* draw_data)
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
-                // Apply scissor/clipping rectangle
+                // Apply scissor/clipping rectangle, unless the previous command already did
                 const D3D11_RECT r = { (LONG)clip_min.x, (LONG)clip_min.y, (LONG)clip_max.x, (LONG)clip_max.y };
-                device->RSSetScissorRects(1, &r);
+                if (!bound_valid || r.left != bound_scissor.left || r.top != bound_scissor.top || r.right != bound_scissor.right || r.bottom != bound_scissor.bottom)
+                    device->RSSetScissorRects(1, &r);
 
-                // Bind texture, Draw
+                // Bind texture (likewise), Draw
                 ID3D11ShaderResourceView* texture_srv = (ID3D11ShaderResourceView*)pcmd->GetTexID();
-                device->PSSetShaderResources(0, 1, &texture_srv);
+                if (!bound_valid || texture_srv != bound_srv)
+                    device->PSSetShaderResources(0, 1, &texture_srv);
+                bound_scissor = r;
+                bound_srv = texture_srv;
+                bound_valid = true;
                 device->DrawIndexed(pcmd->ElemCount, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset);
             }
         }
@@ -1,150 +1,415 @@
-
-#include <Windows.h>
-#include <crtdbg.h>
-
-#include "Window.h"
-#include "Graphics.h"
-#include "Game.h"
-#include "Input.h"
-
-// Annonymous namespace to hold variables
-// only accessible in this file
-namespace
-{
-	// A "global" game object that
-	// can be used in WinMain() and
-	// in our window resize callback
-	Game* game = 0;
-
-	// A simple function to hook up 
-	// to the window for resize
-	// notifications
-	void WindowResizeCallback()
-	{
-		// Let the game object know
-		// that the window has been
-		// resized, if it exists
-		if(game)
-			game->OnResize();
-	}
-}
-
-
-
-// --------------------------------------------------------
-// Entry point for a graphical (non-console) Windows application
-// --------------------------------------------------------
-int WINAPI WinMain(
-	_In_ HINSTANCE hInstance,			// The handle to this app's instance
-	_In_opt_ HINSTANCE hPrevInstance,	// A handle to the previous instance of the app (always NULL)
-	_In_ LPSTR lpCmdLine,				// Command line params
-	_In_ int nCmdShow)					// How the window should be shown (we ignore this)
-{
-#if defined(DEBUG) | defined(_DEBUG)
-	// Enable memory leak detection as a quick and dirty
-	// way of determining if we forgot to clean something up
-	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
-
-	// Do we also want a console window?  Probably only in debug mode
-	Window::CreateConsoleWindow(500, 120, 32, 120);
-	printf("Console window created successfully.  Feel free to printf() here.\n");
-#endif
-
-	// Set up app initialization details
-	unsigned int windowWidth = 1280;
-	unsigned int windowHeight = 720;
-	const wchar_t* windowTitle = L"Direct3D11 Game";
-	bool statsInTitleBar = true;
-	bool vsync = false;
-
-	// The main application object
-	game = new Game();
-
-	// Create the window and verify
-	HRESULT windowResult = Window::Create(
-		hInstance,
-		windowWidth,
-		windowHeight,
-		windowTitle,
-		statsInTitleBar,
-		WindowResizeCallback);
-	if (FAILED(windowResult))
-		return windowResult;
-
-	// Initialize the graphics API and verify
-	HRESULT graphicsResult = Graphics::Initialize(
-		Window::Width(), 
-		Window::Height(), 
-		Window::Handle(),
-		vsync);
-	if (FAILED(graphicsResult))
-		return graphicsResult;
-
-	// Initalize the input system, which requires the window handle
-	Input::Initialize(Window::Handle());
-
-	// Now the game itself can be initialzied
-	game->Initialize();
-
-	// Time tracking
-	LARGE_INTEGER perfFreq{};
-	double perfSeconds = 0;
-	__int64 startTime = 0;
-	__int64 currentTime = 0;
-	__int64 previousTime = 0;
-
-	// Query for accurate timing information
-	QueryPerformanceFrequency(&perfFreq);
-	perfSeconds = 1.0 / (double)perfFreq.QuadPart;
-
-	// Performance Counter gives high-resolution time stamps
-	QueryPerformanceCounter((LARGE_INTEGER*)&startTime);
-	currentTime = startTime;
-	previousTime = startTime;
-
-	// Windows message loop (and our game loop)
-	MSG msg = {};
-	while (msg.message != WM_QUIT)
-	{
-		// Determine if there is a message from the operating system
-		if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
-		{
-			// Translate and dispatch the message
-			// to our custom WindowProc function
-			TranslateMessage(&msg);
-			DispatchMessage(&msg);
-		}
-		else
-		{
-			// Calculate up-to-date timing info
-			QueryPerformanceCounter((LARGE_INTEGER*)&currentTime);
-			float deltaTime = max((float)((currentTime - previousTime) * perfSeconds), 0.0f);
-			float totalTime = (float)((currentTime - startTime) * perfSeconds);
-			previousTime = currentTime;
-
-			// Calculate basic fps
-			Window::UpdateStats(totalTime);
-
-			// Input updating
-			Input::Update();
-
-			// Update and draw
-			game->Update(deltaTime, totalTime);
-			game->Draw(deltaTime, totalTime);
-
-			// Notify Input system about end of frame
-			Input::EndOfFrame();
-
-#if defined(DEBUG) || defined(_DEBUG)
-			// Print any graphics debug messages that occurred this frame
-			Graphics::PrintDebugMessages();
-#endif
-		}
-	}
-
-	// Clean up
-	delete game;
-	Input::ShutDown();
-	Graphics::ShutDown();
-	return (HRESULT)msg.wParam;
-}
+
+#include <Windows.h>
+#include <crtdbg.h>
+
+#include "Window.h"
+#include "Graphics.h"
+#include "Game.h"
+#include "Input.h"
+#include "StateCache.h"
+#include "RenderResources.h"
+#include "Profiler.h"
+#include "TraceWriter.h"
+#include "FrameTimes.h"
+#include "AllocationTracker.h"
+#include "PoolAllocator.h"
+#include "RenderStats.h"
+#include "Benchmark.h"
+#include "PathHelpers.h"
+
+#include <cmath>
+
+#if defined(GRAPHICS_NULL)
+#include "NullGraphics.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#endif
+
+// Annonymous namespace to hold variables
+// only accessible in this file
+namespace
+{
+	// A "global" game object that
+	// can be used in WinMain() and
+	// in our window resize callback
+	Game* game = 0;
+
+#if !defined(GRAPHICS_NULL)
+	// A simple function to hook up 
+	// to the window for resize
+	// notifications
+	void WindowResizeCallback()
+	{
+		// Let the game object know
+		// that the window has been
+		// resized, if it exists
+		if(game)
+			game->OnResize();
+	}
+#endif
+
+#if defined(GRAPHICS_NULL)
+	// Per-frame results of a headless run
+	struct HeadlessFrame
+	{
+		double milliseconds;
+		unsigned long long contextCalls;
+		unsigned long long draws;
+		unsigned long long bytesUploaded;
+		unsigned long long bytesAllocated;
+	};
+
+	// --------------------------------------------------------
+	// Reads "-frames N" from the command line, or returns the
+	// default when it isn't there
+	// --------------------------------------------------------
+	unsigned int FrameCountFromCommandLine(const char* commandLine)
+	{
+		const unsigned int defaultFrames = 1000;
+		const char* option = commandLine ? strstr(commandLine, "-frames") : 0;
+		if (!option)
+			return defaultFrames;
+
+		int frames = atoi(option + strlen("-frames"));
+		return frames > 0 ? (unsigned int)frames : defaultFrames;
+	}
+
+	// --------------------------------------------------------
+	// Runs the game for a fixed number of frames on the null
+	// device, then prints a summary and writes every frame to
+	// HeadlessRun.csv next to the executable
+	//
+	// Each frame gets the same time step and input is never
+	// polled, so two runs do exactly the same work
+	// --------------------------------------------------------
+	int RunHeadless(unsigned int frameCount)
+	{
+		const float deltaTime = 1.0f / 60.0f;
+
+		LARGE_INTEGER perfFreq{};
+		QueryPerformanceFrequency(&perfFreq);
+		double perfMilliseconds = 1000.0 / (double)perfFreq.QuadPart;
+
+		std::vector<HeadlessFrame> frames(frameCount);
+		for (unsigned int i = 0; i < frameCount; i++)
+		{
+			NullGraphicsStats before = NullGraphics::GetStats();
+			__int64 startTime = 0;
+			__int64 endTime = 0;
+			QueryPerformanceCounter((LARGE_INTEGER*)&startTime);
+			Profiler::BeginFrame();
+
+			float totalTime = i * deltaTime;
+			game->Update(deltaTime, totalTime);
+			game->Draw(deltaTime, totalTime);
+			Input::EndOfFrame();
+
+			Profiler::EndFrame();
+			AllocationTracker::EndFrame();
+			PoolAllocator::EndFrame();
+			QueryPerformanceCounter((LARGE_INTEGER*)&endTime);
+			TraceWriter::WriteFrame(Profiler::GetLastFrame());
+			NullGraphicsStats after = NullGraphics::GetStats();
+
+			HeadlessFrame& frame = frames[i];
+			frame.milliseconds = (endTime - startTime) * perfMilliseconds;
+			FrameTimes::Record((float)frame.milliseconds);
+			frame.contextCalls = after.contextCalls - before.contextCalls;
+			frame.draws = after.draws - before.draws;
+			frame.bytesUploaded = after.bytesUploaded - before.bytesUploaded;
+			frame.bytesAllocated = after.bytesAllocated - before.bytesAllocated;
+		}
+
+		std::ofstream csv(FixPath("HeadlessRun.csv"));
+		csv << "frame,ms,context_calls,draws,bytes_uploaded,bytes_allocated\n";
+		for (unsigned int i = 0; i < frameCount; i++)
+		{
+			const HeadlessFrame& frame = frames[i];
+			csv << i << "," << frame.milliseconds << "," << frame.contextCalls << "," << frame.draws << ","
+				<< frame.bytesUploaded << "," << frame.bytesAllocated << "\n";
+		}
+
+		// Summary, leaving the first frame out of the timings
+		// since it pays for first-use costs
+		std::vector<float> times;
+		for (unsigned int i = 1; i < frameCount; i++)
+			times.push_back((float)frames[i].milliseconds);
+		if (times.empty())
+			return 0;
+
+		std::vector<float> scratch;
+		FrameTimeStats timeStats = ComputeFrameTimeStats(times.data(), (unsigned int)times.size(), scratch);
+
+		NullGraphicsStats stats = NullGraphics::GetStats();
+		printf("Headless run: %u frames\n", frameCount);
+		printf("  Frame time (ms)  mean %.4f  p50 %.4f  p90 %.4f  p99 %.4f  p99.9 %.4f  max %.4f\n",
+			timeStats.mean, timeStats.p50, timeStats.p90, timeStats.p99, timeStats.p999, timeStats.max);
+		printf("  Stutters         %u frames over twice the median\n", timeStats.stutters);
+		printf("  Per frame        %llu context calls, %llu draws, %llu bytes uploaded\n",
+			frames.back().contextCalls, frames.back().draws, frames.back().bytesUploaded);
+		printf("  Resources        %llu created, %llu bytes allocated, %llu bytes live\n",
+			stats.resourcesCreated, stats.bytesAllocated, stats.liveBytes);
+
+		// The last frame as the engine counted it, pass by pass
+		for (int i = 0; i <= (int)StatsPass::Count; i++)
+		{
+			bool total = i == (int)StatsPass::Count;
+			RenderPassStats pass = total ? RenderStats::GetLastFrameTotal() : RenderStats::GetLastFrame((StatsPass)i);
+			printf("  %-16s %u draws, %llu triangles, %u binds, %llu constant bytes, %llu other bytes, %u maps\n",
+				total ? "Total" : RenderStats::GetPassName((StatsPass)i),
+				pass.draws, pass.triangles, pass.binds, pass.constantBytes, pass.bufferBytes, pass.maps);
+		}
+		return 0;
+	}
+#endif
+
+	// --------------------------------------------------------
+	// Flies the camera along the scene's path for a fixed
+	// number of frames, each with the same time step, then
+	// reports the stage timings against the baseline.  Input
+	// is never polled, so every run does the same work
+	//
+	// Returns the benchmark's exit code
+	// --------------------------------------------------------
+	int RunBenchmark(const BenchmarkSettings& settings)
+	{
+		if (!game->LoadScene(settings.scene))
+		{
+			printf("Unknown benchmark scene \"%s\"\n", settings.scene.c_str());
+			return 2;
+		}
+		game->SetFollowCameraPath(true);
+
+		// By default, just enough frames to cover the path once
+		unsigned int frameCount = settings.frames;
+		if (frameCount == 0)
+			frameCount = (unsigned int)ceil(game->GetCameraPath().GetDuration() / settings.timeStep);
+
+		Benchmark::Begin(settings, frameCount);
+		unsigned long long culledReused = 0;
+		for (unsigned int i = 0; i < frameCount; i++)
+		{
+#if !defined(GRAPHICS_NULL)
+			// Keep the window responsive, but stop if it's closed
+			MSG msg = {};
+			while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+			{
+				if (msg.message == WM_QUIT)
+					return (int)msg.wParam;
+				TranslateMessage(&msg);
+				DispatchMessage(&msg);
+			}
+#endif
+			Profiler::BeginFrame();
+
+			float totalTime = i * settings.timeStep;
+			game->Update(settings.timeStep, totalTime);
+			game->Draw(settings.timeStep, totalTime);
+			Input::EndOfFrame();
+
+			Profiler::EndFrame();
+			AllocationTracker::EndFrame();
+			PoolAllocator::EndFrame();
+			TraceWriter::WriteFrame(Profiler::GetLastFrame());
+			FrameTimes::Record((float)Profiler::GetLastFrame().durationMs);
+
+			const VisibilityStats& culling = game->GetVisibilityStats();
+			Benchmark::RecordCounter("Culling hit rate %", culling.HitRate() * 100.0);
+			Benchmark::RecordCounter("Culling tests", culling.tested);
+			Benchmark::RecordCounter("Culling reused", culling.reused);
+			Benchmark::RecordCounter("Culling saved us", culling.savedSeconds * 1000000.0);
+			Benchmark::RecordCounter("Visible", culling.visible);
+			Benchmark::RecordFrame(Profiler::GetLastFrame());
+			culledReused += culling.reused;
+		}
+		int result = Benchmark::Finish();
+
+		// The paths hold still in places, so a cache that never
+		// reuses anything is broken rather than just unlucky
+		if (culledReused == 0)
+		{
+			printf("  FAILED: the visibility cache never reused a result (hit rate 0%%)\n");
+			return result == 0 ? 1 : result;
+		}
+		return result;
+	}
+}
+
+
+
+// --------------------------------------------------------
+// Entry point for a graphical (non-console) Windows application
+// --------------------------------------------------------
+int WINAPI WinMain(
+	_In_ HINSTANCE hInstance,			// The handle to this app's instance
+	_In_opt_ HINSTANCE hPrevInstance,	// A handle to the previous instance of the app (always NULL)
+	_In_ LPSTR lpCmdLine,				// Command line params
+	_In_ int nCmdShow)					// How the window should be shown (we ignore this)
+{
+#if defined(DEBUG) | defined(_DEBUG)
+	// Enable memory leak detection as a quick and dirty
+	// way of determining if we forgot to clean something up
+	_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
+
+	// Do we also want a console window?  Probably only in debug mode
+	Window::CreateConsoleWindow(500, 120, 32, 120);
+	printf("Console window created successfully.  Feel free to printf() here.\n");
+#elif defined(GRAPHICS_NULL)
+	// Headless runs report their results to the console
+	Window::CreateConsoleWindow(500, 120, 32, 120);
+#endif
+
+	// "-benchmark <scene>" runs a fixed flythrough instead of
+	// the game (see Benchmark.cpp)
+	BenchmarkSettings benchmark;
+	bool benchmarking = Benchmark::ParseCommandLine(lpCmdLine, benchmark);
+#if !defined(DEBUG) && !defined(_DEBUG) && !defined(GRAPHICS_NULL)
+	if (benchmarking)
+		Window::CreateConsoleWindow(500, 120, 32, 120);
+#endif
+
+	// Set up app initialization details
+	unsigned int windowWidth = 1280;
+	unsigned int windowHeight = 720;
+	bool vsync = false;
+#if !defined(GRAPHICS_NULL)
+	const wchar_t* windowTitle = L"Direct3D11 Game";
+	bool statsInTitleBar = true;
+#endif
+
+	// The main application object
+	game = new Game();
+
+	// Create the window and verify
+#if defined(GRAPHICS_NULL)
+	HRESULT windowResult = Window::CreateHeadless(windowWidth, windowHeight);
+#else
+	HRESULT windowResult = Window::Create(
+		hInstance,
+		windowWidth,
+		windowHeight,
+		windowTitle,
+		statsInTitleBar,
+		WindowResizeCallback);
+#endif
+	if (FAILED(windowResult))
+		return windowResult;
+
+	// Initialize the graphics API and verify
+	HRESULT graphicsResult = Graphics::Initialize(
+		Window::Width(), 
+		Window::Height(), 
+		Window::Handle(),
+		vsync);
+	if (FAILED(graphicsResult))
+		return graphicsResult;
+
+	// Initalize the input system, which requires the window handle
+	Input::Initialize(Window::Handle());
+
+	// State tracking sits on top of the graphics context
+	StateCache::Initialize();
+
+	// CPU timing markers, shown in the profiler window
+	Profiler::Initialize();
+
+	// "-trace" records markers from the first frame (F8 toggles
+	// a trace while running)
+	if (lpCmdLine && strstr(lpCmdLine, "-trace"))
+		TraceWriter::Start(FixPath("Trace"));
+
+	// Now the game itself can be initialzied
+	game->Initialize();
+
+#if defined(GRAPHICS_NULL)
+	// No messages to pump, just a fixed number of frames
+	int exitCode = benchmarking ? RunBenchmark(benchmark) : RunHeadless(FrameCountFromCommandLine(lpCmdLine));
+#else
+	// Time tracking
+	LARGE_INTEGER perfFreq{};
+	double perfSeconds = 0;
+	__int64 startTime = 0;
+	__int64 currentTime = 0;
+	__int64 previousTime = 0;
+
+	// Query for accurate timing information
+	QueryPerformanceFrequency(&perfFreq);
+	perfSeconds = 1.0 / (double)perfFreq.QuadPart;
+
+	// Performance Counter gives high-resolution time stamps
+	QueryPerformanceCounter((LARGE_INTEGER*)&startTime);
+	currentTime = startTime;
+	previousTime = startTime;
+
+	// Windows message loop (and our game loop), skipped when
+	// a benchmark runs its own frames instead
+	MSG msg = {};
+	while (!benchmarking && msg.message != WM_QUIT)
+	{
+		// Determine if there is a message from the operating system
+		if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+		{
+			// Translate and dispatch the message
+			// to our custom WindowProc function
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+		}
+		else
+		{
+			Profiler::BeginFrame();
+
+			// Calculate up-to-date timing info
+			QueryPerformanceCounter((LARGE_INTEGER*)&currentTime);
+			float deltaTime = max((float)((currentTime - previousTime) * perfSeconds), 0.0f);
+			float totalTime = (float)((currentTime - startTime) * perfSeconds);
+			previousTime = currentTime;
+			FrameTimes::Record(deltaTime * 1000.0f);
+
+			// Calculate basic fps
+			Window::UpdateStats(totalTime);
+
+			// Input updating
+			{
+				PROFILE_SCOPE("Input::Update");
+				Input::Update();
+			}
+
+			// Update and draw
+			game->Update(deltaTime, totalTime);
+			game->Draw(deltaTime, totalTime);
+
+			// Notify Input system about end of frame
+			Input::EndOfFrame();
+
+#if defined(DEBUG) || defined(_DEBUG)
+			// Print any graphics debug messages that occurred this frame
+			Graphics::PrintDebugMessages();
+#endif
+
+			// Collect this frame's timing markers and allocation counts
+			Profiler::EndFrame();
+			AllocationTracker::EndFrame();
+			PoolAllocator::EndFrame();
+			TraceWriter::WriteFrame(Profiler::GetLastFrame());
+		}
+	}
+	int exitCode = benchmarking ? RunBenchmark(benchmark) : (int)msg.wParam;
+#endif
+
+	// Every frame time still in the window, for a closer look
+	FrameTimes::WriteCSV(FixPath("FrameTimes.csv"));
+
+	// Clean up
+	delete game;
+	Input::ShutDown();
+	StateCache::ShutDown();
+	TraceWriter::ShutDown();
+	AllocationTracker::ShutDown();
+	Profiler::ShutDown();
+	RenderResources::ShutDown();
+	Graphics::ShutDown();
+	return exitCode;
+}
@@ -1,84 +1,220 @@
-#include "Mesh.h"
-#include "Graphics.h"
-#include "Vertex.h"
-
-Mesh::Mesh(size_t indiceCount, size_t verticeCount, Vertex* verticeArr, unsigned int* indiceArr, const char* name)
-{
-	
-	// Create a VERTEX BUFFER
-	{
-		D3D11_BUFFER_DESC vbd = {};
-		vbd.Usage = D3D11_USAGE_IMMUTABLE;	// Will NEVER change
-		vbd.ByteWidth = sizeof(Vertex) * (UINT)verticeCount;       // 3 = number of vertices in the buffer
-		vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER; // Tells Direct3D this is a vertex buffer
-		vbd.CPUAccessFlags = 0;	// Note: We cannot access the data from C++ (this is good)
-		vbd.MiscFlags = 0;
-		vbd.StructureByteStride = 0;
-
-		D3D11_SUBRESOURCE_DATA initialVertexData = {};
-		initialVertexData.pSysMem = verticeArr; // pSysMem = Pointer to System Memory
-		Graphics::Device->CreateBuffer(&vbd, &initialVertexData, vertexBuffer.GetAddressOf());
-	}
-
-	// Create an INDEX BUFFER
-	{
-		D3D11_BUFFER_DESC ibd = {};
-		ibd.Usage = D3D11_USAGE_IMMUTABLE;	// Will NEVER change
-		ibd.ByteWidth = sizeof(unsigned int) * (UINT)indiceCount;	// 3 = number of indices in the buffer
-		ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;	// Tells Direct3D this is an index buffer
-		ibd.CPUAccessFlags = 0;	// Note: We cannot access the data from C++ (this is good)
-		ibd.MiscFlags = 0;
-		ibd.StructureByteStride = 0;
-
-		// Specify the initial data for this buffer, similar to above
-		D3D11_SUBRESOURCE_DATA initialIndexData = {};
-		initialIndexData.pSysMem = indiceArr; // pSysMem = Pointer to System Memory
-		Graphics::Device->CreateBuffer(&ibd, &initialIndexData, indexBuffer.GetAddressOf());
-	}
-
-	this->indicesCount = (unsigned int)indiceCount;
-	this->verticesCount = (unsigned int)verticeCount;
-	this->name = name;
-}
-
-Mesh::~Mesh()
-{
-}
-
-Microsoft::WRL::ComPtr<ID3D11Buffer> Mesh::GetVertexBuffer()
-{
-	return vertexBuffer;
-}
-
-Microsoft::WRL::ComPtr<ID3D11Buffer> Mesh::GetIndexBuffer()
-{
-	return indexBuffer;
-}
-
-unsigned int Mesh::GetIndexCount()
-{
-	return indicesCount;
-}
-
-unsigned int Mesh::GetVertexCount()
-{
-	return verticesCount;
-}
-
-const char* Mesh::GetName()
-{
-	return name;
-}
-
-void Mesh::Draw()
-{	
-	UINT stride = sizeof(Vertex);
-	UINT offset = 0;
-	Graphics::Context->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
-	Graphics::Context->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-
-	Graphics::Context->DrawIndexed(
-		this->indicesCount,     // The number of indices to use (we could draw a subset if we wanted)
-		0,     // Offset to the first index we want to use
-		0);    // Offset to add to each index when looking up vertices
-}
+#include "Mesh.h"
+#include "Graphics.h"
+#include "RenderResources.h"
+#include "RenderStats.h"
+#include "Vertex.h"
+
+#include <cmath>
+#include <chrono>
+
+unsigned int Mesh::nextID = 0;
+
+Mesh::Mesh(size_t indiceCount, size_t verticeCount, Vertex* verticeArr, unsigned int* indiceArr, const char* name, bool buildBVH) :
+	bvhBuildTime(0.0)
+{
+	
+	// Create a VERTEX BUFFER
+	{
+		D3D11_BUFFER_DESC vbd = {};
+		vbd.Usage = D3D11_USAGE_IMMUTABLE;	// Will NEVER change
+		vbd.ByteWidth = sizeof(Vertex) * (UINT)verticeCount;       // 3 = number of vertices in the buffer
+		vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER; // Tells Direct3D this is a vertex buffer
+		vbd.CPUAccessFlags = 0;	// Note: We cannot access the data from C++ (this is good)
+		vbd.MiscFlags = 0;
+		vbd.StructureByteStride = 0;
+
+		D3D11_SUBRESOURCE_DATA initialVertexData = {};
+		initialVertexData.pSysMem = verticeArr; // pSysMem = Pointer to System Memory
+		Graphics::Device->CreateBuffer(&vbd, &initialVertexData, vertexBuffer.GetAddressOf());
+		RenderStats::CountBufferCreated();
+	}
+
+	// Create an INDEX BUFFER
+	{
+		D3D11_BUFFER_DESC ibd = {};
+		ibd.Usage = D3D11_USAGE_IMMUTABLE;	// Will NEVER change
+		ibd.ByteWidth = sizeof(unsigned int) * (UINT)indiceCount;	// 3 = number of indices in the buffer
+		ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;	// Tells Direct3D this is an index buffer
+		ibd.CPUAccessFlags = 0;	// Note: We cannot access the data from C++ (this is good)
+		ibd.MiscFlags = 0;
+		ibd.StructureByteStride = 0;
+
+		// Specify the initial data for this buffer, similar to above
+		D3D11_SUBRESOURCE_DATA initialIndexData = {};
+		initialIndexData.pSysMem = indiceArr; // pSysMem = Pointer to System Memory
+		Graphics::Device->CreateBuffer(&ibd, &initialIndexData, indexBuffer.GetAddressOf());
+		RenderStats::CountBufferCreated();
+	}
+
+	// Handles for recording draws into command streams
+	vertexBufferHandle = RenderResources::AddBuffer(vertexBuffer.Get());
+	indexBufferHandle = RenderResources::AddBuffer(indexBuffer.Get());
+
+	// Bounding sphere centered on the box around the vertices
+	{
+		DirectX::XMFLOAT3 minPos = verticeCount > 0 ? verticeArr[0].Position : DirectX::XMFLOAT3(0, 0, 0);
+		DirectX::XMFLOAT3 maxPos = minPos;
+		for (size_t i = 1; i < verticeCount; i++)
+		{
+			DirectX::XMFLOAT3 p = verticeArr[i].Position;
+			minPos = DirectX::XMFLOAT3(fminf(minPos.x, p.x), fminf(minPos.y, p.y), fminf(minPos.z, p.z));
+			maxPos = DirectX::XMFLOAT3(fmaxf(maxPos.x, p.x), fmaxf(maxPos.y, p.y), fmaxf(maxPos.z, p.z));
+		}
+
+		boundsCenter = DirectX::XMFLOAT3(
+			(minPos.x + maxPos.x) * 0.5f,
+			(minPos.y + maxPos.y) * 0.5f,
+			(minPos.z + maxPos.z) * 0.5f);
+
+		float maxDistSq = 0.0f;
+		for (size_t i = 0; i < verticeCount; i++)
+		{
+			float x = verticeArr[i].Position.x - boundsCenter.x;
+			float y = verticeArr[i].Position.y - boundsCenter.y;
+			float z = verticeArr[i].Position.z - boundsCenter.z;
+			maxDistSq = fmaxf(maxDistSq, x * x + y * y + z * z);
+		}
+		boundsRadius = sqrtf(maxDistSq);
+	}
+
+	this->indicesCount = (unsigned int)indiceCount;
+	this->verticesCount = (unsigned int)verticeCount;
+	this->name = name;
+	this->id = nextID++;
+
+	// Copy the triangles and build the picking BVH off the main thread
+	if (buildBVH)
+	{
+		positions.resize(verticeCount);
+		for (size_t i = 0; i < verticeCount; i++)
+			positions[i] = verticeArr[i].Position;
+		indices.assign(indiceArr, indiceArr + indiceCount);
+
+		bvhBuild = std::async(std::launch::async, [this]()
+			{
+				auto start = std::chrono::high_resolution_clock::now();
+				bvh.Build(positions, indices);
+				auto end = std::chrono::high_resolution_clock::now();
+				bvhBuildTime = std::chrono::duration<double>(end - start).count();
+			});
+	}
+}
+
+Mesh::~Mesh()
+{
+	// Don't tear down the data a build might still be using
+	if (bvhBuild.valid())
+		bvhBuild.wait();
+
+	RenderResources::RemoveBuffer(vertexBufferHandle);
+	RenderResources::RemoveBuffer(indexBufferHandle);
+}
+
+Microsoft::WRL::ComPtr<ID3D11Buffer> Mesh::GetVertexBuffer()
+{
+	return vertexBuffer;
+}
+
+Microsoft::WRL::ComPtr<ID3D11Buffer> Mesh::GetIndexBuffer()
+{
+	return indexBuffer;
+}
+
+unsigned int Mesh::GetIndexCount()
+{
+	return indicesCount;
+}
+
+unsigned int Mesh::GetVertexCount()
+{
+	return verticesCount;
+}
+
+const char* Mesh::GetName()
+{
+	return name;
+}
+
+unsigned int Mesh::GetID()
+{
+	return id;
+}
+
+DirectX::XMFLOAT3 Mesh::GetBoundsCenter()
+{
+	return boundsCenter;
+}
+
+float Mesh::GetBoundsRadius()
+{
+	return boundsRadius;
+}
+
+void Mesh::Draw(RenderCommandStream& stream)
+{	
+	unsigned int stride = sizeof(Vertex);
+	unsigned int offset = 0;
+	stream.SetVertexBuffers(0, 1, &vertexBufferHandle, &stride, &offset);
+	stream.SetIndexBuffer(indexBufferHandle, DXGI_FORMAT_R32_UINT, 0);
+
+	stream.DrawIndexed(
+		this->indicesCount,     // The number of indices to use (we could draw a subset if we wanted)
+		0,     // Offset to the first index we want to use
+		0);    // Offset to add to each index when looking up vertices
+}
+
+// Draws straight into a specific context (like a deferred
+// one on a worker thread) instead of a command stream
+void Mesh::Draw(ID3D11DeviceContext* context)
+{
+	UINT stride = sizeof(Vertex);
+	UINT offset = 0;
+	context->IASetVertexBuffers(0, 1, vertexBuffer.GetAddressOf(), &stride, &offset);
+	context->IASetIndexBuffer(indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+	context->DrawIndexed(this->indicesCount, 0, 0);
+	RenderStats::CountBinds(2);
+	RenderStats::CountDraw(this->indicesCount);
+}
+
+void Mesh::DrawInstanced(RenderCommandStream& stream, ResourceHandle instanceBuffer, unsigned int instanceStride, unsigned int instanceCount, unsigned int startInstance)
+{
+	// Slot 0 is the mesh, slot 1 is the instance data
+	ResourceHandle buffers[2] = { vertexBufferHandle, instanceBuffer };
+	unsigned int strides[2] = { sizeof(Vertex), instanceStride };
+	unsigned int offsets[2] = { 0, 0 };
+	stream.SetVertexBuffers(0, 2, buffers, strides, offsets);
+	stream.SetIndexBuffer(indexBufferHandle, DXGI_FORMAT_R32_UINT, 0);
+
+	stream.DrawIndexedInstanced(
+		this->indicesCount,	// Indices per instance
+		instanceCount,		// How many copies
+		0,					// First index
+		0,					// Offset added to each index
+		startInstance);		// First entry in the instance buffer
+}
+
+bool Mesh::HasBVH()
+{
+	return bvhBuild.valid();
+}
+
+bool Mesh::Raycast(DirectX::XMFLOAT3 origin, DirectX::XMFLOAT3 direction, RayHit& hit, float maxDistance)
+{
+	if (!bvhBuild.valid())
+		return false;
+
+	bvhBuild.wait();
+	return bvh.Raycast(origin, direction, hit, maxDistance);
+}
+
+bool Mesh::IsBVHReady()
+{
+	return bvhBuild.valid() && bvhBuild.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+double Mesh::GetBVHBuildTime()
+{
+	if (bvhBuild.valid())
+		bvhBuild.wait();
+	return bvhBuildTime;
+}
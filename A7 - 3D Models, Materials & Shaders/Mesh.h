@@ -1,32 +1,77 @@
-#pragma once
-
-#include <d3d11.h>
-#include <wrl/client.h>
-
-#include "Vertex.h"
-
-
-class Mesh
-{
-
-public:
-	Mesh(size_t indiceCount,size_t verticeCount, Vertex* verticeArr, unsigned int* indicesArr, const char* name);
-
-	~Mesh();
-
-	Microsoft::WRL::ComPtr<ID3D11Buffer> GetVertexBuffer();
-	Microsoft::WRL::ComPtr<ID3D11Buffer> GetIndexBuffer();
-	unsigned int GetIndexCount();
-	unsigned int GetVertexCount();
-	const char* GetName();
-	void Draw();
-
-	
-private:
-	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
-	Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
-	unsigned int indicesCount;
-	unsigned int verticesCount;
-	const char* name;
-};
-
+#pragma once
+
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <DirectXMath.h>
+#include <vector>
+#include <future>
+
+#include "Vertex.h"
+#include "MeshBVH.h"
+#include "RenderCommands.h"
+
+
+class Mesh
+{
+
+public:
+	// Pass buildBVH = true to keep a CPU copy of the triangles
+	// for Raycast().  The BVH is built on a worker thread
+	Mesh(size_t indiceCount,size_t verticeCount, Vertex* verticeArr, unsigned int* indicesArr, const char* name, bool buildBVH = false);
+
+	~Mesh();
+
+	Microsoft::WRL::ComPtr<ID3D11Buffer> GetVertexBuffer();
+	Microsoft::WRL::ComPtr<ID3D11Buffer> GetIndexBuffer();
+	unsigned int GetIndexCount();
+	unsigned int GetVertexCount();
+	const char* GetName();
+	unsigned int GetID();
+
+	// Local space bounding sphere around every vertex
+	DirectX::XMFLOAT3 GetBoundsCenter();
+	float GetBoundsRadius();
+
+	void Draw(RenderCommandStream& stream);
+	void Draw(ID3D11DeviceContext* context);
+
+	// Draws instanceCount copies, reading per-instance data
+	// from instanceBuffer starting at startInstance
+	void DrawInstanced(RenderCommandStream& stream, ResourceHandle instanceBuffer, unsigned int instanceStride, unsigned int instanceCount, unsigned int startInstance);
+
+	// Exact ray test against the triangles, in local space.
+	// Waits for the BVH if it's still building
+	bool HasBVH();
+	bool Raycast(DirectX::XMFLOAT3 origin, DirectX::XMFLOAT3 direction, RayHit& hit, float maxDistance = FLT_MAX);
+
+	// True once the worker has finished, without waiting.  The
+	// build time waits like Raycast() does, so per-frame UI
+	// should check this first
+	bool IsBVHReady();
+	double GetBVHBuildTime();
+
+	
+private:
+	Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
+	Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
+	ResourceHandle vertexBufferHandle;
+	ResourceHandle indexBufferHandle;
+	unsigned int indicesCount;
+	unsigned int verticesCount;
+	const char* name;
+
+	// Small unique number used to group draws by mesh
+	unsigned int id;
+	static unsigned int nextID;
+
+	DirectX::XMFLOAT3 boundsCenter;
+	float boundsRadius;
+
+	// Picking data, only filled in when requested
+	std::vector<DirectX::XMFLOAT3> positions;
+	std::vector<unsigned int> indices;
+	MeshBVH bvh;
+	std::future<void> bvhBuild;
+	double bvhBuildTime;
+};
+
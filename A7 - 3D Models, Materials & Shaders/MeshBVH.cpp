@@ -0,0 +1,382 @@
+#include "MeshBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <xmmintrin.h>
+
+using namespace DirectX;
+
+namespace
+{
+	const unsigned int MaxLeafTriangles = 4;
+	const unsigned int SAHBins = 12;
+
+	// Past this depth splits fall back to the median, which
+	// bounds the tree depth (and the traversal stack) even
+	// for meshes the SAH handles badly
+	const unsigned int MaxSAHDepth = 40;
+	const unsigned int TraversalStackSize = 96;
+
+	// Plain compares instead of fminf/fmaxf, which may be
+	// library calls to get NaN handling we don't need
+	inline float Min(float a, float b) { return a < b ? a : b; }
+	inline float Max(float a, float b) { return a > b ? a : b; }
+
+	struct Bounds
+	{
+		XMFLOAT3 min;
+		XMFLOAT3 max;
+
+		Bounds() :
+			min(FLT_MAX, FLT_MAX, FLT_MAX),
+			max(-FLT_MAX, -FLT_MAX, -FLT_MAX) {}
+
+		void Grow(XMFLOAT3 p)
+		{
+			min = XMFLOAT3(Min(min.x, p.x), Min(min.y, p.y), Min(min.z, p.z));
+			max = XMFLOAT3(Max(max.x, p.x), Max(max.y, p.y), Max(max.z, p.z));
+		}
+
+		void Grow(const Bounds& b)
+		{
+			Grow(b.min);
+			Grow(b.max);
+		}
+
+		float Area() const
+		{
+			float x = max.x - min.x;
+			float y = max.y - min.y;
+			float z = max.z - min.z;
+			if (x < 0 || y < 0 || z < 0) return 0.0f;
+			return x * y + y * z + z * x;
+		}
+	};
+
+	float Axis(const XMFLOAT3& v, int axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	XMFLOAT3 Sub(XMFLOAT3 a, XMFLOAT3 b) { return XMFLOAT3(a.x - b.x, a.y - b.y, a.z - b.z); }
+}
+
+MeshBVH::MeshBVH() :
+	buildPositions(0),
+	buildIndices(0),
+	triangleCount(0)
+{
+}
+
+void MeshBVH::Build(const std::vector<DirectX::XMFLOAT3>& positions, const std::vector<unsigned int>& indices)
+{
+	nodes.clear();
+	blocks.clear();
+	triangleCount = (unsigned int)(indices.size() / 3);
+	if (triangleCount == 0)
+		return;
+
+	buildPositions = &positions;
+	buildIndices = &indices;
+
+	std::vector<BuildTriangle> tris(triangleCount);
+	for (unsigned int i = 0; i < triangleCount; i++)
+	{
+		Bounds b;
+		b.Grow(positions[indices[i * 3 + 0]]);
+		b.Grow(positions[indices[i * 3 + 1]]);
+		b.Grow(positions[indices[i * 3 + 2]]);
+
+		tris[i].min = b.min;
+		tris[i].max = b.max;
+		tris[i].centroid = XMFLOAT3(
+			(b.min.x + b.max.x) * 0.5f,
+			(b.min.y + b.max.y) * 0.5f,
+			(b.min.z + b.max.z) * 0.5f);
+		tris[i].index = i;
+	}
+
+	// A binary tree with at most one triangle per leaf has
+	// fewer than 2n nodes, so this never reallocates
+	nodes.reserve(triangleCount * 2);
+	blocks.reserve(triangleCount / MaxLeafTriangles + triangleCount);
+	nodes.push_back({});
+	Subdivide(0, tris, 0, triangleCount, 0);
+
+	buildPositions = 0;
+	buildIndices = 0;
+}
+
+// --------------------------------------------------------
+// Splits a node where the surface area heuristic says a ray
+// is least likely to visit both halves.  Triangle centroids
+// are dropped into a few bins per axis, and only the bin
+// boundaries are considered as split planes
+// --------------------------------------------------------
+void MeshBVH::Subdivide(unsigned int nodeIndex, std::vector<BuildTriangle>& tris, unsigned int first, unsigned int count, unsigned int depth)
+{
+	Bounds bounds;
+	Bounds centroidBounds;
+	for (unsigned int i = first; i < first + count; i++)
+	{
+		bounds.Grow(tris[i].min);
+		bounds.Grow(tris[i].max);
+		centroidBounds.Grow(tris[i].centroid);
+	}
+	nodes[nodeIndex].min = bounds.min;
+	nodes[nodeIndex].max = bounds.max;
+
+	if (count <= MaxLeafTriangles)
+	{
+		MakeLeaf(nodeIndex, tris, first, count);
+		return;
+	}
+
+	// Find the cheapest bin boundary on any axis
+	int bestAxis = -1;
+	unsigned int bestSplit = 0;
+	float bestCost = FLT_MAX;
+	for (int axis = 0; axis < 3 && depth < MaxSAHDepth; axis++)
+	{
+		float axisMin = Axis(centroidBounds.min, axis);
+		float extent = Axis(centroidBounds.max, axis) - axisMin;
+		if (extent <= 0.0f)
+			continue;
+
+		Bounds binBounds[SAHBins];
+		unsigned int binCount[SAHBins] = {};
+		float scale = SAHBins / extent;
+		for (unsigned int i = first; i < first + count; i++)
+		{
+			unsigned int bin = std::min(SAHBins - 1, (unsigned int)((Axis(tris[i].centroid, axis) - axisMin) * scale));
+			binCount[bin]++;
+			Bounds tb;
+			tb.min = tris[i].min;
+			tb.max = tris[i].max;
+			binBounds[bin].Grow(tb);
+		}
+
+		// Sweep from the left, then from the right
+		float leftArea[SAHBins - 1];
+		unsigned int leftCount[SAHBins - 1];
+		Bounds leftBox;
+		unsigned int leftSum = 0;
+		for (unsigned int b = 0; b < SAHBins - 1; b++)
+		{
+			leftSum += binCount[b];
+			leftBox.Grow(binBounds[b]);
+			leftCount[b] = leftSum;
+			leftArea[b] = leftBox.Area();
+		}
+
+		Bounds rightBox;
+		unsigned int rightSum = 0;
+		for (unsigned int b = SAHBins - 1; b > 0; b--)
+		{
+			rightSum += binCount[b];
+			rightBox.Grow(binBounds[b]);
+			if (leftCount[b - 1] == 0 || rightSum == 0)
+				continue;
+
+			float cost = leftCount[b - 1] * leftArea[b - 1] + rightSum * rightBox.Area();
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b;
+			}
+		}
+	}
+
+	unsigned int leftCount = 0;
+	if (bestAxis >= 0)
+	{
+		float axisMin = Axis(centroidBounds.min, bestAxis);
+		float scale = SAHBins / (Axis(centroidBounds.max, bestAxis) - axisMin);
+		auto middle = std::partition(tris.begin() + first, tris.begin() + first + count,
+			[&](const BuildTriangle& t)
+			{
+				unsigned int bin = std::min(SAHBins - 1, (unsigned int)((Axis(t.centroid, bestAxis) - axisMin) * scale));
+				return bin < bestSplit;
+			});
+		leftCount = (unsigned int)(middle - (tris.begin() + first));
+	}
+
+	// Too deep, or all centroids in the same spot, so cut at
+	// the median of the longest axis to keep leaves small
+	if (leftCount == 0 || leftCount == count)
+	{
+		XMFLOAT3 extent = Sub(centroidBounds.max, centroidBounds.min);
+		int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+		leftCount = count / 2;
+		std::nth_element(tris.begin() + first, tris.begin() + first + leftCount, tris.begin() + first + count,
+			[axis](const BuildTriangle& a, const BuildTriangle& b) { return Axis(a.centroid, axis) < Axis(b.centroid, axis); });
+	}
+
+	unsigned int left = (unsigned int)nodes.size();
+	nodes.push_back({});
+	nodes.push_back({});
+	nodes[nodeIndex].leftOrFirst = left;
+	nodes[nodeIndex].count = 0;
+
+	Subdivide(left, tris, first, leftCount, depth + 1);
+	Subdivide(left + 1, tris, first + leftCount, count - leftCount, depth + 1);
+}
+
+void MeshBVH::MakeLeaf(unsigned int nodeIndex, const std::vector<BuildTriangle>& tris, unsigned int first, unsigned int count)
+{
+	const std::vector<XMFLOAT3>& positions = *buildPositions;
+	const std::vector<unsigned int>& indices = *buildIndices;
+
+	TriangleBlock block = {};
+	for (unsigned int lane = 0; lane < count; lane++)
+	{
+		unsigned int t = tris[first + lane].index;
+		XMFLOAT3 v0 = positions[indices[t * 3 + 0]];
+		XMFLOAT3 e1 = Sub(positions[indices[t * 3 + 1]], v0);
+		XMFLOAT3 e2 = Sub(positions[indices[t * 3 + 2]], v0);
+
+		block.v0x[lane] = v0.x; block.v0y[lane] = v0.y; block.v0z[lane] = v0.z;
+		block.e1x[lane] = e1.x; block.e1y[lane] = e1.y; block.e1z[lane] = e1.z;
+		block.e2x[lane] = e2.x; block.e2y[lane] = e2.y; block.e2z[lane] = e2.z;
+		block.triangle[lane] = t;
+	}
+
+	nodes[nodeIndex].leftOrFirst = (unsigned int)blocks.size();
+	nodes[nodeIndex].count = count;
+	blocks.push_back(block);
+}
+
+
+// --------------------------------------------------------
+// Walks the tree nearest child first, skipping any box that
+// starts farther away than the closest hit so far
+// --------------------------------------------------------
+bool MeshBVH::Raycast(DirectX::XMFLOAT3 origin, DirectX::XMFLOAT3 direction, RayHit& hit, float maxDistance) const
+{
+	if (nodes.empty())
+		return false;
+
+	XMFLOAT3 invDir(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+	// Slab test, returning the entry distance or a miss
+	auto boxDistance = [&](const Node& n, float closest)
+	{
+		float tx1 = (n.min.x - origin.x) * invDir.x, tx2 = (n.max.x - origin.x) * invDir.x;
+		float ty1 = (n.min.y - origin.y) * invDir.y, ty2 = (n.max.y - origin.y) * invDir.y;
+		float tz1 = (n.min.z - origin.z) * invDir.z, tz2 = (n.max.z - origin.z) * invDir.z;
+		float tmin = Max(Max(Min(tx1, tx2), Min(ty1, ty2)), Max(Min(tz1, tz2), 0.0f));
+		float tmax = Min(Min(Max(tx1, tx2), Max(ty1, ty2)), Min(Max(tz1, tz2), closest));
+		return tmin <= tmax ? tmin : FLT_MAX;
+	};
+
+	// Ray broadcast to all four lanes
+	const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y), oz = _mm_set1_ps(origin.z);
+	const __m128 dx = _mm_set1_ps(direction.x), dy = _mm_set1_ps(direction.y), dz = _mm_set1_ps(direction.z);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 epsilon = _mm_set1_ps(1e-9f);
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+	float closest = maxDistance;
+	bool found = false;
+
+	unsigned int stack[TraversalStackSize];
+	unsigned int stackSize = 0;
+	unsigned int current = 0;
+	if (boxDistance(nodes[0], closest) == FLT_MAX)
+		return false;
+
+	while (true)
+	{
+		const Node& node = nodes[current];
+		if (node.count > 0)
+		{
+			// Moller-Trumbore on the leaf's four triangles at once
+			const TriangleBlock& b = blocks[node.leftOrFirst];
+			__m128 e1x = _mm_load_ps(b.e1x), e1y = _mm_load_ps(b.e1y), e1z = _mm_load_ps(b.e1z);
+			__m128 e2x = _mm_load_ps(b.e2x), e2y = _mm_load_ps(b.e2y), e2z = _mm_load_ps(b.e2z);
+
+			// p = d x e2, det = e1 . p
+			__m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+			__m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+			__m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+			__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+			__m128 invDet = _mm_div_ps(one, det);
+
+			// s = o - v0, u = (s . p) / det
+			__m128 sx = _mm_sub_ps(ox, _mm_load_ps(b.v0x));
+			__m128 sy = _mm_sub_ps(oy, _mm_load_ps(b.v0y));
+			__m128 sz = _mm_sub_ps(oz, _mm_load_ps(b.v0z));
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+			// q = s x e1, v = (d . q) / det, t = (e2 . q) / det
+			__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+			__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+			__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+			__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+			__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+			__m128 valid = _mm_cmpgt_ps(_mm_and_ps(det, absMask), epsilon);
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+			valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(t, zero));
+			valid = _mm_and_ps(valid, _mm_cmplt_ps(t, _mm_set1_ps(closest)));
+
+			int mask = _mm_movemask_ps(valid);
+			if (mask)
+			{
+				alignas(16) float ts[4], us[4], vs[4];
+				_mm_store_ps(ts, t);
+				_mm_store_ps(us, u);
+				_mm_store_ps(vs, v);
+				for (int lane = 0; lane < 4; lane++)
+				{
+					if ((mask & (1 << lane)) && ts[lane] < closest)
+					{
+						closest = ts[lane];
+						hit.distance = ts[lane];
+						hit.triangle = b.triangle[lane];
+						hit.u = us[lane];
+						hit.v = vs[lane];
+						found = true;
+					}
+				}
+			}
+
+			if (stackSize == 0) break;
+			current = stack[--stackSize];
+			continue;
+		}
+
+		// Visit the nearer child first and save the other
+		unsigned int nearChild = node.leftOrFirst;
+		unsigned int farChild = node.leftOrFirst + 1;
+		float nearDist = boxDistance(nodes[nearChild], closest);
+		float farDist = boxDistance(nodes[farChild], closest);
+		if (farDist < nearDist)
+		{
+			std::swap(nearChild, farChild);
+			std::swap(nearDist, farDist);
+		}
+
+		if (nearDist == FLT_MAX)
+		{
+			if (stackSize == 0) break;
+			current = stack[--stackSize];
+			continue;
+		}
+
+		current = nearChild;
+		if (farDist != FLT_MAX)
+			stack[stackSize++] = farChild;
+	}
+
+	return found;
+}
+
+unsigned int MeshBVH::GetNodeCount() const { return (unsigned int)nodes.size(); }
+unsigned int MeshBVH::GetTriangleCount() const { return triangleCount; }
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <vector>
+#include <cfloat>
+
+// Closest hit along a ray
+struct RayHit
+{
+	float distance;			// In units of the ray direction's length
+	unsigned int triangle;	// Index of the triangle (first index / 3)
+	float u;				// Barycentrics, so the hit point is
+	float v;				// v0 * (1 - u - v) + v1 * u + v2 * v
+};
+
+// --------------------------------------------------------
+// Triangle bounding volume hierarchy for exact CPU picking
+//
+// Built top-down with binned SAH splits and packed into
+// 32-byte nodes.  Every leaf holds at most four triangles,
+// stored together so one SSE Moller-Trumbore test covers
+// the whole leaf
+//
+// Tools/MicroBenchmarks times the build and raycasts for
+// each model in Assets/Models
+// --------------------------------------------------------
+class MeshBVH
+{
+public:
+	MeshBVH();
+
+	void Build(const std::vector<DirectX::XMFLOAT3>& positions, const std::vector<unsigned int>& indices);
+
+	// Returns true and fills in hit if the ray hits anything
+	// closer than maxDistance
+	bool Raycast(DirectX::XMFLOAT3 origin, DirectX::XMFLOAT3 direction, RayHit& hit, float maxDistance = FLT_MAX) const;
+
+	unsigned int GetNodeCount() const;
+	unsigned int GetTriangleCount() const;
+
+private:
+	struct Node
+	{
+		DirectX::XMFLOAT3 min;
+		unsigned int leftOrFirst;	// Left child index, or leaf block index
+		DirectX::XMFLOAT3 max;
+		unsigned int count;			// Triangles in a leaf, 0 for interior nodes
+	};
+
+	// Four triangles in structure-of-arrays form, with edges
+	// precomputed.  Unused lanes are left degenerate so they
+	// can never report a hit
+	struct alignas(16) TriangleBlock
+	{
+		float v0x[4], v0y[4], v0z[4];
+		float e1x[4], e1y[4], e1z[4];
+		float e2x[4], e2y[4], e2z[4];
+		unsigned int triangle[4];
+	};
+
+	// Per-triangle data only needed while building
+	struct BuildTriangle
+	{
+		DirectX::XMFLOAT3 min;
+		DirectX::XMFLOAT3 max;
+		DirectX::XMFLOAT3 centroid;
+		unsigned int index;
+	};
+
+	void Subdivide(unsigned int nodeIndex, std::vector<BuildTriangle>& tris, unsigned int first, unsigned int count, unsigned int depth);
+	void MakeLeaf(unsigned int nodeIndex, const std::vector<BuildTriangle>& tris, unsigned int first, unsigned int count);
+
+	std::vector<Node> nodes;
+	std::vector<TriangleBlock> blocks;
+
+	// Kept only for building leaf blocks
+	const std::vector<DirectX::XMFLOAT3>* buildPositions;
+	const std::vector<unsigned int>* buildIndices;
+
+	unsigned int triangleCount;
+};
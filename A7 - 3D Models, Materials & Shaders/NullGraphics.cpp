@@ -0,0 +1,918 @@
+#include "NullGraphics.h"
+
+#if defined(GRAPHICS_NULL)
+
+#include <wrl/client.h>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace NullGraphics
+{
+	// Annonymous namespace to hold variables
+	// only accessible in this file
+	namespace
+	{
+		// Every format this project creates is 32 bits per texel
+		const unsigned int BytesPerTexel = 4;
+		const unsigned int MaxViewports = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+
+		NullGraphicsStats stats = {};
+		ID3D11Device* device = 0;
+
+		// ----------------------------------------------------
+		// IUnknown for all of the objects below.  Each level of
+		// the class hierarchy adds the interfaces it answers to
+		// by overriding Supports()
+		// ----------------------------------------------------
+		template<typename Interface>
+		class NullUnknown : public Interface
+		{
+		public:
+			virtual ~NullUnknown() {}
+
+			ULONG STDMETHODCALLTYPE AddRef() override { return ++refCount; }
+			ULONG STDMETHODCALLTYPE Release() override
+			{
+				ULONG count = --refCount;
+				if (count == 0)
+					delete this;
+				return count;
+			}
+
+			HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+			{
+				if (!object)
+					return E_POINTER;
+
+				if (!Supports(riid))
+				{
+					*object = 0;
+					return E_NOINTERFACE;
+				}
+
+				*object = static_cast<Interface*>(this);
+				AddRef();
+				return S_OK;
+			}
+
+		protected:
+			virtual bool Supports(REFIID riid) { return riid == __uuidof(IUnknown) || riid == __uuidof(Interface); }
+
+		private:
+			std::atomic<ULONG> refCount{ 1 };
+		};
+
+		// Private data is accepted and thrown away
+		template<typename Interface>
+		class NullDeviceChild : public NullUnknown<Interface>
+		{
+		public:
+			void STDMETHODCALLTYPE GetDevice(ID3D11Device** outDevice) override
+			{
+				*outDevice = device;
+				if (device)
+					device->AddRef();
+			}
+			HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) override { return DXGI_ERROR_NOT_FOUND; }
+			HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) override { return S_OK; }
+			HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) override { return S_OK; }
+
+		protected:
+			bool Supports(REFIID riid) override { return riid == __uuidof(ID3D11DeviceChild) || NullUnknown<Interface>::Supports(riid); }
+		};
+
+		template<typename Interface>
+		class NullResource : public NullDeviceChild<Interface>
+		{
+		public:
+			NullResource(unsigned long long sizeInBytes) : sizeInBytes(sizeInBytes)
+			{
+				stats.resourcesCreated++;
+				stats.bytesAllocated += sizeInBytes;
+				stats.liveBytes += sizeInBytes;
+			}
+			~NullResource() { stats.liveBytes -= sizeInBytes; }
+
+			void STDMETHODCALLTYPE SetEvictionPriority(UINT priority) override {}
+			UINT STDMETHODCALLTYPE GetEvictionPriority() override { return DXGI_RESOURCE_PRIORITY_NORMAL; }
+
+		protected:
+			bool Supports(REFIID riid) override { return riid == __uuidof(ID3D11Resource) || NullDeviceChild<Interface>::Supports(riid); }
+
+		private:
+			unsigned long long sizeInBytes;
+		};
+
+		// ----------------------------------------------------
+		// Buffers keep real system memory, so writes through
+		// Map() and UpdateSubresource() land somewhere and cost
+		// what a memcpy costs
+		// ----------------------------------------------------
+		class NullBuffer : public NullResource<ID3D11Buffer>
+		{
+		public:
+			NullBuffer(const D3D11_BUFFER_DESC& desc, const D3D11_SUBRESOURCE_DATA* initialData) :
+				NullResource<ID3D11Buffer>(desc.ByteWidth),
+				desc(desc),
+				memory(desc.ByteWidth)
+			{
+				if (initialData && initialData->pSysMem)
+					memcpy(memory.data(), initialData->pSysMem, desc.ByteWidth);
+			}
+
+			void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) override { *dimension = D3D11_RESOURCE_DIMENSION_BUFFER; }
+			void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* outDesc) override { *outDesc = desc; }
+
+			unsigned char* GetMemory() { return memory.data(); }
+			UINT GetByteWidth() { return desc.ByteWidth; }
+
+		private:
+			D3D11_BUFFER_DESC desc;
+			std::vector<unsigned char> memory;
+		};
+
+		// Textures are never read back, so only their size is recorded
+		class NullTexture2D : public NullResource<ID3D11Texture2D>
+		{
+		public:
+			NullTexture2D(const D3D11_TEXTURE2D_DESC& desc) :
+				NullResource<ID3D11Texture2D>((unsigned long long)desc.Width * desc.Height * desc.ArraySize * BytesPerTexel),
+				desc(desc)
+			{
+			}
+
+			void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) override { *dimension = D3D11_RESOURCE_DIMENSION_TEXTURE2D; }
+			void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE2D_DESC* outDesc) override { *outDesc = desc; }
+
+		private:
+			D3D11_TEXTURE2D_DESC desc;
+		};
+
+		template<typename Interface, typename Desc>
+		class NullView : public NullDeviceChild<Interface>
+		{
+		public:
+			NullView(ID3D11Resource* resource, const Desc& desc) : resource(resource), desc(desc) {}
+
+			void STDMETHODCALLTYPE GetResource(ID3D11Resource** outResource) override
+			{
+				*outResource = resource.Get();
+				resource->AddRef();
+			}
+			void STDMETHODCALLTYPE GetDesc(Desc* outDesc) override { *outDesc = desc; }
+
+		protected:
+			bool Supports(REFIID riid) override { return riid == __uuidof(ID3D11View) || NullDeviceChild<Interface>::Supports(riid); }
+
+		private:
+			Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+			Desc desc;
+		};
+
+		// Shaders and input layouts have nothing to look at
+		template<typename Interface>
+		class NullObject : public NullDeviceChild<Interface>
+		{
+		};
+
+		// ----------------------------------------------------
+		// The immediate context.  Every call is counted; draws
+		// and uploads are counted in more detail
+		// ----------------------------------------------------
+		class NullContext : public NullDeviceChild<ID3D11DeviceContext>
+		{
+		public:
+			NullContext() : viewportCount(0), viewports{} {}
+
+			void STDMETHODCALLTYPE VSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) override { Count(); }
+			void STDMETHODCALLTYPE PSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) override { Count(); }
+			void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) override { Count(); }
+			void STDMETHODCALLTYPE PSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override { Count(); }
+			void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) override { Count(); }
+
+			void STDMETHODCALLTYPE DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) override
+			{
+				Count();
+				stats.draws++;
+				stats.indices += indexCount;
+			}
+
+			void STDMETHODCALLTYPE Draw(UINT vertexCount, UINT startVertexLocation) override
+			{
+				Count();
+				stats.draws++;
+			}
+
+			HRESULT STDMETHODCALLTYPE Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource) override
+			{
+				Count();
+				NullBuffer* buffer = AsBuffer(resource);
+				if (!buffer || !mappedResource)
+					return E_INVALIDARG;
+
+				// The whole buffer is handed out, so count all of it
+				mappedResource->pData = buffer->GetMemory();
+				mappedResource->RowPitch = buffer->GetByteWidth();
+				mappedResource->DepthPitch = buffer->GetByteWidth();
+				stats.maps++;
+				stats.bytesUploaded += buffer->GetByteWidth();
+				return S_OK;
+			}
+
+			void STDMETHODCALLTYPE Unmap(ID3D11Resource* resource, UINT subresource) override { Count(); }
+			void STDMETHODCALLTYPE PSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) override { Count(); }
+			void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout* inputLayout) override { Count(); }
+			void STDMETHODCALLTYPE IASetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets) override { Count(); }
+			void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) override { Count(); }
+
+			void STDMETHODCALLTYPE DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation) override
+			{
+				Count();
+				stats.draws++;
+				stats.indices += (unsigned long long)indexCountPerInstance * instanceCount;
+				stats.instances += instanceCount;
+			}
+
+			void STDMETHODCALLTYPE DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation) override
+			{
+				Count();
+				stats.draws++;
+				stats.instances += instanceCount;
+			}
+
+			void STDMETHODCALLTYPE GSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) override { Count(); }
+			void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) override { Count(); }
+			void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) override { Count(); }
+			void STDMETHODCALLTYPE VSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) override { Count(); }
+			void STDMETHODCALLTYPE VSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override { Count(); }
+			void STDMETHODCALLTYPE Begin(ID3D11Asynchronous* async) override { Count(); }
+			void STDMETHODCALLTYPE End(ID3D11Asynchronous* async) override { Count(); }
+			HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous* async, void* data, UINT dataSize, UINT getDataFlags) override { Count(); return S_OK; }
+			void STDMETHODCALLTYPE SetPredication(ID3D11Predicate* predicate, BOOL predicateValue) override { Count(); }
+			void STDMETHODCALLTYPE GSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) override { Count(); }
+			void STDMETHODCALLTYPE GSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override { Count(); }
+			void STDMETHODCALLTYPE OMSetRenderTargets(UINT numViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView) override { Count(); }
+			void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(UINT numRTVs, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView, UINT uavStartSlot, UINT numUAVs, ID3D11UnorderedAccessView* const* unorderedAccessViews, const UINT* uavInitialCounts) override { Count(); }
+			void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) override { Count(); }
+			void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) override { Count(); }
+			void STDMETHODCALLTYPE SOSetTargets(UINT numBuffers, ID3D11Buffer* const* targets, const UINT* offsets) override { Count(); }
+
+			void STDMETHODCALLTYPE DrawAuto() override
+			{
+				Count();
+				stats.draws++;
+			}
+
+			void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer* bufferForArgs, UINT alignedByteOffsetForArgs) override
+			{
+				Count();
+				stats.draws++;
+			}
+
+			void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer* bufferForArgs, UINT alignedByteOffsetForArgs) override
+			{
+				Count();
+				stats.draws++;
+			}
+
+			void STDMETHODCALLTYPE Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ) override { Count(); }
+			void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer* bufferForArgs, UINT alignedByteOffsetForArgs) override { Count(); }
+			void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState* rasterizerState) override { Count(); }
+
+			void STDMETHODCALLTYPE RSSetViewports(UINT numViewports, const D3D11_VIEWPORT* viewports) override
+			{
+				Count();
+				viewportCount = numViewports < MaxViewports ? numViewports : MaxViewports;
+				for (UINT i = 0; i < viewportCount; i++)
+					this->viewports[i] = viewports[i];
+			}
+
+			void STDMETHODCALLTYPE RSSetScissorRects(UINT numRects, const D3D11_RECT* rects) override { Count(); }
+			void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource* dstResource, UINT dstSubresource, UINT dstX, UINT dstY, UINT dstZ, ID3D11Resource* srcResource, UINT srcSubresource, const D3D11_BOX* srcBox) override { Count(); }
+			void STDMETHODCALLTYPE CopyResource(ID3D11Resource* dstResource, ID3D11Resource* srcResource) override { Count(); }
+
+			void STDMETHODCALLTYPE UpdateSubresource(ID3D11Resource* dstResource, UINT dstSubresource, const D3D11_BOX* dstBox, const void* srcData, UINT srcRowPitch, UINT srcDepthPitch) override
+			{
+				Count();
+				NullBuffer* buffer = AsBuffer(dstResource);
+				if (!buffer || !srcData)
+					return;
+
+				UINT start = dstBox ? dstBox->left : 0;
+				UINT end = dstBox ? dstBox->right : buffer->GetByteWidth();
+				if (end > buffer->GetByteWidth() || start >= end)
+					return;
+
+				memcpy(buffer->GetMemory() + start, srcData, end - start);
+				stats.bytesUploaded += end - start;
+			}
+
+			void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer* dstBuffer, UINT dstAlignedByteOffset, ID3D11UnorderedAccessView* srcView) override { Count(); }
+			void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) override { Count(); }
+			void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView* unorderedAccessView, const UINT values[4]) override { Count(); }
+			void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView* unorderedAccessView, const FLOAT values[4]) override { Count(); }
+			void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil) override { Count(); }
+			void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView* shaderResourceView) override { Count(); }
+			void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource* resource, FLOAT minLOD) override { Count(); }
+			FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource* resource) override { Count(); return 0.0f; }
+			void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource* dstResource, UINT dstSubresource, ID3D11Resource* srcResource, UINT srcSubresource, DXGI_FORMAT format) override { Count(); }
+			void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList* commandList, BOOL restoreContextState) override { Count(); }
+			void STDMETHODCALLTYPE HSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) override { Count(); }
+			void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) override { Count(); }
+			void STDMETHODCALLTYPE HSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override { Count(); }
+			void STDMETHODCALLTYPE HSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) override { Count(); }
+			void STDMETHODCALLTYPE DSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) override { Count(); }
+			void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) override { Count(); }
+			void STDMETHODCALLTYPE DSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override { Count(); }
+			void STDMETHODCALLTYPE DSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) override { Count(); }
+			void STDMETHODCALLTYPE CSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) override { Count(); }
+			void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT startSlot, UINT numUAVs, ID3D11UnorderedAccessView* const* unorderedAccessViews, const UINT* uavInitialCounts) override { Count(); }
+			void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) override { Count(); }
+			void STDMETHODCALLTYPE CSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) override { Count(); }
+			void STDMETHODCALLTYPE CSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) override { Count(); }
+
+			void STDMETHODCALLTYPE VSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) override
+			{
+				Count();
+				for (UINT i = 0; buffers && i < numBuffers; i++)
+					buffers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE PSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) override
+			{
+				Count();
+				for (UINT i = 0; views && i < numViews; i++)
+					views[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) override
+			{
+				Count();
+				if (shader) *shader = 0;
+				if (numClassInstances) *numClassInstances = 0;
+			}
+
+			void STDMETHODCALLTYPE PSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) override
+			{
+				Count();
+				for (UINT i = 0; samplers && i < numSamplers; i++)
+					samplers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) override
+			{
+				Count();
+				if (shader) *shader = 0;
+				if (numClassInstances) *numClassInstances = 0;
+			}
+
+			void STDMETHODCALLTYPE PSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) override
+			{
+				Count();
+				for (UINT i = 0; buffers && i < numBuffers; i++)
+					buffers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** inputLayout) override
+			{
+				Count();
+				*inputLayout = 0;
+			}
+
+			void STDMETHODCALLTYPE IAGetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** vertexBuffers, UINT* strides, UINT* offsets) override
+			{
+				Count();
+				for (UINT i = 0; i < numBuffers; i++)
+				{
+					if (vertexBuffers) vertexBuffers[i] = 0;
+					if (strides) strides[i] = 0;
+					if (offsets) offsets[i] = 0;
+				}
+			}
+
+			void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** indexBuffer, DXGI_FORMAT* format, UINT* offset) override
+			{
+				Count();
+				if (indexBuffer) *indexBuffer = 0;
+				if (format) *format = DXGI_FORMAT_UNKNOWN;
+				if (offset) *offset = 0;
+			}
+
+			void STDMETHODCALLTYPE GSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) override
+			{
+				Count();
+				for (UINT i = 0; buffers && i < numBuffers; i++)
+					buffers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) override
+			{
+				Count();
+				if (shader) *shader = 0;
+				if (numClassInstances) *numClassInstances = 0;
+			}
+
+			void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* topology) override
+			{
+				Count();
+				*topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+			}
+
+			void STDMETHODCALLTYPE VSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) override
+			{
+				Count();
+				for (UINT i = 0; views && i < numViews; i++)
+					views[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE VSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) override
+			{
+				Count();
+				for (UINT i = 0; samplers && i < numSamplers; i++)
+					samplers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** predicate, BOOL* predicateValue) override
+			{
+				Count();
+				if (predicate) *predicate = 0;
+				if (predicateValue) *predicateValue = FALSE;
+			}
+
+			void STDMETHODCALLTYPE GSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) override
+			{
+				Count();
+				for (UINT i = 0; views && i < numViews; i++)
+					views[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE GSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) override
+			{
+				Count();
+				for (UINT i = 0; samplers && i < numSamplers; i++)
+					samplers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE OMGetRenderTargets(UINT numViews, ID3D11RenderTargetView** renderTargetViews, ID3D11DepthStencilView** depthStencilView) override
+			{
+				Count();
+				for (UINT i = 0; renderTargetViews && i < numViews; i++)
+					renderTargetViews[i] = 0;
+				if (depthStencilView) *depthStencilView = 0;
+			}
+
+			void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(UINT numRTVs, ID3D11RenderTargetView** renderTargetViews, ID3D11DepthStencilView** depthStencilView, UINT uavStartSlot, UINT numUAVs, ID3D11UnorderedAccessView** unorderedAccessViews) override
+			{
+				Count();
+				for (UINT i = 0; renderTargetViews && i < numRTVs; i++)
+					renderTargetViews[i] = 0;
+				for (UINT i = 0; unorderedAccessViews && i < numUAVs; i++)
+					unorderedAccessViews[i] = 0;
+				if (depthStencilView) *depthStencilView = 0;
+			}
+
+			void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** blendState, FLOAT blendFactor[4], UINT* sampleMask) override
+			{
+				Count();
+				if (blendState) *blendState = 0;
+				if (blendFactor) blendFactor[0] = blendFactor[1] = blendFactor[2] = blendFactor[3] = 1.0f;
+				if (sampleMask) *sampleMask = 0xffffffff;
+			}
+
+			void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState** depthStencilState, UINT* stencilRef) override
+			{
+				Count();
+				if (depthStencilState) *depthStencilState = 0;
+				if (stencilRef) *stencilRef = 0;
+			}
+
+			void STDMETHODCALLTYPE SOGetTargets(UINT numBuffers, ID3D11Buffer** targets) override
+			{
+				Count();
+				for (UINT i = 0; targets && i < numBuffers; i++)
+					targets[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** rasterizerState) override
+			{
+				Count();
+				*rasterizerState = 0;
+			}
+
+			void STDMETHODCALLTYPE RSGetViewports(UINT* numViewports, D3D11_VIEWPORT* viewports) override
+			{
+				Count();
+				if (!viewports)
+				{
+					*numViewports = viewportCount;
+					return;
+				}
+
+				UINT count = *numViewports < viewportCount ? *numViewports : viewportCount;
+				for (UINT i = 0; i < count; i++)
+					viewports[i] = this->viewports[i];
+				*numViewports = count;
+			}
+
+			void STDMETHODCALLTYPE RSGetScissorRects(UINT* numRects, D3D11_RECT* rects) override
+			{
+				Count();
+				*numRects = 0;
+			}
+
+			void STDMETHODCALLTYPE HSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) override
+			{
+				Count();
+				for (UINT i = 0; views && i < numViews; i++)
+					views[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) override
+			{
+				Count();
+				if (shader) *shader = 0;
+				if (numClassInstances) *numClassInstances = 0;
+			}
+
+			void STDMETHODCALLTYPE HSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) override
+			{
+				Count();
+				for (UINT i = 0; samplers && i < numSamplers; i++)
+					samplers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE HSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) override
+			{
+				Count();
+				for (UINT i = 0; buffers && i < numBuffers; i++)
+					buffers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE DSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) override
+			{
+				Count();
+				for (UINT i = 0; views && i < numViews; i++)
+					views[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) override
+			{
+				Count();
+				if (shader) *shader = 0;
+				if (numClassInstances) *numClassInstances = 0;
+			}
+
+			void STDMETHODCALLTYPE DSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) override
+			{
+				Count();
+				for (UINT i = 0; samplers && i < numSamplers; i++)
+					samplers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE DSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) override
+			{
+				Count();
+				for (UINT i = 0; buffers && i < numBuffers; i++)
+					buffers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE CSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) override
+			{
+				Count();
+				for (UINT i = 0; views && i < numViews; i++)
+					views[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT startSlot, UINT numUAVs, ID3D11UnorderedAccessView** unorderedAccessViews) override
+			{
+				Count();
+				for (UINT i = 0; unorderedAccessViews && i < numUAVs; i++)
+					unorderedAccessViews[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) override
+			{
+				Count();
+				if (shader) *shader = 0;
+				if (numClassInstances) *numClassInstances = 0;
+			}
+
+			void STDMETHODCALLTYPE CSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) override
+			{
+				Count();
+				for (UINT i = 0; samplers && i < numSamplers; i++)
+					samplers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE CSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) override
+			{
+				Count();
+				for (UINT i = 0; buffers && i < numBuffers; i++)
+					buffers[i] = 0;
+			}
+
+			void STDMETHODCALLTYPE ClearState() override
+			{
+				Count();
+				viewportCount = 0;
+			}
+
+			void STDMETHODCALLTYPE Flush() override { Count(); }
+			D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() override { return D3D11_DEVICE_CONTEXT_IMMEDIATE; }
+			UINT STDMETHODCALLTYPE GetContextFlags() override { return 0; }
+
+			HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL restoreDeferredContextState, ID3D11CommandList** commandList) override
+			{
+				// Only deferred contexts can finish a command list
+				return DXGI_ERROR_INVALID_CALL;
+			}
+
+		private:
+			void Count() { stats.contextCalls++; }
+
+			// Returns the buffer behind a resource, or null for textures
+			NullBuffer* AsBuffer(ID3D11Resource* resource)
+			{
+				if (!resource)
+					return 0;
+
+				D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+				resource->GetType(&dimension);
+				if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER)
+					return 0;
+
+				return static_cast<NullBuffer*>(static_cast<ID3D11Buffer*>(resource));
+			}
+
+			// Kept so RSGetViewports() can hand them back
+			UINT viewportCount;
+			D3D11_VIEWPORT viewports[MaxViewports];
+		};
+
+		// ----------------------------------------------------
+		// The device creates the objects above and says no to
+		// everything else
+		// ----------------------------------------------------
+		class NullDevice : public NullUnknown<ID3D11Device>
+		{
+		public:
+			NullDevice() { context.Attach(new NullContext()); }
+			~NullDevice()
+			{
+				if (device == this)
+					device = 0;
+			}
+
+			HRESULT STDMETHODCALLTYPE CreateBuffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Buffer** buffer) override
+			{
+				stats.deviceCalls++;
+				if (!desc || desc->ByteWidth == 0)
+					return E_INVALIDARG;
+				if (buffer)
+					*buffer = new NullBuffer(*desc, initialData);
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE CreateTexture2D(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Texture2D** texture) override
+			{
+				stats.deviceCalls++;
+				if (!desc)
+					return E_INVALIDARG;
+				if (texture)
+					*texture = new NullTexture2D(*desc);
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE CreateRenderTargetView(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc, ID3D11RenderTargetView** view) override
+			{
+				stats.deviceCalls++;
+				if (!resource)
+					return E_INVALIDARG;
+				if (view)
+					*view = new NullView<ID3D11RenderTargetView, D3D11_RENDER_TARGET_VIEW_DESC>(resource, desc ? *desc : D3D11_RENDER_TARGET_VIEW_DESC{});
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE CreateDepthStencilView(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc, ID3D11DepthStencilView** view) override
+			{
+				stats.deviceCalls++;
+				if (!resource)
+					return E_INVALIDARG;
+				if (view)
+					*view = new NullView<ID3D11DepthStencilView, D3D11_DEPTH_STENCIL_VIEW_DESC>(resource, desc ? *desc : D3D11_DEPTH_STENCIL_VIEW_DESC{});
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* elements, UINT numElements, const void* bytecode, SIZE_T bytecodeLength, ID3D11InputLayout** inputLayout) override
+			{
+				stats.deviceCalls++;
+				if (inputLayout)
+					*inputLayout = new NullObject<ID3D11InputLayout>();
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE CreateVertexShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11VertexShader** shader) override
+			{
+				stats.deviceCalls++;
+				if (shader)
+					*shader = new NullObject<ID3D11VertexShader>();
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE CreatePixelShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11PixelShader** shader) override
+			{
+				stats.deviceCalls++;
+				if (shader)
+					*shader = new NullObject<ID3D11PixelShader>();
+				return S_OK;
+			}
+
+			// Zeroed feature data means "not supported" for every
+			// feature this project asks about
+			HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D11_FEATURE feature, void* data, UINT dataSize) override
+			{
+				stats.deviceCalls++;
+				if (!data)
+					return E_INVALIDARG;
+				memset(data, 0, dataSize);
+				return S_OK;
+			}
+
+			void STDMETHODCALLTYPE GetImmediateContext(ID3D11DeviceContext** immediateContext) override
+			{
+				*immediateContext = context.Get();
+				context->AddRef();
+			}
+
+			D3D_FEATURE_LEVEL STDMETHODCALLTYPE GetFeatureLevel() override { return D3D_FEATURE_LEVEL_11_0; }
+			UINT STDMETHODCALLTYPE GetCreationFlags() override { return 0; }
+			HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() override { return S_OK; }
+			HRESULT STDMETHODCALLTYPE SetExceptionMode(UINT raiseFlags) override { return S_OK; }
+			UINT STDMETHODCALLTYPE GetExceptionMode() override { return 0; }
+
+			HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) override { return DXGI_ERROR_NOT_FOUND; }
+			HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) override { return S_OK; }
+			HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) override { return S_OK; }
+
+			// Nothing below is used by this project
+			HRESULT STDMETHODCALLTYPE CreateTexture1D(const D3D11_TEXTURE1D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Texture1D** texture) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateTexture3D(const D3D11_TEXTURE3D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Texture3D** texture) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateShaderResourceView(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc, ID3D11ShaderResourceView** view) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D11Resource* resource, const D3D11_UNORDERED_ACCESS_VIEW_DESC* desc, ID3D11UnorderedAccessView** view) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateGeometryShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11GeometryShader** shader) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateGeometryShaderWithStreamOutput(const void* bytecode, SIZE_T bytecodeLength, const D3D11_SO_DECLARATION_ENTRY* declaration, UINT numEntries, const UINT* bufferStrides, UINT numStrides, UINT rasterizedStream, ID3D11ClassLinkage* classLinkage, ID3D11GeometryShader** shader) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateHullShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11HullShader** shader) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateDomainShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11DomainShader** shader) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateComputeShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11ComputeShader** shader) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateClassLinkage(ID3D11ClassLinkage** linkage) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateBlendState(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateRasterizerState(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateSamplerState(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateQuery(const D3D11_QUERY_DESC* desc, ID3D11Query** query) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreatePredicate(const D3D11_QUERY_DESC* desc, ID3D11Predicate** predicate) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateCounter(const D3D11_COUNTER_DESC* desc, ID3D11Counter** counter) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CreateDeferredContext(UINT contextFlags, ID3D11DeviceContext** deferredContext) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE OpenSharedResource(HANDLE resource, REFIID returnedInterface, void** outResource) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CheckFormatSupport(DXGI_FORMAT format, UINT* formatSupport) override { return E_NOTIMPL; }
+			HRESULT STDMETHODCALLTYPE CheckMultisampleQualityLevels(DXGI_FORMAT format, UINT sampleCount, UINT* numQualityLevels) override { return E_NOTIMPL; }
+			void STDMETHODCALLTYPE CheckCounterInfo(D3D11_COUNTER_INFO* counterInfo) override { memset(counterInfo, 0, sizeof(D3D11_COUNTER_INFO)); }
+			HRESULT STDMETHODCALLTYPE CheckCounter(const D3D11_COUNTER_DESC* desc, D3D11_COUNTER_TYPE* type, UINT* activeCounters, LPSTR name, UINT* nameLength, LPSTR units, UINT* unitsLength, LPSTR description, UINT* descriptionLength) override { return E_NOTIMPL; }
+
+		private:
+			Microsoft::WRL::ComPtr<NullContext> context;
+		};
+
+		// ----------------------------------------------------
+		// A swap chain with a single back buffer texture and
+		// no output.  Present() only counts
+		// ----------------------------------------------------
+		class NullSwapChain : public NullUnknown<IDXGISwapChain>
+		{
+		public:
+			NullSwapChain(unsigned int width, unsigned int height) : desc{}
+			{
+				desc.BufferCount = 2;
+				desc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+				desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+				desc.SampleDesc.Count = 1;
+				desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+				desc.Windowed = true;
+				ResizeBuffers(desc.BufferCount, width, height, desc.BufferDesc.Format, 0);
+			}
+
+			HRESULT STDMETHODCALLTYPE Present(UINT syncInterval, UINT flags) override
+			{
+				stats.presents++;
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE GetBuffer(UINT buffer, REFIID riid, void** surface) override
+			{
+				if (buffer != 0 || !backBuffer)
+					return DXGI_ERROR_INVALID_CALL;
+				return backBuffer->QueryInterface(riid, surface);
+			}
+
+			HRESULT STDMETHODCALLTYPE ResizeBuffers(UINT bufferCount, UINT width, UINT height, DXGI_FORMAT newFormat, UINT swapChainFlags) override
+			{
+				if (bufferCount > 0) desc.BufferCount = bufferCount;
+				if (width > 0) desc.BufferDesc.Width = width;
+				if (height > 0) desc.BufferDesc.Height = height;
+				if (newFormat != DXGI_FORMAT_UNKNOWN) desc.BufferDesc.Format = newFormat;
+				desc.Flags = swapChainFlags;
+
+				D3D11_TEXTURE2D_DESC textureDesc = {};
+				textureDesc.Width = desc.BufferDesc.Width;
+				textureDesc.Height = desc.BufferDesc.Height;
+				textureDesc.MipLevels = 1;
+				textureDesc.ArraySize = 1;
+				textureDesc.Format = desc.BufferDesc.Format;
+				textureDesc.SampleDesc.Count = 1;
+				textureDesc.Usage = D3D11_USAGE_DEFAULT;
+				textureDesc.BindFlags = D3D11_BIND_RENDER_TARGET;
+
+				backBuffer.Attach(new NullTexture2D(textureDesc));
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE GetFullscreenState(BOOL* fullscreen, IDXGIOutput** target) override
+			{
+				if (fullscreen) *fullscreen = FALSE;
+				if (target) *target = 0;
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE GetDesc(DXGI_SWAP_CHAIN_DESC* outDesc) override
+			{
+				*outDesc = desc;
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** outDevice) override
+			{
+				if (!device)
+					return DXGI_ERROR_INVALID_CALL;
+				return device->QueryInterface(riid, outDevice);
+			}
+
+			HRESULT STDMETHODCALLTYPE SetFullscreenState(BOOL fullscreen, IDXGIOutput* target) override { return DXGI_ERROR_UNSUPPORTED; }
+			HRESULT STDMETHODCALLTYPE ResizeTarget(const DXGI_MODE_DESC* newTargetParameters) override { return S_OK; }
+			HRESULT STDMETHODCALLTYPE GetContainingOutput(IDXGIOutput** output) override { return DXGI_ERROR_UNSUPPORTED; }
+			HRESULT STDMETHODCALLTYPE GetFrameStatistics(DXGI_FRAME_STATISTICS* frameStatistics) override { return DXGI_ERROR_UNSUPPORTED; }
+			HRESULT STDMETHODCALLTYPE GetLastPresentCount(UINT* lastPresentCount) override
+			{
+				*lastPresentCount = (UINT)stats.presents;
+				return S_OK;
+			}
+
+			HRESULT STDMETHODCALLTYPE GetParent(REFIID riid, void** parent) override { return E_NOINTERFACE; }
+			HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) override { return DXGI_ERROR_NOT_FOUND; }
+			HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) override { return S_OK; }
+			HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) override { return S_OK; }
+
+		protected:
+			bool Supports(REFIID riid) override
+			{
+				return riid == __uuidof(IDXGIObject) ||
+					riid == __uuidof(IDXGIDeviceSubObject) ||
+					NullUnknown<IDXGISwapChain>::Supports(riid);
+			}
+
+		private:
+			DXGI_SWAP_CHAIN_DESC desc;
+			Microsoft::WRL::ComPtr<ID3D11Texture2D> backBuffer;
+		};
+	}
+}
+
+// --------------------------------------------------------
+// Creates the null device, its immediate context and a swap
+// chain, with the same outputs as D3D11CreateDeviceAndSwapChain
+// --------------------------------------------------------
+HRESULT NullGraphics::CreateDevice(
+	unsigned int width,
+	unsigned int height,
+	IDXGISwapChain** swapChain,
+	ID3D11Device** outDevice,
+	D3D_FEATURE_LEVEL* featureLevel,
+	ID3D11DeviceContext** context)
+{
+	if (device)
+		return E_FAIL;
+
+	stats = {};
+	device = new NullDevice();
+
+	*outDevice = device;
+	device->GetImmediateContext(context);
+	*swapChain = new NullSwapChain(width, height);
+	if (featureLevel)
+		*featureLevel = device->GetFeatureLevel();
+	return S_OK;
+}
+
+NullGraphicsStats NullGraphics::GetStats() { return stats; }
+
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <d3d11.h>
+
+// --------------------------------------------------------
+// A stand-in for the D3D11 device, context and swap chain
+// that never touches a GPU or a window.  Compiled only when
+// GRAPHICS_NULL is defined (see Graphics.h)
+//
+// Every object is a real COM object implementing the D3D11
+// interfaces, so Game, Mesh and the rest run unchanged on
+// top of it.  Buffers get system memory so Map() works, and
+// every call is counted, which leaves only the CPU side of
+// the frame to measure
+//
+// Optional features are reported as unsupported, so the
+// constant buffer ring and deferred recording both take
+// their fallback paths
+// --------------------------------------------------------
+struct NullGraphicsStats
+{
+	unsigned long long deviceCalls;
+	unsigned long long contextCalls;
+	unsigned long long draws;
+	unsigned long long indices;
+	unsigned long long instances;
+	unsigned long long maps;
+	unsigned long long bytesUploaded;
+	unsigned long long presents;
+
+	unsigned long long resourcesCreated;
+	unsigned long long bytesAllocated;	// Total over the whole run
+	unsigned long long liveBytes;		// Resources still alive
+};
+
+namespace NullGraphics
+{
+	HRESULT CreateDevice(
+		unsigned int width,
+		unsigned int height,
+		IDXGISwapChain** swapChain,
+		ID3D11Device** device,
+		D3D_FEATURE_LEVEL* featureLevel,
+		ID3D11DeviceContext** context);
+
+	NullGraphicsStats GetStats();
+}
@@ -0,0 +1,166 @@
+#include "NullRenderBackend.h"
+
+#include <cstring>
+
+namespace
+{
+	const unsigned int Unknown = 0xFFFFFFFF;
+	const unsigned int ConstantSlots = 16;
+
+	// Uploads wrap around in this much memory, which keeps it
+	// warm in cache about as much as a real upload ring would be
+	const size_t UploadMemorySize = 4 * 1024 * 1024;
+}
+
+NullRenderBackend::NullRenderBackend() :
+	uploadMemory(UploadMemorySize),
+	uploadCursor(0)
+{
+	ResetState();
+	ResetStats();
+}
+
+void NullRenderBackend::ResetState()
+{
+	topology = Unknown;
+	inputLayout = Unknown;
+	vertexShader = Unknown;
+	pixelShader = Unknown;
+	indexBuffer = Unknown;
+	indexFormat = Unknown;
+	for (unsigned int i = 0; i < MaxStreamVertexBuffers; i++)
+	{
+		vertexBuffers[i] = Unknown;
+		vertexStrides[i] = Unknown;
+		vertexOffsets[i] = Unknown;
+	}
+	for (unsigned int i = 0; i < ConstantSlots; i++)
+		constantBuffers[i] = Unknown;
+}
+
+const NullBackendStats& NullRenderBackend::GetStats() const { return stats; }
+void NullRenderBackend::ResetStats() { stats = {}; }
+
+// Counts a bind and reports whether it changed anything
+bool NullRenderBackend::Bind(unsigned int& current, unsigned int value)
+{
+	if (current == value)
+	{
+		stats.redundantBinds++;
+		return false;
+	}
+
+	current = value;
+	stats.stateChanges++;
+	return true;
+}
+
+void NullRenderBackend::Upload(const void* data, unsigned int size)
+{
+	if (size > uploadMemory.size())
+		size = (unsigned int)uploadMemory.size();
+	if (uploadCursor + size > uploadMemory.size())
+		uploadCursor = 0;
+
+	memcpy(uploadMemory.data() + uploadCursor, data, size);
+	uploadCursor += (size + 255) & ~(size_t)255;
+	stats.bytesUploaded += size;
+}
+
+void NullRenderBackend::Execute(const RenderCommandStream& stream)
+{
+	RenderCommandReader reader(stream);
+	RenderCommand command;
+	while (reader.Next(command))
+	{
+		stats.commands++;
+
+		switch (command.type)
+		{
+		case RenderCommandType::SetTopology:
+			Bind(topology, command.As<SetTopologyCommand>().topology);
+			break;
+
+		case RenderCommandType::SetInputLayout:
+			Bind(inputLayout, command.As<SetResourceCommand>().resource);
+			break;
+
+		case RenderCommandType::SetVertexShader:
+			Bind(vertexShader, command.As<SetResourceCommand>().resource);
+			break;
+
+		case RenderCommandType::SetPixelShader:
+			Bind(pixelShader, command.As<SetResourceCommand>().resource);
+			break;
+
+		case RenderCommandType::SetVertexBuffers:
+		{
+			// Same rule as StateCache: one call for the whole range
+			// unless every slot already matches
+			const SetVertexBuffersCommand& vb = command.As<SetVertexBuffersCommand>();
+			bool changed = false;
+			for (unsigned int i = 0; i < vb.count; i++)
+			{
+				unsigned int slot = vb.startSlot + i;
+				if (slot >= MaxStreamVertexBuffers)
+					break;
+				changed |= vertexBuffers[slot] != vb.buffers[i] ||
+					vertexStrides[slot] != vb.strides[i] ||
+					vertexOffsets[slot] != vb.offsets[i];
+				vertexBuffers[slot] = vb.buffers[i];
+				vertexStrides[slot] = vb.strides[i];
+				vertexOffsets[slot] = vb.offsets[i];
+			}
+			if (changed) stats.stateChanges++;
+			else stats.redundantBinds++;
+			break;
+		}
+
+		case RenderCommandType::SetIndexBuffer:
+		{
+			const SetIndexBufferCommand& ib = command.As<SetIndexBufferCommand>();
+			bool changed = indexBuffer != ib.buffer || indexFormat != ib.format;
+			indexBuffer = ib.buffer;
+			indexFormat = ib.format;
+			if (changed) stats.stateChanges++;
+			else stats.redundantBinds++;
+			break;
+		}
+
+		case RenderCommandType::SetVSConstantBuffer:
+		{
+			const SetConstantBufferCommand& cb = command.As<SetConstantBufferCommand>();
+			if (cb.slot < ConstantSlots)
+				Bind(constantBuffers[cb.slot], cb.buffer);
+			break;
+		}
+
+		case RenderCommandType::UploadBuffer:
+		case RenderCommandType::SetVSConstants:
+			// Per-draw constants also end up bound at a new offset,
+			// which is always a real state change
+			Upload(command.payload, command.payloadSize);
+			if (command.type == RenderCommandType::SetVSConstants)
+				stats.stateChanges++;
+			break;
+
+		case RenderCommandType::DrawIndexed:
+			stats.draws++;
+			stats.indices += command.As<DrawIndexedCommand>().indexCount;
+			stats.instances++;
+			break;
+
+		case RenderCommandType::DrawIndexedInstanced:
+		{
+			const DrawIndexedInstancedCommand& draw = command.As<DrawIndexedInstancedCommand>();
+			stats.draws++;
+			stats.indices += (unsigned long long)draw.indexCount * draw.instanceCount;
+			stats.instances += draw.instanceCount;
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "RenderBackend.h"
+
+// What a NullRenderBackend saw, added up over every Execute()
+struct NullBackendStats
+{
+	unsigned long long commands;
+	unsigned long long stateChanges;		// Binds that changed something
+	unsigned long long redundantBinds;		// Binds that didn't
+	unsigned long long bytesUploaded;
+	unsigned long long draws;
+	unsigned long long indices;
+	unsigned long long instances;
+};
+
+// --------------------------------------------------------
+// Executes streams without a GPU
+//
+// It does the CPU side of what a real backend does: decode
+// every command, filter redundant binds against the state it
+// tracks, and copy every upload into memory standing in for
+// mapped buffers.  That makes replaying a capture through it
+// a repeatable measure of submission cost, on any platform
+// --------------------------------------------------------
+class NullRenderBackend : public RenderBackend
+{
+public:
+	NullRenderBackend();
+
+	void Execute(const RenderCommandStream& stream) override;
+
+	// Forgets the tracked state, like a new frame on a
+	// context somebody else has touched
+	void ResetState();
+
+	const NullBackendStats& GetStats() const;
+	void ResetStats();
+
+private:
+	bool Bind(unsigned int& current, unsigned int value);
+	void Upload(const void* data, unsigned int size);
+
+	// Bound state, with 0xFFFFFFFF meaning unknown
+	unsigned int topology;
+	unsigned int inputLayout;
+	unsigned int vertexShader;
+	unsigned int pixelShader;
+	unsigned int vertexBuffers[MaxStreamVertexBuffers];
+	unsigned int vertexStrides[MaxStreamVertexBuffers];
+	unsigned int vertexOffsets[MaxStreamVertexBuffers];
+	unsigned int indexBuffer;
+	unsigned int indexFormat;
+	unsigned int constantBuffers[16];
+
+	// Stands in for mapped GPU memory
+	std::vector<unsigned char> uploadMemory;
+	size_t uploadCursor;
+
+	NullBackendStats stats;
+};
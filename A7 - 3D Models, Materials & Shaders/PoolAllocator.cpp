@@ -0,0 +1,515 @@
+#include "PoolAllocator.h"
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <unordered_map>
+
+// --------------- Basic usage -----------------
+//
+// A general purpose allocator for code that allocates and
+// frees lots of small blocks every frame, ImGui in particular:
+//
+//   ImGui::SetAllocatorFunctions(
+//       [](size_t size, void*) { return PoolAllocator::Allocate(size); },
+//       [](void* memory, void*) { PoolAllocator::Free(memory); });
+//
+// Requests are rounded up to one of 40 size classes (16 bytes
+// apart up to 128, then four classes per doubling up to 32 KB)
+// and anything bigger goes straight to malloc.  Each block has
+// a 16-byte header holding its class and requested size, so
+// Free() needs nothing but the pointer.
+//
+// Every thread keeps a free list per class.  Allocating and
+// freeing only touch that list, with no locks or atomics,
+// until it runs dry or grows too long; then a batch of blocks
+// moves to or from the class's shared pool under its lock.
+// Shared pools carve new blocks out of 64 KB chunks and never
+// give memory back, so a steady workload stops calling malloc
+// once it has warmed up.
+//
+// Stats are counted per thread in plain stores and summed by
+// EndFrame().  PoolAllocator::StartTrace() records every
+// call for a few frames; Tools/ReplayAllocations.cpp replays
+// the file against this allocator and malloc on Linux.
+//
+// ---------------------------------------------
+
+namespace
+{
+	const size_t HeaderSize = 16;
+	const unsigned int SmallClasses = 8;		// 16 to 128 bytes, 16 apart
+	const unsigned int ClassesPerDoubling = 4;
+	const unsigned int ClassCount = SmallClasses + 8 * ClassesPerDoubling;
+	const size_t MaxBlockSize = 32768;
+	const unsigned int LargeClass = 0xFFFFFFFF;
+
+	const size_t ChunkBytes = 64 * 1024;
+
+	// Written at the start of every block that's handed out
+	struct BlockHeader
+	{
+		size_t size;
+		unsigned int sizeClass;
+	};
+	static_assert(sizeof(BlockHeader) <= HeaderSize, "Header must leave the block 16-byte aligned");
+
+	// A free block's first bytes link it into a free list
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	// Smallest class whose blocks hold blockBytes
+	unsigned int SizeClassOf(size_t blockBytes)
+	{
+		if (blockBytes <= 128)
+			return (unsigned int)((blockBytes + 15) / 16) - 1;
+
+		// Above 128, the top three bits of (blockBytes - 1) pick
+		// the doubling and the quarter within it
+		size_t n = blockBytes - 1;
+		unsigned int log = (unsigned int)std::bit_width(n);
+		return SmallClasses + (log - 8) * ClassesPerDoubling + (unsigned int)((n >> (log - 3)) & 3);
+	}
+
+	size_t BlockSizeOf(unsigned int sizeClass)
+	{
+		if (sizeClass < SmallClasses)
+			return (sizeClass + 1) * 16;
+
+		size_t base = (size_t)128 << ((sizeClass - SmallClasses) / ClassesPerDoubling);
+		return base + ((sizeClass - SmallClasses) % ClassesPerDoubling + 1) * (base / 4);
+	}
+
+	// Blocks moved between a thread cache and its shared pool
+	// at once: about 16 KB worth, within reason
+	unsigned int BatchSize(unsigned int sizeClass)
+	{
+		size_t batch = 16384 / BlockSizeOf(sizeClass);
+		if (batch < 2) return 2;
+		if (batch > 64) return 64;
+		return (unsigned int)batch;
+	}
+
+	struct SharedPool
+	{
+		std::mutex mutex;
+		FreeBlock* head = 0;
+	};
+	SharedPool pools[ClassCount];
+	std::atomic<unsigned long long> bytesReserved = 0;
+
+	// Running totals, summed over threads
+	struct Totals
+	{
+		unsigned long long allocations;
+		unsigned long long frees;
+		unsigned long long bytesAllocated;
+		unsigned long long bytesFreed;
+		unsigned long long largeAllocations;
+		unsigned long long refills;
+		unsigned long long classAllocations[ClassCount];
+		unsigned long long classFrees[ClassCount];
+	};
+
+	// One thread's counters.  Only that thread writes them, so a
+	// relaxed load and store is enough and costs what a plain
+	// increment does, while EndFrame() can still read them
+	struct ThreadCounters
+	{
+		std::atomic<unsigned long long> allocations;
+		std::atomic<unsigned long long> frees;
+		std::atomic<unsigned long long> bytesAllocated;
+		std::atomic<unsigned long long> bytesFreed;
+		std::atomic<unsigned long long> largeAllocations;
+		std::atomic<unsigned long long> refills;
+		std::atomic<unsigned long long> classAllocations[ClassCount];
+		std::atomic<unsigned long long> classFrees[ClassCount];
+	};
+
+	inline void Bump(std::atomic<unsigned long long>& counter, unsigned long long amount = 1)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	void AddCounters(Totals& totals, const ThreadCounters& counters)
+	{
+		totals.allocations += counters.allocations.load(std::memory_order_relaxed);
+		totals.frees += counters.frees.load(std::memory_order_relaxed);
+		totals.bytesAllocated += counters.bytesAllocated.load(std::memory_order_relaxed);
+		totals.bytesFreed += counters.bytesFreed.load(std::memory_order_relaxed);
+		totals.largeAllocations += counters.largeAllocations.load(std::memory_order_relaxed);
+		totals.refills += counters.refills.load(std::memory_order_relaxed);
+		for (unsigned int i = 0; i < ClassCount; i++)
+		{
+			totals.classAllocations[i] += counters.classAllocations[i].load(std::memory_order_relaxed);
+			totals.classFrees[i] += counters.classFrees[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	struct ThreadCache;
+
+	// Every live thread cache, plus what exited threads counted
+	std::mutex registryMutex;
+	std::vector<ThreadCache*> registry;
+	Totals retired = {};
+
+	// Moves count blocks from the front of list to a shared pool
+	void ReleaseBlocks(FreeBlock*& list, unsigned int count, unsigned int sizeClass)
+	{
+		FreeBlock* first = list;
+		FreeBlock* last = first;
+		for (unsigned int i = 1; i < count; i++)
+			last = last->next;
+		list = last->next;
+
+		std::lock_guard<std::mutex> lock(pools[sizeClass].mutex);
+		last->next = pools[sizeClass].head;
+		pools[sizeClass].head = first;
+	}
+
+	struct ThreadCache
+	{
+		FreeBlock* lists[ClassCount] = {};
+		unsigned int counts[ClassCount] = {};
+		ThreadCounters counters = {};
+
+		ThreadCache()
+		{
+			std::lock_guard<std::mutex> lock(registryMutex);
+			registry.push_back(this);
+		}
+
+		// A thread's blocks go back to the shared pools when it
+		// exits, so other threads can use them
+		~ThreadCache()
+		{
+			for (unsigned int i = 0; i < ClassCount; i++)
+			{
+				if (counts[i] > 0)
+					ReleaseBlocks(lists[i], counts[i], i);
+			}
+
+			std::lock_guard<std::mutex> lock(registryMutex);
+			AddCounters(retired, counters);
+			for (size_t i = 0; i < registry.size(); i++)
+			{
+				if (registry[i] == this)
+				{
+					registry[i] = registry.back();
+					registry.pop_back();
+					break;
+				}
+			}
+		}
+	};
+	thread_local ThreadCache cache;
+
+	// --------------------------------------------------------
+	// Fills an empty thread list with a batch from the shared
+	// pool, carving a new chunk into blocks when the pool
+	// doesn't have enough
+	// --------------------------------------------------------
+	void Refill(ThreadCache& local, unsigned int sizeClass)
+	{
+		unsigned int batch = BatchSize(sizeClass);
+		size_t blockSize = BlockSizeOf(sizeClass);
+		SharedPool& pool = pools[sizeClass];
+
+		std::lock_guard<std::mutex> lock(pool.mutex);
+		unsigned int taken = 0;
+		while (taken < batch)
+		{
+			if (!pool.head)
+			{
+				size_t chunkBytes = blockSize * batch > ChunkBytes ? blockSize * batch : ChunkBytes;
+				unsigned char* chunk = (unsigned char*)AllocationTracker::Malloc(chunkBytes);
+				if (!chunk)
+					throw std::bad_alloc();
+				bytesReserved.fetch_add(chunkBytes, std::memory_order_relaxed);
+
+				// Linked back to front so the list runs in address order
+				size_t blockCount = chunkBytes / blockSize;
+				for (size_t i = blockCount; i > 0; i--)
+				{
+					FreeBlock* block = (FreeBlock*)(chunk + (i - 1) * blockSize);
+					block->next = pool.head;
+					pool.head = block;
+				}
+			}
+
+			FreeBlock* block = pool.head;
+			pool.head = block->next;
+			block->next = local.lists[sizeClass];
+			local.lists[sizeClass] = block;
+			taken++;
+		}
+		local.counts[sizeClass] += taken;
+		Bump(local.counters.refills);
+	}
+
+	PoolFrameStats lastFrame = {};
+	Totals previousTotals = {};
+	Totals lastTotals = {};
+
+	// Trace recording, only touched while a trace is running
+	std::atomic<bool> tracing = false;
+	std::mutex traceMutex;
+	std::unordered_map<void*, unsigned int> traceIds;
+	std::vector<PoolTraceEvent> traceEvents;
+	unsigned int traceNextId = 0;
+	unsigned int traceFramesLeft = 0;
+	std::string tracePath;
+	bool traceSaved = false;
+
+	void TraceAllocate(void* memory, size_t size)
+	{
+		std::lock_guard<std::mutex> lock(traceMutex);
+		if (!tracing.load(std::memory_order_relaxed))
+			return;
+
+		traceIds[memory] = traceNextId;
+		traceEvents.push_back({ PoolTraceEvent::Type::Allocate, traceNextId, (unsigned int)size });
+		traceNextId++;
+	}
+
+	// Blocks allocated before the trace started aren't in it,
+	// so neither are their frees
+	void TraceFree(void* memory)
+	{
+		std::lock_guard<std::mutex> lock(traceMutex);
+		if (!tracing.load(std::memory_order_relaxed))
+			return;
+
+		auto found = traceIds.find(memory);
+		if (found == traceIds.end())
+			return;
+
+		traceEvents.push_back({ PoolTraceEvent::Type::Free, found->second, 0 });
+		traceIds.erase(found);
+	}
+
+	bool SaveTrace(const std::string& path, const std::vector<PoolTraceEvent>& events)
+	{
+		std::ofstream file(path);
+		if (!file)
+			return false;
+
+		file << "# Pool allocator trace: a <id> <size>, f <id>, frame\n";
+		for (const PoolTraceEvent& event : events)
+		{
+			switch (event.type)
+			{
+			case PoolTraceEvent::Type::Allocate: file << "a " << event.id << " " << event.size << "\n"; break;
+			case PoolTraceEvent::Type::Free: file << "f " << event.id << "\n"; break;
+			case PoolTraceEvent::Type::EndFrame: file << "frame\n"; break;
+			}
+		}
+		return (bool)file;
+	}
+}
+
+void* PoolAllocator::Allocate(size_t size)
+{
+	ThreadCache& local = cache;
+	size_t blockBytes = size + HeaderSize;
+
+	BlockHeader* header;
+	if (blockBytes > MaxBlockSize)
+	{
+		header = (BlockHeader*)AllocationTracker::Malloc(blockBytes);
+		if (!header)
+			throw std::bad_alloc();
+		header->sizeClass = LargeClass;
+		bytesReserved.fetch_add(blockBytes, std::memory_order_relaxed);
+		Bump(local.counters.largeAllocations);
+	}
+	else
+	{
+		unsigned int sizeClass = SizeClassOf(blockBytes);
+		if (!local.lists[sizeClass])
+			Refill(local, sizeClass);
+
+		FreeBlock* block = local.lists[sizeClass];
+		local.lists[sizeClass] = block->next;
+		local.counts[sizeClass]--;
+
+		header = (BlockHeader*)block;
+		header->sizeClass = sizeClass;
+		Bump(local.counters.classAllocations[sizeClass]);
+	}
+	header->size = size;
+	Bump(local.counters.allocations);
+	Bump(local.counters.bytesAllocated, size);
+
+	void* memory = (unsigned char*)header + HeaderSize;
+	if (tracing.load(std::memory_order_relaxed))
+		TraceAllocate(memory, size);
+	return memory;
+}
+
+void PoolAllocator::Free(void* memory)
+{
+	if (!memory)
+		return;
+
+	if (tracing.load(std::memory_order_relaxed))
+		TraceFree(memory);
+
+	ThreadCache& local = cache;
+	BlockHeader* header = (BlockHeader*)((unsigned char*)memory - HeaderSize);
+	Bump(local.counters.frees);
+	Bump(local.counters.bytesFreed, header->size);
+
+	if (header->sizeClass == LargeClass)
+	{
+		bytesReserved.fetch_sub(header->size + HeaderSize, std::memory_order_relaxed);
+		AllocationTracker::Free(header);
+		return;
+	}
+
+	unsigned int sizeClass = header->sizeClass;
+	FreeBlock* block = (FreeBlock*)header;
+	block->next = local.lists[sizeClass];
+	local.lists[sizeClass] = block;
+	local.counts[sizeClass]++;
+	Bump(local.counters.classFrees[sizeClass]);
+
+	// Keep a batch for the next allocations and share the rest
+	unsigned int batch = BatchSize(sizeClass);
+	if (local.counts[sizeClass] > batch * 2)
+	{
+		ReleaseBlocks(local.lists[sizeClass], batch, sizeClass);
+		local.counts[sizeClass] -= batch;
+	}
+}
+
+void PoolAllocator::EndFrame()
+{
+	Totals totals = {};
+	{
+		std::lock_guard<std::mutex> lock(registryMutex);
+		totals = retired;
+		for (ThreadCache* threadCache : registry)
+			AddCounters(totals, threadCache->counters);
+	}
+
+	lastFrame.allocations = totals.allocations - previousTotals.allocations;
+	lastFrame.frees = totals.frees - previousTotals.frees;
+	lastFrame.bytesAllocated = totals.bytesAllocated - previousTotals.bytesAllocated;
+	lastFrame.bytesFreed = totals.bytesFreed - previousTotals.bytesFreed;
+	lastFrame.largeAllocations = totals.largeAllocations - previousTotals.largeAllocations;
+	lastFrame.refills = totals.refills - previousTotals.refills;
+	previousTotals = totals;
+	lastTotals = totals;
+
+	if (!tracing.load(std::memory_order_relaxed))
+		return;
+
+	// Saved outside the lock, once nothing else is recorded
+	std::vector<PoolTraceEvent> finished;
+	{
+		std::lock_guard<std::mutex> lock(traceMutex);
+		traceEvents.push_back({ PoolTraceEvent::Type::EndFrame, 0, 0 });
+		if (--traceFramesLeft > 0)
+			return;
+
+		tracing = false;
+		finished.swap(traceEvents);
+		traceIds.clear();
+	}
+	traceSaved = SaveTrace(tracePath, finished);
+}
+
+const PoolFrameStats& PoolAllocator::GetLastFrame() { return lastFrame; }
+
+unsigned long long PoolAllocator::GetBytesLive() { return lastTotals.bytesAllocated - lastTotals.bytesFreed; }
+unsigned long long PoolAllocator::GetBytesReserved() { return bytesReserved.load(std::memory_order_relaxed); }
+
+unsigned int PoolAllocator::GetSizeClassCount() { return ClassCount; }
+unsigned int PoolAllocator::GetSizeClassBlockSize(unsigned int sizeClass) { return (unsigned int)BlockSizeOf(sizeClass); }
+
+unsigned long long PoolAllocator::GetSizeClassBlocksLive(unsigned int sizeClass)
+{
+	return lastTotals.classAllocations[sizeClass] - lastTotals.classFrees[sizeClass];
+}
+
+void PoolAllocator::StartTrace(const std::string& path, unsigned int frames)
+{
+	std::lock_guard<std::mutex> lock(traceMutex);
+	if (tracing || frames == 0)
+		return;
+
+	tracePath = path;
+	traceFramesLeft = frames;
+	traceNextId = 0;
+	traceEvents.clear();
+	traceIds.clear();
+	traceSaved = false;
+	tracing = true;
+}
+
+bool PoolAllocator::IsTracing() { return tracing.load(std::memory_order_relaxed); }
+unsigned int PoolAllocator::GetTraceFramesLeft() { return traceFramesLeft; }
+bool PoolAllocator::LastTraceSaved() { return traceSaved; }
+
+// --------------------------------------------------------
+// Reads a trace written by EndFrame().  Fails on anything
+// that couldn't have been recorded: allocation ids out of
+// order, or frees of ids that aren't live
+// --------------------------------------------------------
+bool PoolAllocator::LoadTrace(const std::string& path, std::vector<PoolTraceEvent>& events)
+{
+	events.clear();
+	std::ifstream file(path);
+	if (!file)
+		return false;
+
+	std::vector<bool> live;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty() || line[0] == '#')
+			continue;
+
+		std::istringstream values(line);
+		std::string type;
+		values >> type;
+
+		PoolTraceEvent event = {};
+		if (type == "a")
+		{
+			event.type = PoolTraceEvent::Type::Allocate;
+			values >> event.id >> event.size;
+			if (!values || event.id != live.size())
+				return false;
+			live.push_back(true);
+		}
+		else if (type == "f")
+		{
+			event.type = PoolTraceEvent::Type::Free;
+			values >> event.id;
+			if (!values || event.id >= live.size() || !live[event.id])
+				return false;
+			live[event.id] = false;
+		}
+		else if (type == "frame")
+		{
+			event.type = PoolTraceEvent::Type::EndFrame;
+		}
+		else
+		{
+			return false;
+		}
+		events.push_back(event);
+	}
+	return !events.empty();
+}
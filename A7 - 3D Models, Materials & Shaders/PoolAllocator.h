@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// See PoolAllocator.cpp for usage details
+
+// Pool activity during one frame, across every thread
+struct PoolFrameStats
+{
+	unsigned long long allocations;
+	unsigned long long frees;
+	unsigned long long bytesAllocated;	// As requested, not rounded up
+	unsigned long long bytesFreed;
+	unsigned long long largeAllocations;	// Too big for a size class
+	unsigned long long refills;			// Thread cache trips to the shared pools
+};
+
+// One event in a recorded allocation trace.  Ids number the
+// trace's allocations from zero, so a replay can keep its
+// pointers in a plain array
+struct PoolTraceEvent
+{
+	enum class Type { Allocate, Free, EndFrame } type;
+	unsigned int id;
+	unsigned int size;	// Allocate only
+};
+
+namespace PoolAllocator
+{
+	// Drop-in for malloc and free: 16-byte aligned, never
+	// returns null, Free(0) does nothing.  Safe from any thread,
+	// and a block may be freed on a different thread than the
+	// one that allocated it
+	void* Allocate(size_t size);
+	void Free(void* memory);
+
+	// Call once per frame on the main thread.  Ends the frame's
+	// stats and the frame in a running trace
+	void EndFrame();
+	const PoolFrameStats& GetLastFrame();
+
+	// Requested bytes in use right now, and memory taken from
+	// the system for blocks (which is never given back)
+	unsigned long long GetBytesLive();
+	unsigned long long GetBytesReserved();
+
+	unsigned int GetSizeClassCount();
+	unsigned int GetSizeClassBlockSize(unsigned int sizeClass);
+	unsigned long long GetSizeClassBlocksLive(unsigned int sizeClass);
+
+	// Records every Allocate() and Free() for the next few
+	// frames, then writes them to path for Tools/ReplayAllocations
+	void StartTrace(const std::string& path, unsigned int frames);
+	bool IsTracing();
+	unsigned int GetTraceFramesLeft();
+	bool LastTraceSaved();
+
+	bool LoadTrace(const std::string& path, std::vector<PoolTraceEvent>& events);
+}
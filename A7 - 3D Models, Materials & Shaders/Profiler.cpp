@@ -0,0 +1,433 @@
+#include "Profiler.h"
+
+#include <Windows.h>
+#include <intrin.h>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
+// --------------- Basic usage -----------------
+//
+// Put a marker at the top of any block worth timing:
+//
+//   void Game::Update(float deltaTime, float totalTime)
+//   {
+//       PROFILE_SCOPE("Game::Update");
+//       ...
+//   }
+//
+// Markers nest, and can be used on any thread.  Each thread
+// writes into its own fixed-size ring of events, so a marker
+// costs two timestamp reads and never allocates or locks.
+// Tools/ProfilerOverhead.cpp measures what 10,000 of them
+// add to a frame.
+//
+// Once per frame, Profiler::EndFrame() (on the main thread)
+// reads every ring and collects the markers that finished,
+// which is what the profiler window in Game::BuildUI() shows.
+//
+// Timestamps come from the CPU's time stamp counter, which is
+// much cheaper to read than QueryPerformanceCounter().  It is
+// converted to milliseconds by comparing the two over the
+// whole run, which assumes an invariant TSC (any x64 CPU from
+// the last decade or so).
+//
+// ---------------------------------------------
+
+struct Profiler::Event
+{
+	const char* name;
+	long long start;
+	std::atomic<long long> end;	// Zero until the scope closes
+	unsigned int depth;
+};
+
+namespace
+{
+	const unsigned int MaxThreads = 32;
+	const unsigned int EventsPerThread = 1 << 14; // Must be a power of two
+	const unsigned int ThreadNameLength = 32;
+	const unsigned int MaxOpenScopes = 64;
+
+	// Startup frames are always slow, so they never count as spikes
+	const unsigned long long SpikeWarmupFrames = 30;
+
+	struct ThreadRing
+	{
+		char name[ThreadNameLength];
+		Profiler::Event* events;
+
+		// Written by the owning thread, read by EndFrame()
+		std::atomic<unsigned long long> head;
+
+		// Only touched by the owning thread
+		unsigned int depth;
+		const char* openScopes[MaxOpenScopes];
+
+		// Only touched by EndFrame()
+		unsigned long long collected;
+
+		// Set when the owning thread exits.  Once EndFrame() has
+		// drained the ring it becomes available to a new thread
+		std::atomic<bool> exited;
+		std::atomic<bool> available;
+	};
+
+	ThreadRing threads[MaxThreads];
+	std::atomic<unsigned int> threadCount{ 0 };
+	std::mutex registerMutex;
+
+	thread_local ThreadRing* currentThread = 0;
+	thread_local bool threadRejected = false;
+
+	// Marks the thread's ring as exited when the thread ends, so
+	// short-lived threads (like those from std::async) don't use
+	// up every ring
+	struct ThreadExitGuard
+	{
+		ThreadRing* ring = 0;
+		~ThreadExitGuard()
+		{
+			if (ring)
+				ring->exited.store(true, std::memory_order_release);
+		}
+	};
+	thread_local ThreadExitGuard threadExitGuard;
+
+	std::atomic<bool> enabled{ false };
+
+	// Converting time stamp counter ticks to milliseconds
+	long long startTicks = 0;
+	long long startCounter = 0;
+	double counterFrequency = 1.0;
+	double msPerTick = 0.0;
+
+	long long frameStartTicks = 0;
+	unsigned long long frameIndex = 0;
+
+	ProfileFrame lastFrame;
+	ProfileFrame spikeFrame;
+	bool spikeCapture = false;
+	float spikeThresholdMs = 33.3f;
+	bool paused = false;
+
+	// Scope stats, found by name pointer
+	std::vector<ProfileScopeStats> scopeStats;
+	std::vector<double> scopeFrameMs;
+	std::vector<unsigned int> scopeFrameCalls;
+	std::unordered_map<const char*, unsigned int> scopeLookup;
+
+	// Most samples in a row share a name, so a tiny cache in
+	// front of the map saves most of the hashing
+	const unsigned int ScopeCacheBits = 6;
+	const unsigned int ScopeCacheSize = 1 << ScopeCacheBits;
+	const char* scopeCacheNames[ScopeCacheSize] = {};
+	unsigned int scopeCacheIndices[ScopeCacheSize] = {};
+
+	long long ReadCounter()
+	{
+		LARGE_INTEGER counter = {};
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	// --------------------------------------------------------
+	// Gives the calling thread a ring, or returns null once
+	// every ring is taken
+	// --------------------------------------------------------
+	ThreadRing* RegisterThread(const char* name)
+	{
+		if (currentThread)
+			return currentThread;
+		if (threadRejected)
+			return 0;
+
+		std::lock_guard<std::mutex> lock(registerMutex);
+
+		// Reuse the ring of a thread that has exited
+		ThreadRing* ring = 0;
+		unsigned int count = threadCount.load();
+		for (unsigned int i = 0; i < count && !ring; i++)
+		{
+			bool available = true;
+			if (threads[i].available.compare_exchange_strong(available, false))
+				ring = &threads[i];
+		}
+
+		// Otherwise take a new one
+		if (!ring)
+		{
+			if (count >= MaxThreads)
+			{
+				threadRejected = true;
+				return 0;
+			}
+
+			ring = &threads[count];
+			ring->events = new Profiler::Event[EventsPerThread];
+			ring->head.store(0);
+			ring->collected = 0;
+
+			// Publishing the count makes the ring visible to EndFrame()
+			threadCount.store(count + 1, std::memory_order_release);
+		}
+
+		unsigned int index = (unsigned int)(ring - threads);
+		if (name)
+			snprintf(ring->name, ThreadNameLength, "%s", name);
+		else
+			snprintf(ring->name, ThreadNameLength, "Worker %u", index);
+		ring->depth = 0;
+
+		threadExitGuard.ring = ring;
+		currentThread = ring;
+		return currentThread;
+	}
+
+	unsigned int FindScope(const char* name)
+	{
+		// String literals sit a few bytes apart, so mix the
+		// pointer rather than dropping its low bits
+		unsigned int slot = (unsigned int)(((unsigned long long)(size_t)name * 0x9E3779B97F4A7C15ull) >> (64 - ScopeCacheBits));
+		if (scopeCacheNames[slot] == name)
+			return scopeCacheIndices[slot];
+
+		auto it = scopeLookup.find(name);
+		if (it != scopeLookup.end())
+		{
+			scopeCacheNames[slot] = name;
+			scopeCacheIndices[slot] = it->second;
+			return it->second;
+		}
+
+		ProfileScopeStats stats = {};
+		stats.name = name;
+		unsigned int index = (unsigned int)scopeStats.size();
+		scopeStats.push_back(stats);
+		scopeFrameMs.push_back(0.0);
+		scopeFrameCalls.push_back(0);
+		scopeLookup[name] = index;
+		return index;
+	}
+
+	// --------------------------------------------------------
+	// Moves every finished event from one thread's ring into
+	// the frame, stopping at the first one still open so it
+	// is picked up next frame
+	// --------------------------------------------------------
+	void CollectThread(unsigned int threadIndex, ProfileFrame& frame)
+	{
+		ThreadRing& ring = threads[threadIndex];
+		unsigned long long head = ring.head.load(std::memory_order_acquire);
+
+		// Anything older than one ring's worth was overwritten
+		if (head - ring.collected > EventsPerThread)
+			ring.collected = head - EventsPerThread;
+
+		// Locals, since the globals would otherwise be reloaded
+		// after every push_back()
+		unsigned long long next = ring.collected;
+		long long frameStart = frameStartTicks;
+		double tickMs = msPerTick;
+		for (; next < head; next++)
+		{
+			Profiler::Event& event = ring.events[next & (EventsPerThread - 1)];
+			long long end = event.end.load(std::memory_order_acquire);
+			if (end == 0)
+				break;
+
+			ProfileSample sample = {};
+			sample.name = event.name;
+			sample.startMs = (event.start - frameStart) * tickMs;
+			sample.durationMs = (end - event.start) * tickMs;
+			sample.depth = event.depth;
+			sample.thread = threadIndex;
+			frame.samples.push_back(sample);
+
+			unsigned int scope = FindScope(sample.name);
+			scopeFrameMs[scope] += sample.durationMs;
+			scopeFrameCalls[scope]++;
+		}
+		ring.collected = next;
+
+		// Nothing more can arrive from a thread that has exited
+		if (ring.collected == head && ring.exited.load(std::memory_order_acquire))
+		{
+			ring.exited.store(false);
+			ring.available.store(true, std::memory_order_release);
+		}
+	}
+}
+
+void Profiler::Initialize()
+{
+	LARGE_INTEGER frequency = {};
+	QueryPerformanceFrequency(&frequency);
+	counterFrequency = (double)frequency.QuadPart;
+	startCounter = ReadCounter();
+	startTicks = (long long)__rdtsc();
+	frameStartTicks = startTicks;
+
+	lastFrame.samples.reserve(EventsPerThread);
+	spikeFrame.samples.reserve(EventsPerThread);
+	scopeStats.reserve(256);
+
+	RegisterThread("Main");
+	enabled = true;
+}
+
+void Profiler::ShutDown()
+{
+	enabled = false;
+
+	std::lock_guard<std::mutex> lock(registerMutex);
+	unsigned int count = threadCount.load();
+	for (unsigned int i = 0; i < count; i++)
+	{
+		delete[] threads[i].events;
+		threads[i].events = 0;
+	}
+	threadCount = 0;
+	currentThread = 0;
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	ThreadRing* ring = currentThread ? currentThread : RegisterThread(name);
+	if (ring)
+		snprintf(ring->name, ThreadNameLength, "%s", name);
+}
+
+void Profiler::BeginFrame()
+{
+	frameStartTicks = (long long)__rdtsc();
+}
+
+// --------------------------------------------------------
+// Collects the frame's markers from every thread, updates
+// the per-scope stats and checks for a spike
+// --------------------------------------------------------
+void Profiler::EndFrame()
+{
+	long long frameEndTicks = (long long)__rdtsc();
+
+	// Refine the tick rate against the performance counter,
+	// which gets more accurate the longer the app runs
+	double elapsedSeconds = (ReadCounter() - startCounter) / counterFrequency;
+	if (elapsedSeconds > 0.0 && frameEndTicks > startTicks)
+		msPerTick = elapsedSeconds * 1000.0 / (double)(frameEndTicks - startTicks);
+
+	lastFrame.index = frameIndex++;
+	lastFrame.startMs = (frameStartTicks - startTicks) * msPerTick;
+	lastFrame.durationMs = (frameEndTicks - frameStartTicks) * msPerTick;
+	lastFrame.samples.clear();
+
+	unsigned int count = threadCount.load(std::memory_order_acquire);
+	for (unsigned int i = 0; i < count; i++)
+		CollectThread(i, lastFrame);
+
+	for (size_t i = 0; i < scopeStats.size(); i++)
+	{
+		ProfileScopeStats& stats = scopeStats[i];
+		stats.calls = scopeFrameCalls[i];
+		stats.lastMs = scopeFrameMs[i];
+		if (stats.calls > 0)
+		{
+			stats.minMs = (stats.frames == 0 || stats.lastMs < stats.minMs) ? stats.lastMs : stats.minMs;
+			stats.maxMs = (stats.frames == 0 || stats.lastMs > stats.maxMs) ? stats.lastMs : stats.maxMs;
+			stats.totalMs += stats.lastMs;
+			stats.frames++;
+		}
+
+		scopeFrameMs[i] = 0.0;
+		scopeFrameCalls[i] = 0;
+	}
+
+	if (spikeCapture && !paused &&
+		lastFrame.index >= SpikeWarmupFrames &&
+		lastFrame.durationMs > spikeThresholdMs)
+	{
+		spikeFrame = lastFrame;
+		paused = true;
+	}
+}
+
+void Profiler::SetEnabled(bool enable) { enabled = enable; }
+bool Profiler::IsEnabled() { return enabled; }
+
+void Profiler::SetSpikeCapture(bool enable, float thresholdMs)
+{
+	spikeCapture = enable;
+	spikeThresholdMs = thresholdMs;
+}
+
+bool Profiler::IsSpikeCaptureEnabled() { return spikeCapture; }
+float Profiler::GetSpikeThreshold() { return spikeThresholdMs; }
+bool Profiler::IsPaused() { return paused; }
+void Profiler::Resume() { paused = false; }
+
+const ProfileFrame& Profiler::GetDisplayedFrame() { return paused ? spikeFrame : lastFrame; }
+const ProfileFrame& Profiler::GetLastFrame() { return lastFrame; }
+
+const std::vector<ProfileScopeStats>& Profiler::GetScopeStats() { return scopeStats; }
+
+void Profiler::ResetStats()
+{
+	for (ProfileScopeStats& stats : scopeStats)
+	{
+		const char* name = stats.name;
+		stats = {};
+		stats.name = name;
+	}
+}
+
+unsigned int Profiler::GetThreadCount() { return threadCount.load(std::memory_order_acquire); }
+const char* Profiler::GetThreadName(unsigned int thread) { return thread < GetThreadCount() ? threads[thread].name : ""; }
+
+// --------------------------------------------------------
+// Opens a scope on the calling thread.  Returns null when
+// profiling is off, so the matching Pop() is skipped
+// --------------------------------------------------------
+Profiler::Event* Profiler::Push(const char* name)
+{
+	if (!enabled.load(std::memory_order_relaxed))
+		return 0;
+
+	ThreadRing* ring = currentThread ? currentThread : RegisterThread(0);
+	if (!ring)
+		return 0;
+
+	unsigned long long index = ring->head.load(std::memory_order_relaxed);
+	Event* event = &ring->events[index & (EventsPerThread - 1)];
+	event->name = name;
+	event->depth = ring->depth++;
+	if (event->depth < MaxOpenScopes)
+		ring->openScopes[event->depth] = name;
+	event->end.store(0, std::memory_order_relaxed);
+	event->start = (long long)__rdtsc();
+
+	ring->head.store(index + 1, std::memory_order_release);
+	return event;
+}
+
+void Profiler::Pop(Event* event)
+{
+	event->end.store((long long)__rdtsc(), std::memory_order_release);
+	currentThread->depth--;
+}
+
+// --------------------------------------------------------
+// Name of the innermost open scope on the calling thread,
+// or null outside of any scope (or while disabled).  Scopes
+// nested deeper than MaxOpenScopes report their ancestor
+// --------------------------------------------------------
+const char* Profiler::GetCurrentScope()
+{
+	ThreadRing* ring = currentThread;
+	if (!ring || ring->depth == 0)
+		return 0;
+
+	unsigned int depth = ring->depth - 1;
+	return ring->openScopes[depth < MaxOpenScopes ? depth : MaxOpenScopes - 1];
+}
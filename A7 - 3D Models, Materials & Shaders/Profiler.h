@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+
+// See Profiler.cpp for usage details
+
+// Joins two tokens after expanding them, so every scope
+// marker on a line gets its own variable name
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing block.  The name must be a
+// string literal (or otherwise outlive the profiler), since
+// only the pointer is stored
+#define PROFILE_SCOPE(name) Profiler::Scope PROFILER_CONCAT(profileScope, __LINE__)(name)
+
+// One finished scope from a collected frame
+struct ProfileSample
+{
+	const char* name;
+	double startMs;		// Relative to the start of the frame
+	double durationMs;
+	unsigned int depth;	// 0 for outermost scopes
+	unsigned int thread;	// Index for Profiler::GetThreadName()
+};
+
+struct ProfileFrame
+{
+	unsigned long long index;
+	double startMs;		// Since Profiler::Initialize()
+	double durationMs;
+	std::vector<ProfileSample> samples;
+};
+
+// Per-scope totals, one entry per scope name.  A scope that
+// runs several times in a frame counts as the sum of its runs
+struct ProfileScopeStats
+{
+	const char* name;
+	unsigned int calls;	// Last frame
+	double lastMs;
+	double minMs;
+	double maxMs;
+	double totalMs;
+	unsigned int frames;
+};
+
+namespace Profiler
+{
+	void Initialize();
+	void ShutDown();
+
+	// Names the calling thread.  Threads that never call this
+	// are named "Worker N" the first time they hit a marker
+	void SetThreadName(const char* name);
+
+	// Brackets one frame on the main thread.  EndFrame()
+	// collects every marker that finished during the frame
+	void BeginFrame();
+	void EndFrame();
+
+	void SetEnabled(bool enable);
+	bool IsEnabled();
+
+	// Freezes the displayed frame on the first one slower
+	// than the threshold, until Resume() is called
+	void SetSpikeCapture(bool enable, float thresholdMs);
+	bool IsSpikeCaptureEnabled();
+	float GetSpikeThreshold();
+	bool IsPaused();
+	void Resume();
+
+	// Latest frame, or the captured spike while paused
+	const ProfileFrame& GetDisplayedFrame();
+	const ProfileFrame& GetLastFrame();
+
+	const std::vector<ProfileScopeStats>& GetScopeStats();
+	void ResetStats();
+
+	unsigned int GetThreadCount();
+	const char* GetThreadName(unsigned int thread);
+
+	// Innermost open scope on the calling thread, or null
+	const char* GetCurrentScope();
+
+	// Used by PROFILE_SCOPE
+	struct Event;
+	Event* Push(const char* name);
+	void Pop(Event* event);
+
+	class Scope
+	{
+	public:
+		explicit Scope(const char* name) : event(Push(name)) {}
+		~Scope() { if (event) Pop(event); }
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		Event* event;
+	};
+}
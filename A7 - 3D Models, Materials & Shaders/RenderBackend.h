@@ -0,0 +1,14 @@
+#pragma once
+
+#include "RenderCommands.h"
+
+// --------------------------------------------------------
+// Something that carries out a RenderCommandStream
+// --------------------------------------------------------
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	virtual void Execute(const RenderCommandStream& stream) = 0;
+};
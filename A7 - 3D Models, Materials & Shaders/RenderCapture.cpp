@@ -0,0 +1,94 @@
+#include "RenderCapture.h"
+
+#include <fstream>
+#include <cstring>
+
+namespace
+{
+	const char Magic[4] = { 'R', 'C', 'A', 'P' };
+	const unsigned int Version = 1;
+
+	// Sanity limit, so a damaged file can't ask for gigabytes
+	const unsigned int MaxFrameBytes = 256 * 1024 * 1024;
+}
+
+void RenderCapture::Clear()
+{
+	frames.clear();
+}
+
+void RenderCapture::AddFrame(const RenderCommandStream& stream)
+{
+	frames.push_back(stream);
+}
+
+bool RenderCapture::Save(const std::string& path) const
+{
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	unsigned int frameCount = (unsigned int)frames.size();
+	file.write(Magic, sizeof(Magic));
+	file.write((const char*)&Version, sizeof(Version));
+	file.write((const char*)&frameCount, sizeof(frameCount));
+
+	for (const RenderCommandStream& frame : frames)
+	{
+		unsigned int commandCount = frame.GetCommandCount();
+		unsigned int byteCount = (unsigned int)frame.GetSize();
+		file.write((const char*)&commandCount, sizeof(commandCount));
+		file.write((const char*)&byteCount, sizeof(byteCount));
+		file.write((const char*)frame.GetData(), byteCount);
+	}
+
+	return (bool)file;
+}
+
+bool RenderCapture::Load(const std::string& path)
+{
+	frames.clear();
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	char magic[4] = {};
+	unsigned int version = 0;
+	unsigned int frameCount = 0;
+	file.read(magic, sizeof(magic));
+	file.read((char*)&version, sizeof(version));
+	file.read((char*)&frameCount, sizeof(frameCount));
+	if (!file || memcmp(magic, Magic, sizeof(Magic)) != 0 || version != Version)
+		return false;
+
+	std::vector<unsigned char> bytes;
+	for (unsigned int i = 0; i < frameCount; i++)
+	{
+		unsigned int commandCount = 0;
+		unsigned int byteCount = 0;
+		file.read((char*)&commandCount, sizeof(commandCount));
+		file.read((char*)&byteCount, sizeof(byteCount));
+		if (!file || byteCount > MaxFrameBytes)
+		{
+			frames.clear();
+			return false;
+		}
+
+		bytes.resize(byteCount);
+		file.read((char*)bytes.data(), byteCount);
+		if (!file)
+		{
+			frames.clear();
+			return false;
+		}
+
+		frames.emplace_back();
+		frames.back().Assign(bytes.data(), bytes.size(), commandCount);
+	}
+
+	return true;
+}
+
+unsigned int RenderCapture::GetFrameCount() const { return (unsigned int)frames.size(); }
+const RenderCommandStream& RenderCapture::GetFrame(unsigned int index) const { return frames[index]; }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "RenderCommands.h"
+
+// --------------------------------------------------------
+// A run of captured frames that can be saved and loaded
+//
+// File layout (little endian):
+//   "RCAP", version, frame count
+//   per frame: command count, byte count, command bytes
+//
+// Handles in the commands are saved as-is, so a capture
+// only means something to a backend that doesn't need the
+// real objects behind them (like NullRenderBackend)
+// --------------------------------------------------------
+class RenderCapture
+{
+public:
+	void Clear();
+	void AddFrame(const RenderCommandStream& stream);
+
+	bool Save(const std::string& path) const;
+	bool Load(const std::string& path);
+
+	unsigned int GetFrameCount() const;
+	const RenderCommandStream& GetFrame(unsigned int index) const;
+
+private:
+	std::vector<RenderCommandStream> frames;
+};
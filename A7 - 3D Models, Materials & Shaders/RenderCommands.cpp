@@ -0,0 +1,191 @@
+#include "RenderCommands.h"
+
+#include <cstring>
+
+namespace
+{
+	unsigned int AlignTo4(unsigned int value)
+	{
+		return (value + 3) & ~3u;
+	}
+}
+
+unsigned int RenderCommandSize(RenderCommandType type)
+{
+	switch (type)
+	{
+	case RenderCommandType::SetTopology:			return sizeof(SetTopologyCommand);
+	case RenderCommandType::SetInputLayout:
+	case RenderCommandType::SetVertexShader:
+	case RenderCommandType::SetPixelShader:			return sizeof(SetResourceCommand);
+	case RenderCommandType::SetVertexBuffers:		return sizeof(SetVertexBuffersCommand);
+	case RenderCommandType::SetIndexBuffer:			return sizeof(SetIndexBufferCommand);
+	case RenderCommandType::SetVSConstantBuffer:	return sizeof(SetConstantBufferCommand);
+	case RenderCommandType::UploadBuffer:			return sizeof(UploadBufferCommand);
+	case RenderCommandType::SetVSConstants:			return sizeof(SetConstantsCommand);
+	case RenderCommandType::DrawIndexed:			return sizeof(DrawIndexedCommand);
+	case RenderCommandType::DrawIndexedInstanced:	return sizeof(DrawIndexedInstancedCommand);
+	default:										return 0;
+	}
+}
+
+RenderCommandStream::RenderCommandStream() :
+	commandCount(0)
+{
+}
+
+// Keeps the memory, so a stream reused every frame stops
+// allocating once it has seen its biggest frame
+void RenderCommandStream::Clear()
+{
+	bytes.clear();
+	commandCount = 0;
+}
+
+// --------------------------------------------------------
+// Appends a header, room for the command struct and a copy
+// of the payload.  Returns where the command struct goes
+// --------------------------------------------------------
+void* RenderCommandStream::Push(RenderCommandType type, unsigned int commandSize, const void* payload, unsigned int payloadSize)
+{
+	unsigned int size = AlignTo4(sizeof(RenderCommandHeader) + commandSize + payloadSize);
+
+	size_t start = bytes.size();
+	bytes.resize(start + size);
+	unsigned char* dest = bytes.data() + start;
+
+	RenderCommandHeader header = { type, size };
+	memcpy(dest, &header, sizeof(header));
+	if (payloadSize > 0)
+		memcpy(dest + sizeof(header) + commandSize, payload, payloadSize);
+
+	commandCount++;
+	return dest + sizeof(header);
+}
+
+void RenderCommandStream::SetTopology(unsigned int topology)
+{
+	SetTopologyCommand command = { topology };
+	memcpy(Push(RenderCommandType::SetTopology, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::SetInputLayout(ResourceHandle layout)
+{
+	SetResourceCommand command = { layout };
+	memcpy(Push(RenderCommandType::SetInputLayout, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::SetVertexShader(ResourceHandle shader)
+{
+	SetResourceCommand command = { shader };
+	memcpy(Push(RenderCommandType::SetVertexShader, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::SetPixelShader(ResourceHandle shader)
+{
+	SetResourceCommand command = { shader };
+	memcpy(Push(RenderCommandType::SetPixelShader, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::SetVertexBuffers(unsigned int startSlot, unsigned int count, const ResourceHandle* buffers, const unsigned int* strides, const unsigned int* offsets)
+{
+	SetVertexBuffersCommand command = {};
+	command.startSlot = startSlot;
+	command.count = count < MaxStreamVertexBuffers ? count : MaxStreamVertexBuffers;
+	for (unsigned int i = 0; i < command.count; i++)
+	{
+		command.buffers[i] = buffers[i];
+		command.strides[i] = strides[i];
+		command.offsets[i] = offsets[i];
+	}
+	memcpy(Push(RenderCommandType::SetVertexBuffers, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::SetIndexBuffer(ResourceHandle buffer, unsigned int format, unsigned int offset)
+{
+	SetIndexBufferCommand command = { buffer, format, offset };
+	memcpy(Push(RenderCommandType::SetIndexBuffer, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::SetVSConstantBuffer(unsigned int slot, ResourceHandle buffer)
+{
+	SetConstantBufferCommand command = { slot, buffer };
+	memcpy(Push(RenderCommandType::SetVSConstantBuffer, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::UploadBuffer(ResourceHandle buffer, const void* data, unsigned int size)
+{
+	UploadBufferCommand command = { buffer, size };
+	memcpy(Push(RenderCommandType::UploadBuffer, sizeof(command), data, size), &command, sizeof(command));
+}
+
+void RenderCommandStream::SetVSConstants(unsigned int slot, const void* data, unsigned int size)
+{
+	SetConstantsCommand command = { slot, size };
+	memcpy(Push(RenderCommandType::SetVSConstants, sizeof(command), data, size), &command, sizeof(command));
+}
+
+void RenderCommandStream::DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex)
+{
+	DrawIndexedCommand command = { indexCount, startIndex, baseVertex };
+	memcpy(Push(RenderCommandType::DrawIndexed, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+void RenderCommandStream::DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount, unsigned int startIndex, int baseVertex, unsigned int startInstance)
+{
+	DrawIndexedInstancedCommand command = { indexCount, instanceCount, startIndex, baseVertex, startInstance };
+	memcpy(Push(RenderCommandType::DrawIndexedInstanced, sizeof(command), 0, 0), &command, sizeof(command));
+}
+
+const unsigned char* RenderCommandStream::GetData() const { return bytes.data(); }
+size_t RenderCommandStream::GetSize() const { return bytes.size(); }
+unsigned int RenderCommandStream::GetCommandCount() const { return commandCount; }
+
+void RenderCommandStream::Assign(const unsigned char* data, size_t size, unsigned int commandCount)
+{
+	bytes.assign(data, data + size);
+	this->commandCount = commandCount;
+}
+
+RenderCommandReader::RenderCommandReader(const RenderCommandStream& stream) :
+	cursor(stream.GetData()),
+	end(stream.GetData() + stream.GetSize())
+{
+}
+
+// --------------------------------------------------------
+// Decodes the next command.  Stops early on anything that
+// doesn't look right, since streams can come from files
+// --------------------------------------------------------
+bool RenderCommandReader::Next(RenderCommand& command)
+{
+	if (end - cursor < (ptrdiff_t)sizeof(RenderCommandHeader))
+		return false;
+
+	RenderCommandHeader header;
+	memcpy(&header, cursor, sizeof(header));
+
+	unsigned int commandSize = RenderCommandSize(header.type);
+	if (commandSize == 0 ||
+		header.size < sizeof(header) + commandSize ||
+		header.size > (size_t)(end - cursor))
+		return false;
+
+	command.type = header.type;
+	command.data = cursor + sizeof(header);
+	command.payload = cursor + sizeof(header) + commandSize;
+	command.payloadSize = 0;
+
+	unsigned int payloadSize = 0;
+	if (header.type == RenderCommandType::UploadBuffer)
+		payloadSize = command.As<UploadBufferCommand>().size;
+	else if (header.type == RenderCommandType::SetVSConstants)
+		payloadSize = command.As<SetConstantsCommand>().size;
+
+	if (payloadSize > header.size - sizeof(header) - commandSize)
+		return false;
+	command.payloadSize = payloadSize;
+
+	cursor += header.size;
+	return true;
+}
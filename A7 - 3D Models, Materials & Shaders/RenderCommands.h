@@ -0,0 +1,171 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// --------------------------------------------------------
+// A frame's worth of rendering work as plain data
+//
+// Draws, binds and constant uploads are appended to a
+// RenderCommandStream instead of going straight to the
+// graphics API.  A backend then walks the stream and does
+// the actual work (see D3D11RenderBackend and
+// NullRenderBackend), and the same bytes can be written to a
+// capture file and replayed later, on any platform
+//
+// Nothing in here includes a graphics API header.  GPU
+// objects are referred to by small handles (see
+// RenderResources), and enums like the topology or index
+// format are stored as their numeric D3D11 values
+// --------------------------------------------------------
+
+typedef unsigned int ResourceHandle;
+const ResourceHandle NoResource = 0;
+
+enum class RenderCommandType : unsigned int
+{
+	SetTopology,
+	SetInputLayout,
+	SetVertexShader,
+	SetPixelShader,
+	SetVertexBuffers,
+	SetIndexBuffer,
+	SetVSConstantBuffer,
+	UploadBuffer,			// Replaces a dynamic buffer's contents
+	SetVSConstants,			// Per-draw constants, backend picks where they live
+	DrawIndexed,
+	DrawIndexedInstanced,
+
+	Count
+};
+
+// Every command starts with this.  size covers the header,
+// the command struct and any payload, rounded up to 4 bytes
+struct RenderCommandHeader
+{
+	RenderCommandType type;
+	unsigned int size;
+};
+
+const unsigned int MaxStreamVertexBuffers = 2;
+
+struct SetTopologyCommand { unsigned int topology; };
+struct SetResourceCommand { ResourceHandle resource; };
+
+struct SetVertexBuffersCommand
+{
+	unsigned int startSlot;
+	unsigned int count;
+	ResourceHandle buffers[MaxStreamVertexBuffers];
+	unsigned int strides[MaxStreamVertexBuffers];
+	unsigned int offsets[MaxStreamVertexBuffers];
+};
+
+struct SetIndexBufferCommand
+{
+	ResourceHandle buffer;
+	unsigned int format;
+	unsigned int offset;
+};
+
+struct SetConstantBufferCommand
+{
+	unsigned int slot;
+	ResourceHandle buffer;
+};
+
+// Followed by size bytes of data
+struct UploadBufferCommand
+{
+	ResourceHandle buffer;
+	unsigned int size;
+};
+
+// Followed by size bytes of data
+struct SetConstantsCommand
+{
+	unsigned int slot;
+	unsigned int size;
+};
+
+struct DrawIndexedCommand
+{
+	unsigned int indexCount;
+	unsigned int startIndex;
+	int baseVertex;
+};
+
+struct DrawIndexedInstancedCommand
+{
+	unsigned int indexCount;
+	unsigned int instanceCount;
+	unsigned int startIndex;
+	int baseVertex;
+	unsigned int startInstance;
+};
+
+// One decoded command, pointing back into the stream
+struct RenderCommand
+{
+	RenderCommandType type;
+	const void* data;			// The command struct
+	const void* payload;		// Upload data, if any
+	unsigned int payloadSize;
+
+	template<typename T> const T& As() const { return *(const T*)data; }
+};
+
+class RenderCommandStream
+{
+public:
+	RenderCommandStream();
+
+	void Clear();
+
+	// Recording
+	void SetTopology(unsigned int topology);
+	void SetInputLayout(ResourceHandle layout);
+	void SetVertexShader(ResourceHandle shader);
+	void SetPixelShader(ResourceHandle shader);
+	void SetVertexBuffers(unsigned int startSlot, unsigned int count, const ResourceHandle* buffers, const unsigned int* strides, const unsigned int* offsets);
+	void SetIndexBuffer(ResourceHandle buffer, unsigned int format, unsigned int offset);
+	void SetVSConstantBuffer(unsigned int slot, ResourceHandle buffer);
+	void UploadBuffer(ResourceHandle buffer, const void* data, unsigned int size);
+	void SetVSConstants(unsigned int slot, const void* data, unsigned int size);
+	void DrawIndexed(unsigned int indexCount, unsigned int startIndex, int baseVertex);
+	void DrawIndexedInstanced(unsigned int indexCount, unsigned int instanceCount, unsigned int startIndex, int baseVertex, unsigned int startInstance);
+
+	// Raw access, for captures
+	const unsigned char* GetData() const;
+	size_t GetSize() const;
+	unsigned int GetCommandCount() const;
+	void Assign(const unsigned char* data, size_t size, unsigned int commandCount);
+
+private:
+	void* Push(RenderCommandType type, unsigned int commandSize, const void* payload, unsigned int payloadSize);
+
+	std::vector<unsigned char> bytes;
+	unsigned int commandCount;
+};
+
+// --------------------------------------------------------
+// Walks a stream front to back:
+//
+//   RenderCommandReader reader(stream);
+//   RenderCommand command;
+//   while (reader.Next(command)) { ... }
+// --------------------------------------------------------
+class RenderCommandReader
+{
+public:
+	RenderCommandReader(const RenderCommandStream& stream);
+
+	bool Next(RenderCommand& command);
+
+private:
+	const unsigned char* cursor;
+	const unsigned char* end;
+};
+
+// Size of the struct for each command type, for decoding
+unsigned int RenderCommandSize(RenderCommandType type);
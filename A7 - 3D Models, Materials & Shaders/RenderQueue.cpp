@@ -0,0 +1,138 @@
+#include "RenderQueue.h"
+
+#include <cstring>
+
+namespace
+{
+	const unsigned int DepthBits = 24;
+	const unsigned int MeshBits = 24;
+	const unsigned int ShaderBits = 12;
+
+	const unsigned int DepthMax = (1u << DepthBits) - 1;
+	const unsigned int MeshMask = (1u << MeshBits) - 1;
+	const unsigned int ShaderMask = (1u << ShaderBits) - 1;
+
+	// Radix sort works one byte of the key at a time
+	const unsigned int RadixPasses = 8;
+	const unsigned int RadixBuckets = 256;
+}
+
+RenderQueue::RenderQueue()
+{
+}
+
+void RenderQueue::Clear()
+{
+	items.clear();
+}
+
+void RenderQueue::Add(unsigned long long key, unsigned int entityIndex)
+{
+	items.push_back({ key, entityIndex });
+}
+
+void RenderQueue::Sort(DrawItem* scratch)
+{
+	RadixSort(items.data(), scratch, items.size());
+}
+
+const std::vector<DrawItem>& RenderQueue::GetItems() { return items; }
+size_t RenderQueue::GetCount() { return items.size(); }
+
+
+// --------------------------------------------------------
+// Maps a view space depth to [0, 2^24 - 1] between the
+// camera's clip planes.  Anything outside is clamped
+// --------------------------------------------------------
+unsigned int RenderQueue::QuantizeDepth(float viewDepth, float nearClip, float farClip)
+{
+	float range = farClip - nearClip;
+	if (range <= 0.0f)
+		return 0;
+
+	float t = (viewDepth - nearClip) / range;
+	if (!(t > 0.0f)) return 0; // Also catches NaN
+	if (t >= 1.0f) return DepthMax;
+
+	return (unsigned int)(t * (float)DepthMax);
+}
+
+unsigned long long RenderQueue::MakeOpaqueKey(unsigned int shaderID, unsigned int meshID, unsigned int depth)
+{
+	return ((unsigned long long)RenderPass::Opaque << 60) |
+		((unsigned long long)(shaderID & ShaderMask) << 48) |
+		((unsigned long long)(meshID & MeshMask) << 24) |
+		(unsigned long long)(depth & DepthMax);
+}
+
+unsigned long long RenderQueue::MakeTransparentKey(unsigned int shaderID, unsigned int meshID, unsigned int depth)
+{
+	// Farther items need to come first, so flip the depth
+	unsigned int inverted = DepthMax - (depth & DepthMax);
+
+	return ((unsigned long long)RenderPass::Transparent << 60) |
+		((unsigned long long)inverted << 36) |
+		((unsigned long long)(shaderID & ShaderMask) << 24) |
+		(unsigned long long)(meshID & MeshMask);
+}
+
+
+// --------------------------------------------------------
+// Stable LSD radix sort on the 64-bit key
+//
+// All eight byte histograms are built in a single read of
+// the input, and any byte that is the same for every key
+// (like the pass bits when nothing is transparent) is
+// skipped entirely
+// --------------------------------------------------------
+void RenderQueue::RadixSort(DrawItem* items, DrawItem* scratch, size_t count)
+{
+	if (count < 2)
+		return;
+
+	size_t histograms[RadixPasses][RadixBuckets];
+	memset(histograms, 0, sizeof(histograms));
+
+	for (size_t i = 0; i < count; i++)
+	{
+		unsigned long long key = items[i].key;
+		for (unsigned int pass = 0; pass < RadixPasses; pass++)
+			histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+	}
+
+	DrawItem* src = items;
+	DrawItem* dst = scratch;
+
+	for (unsigned int pass = 0; pass < RadixPasses; pass++)
+	{
+		size_t* histogram = histograms[pass];
+
+		// Every key has the same byte here, nothing would move
+		unsigned int firstByte = (unsigned int)((src[0].key >> (pass * 8)) & 0xFF);
+		if (histogram[firstByte] == count)
+			continue;
+
+		// Turn counts into starting offsets
+		size_t offset = 0;
+		for (unsigned int b = 0; b < RadixBuckets; b++)
+		{
+			size_t bucketCount = histogram[b];
+			histogram[b] = offset;
+			offset += bucketCount;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			unsigned int b = (unsigned int)((src[i].key >> (pass * 8)) & 0xFF);
+			dst[histogram[b]++] = src[i];
+		}
+
+		DrawItem* temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	// Make sure the sorted result ends up in the caller's array
+	if (src != items)
+		memcpy(items, src, count * sizeof(DrawItem));
+}
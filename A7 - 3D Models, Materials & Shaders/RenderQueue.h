@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// Which part of the frame an item is drawn in.  This is the
+// top of the sort key, so every opaque item sorts before any
+// transparent one
+enum class RenderPass
+{
+	Opaque = 0,
+	Transparent = 1
+};
+
+// A single thing to draw this frame: its sort key and the
+// index of the entity it came from
+struct DrawItem
+{
+	unsigned long long key;
+	unsigned int entityIndex;
+};
+
+// --------------------------------------------------------
+// Collects the visible items for a frame and sorts them by
+// a packed 64-bit key so state changes are grouped and
+// depth testing can reject hidden pixels early
+//
+// Opaque key:      [pass:4][shader:12][mesh:24][depth:24]
+//  - Grouped by state, then front-to-back inside a group
+// Transparent key: [pass:4][inverted depth:24][shader:12][mesh:24]
+//  - Strictly back-to-front, state only breaks ties
+// --------------------------------------------------------
+class RenderQueue
+{
+public:
+	RenderQueue();
+
+	void Clear();
+	void Add(unsigned long long key, unsigned int entityIndex);
+
+	// Sorts by key.  The caller's scratch must hold at least
+	// GetCount() items (Game takes it from the frame arena)
+	void Sort(DrawItem* scratch);
+
+	const std::vector<DrawItem>& GetItems();
+	size_t GetCount();
+
+	// Key packing
+	static unsigned int QuantizeDepth(float viewDepth, float nearClip, float farClip);
+	static unsigned long long MakeOpaqueKey(unsigned int shaderID, unsigned int meshID, unsigned int depth);
+	static unsigned long long MakeTransparentKey(unsigned int shaderID, unsigned int meshID, unsigned int depth);
+
+	// Sorts count items by key, using scratch (which must hold
+	// at least count items) as the ping-pong buffer
+	static void RadixSort(DrawItem* items, DrawItem* scratch, size_t count);
+
+private:
+	std::vector<DrawItem> items;
+};
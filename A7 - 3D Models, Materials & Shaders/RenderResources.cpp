@@ -0,0 +1,82 @@
+#include "RenderResources.h"
+
+#include <vector>
+#include <wrl/client.h>
+
+// --------------- Basic usage -----------------
+//
+// Render commands can't hold pointers (they get written to
+// capture files), so GPU objects are registered here once
+// and referred to by handle from then on:
+//
+//   ResourceHandle vs = RenderResources::AddVertexShader(shader.Get());
+//   stream.SetVertexShader(vs);
+//
+// Each kind of object has its own table, and handles start
+// at 1 so NoResource (0) is never a real object.  Handles
+// are never reused, so a stale one finds nothing rather than
+// somebody else's buffer
+//
+// ---------------------------------------------
+
+namespace
+{
+	template<typename T>
+	class ResourceTable
+	{
+	public:
+		ResourceTable() : items(1) {}
+
+		ResourceHandle Add(T* item)
+		{
+			items.push_back(item);
+			return (ResourceHandle)(items.size() - 1);
+		}
+
+		void Remove(ResourceHandle handle)
+		{
+			if (handle < items.size())
+				items[handle].Reset();
+		}
+
+		T* Get(ResourceHandle handle)
+		{
+			return handle < items.size() ? items[handle].Get() : 0;
+		}
+
+		void Clear()
+		{
+			items.clear();
+			items.resize(1);
+		}
+
+	private:
+		std::vector<Microsoft::WRL::ComPtr<T>> items;
+	};
+
+	ResourceTable<ID3D11Buffer> buffers;
+	ResourceTable<ID3D11InputLayout> inputLayouts;
+	ResourceTable<ID3D11VertexShader> vertexShaders;
+	ResourceTable<ID3D11PixelShader> pixelShaders;
+}
+
+// Lets go of everything before the device goes away
+void RenderResources::ShutDown()
+{
+	buffers.Clear();
+	inputLayouts.Clear();
+	vertexShaders.Clear();
+	pixelShaders.Clear();
+}
+
+ResourceHandle RenderResources::AddBuffer(ID3D11Buffer* buffer) { return buffers.Add(buffer); }
+ResourceHandle RenderResources::AddInputLayout(ID3D11InputLayout* inputLayout) { return inputLayouts.Add(inputLayout); }
+ResourceHandle RenderResources::AddVertexShader(ID3D11VertexShader* shader) { return vertexShaders.Add(shader); }
+ResourceHandle RenderResources::AddPixelShader(ID3D11PixelShader* shader) { return pixelShaders.Add(shader); }
+
+void RenderResources::RemoveBuffer(ResourceHandle handle) { buffers.Remove(handle); }
+
+ID3D11Buffer* RenderResources::GetBuffer(ResourceHandle handle) { return buffers.Get(handle); }
+ID3D11InputLayout* RenderResources::GetInputLayout(ResourceHandle handle) { return inputLayouts.Get(handle); }
+ID3D11VertexShader* RenderResources::GetVertexShader(ResourceHandle handle) { return vertexShaders.Get(handle); }
+ID3D11PixelShader* RenderResources::GetPixelShader(ResourceHandle handle) { return pixelShaders.Get(handle); }
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <d3d11.h>
+
+#include "RenderCommands.h"
+
+// See RenderResources.cpp for usage details
+
+namespace RenderResources
+{
+	void ShutDown();
+
+	ResourceHandle AddBuffer(ID3D11Buffer* buffer);
+	ResourceHandle AddInputLayout(ID3D11InputLayout* inputLayout);
+	ResourceHandle AddVertexShader(ID3D11VertexShader* shader);
+	ResourceHandle AddPixelShader(ID3D11PixelShader* shader);
+
+	void RemoveBuffer(ResourceHandle handle);
+
+	ID3D11Buffer* GetBuffer(ResourceHandle handle);
+	ID3D11InputLayout* GetInputLayout(ResourceHandle handle);
+	ID3D11VertexShader* GetVertexShader(ResourceHandle handle);
+	ID3D11PixelShader* GetPixelShader(ResourceHandle handle);
+}
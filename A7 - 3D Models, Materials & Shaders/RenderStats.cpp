@@ -0,0 +1,130 @@
+#include "RenderStats.h"
+
+#include <atomic>
+
+// --------------- Basic usage -----------------
+//
+// Every place that reaches a D3D11 context or device counts
+// what it did here, right next to the call:
+//
+//   Graphics::Context->DrawIndexed(indexCount, 0, 0);
+//   RenderStats::CountDraw(indexCount);
+//
+// Counts go to whichever pass is current, so Game::Draw()
+// wraps each part of the frame in a PassScope:
+//
+//   {
+//       RenderStats::PassScope pass(StatsPass::Opaque);
+//       renderBackend.Execute(frameCommands);
+//   }
+//
+// Anything outside a pass is charged to StatsPass::Frame.
+// At the end of the frame, RenderStats::EndFrame() makes the
+// counts readable through GetLastFrame(), which is what the
+// "Render Stats" UI shows and what benchmarks can check.
+//
+// Worker threads recording deferred contexts count into the
+// same pass as the main thread, so the counters are atomic.
+//
+// Triangles assume triangle lists, the only topology used.
+//
+// ---------------------------------------------
+
+namespace
+{
+	const unsigned int PassCount = (unsigned int)StatsPass::Count;
+
+	struct PassCounters
+	{
+		std::atomic<unsigned int> draws;
+		std::atomic<unsigned int> instances;
+		std::atomic<unsigned long long> triangles;
+		std::atomic<unsigned int> binds;
+		std::atomic<unsigned long long> constantBytes;
+		std::atomic<unsigned long long> bufferBytes;
+		std::atomic<unsigned int> buffersCreated;
+		std::atomic<unsigned int> maps;
+	};
+
+	PassCounters counters[PassCount];
+	RenderPassStats lastFrame[PassCount];
+	std::atomic<unsigned int> currentPass{ (unsigned int)StatsPass::Frame };
+
+	PassCounters& Current()
+	{
+		return counters[currentPass.load(std::memory_order_relaxed)];
+	}
+}
+
+void RenderStats::EndFrame()
+{
+	for (unsigned int i = 0; i < PassCount; i++)
+	{
+		PassCounters& pass = counters[i];
+		RenderPassStats& stats = lastFrame[i];
+		stats.draws = pass.draws.exchange(0, std::memory_order_relaxed);
+		stats.instances = pass.instances.exchange(0, std::memory_order_relaxed);
+		stats.triangles = pass.triangles.exchange(0, std::memory_order_relaxed);
+		stats.binds = pass.binds.exchange(0, std::memory_order_relaxed);
+		stats.constantBytes = pass.constantBytes.exchange(0, std::memory_order_relaxed);
+		stats.bufferBytes = pass.bufferBytes.exchange(0, std::memory_order_relaxed);
+		stats.buffersCreated = pass.buffersCreated.exchange(0, std::memory_order_relaxed);
+		stats.maps = pass.maps.exchange(0, std::memory_order_relaxed);
+	}
+}
+
+void RenderStats::SetPass(StatsPass pass) { currentPass.store((unsigned int)pass, std::memory_order_relaxed); }
+StatsPass RenderStats::GetPass() { return (StatsPass)currentPass.load(std::memory_order_relaxed); }
+
+const char* RenderStats::GetPassName(StatsPass pass)
+{
+	switch (pass)
+	{
+	case StatsPass::Frame: return "Frame";
+	case StatsPass::Opaque: return "Opaque";
+	case StatsPass::UI: return "UI";
+	default: return "Unknown";
+	}
+}
+
+// --------------------------------------------------------
+// Counts one draw call
+//
+// indexCount    - Indices per instance
+// instanceCount - Instances drawn (1 for a plain draw)
+// --------------------------------------------------------
+void RenderStats::CountDraw(unsigned int indexCount, unsigned int instanceCount)
+{
+	PassCounters& pass = Current();
+	pass.draws.fetch_add(1, std::memory_order_relaxed);
+	pass.instances.fetch_add(instanceCount, std::memory_order_relaxed);
+	pass.triangles.fetch_add((unsigned long long)(indexCount / 3) * instanceCount, std::memory_order_relaxed);
+}
+
+void RenderStats::CountBinds(unsigned int count) { Current().binds.fetch_add(count, std::memory_order_relaxed); }
+void RenderStats::CountConstantBytes(unsigned long long bytes) { Current().constantBytes.fetch_add(bytes, std::memory_order_relaxed); }
+void RenderStats::CountBufferBytes(unsigned long long bytes) { Current().bufferBytes.fetch_add(bytes, std::memory_order_relaxed); }
+void RenderStats::CountBufferCreated() { Current().buffersCreated.fetch_add(1, std::memory_order_relaxed); }
+void RenderStats::CountMap() { Current().maps.fetch_add(1, std::memory_order_relaxed); }
+
+const RenderPassStats& RenderStats::GetLastFrame(StatsPass pass)
+{
+	return lastFrame[(unsigned int)pass < PassCount ? (unsigned int)pass : 0];
+}
+
+RenderPassStats RenderStats::GetLastFrameTotal()
+{
+	RenderPassStats total = {};
+	for (const RenderPassStats& stats : lastFrame)
+	{
+		total.draws += stats.draws;
+		total.instances += stats.instances;
+		total.triangles += stats.triangles;
+		total.binds += stats.binds;
+		total.constantBytes += stats.constantBytes;
+		total.bufferBytes += stats.bufferBytes;
+		total.buffersCreated += stats.buffersCreated;
+		total.maps += stats.maps;
+	}
+	return total;
+}
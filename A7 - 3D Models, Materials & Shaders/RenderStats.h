@@ -0,0 +1,63 @@
+#pragma once
+
+// See RenderStats.cpp for usage details
+
+// Parts of the frame that work is charged to.  Coarser than
+// RenderQueue's RenderPass, which only orders the opaque pass
+enum class StatsPass
+{
+	Frame,		// Clears, resource creation and anything else
+	Opaque,		// Entity draws, on any thread
+	UI,			// ImGui
+	Count
+};
+
+struct RenderPassStats
+{
+	unsigned int draws;
+	unsigned int instances;
+	unsigned long long triangles;
+	unsigned int binds;					// State changes that reached a context
+	unsigned long long constantBytes;	// Written into constant buffers
+	unsigned long long bufferBytes;		// Written into other dynamic buffers
+	unsigned int buffersCreated;
+	unsigned int maps;
+};
+
+namespace RenderStats
+{
+	// Ends the frame: what was counted becomes the last frame's
+	// stats and counting starts over
+	void EndFrame();
+
+	// Work counted from now on (on any thread) is charged to
+	// this pass.  Set from the main thread only
+	void SetPass(StatsPass pass);
+	StatsPass GetPass();
+	const char* GetPassName(StatsPass pass);
+
+	void CountDraw(unsigned int indexCount, unsigned int instanceCount = 1);
+	void CountBinds(unsigned int count = 1);
+	void CountConstantBytes(unsigned long long bytes);
+	void CountBufferBytes(unsigned long long bytes);
+	void CountBufferCreated();
+	void CountMap();
+
+	const RenderPassStats& GetLastFrame(StatsPass pass);
+	RenderPassStats GetLastFrameTotal();
+
+	// Sets the pass for the rest of a block, then puts
+	// back the one before it
+	class PassScope
+	{
+	public:
+		explicit PassScope(StatsPass pass) : previous(GetPass()) { SetPass(pass); }
+		~PassScope() { SetPass(previous); }
+
+		PassScope(const PassScope&) = delete;
+		PassScope& operator=(const PassScope&) = delete;
+
+	private:
+		StatsPass previous;
+	};
+}
@@ -0,0 +1,126 @@
+#include "RetainedUI.h"
+
+#include "ImGui/imgui.h"
+#include "ImGui/imgui_internal.h"
+
+namespace
+{
+	const unsigned long long HashSeed = 14695981039346656037ull;
+}
+
+RetainedUI::RetainedUI(float refreshInterval, float settleTime) :
+	stats{},
+	enabled(true),
+	built(false),
+	refreshInterval(refreshInterval),
+	settleTime(settleTime),
+	sinceBuild(0.0f),
+	sinceInput(0.0f),
+	watchHash(HashSeed),
+	lastWatchHash(HashSeed),
+	buildSeconds(0.0)
+{
+}
+
+// --------------------------------------------------------
+// 64-bit FNV-1a over the watched values, restarted after
+// each BeginFrame()
+// --------------------------------------------------------
+void RetainedUI::WatchBytes(const void* data, size_t size)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+		watchHash = (watchHash ^ bytes[i]) * 1099511628211ull;
+}
+
+// --------------------------------------------------------
+// Input is read straight from ImGui's event queue, which the
+// Win32 backend fills from the window's messages whether or
+// not a frame is being built, and which only NewFrame()
+// empties.  Anything waiting there is input the last build
+// hasn't seen
+// --------------------------------------------------------
+bool RetainedUI::BeginFrame(float deltaTime)
+{
+	// Last frame's build, now that both halves are timed
+	if (buildSeconds > 0.0)
+	{
+		stats.averageBuildSeconds = stats.averageBuildSeconds == 0.0 ?
+			buildSeconds : stats.averageBuildSeconds * 0.9 + buildSeconds * 0.1;
+	}
+	buildSeconds = 0.0;
+
+	stats.elapsedSeconds += deltaTime;
+	sinceBuild += deltaTime;
+	sinceInput += deltaTime;
+
+	bool watchedChanged = watchHash != lastWatchHash;
+	lastWatchHash = watchHash;
+	watchHash = HashSeed;
+
+	bool inputWaiting = ImGui::GetCurrentContext()->InputEventsQueue.Size > 0;
+	if (inputWaiting)
+		sinceInput = 0.0f;
+
+	const char* reason = 0;
+	if (!enabled)
+		reason = "Disabled";
+	else if (!built)
+		reason = "First Frame";
+	else if (inputWaiting)
+		reason = "Input";
+	else if (watchedChanged)
+		reason = "Watched Value Changed";
+	else if (ImGui::IsAnyItemActive() || ImGui::GetIO().WantTextInput)
+		reason = "Item Active";
+	else if (sinceInput < settleTime)
+		reason = "Settling After Input";
+	else if (sinceBuild >= refreshInterval)
+		reason = "Refresh";
+
+	stats.reused = reason == 0;
+	if (stats.reused)
+	{
+		stats.framesReused++;
+		stats.savedSeconds += stats.averageBuildSeconds;
+		return false;
+	}
+
+	stats.reason = reason;
+	stats.framesBuilt++;
+	sinceBuild = 0.0f;
+	built = true;
+	return true;
+}
+
+void RetainedUI::BeginBuildTiming()
+{
+	buildStart = std::chrono::high_resolution_clock::now();
+}
+
+void RetainedUI::EndBuildTiming()
+{
+	auto end = std::chrono::high_resolution_clock::now();
+	buildSeconds += std::chrono::duration<double>(end - buildStart).count();
+}
+
+// --------------------------------------------------------
+// Turning it back on starts the counters over
+// --------------------------------------------------------
+void RetainedUI::SetEnabled(bool enabled)
+{
+	if (enabled && !this->enabled)
+	{
+		double averageBuildSeconds = stats.averageBuildSeconds;
+		stats = {};
+		stats.averageBuildSeconds = averageBuildSeconds;
+	}
+	this->enabled = enabled;
+}
+
+bool RetainedUI::IsEnabled() { return enabled; }
+
+void RetainedUI::SetRefreshInterval(float seconds) { refreshInterval = seconds; }
+float RetainedUI::GetRefreshInterval() { return refreshInterval; }
+
+const RetainedUIStats& RetainedUI::GetStats() { return stats; }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+// Counters since the retained UI was last enabled
+struct RetainedUIStats
+{
+	bool reused;					// This frame drew last frame's UI again
+	const char* reason;				// Why it was rebuilt, when it was
+	unsigned long long framesReused;
+	unsigned long long framesBuilt;
+	double averageBuildSeconds;		// NewFrame through Render, recent builds
+	double savedSeconds;			// Estimated build time the reused frames skipped
+	double elapsedSeconds;
+
+	float ReuseRate() const { return (framesReused + framesBuilt) > 0 ? (float)framesReused / (framesReused + framesBuilt) : 0.0f; }
+};
+
+// --------------------------------------------------------
+// Decides each frame whether ImGui's UI needs building at
+// all, or whether last frame's draw data (still held by
+// ImGui until the next NewFrame) can just be drawn again
+//
+// The UI is rebuilt whenever ImGui has input waiting, a
+// watched value changed, an item is being used, or input
+// arrived within the last settleTime seconds (so tooltips,
+// double clicks and the like can finish).  Once idle, it's
+// still rebuilt every refreshInterval seconds so live
+// numbers keep moving
+// --------------------------------------------------------
+class RetainedUI
+{
+public:
+	RetainedUI(float refreshInterval = 0.5f, float settleTime = 1.0f);
+
+	// Adds to a hash of anything the UI shows that can change
+	// without input.  Call for each value before BeginFrame()
+	template<typename T>
+	void Watch(const T& value) { WatchBytes(&value, sizeof(T)); }
+	void WatchBytes(const void* data, size_t size);
+
+	// True when the UI should be built this frame (NewFrame,
+	// the widgets, Render), false when ImGui::GetDrawData()
+	// can be drawn again as is
+	bool BeginFrame(float deltaTime);
+
+	// Around each part of a build, which is split between
+	// NewFrame and the widgets in Update, and Render in Draw
+	void BeginBuildTiming();
+	void EndBuildTiming();
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled();
+
+	void SetRefreshInterval(float seconds);
+	float GetRefreshInterval();
+
+	const RetainedUIStats& GetStats();
+
+private:
+	RetainedUIStats stats;
+	bool enabled;
+	bool built;
+
+	float refreshInterval;
+	float settleTime;
+	float sinceBuild;
+	float sinceInput;
+
+	unsigned long long watchHash;
+	unsigned long long lastWatchHash;
+
+	std::chrono::high_resolution_clock::time_point buildStart;
+	double buildSeconds;
+};
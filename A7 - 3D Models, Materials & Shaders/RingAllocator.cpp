@@ -0,0 +1,65 @@
+#include "RingAllocator.h"
+
+RingAllocator::RingAllocator(unsigned int capacity, unsigned int alignment) :
+	capacity(capacity),
+	alignment(alignment > 0 ? alignment : 1),
+	head(0),
+	frameStart(0),
+	frameEnd(0),
+	frameCursor(0)
+{
+}
+
+void RingAllocator::Reset(unsigned int capacity)
+{
+	this->capacity = capacity;
+	head = 0;
+	frameStart = 0;
+	frameEnd = 0;
+	frameCursor = 0;
+}
+
+bool RingAllocator::BeginFrame(unsigned int frameBytes)
+{
+	unsigned int reserve = AlignUp(frameBytes, alignment);
+	bool wrapped = false;
+
+	// Not enough room left before the end, so start over
+	if (head > capacity || reserve > capacity - head)
+	{
+		head = 0;
+		wrapped = true;
+	}
+
+	frameStart = head;
+	frameEnd = reserve <= capacity ? head + reserve : capacity;
+	frameCursor = frameStart;
+	head = frameEnd;
+	return wrapped;
+}
+
+unsigned int RingAllocator::Allocate(unsigned int size)
+{
+	unsigned int blockSize = AlignUp(size, alignment);
+	if (blockSize > frameEnd - frameCursor)
+		return InvalidOffset;
+
+	unsigned int offset = frameCursor;
+	frameCursor += blockSize;
+	return offset;
+}
+
+bool RingAllocator::Fits(unsigned int frameBytes)
+{
+	return AlignUp(frameBytes, alignment) <= capacity;
+}
+
+unsigned int RingAllocator::GetCapacity() { return capacity; }
+unsigned int RingAllocator::GetAlignment() { return alignment; }
+unsigned int RingAllocator::GetFrameStart() { return frameStart; }
+unsigned int RingAllocator::GetFrameUsed() { return frameCursor - frameStart; }
+
+unsigned int RingAllocator::AlignUp(unsigned int value, unsigned int alignment)
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// --------------------------------------------------------
+// Offset bookkeeping for a ring buffer that is written once
+// per frame and read by the GPU later
+//
+// Each frame reserves one contiguous region right after the
+// previous frame's.  Because that region never overlaps
+// what the GPU might still be reading, it can be written
+// without waiting.  When a frame doesn't fit in what's left,
+// it starts back at zero and the caller must discard the
+// buffer so the driver hands it fresh memory
+//
+// Nothing here touches the GPU, so the logic can be checked
+// on its own
+// --------------------------------------------------------
+class RingAllocator
+{
+public:
+	static const unsigned int InvalidOffset = 0xFFFFFFFF;
+
+	RingAllocator(unsigned int capacity = 0, unsigned int alignment = 256);
+
+	// Changes the size and starts over from zero
+	void Reset(unsigned int capacity);
+
+	// Reserves room for up to frameBytes this frame.  Returns
+	// true if the frame wrapped back to the start of the ring
+	// (or the reservation can't fit at all, see Fits())
+	bool BeginFrame(unsigned int frameBytes);
+
+	// Aligned offset of a new block of size bytes, or
+	// InvalidOffset if this frame's reservation is used up
+	unsigned int Allocate(unsigned int size);
+
+	bool Fits(unsigned int frameBytes);
+
+	unsigned int GetCapacity();
+	unsigned int GetAlignment();
+	unsigned int GetFrameStart();
+	unsigned int GetFrameUsed();
+
+	static unsigned int AlignUp(unsigned int value, unsigned int alignment);
+
+private:
+	unsigned int capacity;
+	unsigned int alignment;
+
+	unsigned int head;			// Where the next frame starts
+	unsigned int frameStart;
+	unsigned int frameEnd;
+	unsigned int frameCursor;	// Next free byte this frame
+};
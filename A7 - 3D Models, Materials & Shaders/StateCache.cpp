@@ -0,0 +1,266 @@
+#include "StateCache.h"
+#include "Graphics.h"
+#include "RenderStats.h"
+
+#include <wrl/client.h>
+
+// --------------- Basic usage -----------------
+//
+// Engine code binds pipeline state through here instead
+// of straight through Graphics::Context:
+//
+//   StateCache::SetVertexShader(vs.Get());
+//   StateCache::SetIndexBuffer(ib.Get(), DXGI_FORMAT_R32_UINT, 0);
+//
+// Each function remembers what it last bound and skips
+// the call when asked to bind the same thing again.  That
+// is only correct while nothing else touches the context,
+// so call StateCache::Reset() after third party code
+// (such as ImGui_ImplDX11_RenderDrawData) has run.
+//
+// Bound objects are compared by pointer.  That is safe
+// because the context holds a reference to whatever is
+// bound, so a bound object can't be freed and replaced by
+// a new one at the same address.
+//
+// ---------------------------------------------
+
+namespace
+{
+	const unsigned int MaxVertexBufferSlots = 4;
+	const unsigned int MaxConstantBufferSlots = 8;
+
+	Microsoft::WRL::ComPtr<ID3D11DeviceContext1> context1;
+
+	// Each piece of state has a "known" flag, so zero and
+	// null can still be cached after a Reset()
+	struct VertexBufferSlot
+	{
+		bool known;
+		ID3D11Buffer* buffer;
+		UINT stride;
+		UINT offset;
+	};
+
+	struct ConstantBufferSlot
+	{
+		bool known;
+		ID3D11Buffer* buffer;
+		UINT firstConstant;
+		UINT numConstants;
+	};
+
+	bool topologyKnown;
+	D3D11_PRIMITIVE_TOPOLOGY topology;
+
+	bool inputLayoutKnown;
+	ID3D11InputLayout* inputLayout;
+
+	VertexBufferSlot vertexBuffers[MaxVertexBufferSlots];
+
+	bool indexBufferKnown;
+	ID3D11Buffer* indexBuffer;
+	DXGI_FORMAT indexFormat;
+	UINT indexOffset;
+
+	bool vertexShaderKnown;
+	ID3D11VertexShader* vertexShader;
+
+	bool pixelShaderKnown;
+	ID3D11PixelShader* pixelShader;
+
+	ConstantBufferSlot vsConstantBuffers[MaxConstantBufferSlots];
+	ConstantBufferSlot psConstantBuffers[MaxConstantBufferSlots];
+
+	StateCacheStats frameStats;
+	StateCacheStats lastFrameStats;
+
+	// Counts the call and reports whether it should go through
+	bool Changed(bool changed)
+	{
+		if (changed)
+		{
+			frameStats.issued++;
+			RenderStats::CountBinds();
+		}
+		else
+			frameStats.skipped++;
+		return changed;
+	}
+
+	// Whole-buffer binds are cached with an empty range, so
+	// they never match a windowed bind of the same buffer
+	bool SameConstantBuffer(const ConstantBufferSlot& slot, ID3D11Buffer* buffer, UINT firstConstant, UINT numConstants)
+	{
+		return slot.known &&
+			slot.buffer == buffer &&
+			slot.firstConstant == firstConstant &&
+			slot.numConstants == numConstants;
+	}
+}
+
+// --------------------------------------------------------
+// Grabs the D3D11.1 context (if there is one) and starts
+// with nothing known
+// --------------------------------------------------------
+void StateCache::Initialize()
+{
+	Graphics::Context.As(&context1);
+	Reset();
+	frameStats = {};
+	lastFrameStats = {};
+}
+
+void StateCache::ShutDown()
+{
+	Reset();
+	context1.Reset();
+}
+
+void StateCache::BeginFrame()
+{
+	lastFrameStats = frameStats;
+	frameStats = {};
+}
+
+void StateCache::Reset()
+{
+	topologyKnown = false;
+	inputLayoutKnown = false;
+	indexBufferKnown = false;
+	vertexShaderKnown = false;
+	pixelShaderKnown = false;
+
+	for (unsigned int i = 0; i < MaxVertexBufferSlots; i++)
+		vertexBuffers[i].known = false;
+
+	for (unsigned int i = 0; i < MaxConstantBufferSlots; i++)
+	{
+		vsConstantBuffers[i].known = false;
+		psConstantBuffers[i].known = false;
+	}
+}
+
+void StateCache::SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY newTopology)
+{
+	if (!Changed(!topologyKnown || topology != newTopology))
+		return;
+
+	Graphics::Context->IASetPrimitiveTopology(newTopology);
+	topologyKnown = true;
+	topology = newTopology;
+}
+
+void StateCache::SetInputLayout(ID3D11InputLayout* newInputLayout)
+{
+	if (!Changed(!inputLayoutKnown || inputLayout != newInputLayout))
+		return;
+
+	Graphics::Context->IASetInputLayout(newInputLayout);
+	inputLayoutKnown = true;
+	inputLayout = newInputLayout;
+}
+
+// --------------------------------------------------------
+// Binds a range of vertex buffer slots in one call, unless
+// every slot in the range already matches
+// --------------------------------------------------------
+void StateCache::SetVertexBuffers(unsigned int startSlot, unsigned int count, ID3D11Buffer* const* buffers, const UINT* strides, const UINT* offsets)
+{
+	bool tracked = startSlot + count <= MaxVertexBufferSlots;
+
+	bool changed = !tracked;
+	for (unsigned int i = 0; tracked && !changed && i < count; i++)
+	{
+		const VertexBufferSlot& slot = vertexBuffers[startSlot + i];
+		changed = !slot.known ||
+			slot.buffer != buffers[i] ||
+			slot.stride != strides[i] ||
+			slot.offset != offsets[i];
+	}
+
+	if (!Changed(changed))
+		return;
+
+	Graphics::Context->IASetVertexBuffers(startSlot, count, buffers, strides, offsets);
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		if (startSlot + i >= MaxVertexBufferSlots)
+			break;
+		vertexBuffers[startSlot + i] = { true, buffers[i], strides[i], offsets[i] };
+	}
+}
+
+void StateCache::SetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, unsigned int offset)
+{
+	if (!Changed(!indexBufferKnown || indexBuffer != buffer || indexFormat != format || indexOffset != offset))
+		return;
+
+	Graphics::Context->IASetIndexBuffer(buffer, format, offset);
+	indexBufferKnown = true;
+	indexBuffer = buffer;
+	indexFormat = format;
+	indexOffset = offset;
+}
+
+void StateCache::SetVertexShader(ID3D11VertexShader* shader)
+{
+	if (!Changed(!vertexShaderKnown || vertexShader != shader))
+		return;
+
+	Graphics::Context->VSSetShader(shader, 0, 0);
+	vertexShaderKnown = true;
+	vertexShader = shader;
+}
+
+void StateCache::SetPixelShader(ID3D11PixelShader* shader)
+{
+	if (!Changed(!pixelShaderKnown || pixelShader != shader))
+		return;
+
+	Graphics::Context->PSSetShader(shader, 0, 0);
+	pixelShaderKnown = true;
+	pixelShader = shader;
+}
+
+void StateCache::SetVSConstantBuffer(unsigned int slot, ID3D11Buffer* buffer)
+{
+	bool tracked = slot < MaxConstantBufferSlots;
+	if (!Changed(!tracked || !SameConstantBuffer(vsConstantBuffers[slot], buffer, 0, 0)))
+		return;
+
+	Graphics::Context->VSSetConstantBuffers(slot, 1, &buffer);
+	if (tracked)
+		vsConstantBuffers[slot] = { true, buffer, 0, 0 };
+}
+
+void StateCache::SetPSConstantBuffer(unsigned int slot, ID3D11Buffer* buffer)
+{
+	bool tracked = slot < MaxConstantBufferSlots;
+	if (!Changed(!tracked || !SameConstantBuffer(psConstantBuffers[slot], buffer, 0, 0)))
+		return;
+
+	Graphics::Context->PSSetConstantBuffers(slot, 1, &buffer);
+	if (tracked)
+		psConstantBuffers[slot] = { true, buffer, 0, 0 };
+}
+
+void StateCache::SetVSConstantBufferRange(unsigned int slot, ID3D11Buffer* buffer, unsigned int firstConstant, unsigned int numConstants)
+{
+	if (!context1)
+		return;
+
+	bool tracked = slot < MaxConstantBufferSlots;
+	if (!Changed(!tracked || !SameConstantBuffer(vsConstantBuffers[slot], buffer, firstConstant, numConstants)))
+		return;
+
+	UINT first = firstConstant;
+	UINT num = numConstants;
+	context1->VSSetConstantBuffers1(slot, 1, &buffer, &first, &num);
+	if (tracked)
+		vsConstantBuffers[slot] = { true, buffer, firstConstant, numConstants };
+}
+
+StateCacheStats StateCache::GetFrameStats() { return frameStats; }
+StateCacheStats StateCache::GetLastFrameStats() { return lastFrameStats; }
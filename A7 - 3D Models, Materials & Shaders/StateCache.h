@@ -0,0 +1,42 @@
+#pragma once
+
+#include <d3d11_1.h>
+
+// See StateCache.cpp for usage details
+
+struct StateCacheStats
+{
+	unsigned int issued;	// Calls that reached the context
+	unsigned int skipped;	// Calls dropped because nothing changed
+};
+
+namespace StateCache
+{
+	void Initialize();
+	void ShutDown();
+
+	// Starts a new frame of stats
+	void BeginFrame();
+
+	// Forgets everything, so the next call of each kind goes
+	// through.  Needed after anything that binds state
+	// without going through here (like the ImGui backend)
+	void Reset();
+
+	void SetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology);
+	void SetInputLayout(ID3D11InputLayout* inputLayout);
+	void SetVertexBuffers(unsigned int startSlot, unsigned int count, ID3D11Buffer* const* buffers, const UINT* strides, const UINT* offsets);
+	void SetIndexBuffer(ID3D11Buffer* buffer, DXGI_FORMAT format, unsigned int offset);
+
+	void SetVertexShader(ID3D11VertexShader* shader);
+	void SetPixelShader(ID3D11PixelShader* shader);
+
+	void SetVSConstantBuffer(unsigned int slot, ID3D11Buffer* buffer);
+	void SetPSConstantBuffer(unsigned int slot, ID3D11Buffer* buffer);
+
+	// D3D11.1 only: binds a window of a larger buffer
+	void SetVSConstantBufferRange(unsigned int slot, ID3D11Buffer* buffer, unsigned int firstConstant, unsigned int numConstants);
+
+	StateCacheStats GetFrameStats();
+	StateCacheStats GetLastFrameStats();
+}
@@ -0,0 +1,159 @@
+// --------------------------------------------------------
+// Checks DrawChunks::Split() and WorthSplitting() against
+// what DeferredRecorder and Game rely on:
+//
+//  - Chunks are contiguous and cover every draw, in order
+//  - There are never more than maxChunks of them
+//  - Each has at least minDrawsPerChunk draws, unless the
+//    draws all went into a single chunk
+//  - Chunk sizes differ by at most one
+//  - Each chunk's index is its position, and below maxChunks
+//    (Game hands it to FrameArena::GetWorkerArena())
+//  - No draws means no chunks, and a minimum of 0 acts as 1
+//  - WorthSplitting() is true exactly when Split() would
+//    make more than one chunk
+//
+// Nothing here needs Windows; from this folder:
+//
+//   g++ -std=c++20 -O2 -I.. DrawChunksTest.cpp ../DrawChunks.cpp
+//       -o DrawChunksTest
+//
+// Usage:
+//   DrawChunksTest [--max-draws N]
+//
+// Tries every draw count up to --max-draws (default 5000)
+// against a range of worker counts and minimums, then a few
+// very large draw counts.  Exits with 1 if any check fails
+// --------------------------------------------------------
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "DrawChunks.h"
+
+namespace
+{
+	unsigned int failures = 0;
+
+	// Only the first few are printed, one bad rule tends to
+	// fail thousands of cases
+	void Fail(unsigned int drawCount, unsigned int maxChunks, unsigned int minDraws, const char* what)
+	{
+		if (failures < 20)
+			printf("  FAIL draws %u, max chunks %u, min draws %u: %s\n", drawCount, maxChunks, minDraws, what);
+		failures++;
+	}
+
+	void Check(unsigned int drawCount, unsigned int maxChunks, unsigned int minDraws, std::vector<DrawChunk>& chunks)
+	{
+		// Stale chunks from the last call must not survive
+		chunks.assign(3, { 7, 7, 7 });
+		unsigned int count = DrawChunks::Split(drawCount, maxChunks, minDraws, chunks);
+
+		if (count != chunks.size())
+			Fail(drawCount, maxChunks, minDraws, "returned count doesn't match the chunks written");
+		if (count > maxChunks)
+			Fail(drawCount, maxChunks, minDraws, "more chunks than maxChunks");
+		if (drawCount == 0 && count != 0)
+			Fail(drawCount, maxChunks, minDraws, "chunks for no draws");
+		if (drawCount > 0 && maxChunks > 0 && count == 0)
+			Fail(drawCount, maxChunks, minDraws, "draws left unchunked");
+
+		unsigned int effectiveMin = minDraws == 0 ? 1 : minDraws;
+		unsigned long long next = 0;
+		unsigned int smallest = UINT_MAX;
+		unsigned int largest = 0;
+		for (unsigned int i = 0; i < chunks.size(); i++)
+		{
+			const DrawChunk& chunk = chunks[i];
+			if (chunk.start != next)
+				Fail(drawCount, maxChunks, minDraws, "chunk doesn't start where the last one ended");
+			if (chunk.index != i)
+				Fail(drawCount, maxChunks, minDraws, "chunk index isn't its position");
+			if (chunk.index >= maxChunks)
+				Fail(drawCount, maxChunks, minDraws, "chunk index past the last worker");
+			if (chunk.count == 0)
+				Fail(drawCount, maxChunks, minDraws, "empty chunk");
+			if (chunks.size() > 1 && chunk.count < effectiveMin)
+				Fail(drawCount, maxChunks, minDraws, "chunk smaller than minDrawsPerChunk");
+
+			next += chunk.count;
+			smallest = chunk.count < smallest ? chunk.count : smallest;
+			largest = chunk.count > largest ? chunk.count : largest;
+		}
+
+		if (!chunks.empty() && next != drawCount)
+			Fail(drawCount, maxChunks, minDraws, "chunks don't cover every draw");
+		if (!chunks.empty() && largest - smallest > 1)
+			Fail(drawCount, maxChunks, minDraws, "chunk sizes differ by more than one");
+
+		// Larger chunks first, so sizes never go back up
+		for (size_t i = 1; i < chunks.size(); i++)
+		{
+			if (chunks[i].count > chunks[i - 1].count)
+				Fail(drawCount, maxChunks, minDraws, "a later chunk is larger than an earlier one");
+		}
+
+		if (DrawChunks::WorthSplitting(drawCount, maxChunks, minDraws) != (count > 1))
+			Fail(drawCount, maxChunks, minDraws, "WorthSplitting() disagrees with Split()");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int maxDraws = 5000;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--max-draws") == 0 && i + 1 < argc)
+			maxDraws = (unsigned int)atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [--max-draws N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// Worker counts from none to more than most machines have,
+	// and minimums around the ImGui slider's range (1 to 1024)
+	const unsigned int maxChunkCounts[] = { 0, 1, 2, 3, 4, 5, 7, 8, 12, 16, 31, 64 };
+	const unsigned int minDrawCounts[] = { 0, 1, 2, 3, 7, 16, 64, 100, 256, 1000, 1024, 4096 };
+
+	std::vector<DrawChunk> chunks;
+	unsigned long long cases = 0;
+	for (unsigned int drawCount = 0; drawCount <= maxDraws; drawCount++)
+	{
+		for (unsigned int maxChunks : maxChunkCounts)
+		{
+			for (unsigned int minDraws : minDrawCounts)
+			{
+				Check(drawCount, maxChunks, minDraws, chunks);
+				cases++;
+			}
+		}
+	}
+
+	// Counts where sums and divisions could overflow
+	const unsigned int largeDrawCounts[] = { 1000000, UINT_MAX / 2, UINT_MAX - 1, UINT_MAX };
+	for (unsigned int drawCount : largeDrawCounts)
+	{
+		for (unsigned int maxChunks : maxChunkCounts)
+		{
+			for (unsigned int minDraws : { 0u, 1u, 256u, UINT_MAX })
+			{
+				Check(drawCount, maxChunks, minDraws, chunks);
+				cases++;
+			}
+		}
+	}
+
+	if (failures > 0)
+	{
+		printf("%u of %llu cases failed\n", failures, cases);
+		return 1;
+	}
+	printf("All %llu cases passed\n", cases);
+	return 0;
+}
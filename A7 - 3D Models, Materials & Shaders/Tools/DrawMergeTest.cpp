@@ -0,0 +1,496 @@
+// --------------------------------------------------------
+// Checks that DrawDataMerger's output draws exactly what
+// ImGui's own draw data does, and reports how many draw
+// commands and state changes it saves
+//
+// Both are drawn the way ImGui_ImplDX11_RenderDrawData()
+// draws them (scissor per command, index and vertex offsets,
+// 16-bit indices) by a small software rasterizer.  Each
+// pixel keeps a hash of every triangle that covered it, in
+// order, so the two match only if every pixel saw the same
+// triangles, with the same textures, in the same order.
+// Nothing here needs Windows; from this folder:
+//
+//   g++ -std=c++20 -O2 -I.. DrawMergeTest.cpp ../DrawDataMerger.cpp
+//       ../ImGui/imgui.cpp ../ImGui/imgui_demo.cpp ../ImGui/imgui_draw.cpp
+//       ../ImGui/imgui_tables.cpp ../ImGui/imgui_widgets.cpp -o DrawMergeTest
+//
+// Usage:
+//   DrawMergeTest [--random N] [--seed S]
+//
+// Runs a few UI scenes built with real ImGui windows, then N
+// (default 2000) random frames of overlapping, partly clipped
+// geometry across several textures.  Exits with 1 if any
+// frame draws differently
+// --------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "DrawDataMerger.h"
+
+namespace
+{
+	// Textures are only ever compared, never sampled
+	const ImTextureID FontTexture = (ImTextureID)1;
+	const ImTextureID ImageTextures[] = { (ImTextureID)2, (ImTextureID)3 };
+
+	struct Rendered
+	{
+		int width, height;
+		std::vector<uint64_t> pixels;	// Hash of each fragment drawn there, in order
+		uint64_t fragments;
+		unsigned int draws;
+		unsigned int scissorSets;		// Calls the backend makes, skipping repeats
+		unsigned int textureBinds;
+		bool outOfRange;				// An index pointed past the vertex buffer
+	};
+
+	uint64_t Hash(uint64_t hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; i++)
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		return hash;
+	}
+
+	double Edge(const ImVec2& a, const ImVec2& b, double x, double y)
+	{
+		return ((double)b.x - a.x) * (y - a.y) - ((double)b.y - a.y) * (x - a.x);
+	}
+
+	// --------------------------------------------------------
+	// The backend's loop, with a pixel-center rasterizer in
+	// place of DrawIndexed().  Vertices are moved by
+	// DisplayPos the way the projection matrix moves them
+	// --------------------------------------------------------
+	Rendered Render(const ImDrawData* data, int width, int height)
+	{
+		Rendered out = {};
+		out.width = width;
+		out.height = height;
+		out.pixels.assign((size_t)width * height, 14695981039346656037ull);
+
+		const ImVec2 clipOffset = data->DisplayPos;
+		bool boundValid = false;
+		long bound[4] = {};
+		ImTextureID boundTexture = 0;
+
+		const ImDrawVert* vtxBase = 0;
+		std::vector<ImDrawVert> allVertices;
+		std::vector<ImDrawIdx> allIndices;
+		for (int n = 0; n < data->CmdListsCount; n++)
+		{
+			const ImDrawList* list = data->CmdLists[n];
+			allVertices.insert(allVertices.end(), list->VtxBuffer.begin(), list->VtxBuffer.end());
+			allIndices.insert(allIndices.end(), list->IdxBuffer.begin(), list->IdxBuffer.end());
+		}
+		vtxBase = allVertices.data();
+
+		size_t globalIdx = 0;
+		size_t globalVtx = 0;
+		for (int n = 0; n < data->CmdListsCount; n++)
+		{
+			const ImDrawList* list = data->CmdLists[n];
+			for (const ImDrawCmd& command : list->CmdBuffer)
+			{
+				if (command.UserCallback)
+				{
+					boundValid = false;
+					continue;
+				}
+
+				ImVec2 clipMin(command.ClipRect.x - clipOffset.x, command.ClipRect.y - clipOffset.y);
+				ImVec2 clipMax(command.ClipRect.z - clipOffset.x, command.ClipRect.w - clipOffset.y);
+				if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y)
+					continue;
+
+				long scissor[4] = { (long)clipMin.x, (long)clipMin.y, (long)clipMax.x, (long)clipMax.y };
+				if (!boundValid || memcmp(scissor, bound, sizeof(scissor)) != 0)
+					out.scissorSets++;
+				if (!boundValid || command.TextureId != boundTexture)
+					out.textureBinds++;
+				memcpy(bound, scissor, sizeof(scissor));
+				boundTexture = command.TextureId;
+				boundValid = true;
+				out.draws++;
+
+				// Scissor as pixels, clamped to the render target
+				int left = (int)std::max(0L, scissor[0]), top = (int)std::max(0L, scissor[1]);
+				int right = (int)std::min((long)width, scissor[2]), bottom = (int)std::min((long)height, scissor[3]);
+
+				for (unsigned int e = 0; e + 2 < command.ElemCount; e += 3)
+				{
+					ImDrawVert v[3];
+					for (int c = 0; c < 3; c++)
+					{
+						size_t index = globalVtx + command.VtxOffset + allIndices[globalIdx + command.IdxOffset + e + c];
+						if (index >= allVertices.size())
+						{
+							out.outOfRange = true;
+							return out;
+						}
+						v[c] = vtxBase[index];
+						v[c].pos.x -= clipOffset.x;
+						v[c].pos.y -= clipOffset.y;
+					}
+
+					uint64_t triangle = Hash(Hash(14695981039346656037ull, v, sizeof(v)), &command.TextureId, sizeof(ImTextureID));
+					double area = Edge(v[0].pos, v[1].pos, v[2].pos.x, v[2].pos.y);
+					if (area == 0.0)
+						continue;
+					if (area < 0.0)
+						std::swap(v[1], v[2]);
+
+					int minX = std::max(left, (int)std::floor(std::min({ v[0].pos.x, v[1].pos.x, v[2].pos.x })));
+					int minY = std::max(top, (int)std::floor(std::min({ v[0].pos.y, v[1].pos.y, v[2].pos.y })));
+					int maxX = std::min(right - 1, (int)std::ceil(std::max({ v[0].pos.x, v[1].pos.x, v[2].pos.x })));
+					int maxY = std::min(bottom - 1, (int)std::ceil(std::max({ v[0].pos.y, v[1].pos.y, v[2].pos.y })));
+					for (int y = minY; y <= maxY; y++)
+					{
+						for (int x = minX; x <= maxX; x++)
+						{
+							double cx = x + 0.5, cy = y + 0.5;
+							if (Edge(v[0].pos, v[1].pos, cx, cy) >= 0.0 &&
+								Edge(v[1].pos, v[2].pos, cx, cy) >= 0.0 &&
+								Edge(v[2].pos, v[0].pos, cx, cy) >= 0.0)
+							{
+								uint64_t& pixel = out.pixels[(size_t)y * width + x];
+								pixel = (pixel ^ triangle) * 1099511628211ull;
+								out.fragments++;
+							}
+						}
+					}
+				}
+			}
+			globalIdx += list->IdxBuffer.Size;
+			globalVtx += list->VtxBuffer.Size;
+		}
+		return out;
+	}
+
+	// --------------------------------------------------------
+	// Merges the draw data, renders both, and prints a
+	// line comparing them.  Returns false if they differ
+	// --------------------------------------------------------
+	bool Compare(const char* name, ImDrawData* data, int width, int height, bool print, DrawDataMergeStats* totals = 0)
+	{
+		Rendered before = Render(data, width, height);
+
+		DrawDataMerger merger;
+		ImDrawData* merged = merger.Merge(data);
+		DrawDataMergeStats stats = merger.GetStats();
+		Rendered after = Render(merged, width, height);
+
+		bool same = !after.outOfRange && before.pixels == after.pixels && before.fragments == after.fragments;
+		if (totals)
+		{
+			totals->commandsIn += stats.commandsIn;
+			totals->commandsOut += stats.commandsOut;
+			totals->joinedSameScissor += stats.joinedSameScissor;
+			totals->joinedUnion += stats.joinedUnion;
+			totals->scissorsShared += stats.scissorsShared;
+			totals->dropped += stats.dropped;
+			totals->vertexWindows += stats.vertexWindows > 1 ? 1 : 0;
+		}
+		if (print || !same)
+		{
+			// Best of a few runs, for the merge itself
+			double milliseconds = stats.milliseconds;
+			for (int i = 0; print && i < 50; i++)
+			{
+				merger.Merge(data);
+				milliseconds = std::min(milliseconds, merger.GetStats().milliseconds);
+			}
+
+			printf("%-16s %5u %6u %6u %6u %6u %6u %6u %6u %8.3f  %s\n",
+				name, stats.lists, before.draws, after.draws,
+				before.scissorSets, after.scissorSets, before.textureBinds, after.textureBinds,
+				stats.vertexWindows, milliseconds,
+				after.outOfRange ? "INDEX OUT OF RANGE" : same ? "identical" : "DIFFERENT");
+		}
+		return same;
+	}
+
+	void PrintHeader()
+	{
+		printf("%-16s %5s %6s %6s %6s %6s %6s %6s %6s %8s\n",
+			"Scene", "Lists", "Draws", "Merged", "Sciss", "Merged", "Tex", "Merged", "VtxWin", "Merge ms");
+	}
+
+	// --------------------------------------------------------
+	// UI scenes, each built over a few frames so windows have
+	// settled on their sizes before the one that's checked
+	// --------------------------------------------------------
+	void ProfilerWindow(const char* name, ImVec2 pos, int rows)
+	{
+		ImGui::SetNextWindowPos(pos, ImGuiCond_Always);
+		ImGui::SetNextWindowSize(ImVec2(520, 420), ImGuiCond_Always);
+		ImGui::Begin(name);
+		ImGui::Text("Frame: %.3f ms", 16.667);
+		static float values[90];
+		for (int i = 0; i < 90; i++)
+			values[i] = sinf(i * 0.2f) * 0.5f + 0.5f;
+		ImGui::PlotLines("Frame Times", values, 90, 0, 0, 0.0f, 1.0f, ImVec2(0, 60));
+		if (ImGui::BeginTable("Scopes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY))
+		{
+			ImGui::TableSetupColumn("Scope");
+			ImGui::TableSetupColumn("Time");
+			ImGui::TableSetupColumn("Calls");
+			ImGui::TableSetupColumn("Max");
+			ImGui::TableHeadersRow();
+			for (int i = 0; i < rows; i++)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn(); ImGui::Text("Scope %d", i);
+				ImGui::TableNextColumn(); ImGui::Text("%.3f ms", i * 0.013);
+				ImGui::TableNextColumn(); ImGui::Text("%d", i * 7 % 101);
+				ImGui::TableNextColumn(); ImGui::ProgressBar((i % 10) / 10.0f);
+			}
+			ImGui::EndTable();
+		}
+		ImGui::End();
+	}
+
+	void DemoScene()
+	{
+		ImGui::SetNextWindowPos(ImVec2(40, 40), ImGuiCond_Always);
+		ImGui::ShowDemoWindow();
+		ImGui::SetNextWindowPos(ImVec2(700, 60), ImGuiCond_Always);
+		ImGui::ShowMetricsWindow();
+		ImGui::SetNextWindowPos(ImVec2(1100, 500), ImGuiCond_Always);
+		ImGui::ShowAboutWindow();
+		ProfilerWindow("Profiler", ImVec2(1300, 40), 60);
+	}
+
+	void ImagesScene()
+	{
+		ImGui::SetNextWindowPos(ImVec2(100, 100), ImGuiCond_Always);
+		ImGui::SetNextWindowSize(ImVec2(600, 500), ImGuiCond_Always);
+		ImGui::Begin("Materials");
+		for (int i = 0; i < 24; i++)
+		{
+			ImGui::Image(ImageTextures[i % 2], ImVec2(48, 48));
+			ImGui::SameLine();
+			ImGui::Text("Material %d\nroughness %.2f", i, i / 24.0f);
+		}
+		ImGui::End();
+		ProfilerWindow("Profiler", ImVec2(800, 100), 30);
+	}
+
+	void LargeScene()
+	{
+		// Well over 64K vertices in one list, so it needs
+		// several VtxOffsets with 16-bit indices
+		ImDrawList* background = ImGui::GetBackgroundDrawList();
+		char line[96];
+		for (int i = 0; i < 1100; i++)
+		{
+			snprintf(line, sizeof(line), "%5d  Game::Update %8.3f ms  calls %5d  BuildRenderQueue", i, i * 0.37, i * 13);
+			background->AddText(ImVec2(10.0f + (i / 70) * 110.0f, 10.0f + (i % 70) * 15.0f), IM_COL32(200, 200, 200, 255), line);
+		}
+		ProfilerWindow("Profiler A", ImVec2(60, 60), 80);
+		ProfilerWindow("Profiler B", ImVec2(700, 300), 80);
+	}
+
+	void ResetCallbackScene()
+	{
+		ProfilerWindow("Before", ImVec2(50, 50), 20);
+		ImGui::SetNextWindowPos(ImVec2(300, 300), ImGuiCond_Always);
+		ImGui::Begin("Callback");
+		ImGui::Text("Above the reset");
+		ImGui::GetWindowDrawList()->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+		ImGui::Text("Below the reset");
+		ImGui::End();
+		ProfilerWindow("After", ImVec2(600, 200), 20);
+	}
+
+	void UserCallbackScene()
+	{
+		ProfilerWindow("Profiler", ImVec2(50, 50), 20);
+		ImGui::SetNextWindowPos(ImVec2(600, 300), ImGuiCond_Always);
+		ImGui::Begin("Custom");
+		ImGui::GetWindowDrawList()->AddCallback([](const ImDrawList*, const ImDrawCmd*) {}, nullptr);
+		ImGui::Text("Drawn after a user callback");
+		ImGui::End();
+	}
+
+	ImDrawData* BuildScene(void (*scene)())
+	{
+		for (int frame = 0; frame < 4; frame++)
+		{
+			ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+			ImGui::NewFrame();
+			scene();
+			ImGui::Render();
+		}
+		return ImGui::GetDrawData();
+	}
+
+	// --------------------------------------------------------
+	// Random lists of rects, triangles and text at fractional
+	// positions, under random and repeated clip rects (some
+	// cutting through the geometry), across a few textures,
+	// sometimes with reset callbacks or 64K+ vertices
+	// --------------------------------------------------------
+	struct RandomFrame
+	{
+		std::vector<std::unique_ptr<ImDrawList>> lists;
+		ImDrawData data;
+	};
+
+	void BuildRandomFrame(RandomFrame& frame, std::mt19937& random, int width, int height)
+	{
+		auto range = [&](float min, float max) { return min + (max - min) * (random() % 4097) / 4096.0f; };
+		auto chance = [&](int percent) { return (int)(random() % 100) < percent; };
+
+		ImVec2 offset = chance(20) ? ImVec2((float)(random() % 64), (float)(random() % 64)) : ImVec2(0, 0);
+		frame.data.Clear();
+		frame.data.Valid = true;
+		frame.data.DisplayPos = offset;
+		frame.data.DisplaySize = ImVec2((float)width, (float)height);
+		frame.data.FramebufferScale = ImVec2(1, 1);
+
+		int listCount = 1 + random() % 8;
+		frame.lists.resize(listCount);
+		ImVec4 clip(offset.x, offset.y, offset.x + width, offset.y + height);
+		for (int l = 0; l < listCount; l++)
+		{
+			if (!frame.lists[l])
+				frame.lists[l] = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+			ImDrawList* list = frame.lists[l].get();
+			list->_ResetForNewFrame();
+			list->PushTextureID(FontTexture);
+			list->PushClipRect(ImVec2(clip.x, clip.y), ImVec2(clip.z, clip.w));
+
+			int commands = 1 + random() % 12;
+			bool huge = chance(2);		// One command of it, anyway
+			for (int c = 0; c < commands; c++)
+			{
+				// Often keep the same clip rect, as windows do
+				if (chance(60))
+				{
+					float x = offset.x + range(-20, (float)width), y = offset.y + range(-20, (float)height);
+					clip = chance(10) ? ImVec4(x, y, x - range(0, 10), y + range(0, 100)) :
+						ImVec4(x, y, x + range(0, 200), y + range(0, 150));
+				}
+				list->PopClipRect();
+				list->PushClipRect(ImVec2(clip.x, clip.y), ImVec2(clip.z, clip.w));
+				ImTextureID texture = chance(70) ? FontTexture : ImageTextures[random() % 2];
+				list->PopTextureID();
+				list->PushTextureID(texture);
+
+				// Mostly inside the clip rect, the way widgets are
+				int shapes = huge && c == 0 ? 20000 : 1 + random() % 6;
+				for (int s = 0; s < shapes; s++)
+				{
+					bool inside = chance(75);
+					float x = inside ? range(clip.x, clip.z) : range(clip.x - 30, clip.z + 30);
+					float y = inside ? range(clip.y, clip.w) : range(clip.y - 30, clip.w + 30);
+					float w = range(0, inside ? std::max(0.0f, clip.z - x) : 60);
+					float h = range(0, inside ? std::max(0.0f, clip.w - y) : 60);
+					ImU32 col = (ImU32)random() | IM_COL32_A_MASK;
+					switch (random() % 4)
+					{
+					case 0: list->AddRectFilled(ImVec2(x, y), ImVec2(x + w, y + h), col); break;
+					case 1: list->AddRect(ImVec2(x, y), ImVec2(x + w, y + h), col, 0.0f, 0, range(1, 3)); break;
+					case 2: list->AddTriangleFilled(ImVec2(x, y), ImVec2(x + w, y + h * 0.5f), ImVec2(x + w * 0.3f, y + h), col); break;
+					case 3:
+						// Text has to use the font's texture
+						if (texture == FontTexture)
+							list->AddText(ImVec2(x, y), col, "Merge 0.25 ms");
+						else
+							list->AddRectFilledMultiColor(ImVec2(x, y), ImVec2(x + w, y + h), col, ~col, col, ~col);
+						break;
+					}
+				}
+				if (chance(5))
+					list->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+			}
+			list->PopClipRect();
+			list->PopTextureID();
+			frame.data.AddDrawList(list);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int randomFrames = 2000;
+	unsigned int seed = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--random") == 0 && i + 1 < argc)
+			randomFrames = std::max(0, atoi(argv[++i]));
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			seed = (unsigned int)strtoul(argv[++i], 0, 10);
+		else
+		{
+			printf("Usage: %s [--random N] [--seed S]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = 0;
+	io.DisplaySize = ImVec2(1920, 1080);
+	io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+	io.Fonts->AddFontDefault();
+	io.Fonts->Build();
+	io.Fonts->SetTexID(FontTexture);
+
+	struct Scene
+	{
+		const char* name;
+		void (*build)();
+	};
+	const Scene scenes[] =
+	{
+		{ "Demo Windows", DemoScene },
+		{ "Images", ImagesScene },
+		{ "64K+ Vertices", LargeScene },
+		{ "Reset Callback", ResetCallbackScene },
+		{ "User Callback", UserCallbackScene },
+	};
+
+	bool allSame = true;
+	PrintHeader();
+	for (const Scene& scene : scenes)
+		allSame &= Compare(scene.name, BuildScene(scene.build), 1920, 1080, true);
+
+	// Random frames need the shared draw list data a frame sets up
+	ImGui::NewFrame();
+	std::mt19937 random(seed);
+	RandomFrame frame;
+	DrawDataMergeStats totals = {};
+	int failures = 0;
+	for (int i = 0; i < randomFrames; i++)
+	{
+		BuildRandomFrame(frame, random, 320, 240);
+		char name[32];
+		snprintf(name, sizeof(name), "Random #%d", i);
+		if (!Compare(name, &frame.data, 320, 240, false, &totals))
+			failures++;
+	}
+	ImGui::EndFrame();
+	if (randomFrames > 0)
+	{
+		printf("\n%d random frames (seed %u): %d drew differently\n", randomFrames, seed, failures);
+		printf("  %u commands -> %u: %u joined with the same scissor, %u by growing it\n",
+			totals.commandsIn, totals.commandsOut, totals.joinedSameScissor, totals.joinedUnion);
+		printf("  %u shared a scissor, %u dropped, %u frames needed more than one vertex window\n",
+			totals.scissorsShared, totals.dropped, totals.vertexWindows);
+	}
+
+	ImGui::DestroyContext();
+	return allSame && failures == 0 ? 0 : 1;
+}
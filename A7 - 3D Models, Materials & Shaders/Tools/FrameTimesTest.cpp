@@ -0,0 +1,322 @@
+// --------------------------------------------------------
+// Checks the frame time statistics and the ring they're
+// kept in:
+//
+//  - Nearest-rank p50/p90/p99/p99.9 on known inputs, in any
+//    order, with the input left untouched
+//  - The stutter rule: a frame exactly twice the median is
+//    not a stutter, anything over it is
+//  - Windows of zero and one frame
+//  - The ring once it has wrapped: CopyRecent() and
+//    GetStats() only see the last WindowSize frames, oldest
+//    first, and WriteCSV() numbers them from the right frame
+//  - Copying while another thread keeps recording only ever
+//    returns consecutive frames
+//
+// Nothing here needs Windows; from this folder:
+//
+//   g++ -std=c++20 -O2 -pthread -I.. FrameTimesTest.cpp
+//       ../FrameTimes.cpp -o FrameTimesTest
+//
+// Usage:
+//   FrameTimesTest
+//
+// Exits with 1 if any check fails
+// --------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "FrameTimes.h"
+
+namespace
+{
+	unsigned int failures = 0;
+	unsigned int checks = 0;
+
+	void Expect(bool condition, const char* test, const char* what)
+	{
+		checks++;
+		if (condition)
+			return;
+		printf("  FAIL %s: %s\n", test, what);
+		failures++;
+	}
+
+	void ExpectNear(double actual, double expected, const char* test, const char* what)
+	{
+		checks++;
+		if (std::fabs(actual - expected) <= 1e-9 * std::max(1.0, std::fabs(expected)))
+			return;
+		printf("  FAIL %s: %s is %.9g, expected %.9g\n", test, what, actual, expected);
+		failures++;
+	}
+
+	// 1..count in a shuffled order
+	std::vector<float> Shuffled(unsigned int count, unsigned int seed)
+	{
+		std::vector<float> times(count);
+		for (unsigned int i = 0; i < count; i++)
+			times[i] = (float)(i + 1);
+		std::mt19937 random(seed);
+		std::shuffle(times.begin(), times.end(), random);
+		return times;
+	}
+
+	// --------------------------------------------------------
+	// With the values 1..N, nearest rank puts percentile p at
+	// exactly ceil(p * N)
+	// --------------------------------------------------------
+	void TestPercentiles()
+	{
+		const char* test = "percentiles";
+		std::vector<float> scratch;
+
+		std::vector<float> hundred = Shuffled(100, 1);
+		std::vector<float> original = hundred;
+		FrameTimeStats stats = ComputeFrameTimeStats(hundred.data(), 100, scratch);
+		Expect(stats.count == 100, test, "count of 1..100");
+		ExpectNear(stats.mean, 50.5, test, "mean of 1..100");
+		ExpectNear(stats.p50, 50, test, "p50 of 1..100");
+		ExpectNear(stats.p90, 90, test, "p90 of 1..100");
+		ExpectNear(stats.p99, 99, test, "p99 of 1..100");
+		ExpectNear(stats.p999, 100, test, "p99.9 of 1..100");
+		ExpectNear(stats.max, 100, test, "max of 1..100");
+		Expect(hundred == original, test, "input was reordered");
+
+		std::vector<float> thousand = Shuffled(1000, 2);
+		stats = ComputeFrameTimeStats(thousand.data(), 1000, scratch);
+		ExpectNear(stats.p50, 500, test, "p50 of 1..1000");
+		ExpectNear(stats.p90, 900, test, "p90 of 1..1000");
+		ExpectNear(stats.p99, 990, test, "p99 of 1..1000");
+		ExpectNear(stats.p999, 999, test, "p99.9 of 1..1000");
+
+		// Ranks that don't land on a whole number round up
+		std::vector<float> ten = Shuffled(10, 3);
+		stats = ComputeFrameTimeStats(ten.data(), 10, scratch);
+		ExpectNear(stats.p50, 5, test, "p50 of 1..10");
+		ExpectNear(stats.p90, 9, test, "p90 of 1..10");
+		ExpectNear(stats.p99, 10, test, "p99 of 1..10");
+
+		float three[] = { 5.0f, 1.0f, 3.0f };
+		stats = ComputeFrameTimeStats(three, 3, scratch);
+		ExpectNear(stats.p50, 3, test, "p50 of { 5, 1, 3 }");
+		ExpectNear(stats.mean, 3, test, "mean of { 5, 1, 3 }");
+		ExpectNear(stats.max, 5, test, "max of { 5, 1, 3 }");
+
+		// Ties, and a scratch buffer left over from a larger call
+		float ties[] = { 2.0f, 2.0f, 2.0f, 7.0f };
+		stats = ComputeFrameTimeStats(ties, 4, scratch);
+		ExpectNear(stats.p50, 2, test, "p50 of { 2, 2, 2, 7 }");
+		ExpectNear(stats.p90, 7, test, "p90 of { 2, 2, 2, 7 }");
+		Expect(scratch.size() == 4, test, "scratch holds only this call's times");
+	}
+
+	void TestStutterBoundary()
+	{
+		const char* test = "stutters";
+		std::vector<float> scratch;
+
+		// Median 10, so the limit is exactly 20
+		float atLimit[] = { 10.0f, 10.0f, 10.0f, 20.0f, 20.0f };
+		FrameTimeStats stats = ComputeFrameTimeStats(atLimit, 5, scratch);
+		ExpectNear(stats.p50, 10, test, "median");
+		Expect(stats.stutters == 0, test, "frames of exactly twice the median counted");
+
+		float justOver = std::nextafter(20.0f, 100.0f);
+		float overLimit[] = { 20.0f, 10.0f, justOver, 10.0f, 10.0f, 40.0f };
+		stats = ComputeFrameTimeStats(overLimit, 6, scratch);
+		ExpectNear(stats.p50, 10, test, "median with stutters");
+		Expect(stats.stutters == 2, test, "frames just over twice the median not all counted");
+
+		// Every frame the same is never a stutter
+		std::vector<float> steady(4096, 16.6f);
+		stats = ComputeFrameTimeStats(steady.data(), (unsigned int)steady.size(), scratch);
+		Expect(stats.stutters == 0, test, "steady frames counted");
+	}
+
+	void TestSmallWindows()
+	{
+		const char* test = "small windows";
+		std::vector<float> scratch;
+
+		FrameTimeStats stats = ComputeFrameTimeStats(nullptr, 0, scratch);
+		Expect(stats.count == 0, test, "count with no frames");
+		ExpectNear(stats.mean, 0, test, "mean with no frames");
+		ExpectNear(stats.p50, 0, test, "p50 with no frames");
+		ExpectNear(stats.p999, 0, test, "p99.9 with no frames");
+		ExpectNear(stats.max, 0, test, "max with no frames");
+		Expect(stats.stutters == 0, test, "stutters with no frames");
+
+		float one = 12.5f;
+		stats = ComputeFrameTimeStats(&one, 1, scratch);
+		Expect(stats.count == 1, test, "count of one frame");
+		ExpectNear(stats.mean, 12.5, test, "mean of one frame");
+		ExpectNear(stats.p50, 12.5, test, "p50 of one frame");
+		ExpectNear(stats.p90, 12.5, test, "p90 of one frame");
+		ExpectNear(stats.p99, 12.5, test, "p99 of one frame");
+		ExpectNear(stats.p999, 12.5, test, "p99.9 of one frame");
+		ExpectNear(stats.max, 12.5, test, "max of one frame");
+		Expect(stats.stutters == 0, test, "stutters in one frame");
+	}
+
+	// Whether times holds first, first + 1, ... for count frames
+	bool Consecutive(const float* times, unsigned int count, float first)
+	{
+		for (unsigned int i = 0; i < count; i++)
+		{
+			if (times[i] != first + (float)i)
+				return false;
+		}
+		return true;
+	}
+
+	// --------------------------------------------------------
+	// The ring is global, so this runs from an empty ring up
+	// through a couple of wraps.  Each frame records its own
+	// number, which floats hold exactly at these sizes
+	// --------------------------------------------------------
+	void TestRing()
+	{
+		const char* test = "ring";
+		const unsigned int Window = FrameTimes::WindowSize;
+		std::vector<float> copy(Window * 2, -1.0f);
+
+		Expect(FrameTimes::GetFrameCount() == 0, test, "frames before any were recorded");
+		Expect(FrameTimes::CopyRecent(copy.data(), Window) == 0, test, "copied from an empty ring");
+		Expect(FrameTimes::GetStats().count == 0, test, "stats of an empty ring");
+
+		// Before the window fills, stats follow every frame
+		FrameTimes::Record(0.0f);
+		Expect(FrameTimes::GetStats().count == 1, test, "stats after the first frame");
+		for (unsigned int i = 1; i < 10; i++)
+			FrameTimes::Record((float)i);
+		Expect(FrameTimes::CopyRecent(copy.data(), Window) == 10, test, "copied count before wrapping");
+		Expect(Consecutive(copy.data(), 10, 0.0f), test, "frames before wrapping out of order");
+		Expect(FrameTimes::GetStats().count == 10, test, "stats count before wrapping");
+		ExpectNear(FrameTimes::GetStats().max, 9, test, "max before wrapping");
+
+		// Two and a bit times round
+		const unsigned int Total = Window * 2 + 123;
+		for (unsigned int i = 10; i < Total; i++)
+			FrameTimes::Record((float)i);
+		Expect(FrameTimes::GetFrameCount() == Total, test, "frame count after wrapping");
+
+		float oldest = (float)(Total - Window);
+		unsigned int copied = FrameTimes::CopyRecent(copy.data(), Window * 2);
+		Expect(copied == Window, test, "copy asked for more than the window");
+		Expect(Consecutive(copy.data(), copied, oldest), test, "wrapped window not oldest first");
+
+		copied = FrameTimes::CopyRecent(copy.data(), 100);
+		Expect(copied == 100, test, "partial copy count");
+		Expect(Consecutive(copy.data(), 100, (float)(Total - 100)), test, "partial copy isn't the newest frames");
+
+		// Stats are only rebuilt every 32 frames, so refresh them
+		// now and record that many more to be sure of the next
+		FrameTimes::GetStats();
+		for (unsigned int i = 0; i < 32; i++)
+			FrameTimes::Record((float)(Total + i));
+		const FrameTimeStats* stats = &FrameTimes::GetStats();
+		unsigned int end = Total + 32;
+		oldest = (float)(end - Window);
+		Expect(stats->count == Window, test, "stats count after wrapping");
+		ExpectNear(stats->max, end - 1, test, "max after wrapping");
+		ExpectNear(stats->p50, oldest + Window / 2 - 1, test, "p50 after wrapping");
+		ExpectNear(stats->mean, oldest + (Window - 1) / 2.0, test, "mean after wrapping");
+
+		// The CSV numbers frames from the oldest one kept
+		std::string path = "FrameTimesTest_" + std::to_string(getpid()) + ".csv";
+		Expect(FrameTimes::WriteCSV(path), test, "CSV couldn't be written");
+		std::ifstream csv(path);
+		std::string header, first;
+		std::getline(csv, header);
+		std::getline(csv, first);
+		char expected[64];
+		snprintf(expected, sizeof(expected), "%u,%u", end - Window, end - Window);
+		Expect(header == "frame,ms", test, "CSV header");
+		Expect(first == expected, test, "CSV's first row isn't the oldest frame kept");
+		csv.close();
+		remove(path.c_str());
+	}
+
+	// --------------------------------------------------------
+	// A writer records as fast as it can while this thread
+	// copies.  Slots the writer reaches mid-copy must be
+	// dropped, so every copy is a consecutive run ending no
+	// earlier than the frame count before it started
+	//
+	// The writer yields now and then so that, even on a single
+	// core, this thread is often switched out mid-copy
+	// --------------------------------------------------------
+	void TestConcurrentCopy()
+	{
+		const char* test = "concurrent copy";
+		const unsigned int Window = FrameTimes::WindowSize;
+		unsigned long long start = FrameTimes::GetFrameCount();
+
+		// As many as floats can still number exactly
+		const unsigned int Frames = (1u << 24) - (unsigned int)start - Window;
+		std::atomic<bool> done{ false };
+		std::thread writer([&]()
+		{
+			for (unsigned int i = 0; i < Frames; i++)
+			{
+				FrameTimes::Record((float)(start + i));
+				if ((i & 0xFFFF) == 0)
+					std::this_thread::yield();
+			}
+			done = true;
+		});
+
+		std::vector<float> copy(Window);
+		unsigned int copies = 0;
+		unsigned int shortened = 0;
+		unsigned int broken = 0;
+		while (!done)
+		{
+			unsigned long long before = FrameTimes::GetFrameCount();
+			unsigned int copied = FrameTimes::CopyRecent(copy.data(), Window);
+			copies++;
+			if (copied < Window)
+				shortened++;
+			if (copied == 0)
+				continue;
+			if (!Consecutive(copy.data(), copied, copy[0]) || copy[copied - 1] + 1.0f < (float)before)
+				broken++;
+		}
+		writer.join();
+
+		Expect(broken == 0, test, "a copy held frames that weren't consecutive");
+		Expect(FrameTimes::GetFrameCount() == start + Frames, test, "frame count after the writer finished");
+		unsigned int copied = FrameTimes::CopyRecent(copy.data(), Window);
+		Expect(copied == Window && Consecutive(copy.data(), copied, (float)(start + Frames - Window)), test,
+			"window after the writer finished");
+		printf("  %u copies made while recording, %u of them cut short by the writer\n", copies, shortened);
+	}
+}
+
+int main()
+{
+	TestPercentiles();
+	TestStutterBoundary();
+	TestSmallWindows();
+	TestRing();
+	TestConcurrentCopy();
+
+	if (failures > 0)
+	{
+		printf("%u of %u checks failed\n", failures, checks);
+		return 1;
+	}
+	printf("All %u checks passed\n", checks);
+	return 0;
+}
@@ -0,0 +1,66 @@
+// --------------------------------------------------------
+// Runs the game built with GRAPHICS_NULL on Linux, without
+// Windows or a GPU.  Needs DirectXMath (github.com/microsoft/
+// DirectXMath, with its Linux sal.h) on the include path.
+// From the project folder:
+//
+//   g++ -std=c++20 -O2 -DGRAPHICS_NULL -DNDEBUG -pthread
+//       -Wall -Wno-unknown-pragmas -ITools/LinuxShim -I.
+//       -I<DirectXMath>/Inc -I<sal>
+//       AllocationTracker.cpp Benchmark.cpp Camera.cpp
+//       CameraPath.cpp ConstantBufferRing.cpp
+//       D3D11RenderBackend.cpp DeferredRecorder.cpp
+//       DrawChunks.cpp DrawDataMerger.cpp FilteredList.cpp
+//       FontAtlasCache.cpp FrameArena.cpp FrameTimes.cpp
+//       Frustum.cpp Game.cpp GameEntity.cpp Graphics.cpp
+//       Input.cpp Main.cpp Mesh.cpp MeshBVH.cpp
+//       NullGraphics.cpp NullRenderBackend.cpp PathHelpers.cpp
+//       PoolAllocator.cpp Profiler.cpp RenderCapture.cpp
+//       RenderCommands.cpp RenderQueue.cpp RenderResources.cpp
+//       RenderStats.cpp RetainedUI.cpp RingAllocator.cpp
+//       StateCache.cpp TraceWriter.cpp Transform.cpp
+//       VisibilityCache.cpp Window.cpp ImGui/imgui.cpp
+//       ImGui/imgui_demo.cpp ImGui/imgui_draw.cpp
+//       ImGui/imgui_tables.cpp ImGui/imgui_widgets.cpp
+//       Tools/LinuxShim/LinuxMain.cpp -o NullGame
+//
+// That's every file in the project but the two ImGui
+// backends, which GRAPHICS_NULL leaves out.  It builds with
+// no warnings; -Wno-unknown-pragmas is only for the #pragma
+// comment(lib) lines meant for MSVC's linker.  The arguments
+// are the same as on Windows:
+//
+//   NullGame [-frames N] [-trace]
+//   NullGame -benchmark <scene> [options, see Benchmark.cpp]
+//
+// Results go next to the executable, as they do on Windows
+// --------------------------------------------------------
+
+#include <Windows.h>
+#include <string>
+
+#include "../../ImGui/imgui_impl_win32.h"
+
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow);
+
+// Window::ProcessMessage() passes messages to the Win32
+// backend first, but there are never any messages here
+IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+	return 0;
+}
+
+// The arguments, joined back into the one string WinMain()
+// gets on Windows
+int main(int argc, char** argv)
+{
+	std::string commandLine;
+	for (int i = 1; i < argc; i++)
+	{
+		if (i > 1)
+			commandLine += ' ';
+		commandLine += argv[i];
+	}
+
+	return WinMain(0, 0, commandLine.data(), 0);
+}
@@ -0,0 +1,408 @@
+#pragma once
+
+// --------------------------------------------------------
+// Just enough of Windows.h for the engine files the Linux
+// tools compile, nothing more:
+//
+//  - Input and Camera, for the tools in the folder above
+//  - The whole game built with GRAPHICS_NULL (see
+//    LinuxMain.cpp), which also needs COM, timing, paths
+//    and the window and console calls Window.cpp makes
+//
+// The keyboard reads from LinuxShimKeyboardState, so a tool
+// can press keys by setting the high bit of an entry.  There
+// is never a window: creating one fails, and the console
+// calls do nothing since stdout already is the console
+// --------------------------------------------------------
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <ctime>
+#include <type_traits>
+#include <malloc.h>
+#include <unistd.h>
+
+typedef int BOOL;
+typedef int INT;
+typedef unsigned char BYTE;
+typedef unsigned char UINT8;
+typedef unsigned short USHORT;
+typedef unsigned short WORD;
+typedef short SHORT;
+typedef unsigned int UINT;
+typedef unsigned int ULONG;
+typedef unsigned int DWORD;
+typedef int LONG;
+typedef int HRESULT;
+typedef float FLOAT;
+typedef unsigned long long UINT64;
+typedef long long __int64;
+typedef size_t SIZE_T;
+typedef long long LPARAM;
+typedef unsigned long long WPARAM;
+typedef long long LRESULT;
+typedef char* LPSTR;
+typedef const char* LPCSTR;
+typedef wchar_t WCHAR;
+typedef const wchar_t* LPCWSTR;
+typedef void* HANDLE;
+typedef void* HWND;
+typedef void* HRAWINPUT;
+typedef void* HINSTANCE;
+typedef void* HMENU;
+typedef void* HICON;
+typedef void* HCURSOR;
+typedef void* HBRUSH;
+typedef void* HGDIOBJ;
+
+#define TRUE	1
+#define FALSE	0
+
+#define WINAPI
+#define CALLBACK
+#define STDMETHODCALLTYPE
+#define __declspec(x)
+
+// DirectXMath's sal.h may have these already
+#ifndef _In_
+#define _In_
+#endif
+#ifndef _In_opt_
+#define _In_opt_
+#endif
+
+#define ARRAYSIZE(a)	(sizeof(a) / sizeof((a)[0]))
+
+// --------------------------------------------------------
+// HRESULTs and the handful of error codes the engine checks
+// --------------------------------------------------------
+#define S_OK			((HRESULT)0)
+#define E_NOTIMPL		((HRESULT)0x80004001)
+#define E_NOINTERFACE	((HRESULT)0x80004002)
+#define E_POINTER		((HRESULT)0x80004003)
+#define E_FAIL			((HRESULT)0x80004005)
+#define E_OUTOFMEMORY	((HRESULT)0x8007000E)
+#define E_INVALIDARG	((HRESULT)0x80070057)
+
+#define SUCCEEDED(hr)	(((HRESULT)(hr)) >= 0)
+#define FAILED(hr)		(((HRESULT)(hr)) < 0)
+#define HRESULT_FROM_WIN32(x)	((HRESULT)(x) <= 0 ? (HRESULT)(x) : (HRESULT)(((x) & 0x0000FFFF) | 0x80070000))
+
+#define ERROR_CLASS_ALREADY_EXISTS	1410L
+
+// --------------------------------------------------------
+// COM.  __uuidof() hands out a distinct id per interface
+// the first time it's asked, which is all QueryInterface()
+// and ComPtr::As() need
+// --------------------------------------------------------
+struct GUID
+{
+	unsigned int Data1;
+	unsigned short Data2;
+	unsigned short Data3;
+	unsigned char Data4[8];
+};
+typedef GUID IID;
+typedef const GUID& REFGUID;
+typedef const IID& REFIID;
+
+inline bool operator==(const GUID& a, const GUID& b) { return memcmp(&a, &b, sizeof(GUID)) == 0; }
+inline bool operator!=(const GUID& a, const GUID& b) { return !(a == b); }
+
+inline std::atomic<unsigned int> LinuxShimNextUuid{ 1 };
+
+template<typename Interface>
+const GUID& LinuxShimUuidOf()
+{
+	static const GUID id = { LinuxShimNextUuid++ };
+	return id;
+}
+
+#define __uuidof(T) LinuxShimUuidOf<std::remove_cv_t<std::remove_reference_t<T>>>()
+#define IID_PPV_ARGS(pp) LinuxShimUuidOf<std::remove_cv_t<std::remove_reference_t<decltype(**(pp))>>>(), reinterpret_cast<void**>(pp)
+
+struct IUnknown
+{
+	virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) = 0;
+	virtual ULONG STDMETHODCALLTYPE AddRef() = 0;
+	virtual ULONG STDMETHODCALLTYPE Release() = 0;
+};
+
+// --------------------------------------------------------
+// Input
+// --------------------------------------------------------
+#define VK_LBUTTON	0x01
+#define VK_RBUTTON	0x02
+#define VK_MBUTTON	0x04
+#define VK_TAB		0x09
+#define VK_SHIFT	0x10
+#define VK_CONTROL	0x11
+#define VK_ESCAPE	0x1B
+#define VK_F7		0x76
+#define VK_F8		0x77
+#define VK_F9		0x78
+
+#define RIDEV_INPUTSINK	0x00000100
+#define RID_INPUT		0x10000003
+#define RIM_TYPEMOUSE	0
+
+struct POINT { LONG x; LONG y; };
+
+struct RAWINPUTDEVICE
+{
+	USHORT usUsagePage;
+	USHORT usUsage;
+	DWORD dwFlags;
+	HWND hwndTarget;
+};
+
+struct RAWINPUTHEADER
+{
+	DWORD dwType;
+	DWORD dwSize;
+	HANDLE hDevice;
+	WPARAM wParam;
+};
+
+struct RAWMOUSE
+{
+	USHORT usFlags;
+	USHORT usButtonFlags;
+	USHORT usButtonData;
+	unsigned long ulRawButtons;
+	LONG lLastX;
+	LONG lLastY;
+	unsigned long ulExtraInformation;
+};
+
+struct RAWINPUT
+{
+	RAWINPUTHEADER header;
+	union { RAWMOUSE mouse; } data;
+};
+
+inline BYTE LinuxShimKeyboardState[256] = {};
+
+inline BOOL GetKeyboardState(BYTE* keyStates)
+{
+	memcpy(keyStates, LinuxShimKeyboardState, sizeof(LinuxShimKeyboardState));
+	return 1;
+}
+
+inline BOOL GetCursorPos(POINT* point) { point->x = 0; point->y = 0; return 1; }
+inline BOOL ScreenToClient(HWND, POINT*) { return 1; }
+inline BOOL RegisterRawInputDevices(const RAWINPUTDEVICE*, UINT, UINT) { return 1; }
+inline UINT GetRawInputData(HRAWINPUT, UINT, void*, UINT*, UINT) { return (UINT)-1; }
+
+// --------------------------------------------------------
+// Timing, with the counter in nanoseconds
+// --------------------------------------------------------
+union LARGE_INTEGER
+{
+	struct { DWORD LowPart; LONG HighPart; };
+	long long QuadPart;
+};
+
+inline BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency)
+{
+	frequency->QuadPart = 1000000000LL;
+	return 1;
+}
+
+inline BOOL QueryPerformanceCounter(LARGE_INTEGER* counter)
+{
+	timespec now = {};
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	counter->QuadPart = (long long)now.tv_sec * 1000000000LL + now.tv_nsec;
+	return 1;
+}
+
+// --------------------------------------------------------
+// Paths and strings.  The conversions only ever see the
+// ASCII paths FixPath() builds
+// --------------------------------------------------------
+#define CP_UTF8	65001
+
+inline DWORD GetModuleFileNameA(HANDLE, char* fileName, DWORD size)
+{
+	ssize_t length = readlink("/proc/self/exe", fileName, size - 1);
+	if (length < 0)
+		length = 0;
+	fileName[length] = 0;
+	return (DWORD)length;
+}
+
+// A length of -1 means "up to and including the terminator",
+// and a null destination asks for the size needed
+inline int MultiByteToWideChar(UINT, DWORD, const char* source, int sourceLength, wchar_t* dest, int destLength)
+{
+	int length = sourceLength < 0 ? (int)strlen(source) + 1 : sourceLength;
+	if (!dest)
+		return length;
+
+	int count = length < destLength ? length : destLength;
+	for (int i = 0; i < count; i++)
+		dest[i] = (wchar_t)(unsigned char)source[i];
+	return count;
+}
+
+inline int WideCharToMultiByte(UINT, DWORD, const wchar_t* source, int sourceLength, char* dest, int destLength, const char*, BOOL*)
+{
+	int length = sourceLength < 0 ? (int)wcslen(source) + 1 : sourceLength;
+	if (!dest)
+		return length;
+
+	int count = length < destLength ? length : destLength;
+	for (int i = 0; i < count; i++)
+		dest[i] = (char)source[i];
+	return count;
+}
+
+// --------------------------------------------------------
+// Memory, for AllocationTracker.  The sizes are whole blocks,
+// which can be a little more than was asked for, so freed
+// bytes can run slightly ahead of allocated bytes
+// --------------------------------------------------------
+inline size_t _msize(void* memory) { return malloc_usable_size(memory); }
+
+inline void* _aligned_malloc(size_t size, size_t alignment)
+{
+	void* memory = 0;
+	return posix_memalign(&memory, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) == 0 ? memory : 0;
+}
+
+inline size_t _aligned_msize(void* memory, size_t, size_t) { return malloc_usable_size(memory); }
+inline void _aligned_free(void* memory) { free(memory); }
+
+// --------------------------------------------------------
+// Windows and messages.  Window::Create() gets as far as
+// CreateWindow(), which fails, so only headless runs work
+// --------------------------------------------------------
+#define WM_DESTROY			0x0002
+#define WM_SIZE				0x0005
+#define WM_ACTIVATE			0x0006
+#define WM_SETFOCUS			0x0007
+#define WM_KILLFOCUS		0x0008
+#define WM_CLOSE			0x0010
+#define WM_QUIT				0x0012
+#define WM_GETMINMAXINFO	0x0024
+#define WM_MENUCHAR			0x0120
+#define WM_MOUSEWHEEL		0x020A
+
+#define WA_INACTIVE		0
+#define SIZE_MINIMIZED	1
+#define MNC_CLOSE		1
+#define WHEEL_DELTA		120
+#define PM_REMOVE		0x0001
+
+#define CS_VREDRAW			0x0001
+#define CS_HREDRAW			0x0002
+#define WS_OVERLAPPEDWINDOW	0x00CF0000L
+#define SW_SHOW				5
+#define BLACK_BRUSH			4
+#define SC_CLOSE			0xF060
+#define MF_GRAYED			0x00000001L
+#define IDI_APPLICATION		((LPCWSTR)32512)
+#define IDC_ARROW			((LPCWSTR)32512)
+
+#define LOWORD(l)	((WORD)(((UINT64)(l)) & 0xffff))
+#define HIWORD(l)	((WORD)((((UINT64)(l)) >> 16) & 0xffff))
+#define MAKELRESULT(l, h)	((LRESULT)(DWORD)(((WORD)(l)) | ((DWORD)((WORD)(h))) << 16))
+#define GET_WHEEL_DELTA_WPARAM(w)	((short)HIWORD(w))
+
+typedef LRESULT (CALLBACK* WNDPROC)(HWND, UINT, WPARAM, LPARAM);
+
+struct RECT { LONG left; LONG top; LONG right; LONG bottom; };
+
+struct MSG
+{
+	HWND hwnd;
+	UINT message;
+	WPARAM wParam;
+	LPARAM lParam;
+	DWORD time;
+	POINT pt;
+};
+
+struct MINMAXINFO
+{
+	POINT ptReserved;
+	POINT ptMaxSize;
+	POINT ptMaxPosition;
+	POINT ptMinTrackSize;
+	POINT ptMaxTrackSize;
+};
+
+struct WNDCLASS
+{
+	UINT style;
+	WNDPROC lpfnWndProc;
+	int cbClsExtra;
+	int cbWndExtra;
+	HINSTANCE hInstance;
+	HICON hIcon;
+	HCURSOR hCursor;
+	HBRUSH hbrBackground;
+	LPCWSTR lpszMenuName;
+	LPCWSTR lpszClassName;
+};
+
+inline DWORD GetLastError() { return 0; }
+inline HICON LoadIcon(HINSTANCE, LPCWSTR) { return 0; }
+inline HCURSOR LoadCursor(HINSTANCE, LPCWSTR) { return 0; }
+inline HGDIOBJ GetStockObject(int) { return 0; }
+inline WORD RegisterClass(const WNDCLASS*) { return 1; }
+inline BOOL SetRect(RECT* rect, int left, int top, int right, int bottom) { *rect = { left, top, right, bottom }; return 1; }
+inline BOOL AdjustWindowRect(RECT*, DWORD, BOOL) { return 1; }
+inline HWND GetDesktopWindow() { return 0; }
+inline BOOL GetClientRect(HWND, RECT* rect) { *rect = {}; return 1; }
+inline HWND CreateWindow(LPCWSTR, LPCWSTR, DWORD, int, int, int, int, HWND, HMENU, HINSTANCE, void*) { return 0; }
+inline BOOL ShowWindow(HWND, int) { return 1; }
+inline BOOL SetWindowText(HWND, LPCWSTR) { return 1; }
+inline BOOL PostMessage(HWND, UINT, WPARAM, LPARAM) { return 1; }
+inline void PostQuitMessage(int) {}
+inline LRESULT DefWindowProc(HWND, UINT, WPARAM, LPARAM) { return 0; }
+inline BOOL PeekMessage(MSG*, HWND, UINT, UINT, UINT) { return 0; }
+inline BOOL TranslateMessage(const MSG*) { return 1; }
+inline LRESULT DispatchMessage(const MSG*) { return 0; }
+
+// --------------------------------------------------------
+// The console.  A Linux build already writes to one, so
+// these leave stdin, stdout and stderr as they are
+// --------------------------------------------------------
+#define STD_OUTPUT_HANDLE	((DWORD)-11)
+#define ENABLE_PROCESSED_OUTPUT				0x0001
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING	0x0004
+
+struct COORD { SHORT X; SHORT Y; };
+struct SMALL_RECT { SHORT Left; SHORT Top; SHORT Right; SHORT Bottom; };
+
+struct CONSOLE_SCREEN_BUFFER_INFO
+{
+	COORD dwSize;
+	COORD dwCursorPosition;
+	WORD wAttributes;
+	SMALL_RECT srWindow;
+	COORD dwMaximumWindowSize;
+};
+
+inline BOOL AllocConsole() { return 1; }
+inline HANDLE GetStdHandle(DWORD) { return 0; }
+inline BOOL GetConsoleScreenBufferInfo(HANDLE, CONSOLE_SCREEN_BUFFER_INFO* info) { *info = {}; return 1; }
+inline BOOL SetConsoleScreenBufferSize(HANDLE, COORD) { return 1; }
+inline BOOL SetConsoleWindowInfo(HANDLE, BOOL, const SMALL_RECT*) { return 1; }
+inline BOOL GetConsoleMode(HANDLE, DWORD* mode) { *mode = 0; return 1; }
+inline BOOL SetConsoleMode(HANDLE, DWORD) { return 1; }
+inline HWND GetConsoleWindow() { return 0; }
+inline HMENU GetSystemMenu(HWND, BOOL) { return 0; }
+inline BOOL EnableMenuItem(HMENU, UINT, UINT) { return 1; }
+
+inline int freopen_s(FILE** stream, const char*, const char*, FILE* existing)
+{
+	*stream = existing;
+	return 0;
+}
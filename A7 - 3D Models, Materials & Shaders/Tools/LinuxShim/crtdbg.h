@@ -0,0 +1,7 @@
+#pragma once
+
+// The debug heap is Windows only, see Windows.h in this folder
+#define _CRTDBG_ALLOC_MEM_DF	0x01
+#define _CRTDBG_LEAK_CHECK_DF	0x20
+
+inline int _CrtSetDbgFlag(int) { return 0; }
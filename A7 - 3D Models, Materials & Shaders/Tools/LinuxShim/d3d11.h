@@ -0,0 +1,494 @@
+#pragma once
+
+// --------------------------------------------------------
+// The D3D11 types and interfaces NullGraphics implements,
+// for building the game with GRAPHICS_NULL on Linux (see
+// LinuxMain.cpp).  The interfaces list every method, since
+// NullGraphics overrides them all; the rest only has what
+// the engine uses
+//
+// Descriptions that are only ever passed by pointer to calls
+// the null device turns down are left incomplete
+// --------------------------------------------------------
+
+#include <Windows.h>
+#include <dxgi.h>
+
+#define D3D11_APPEND_ALIGNED_ELEMENT	0xffffffff
+#define D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE	16
+
+enum D3D_FEATURE_LEVEL
+{
+	D3D_FEATURE_LEVEL_10_0 = 0xa000,
+	D3D_FEATURE_LEVEL_10_1 = 0xa100,
+	D3D_FEATURE_LEVEL_11_0 = 0xb000,
+	D3D_FEATURE_LEVEL_11_1 = 0xb100,
+};
+
+enum D3D11_USAGE
+{
+	D3D11_USAGE_DEFAULT = 0,
+	D3D11_USAGE_IMMUTABLE = 1,
+	D3D11_USAGE_DYNAMIC = 2,
+	D3D11_USAGE_STAGING = 3,
+};
+
+enum D3D11_BIND_FLAG
+{
+	D3D11_BIND_VERTEX_BUFFER = 0x1,
+	D3D11_BIND_INDEX_BUFFER = 0x2,
+	D3D11_BIND_CONSTANT_BUFFER = 0x4,
+	D3D11_BIND_SHADER_RESOURCE = 0x8,
+	D3D11_BIND_RENDER_TARGET = 0x20,
+	D3D11_BIND_DEPTH_STENCIL = 0x40,
+};
+
+enum D3D11_CPU_ACCESS_FLAG
+{
+	D3D11_CPU_ACCESS_WRITE = 0x10000,
+	D3D11_CPU_ACCESS_READ = 0x20000,
+};
+
+enum D3D11_MAP
+{
+	D3D11_MAP_READ = 1,
+	D3D11_MAP_WRITE = 2,
+	D3D11_MAP_READ_WRITE = 3,
+	D3D11_MAP_WRITE_DISCARD = 4,
+	D3D11_MAP_WRITE_NO_OVERWRITE = 5,
+};
+
+enum D3D11_CLEAR_FLAG
+{
+	D3D11_CLEAR_DEPTH = 0x1,
+	D3D11_CLEAR_STENCIL = 0x2,
+};
+
+enum D3D11_RESOURCE_DIMENSION
+{
+	D3D11_RESOURCE_DIMENSION_UNKNOWN = 0,
+	D3D11_RESOURCE_DIMENSION_BUFFER = 1,
+	D3D11_RESOURCE_DIMENSION_TEXTURE1D = 2,
+	D3D11_RESOURCE_DIMENSION_TEXTURE2D = 3,
+	D3D11_RESOURCE_DIMENSION_TEXTURE3D = 4,
+};
+
+enum D3D11_PRIMITIVE_TOPOLOGY
+{
+	D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED = 0,
+	D3D11_PRIMITIVE_TOPOLOGY_POINTLIST = 1,
+	D3D11_PRIMITIVE_TOPOLOGY_LINELIST = 2,
+	D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP = 3,
+	D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST = 4,
+	D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+};
+
+enum D3D11_INPUT_CLASSIFICATION
+{
+	D3D11_INPUT_PER_VERTEX_DATA = 0,
+	D3D11_INPUT_PER_INSTANCE_DATA = 1,
+};
+
+enum D3D11_DEVICE_CONTEXT_TYPE
+{
+	D3D11_DEVICE_CONTEXT_IMMEDIATE = 0,
+	D3D11_DEVICE_CONTEXT_DEFERRED = 1,
+};
+
+enum D3D11_FEATURE
+{
+	D3D11_FEATURE_THREADING = 0,
+	D3D11_FEATURE_D3D11_OPTIONS = 2,
+};
+
+enum D3D11_COUNTER_TYPE
+{
+	D3D11_COUNTER_TYPE_FLOAT32 = 0,
+	D3D11_COUNTER_TYPE_UINT16 = 1,
+	D3D11_COUNTER_TYPE_UINT32 = 2,
+	D3D11_COUNTER_TYPE_UINT64 = 3,
+};
+
+enum D3D11_MESSAGE_SEVERITY
+{
+	D3D11_MESSAGE_SEVERITY_CORRUPTION = 0,
+	D3D11_MESSAGE_SEVERITY_ERROR = 1,
+	D3D11_MESSAGE_SEVERITY_WARNING = 2,
+	D3D11_MESSAGE_SEVERITY_INFO = 3,
+	D3D11_MESSAGE_SEVERITY_MESSAGE = 4,
+};
+
+struct D3D11_BUFFER_DESC
+{
+	UINT ByteWidth;
+	D3D11_USAGE Usage;
+	UINT BindFlags;
+	UINT CPUAccessFlags;
+	UINT MiscFlags;
+	UINT StructureByteStride;
+};
+
+struct D3D11_TEXTURE2D_DESC
+{
+	UINT Width;
+	UINT Height;
+	UINT MipLevels;
+	UINT ArraySize;
+	DXGI_FORMAT Format;
+	DXGI_SAMPLE_DESC SampleDesc;
+	D3D11_USAGE Usage;
+	UINT BindFlags;
+	UINT CPUAccessFlags;
+	UINT MiscFlags;
+};
+
+struct D3D11_SUBRESOURCE_DATA
+{
+	const void* pSysMem;
+	UINT SysMemPitch;
+	UINT SysMemSlicePitch;
+};
+
+struct D3D11_MAPPED_SUBRESOURCE
+{
+	void* pData;
+	UINT RowPitch;
+	UINT DepthPitch;
+};
+
+struct D3D11_INPUT_ELEMENT_DESC
+{
+	LPCSTR SemanticName;
+	UINT SemanticIndex;
+	DXGI_FORMAT Format;
+	UINT InputSlot;
+	UINT AlignedByteOffset;
+	D3D11_INPUT_CLASSIFICATION InputSlotClass;
+	UINT InstanceDataStepRate;
+};
+
+// Views only ever use the whole first mip of a 2D texture
+struct D3D11_RENDER_TARGET_VIEW_DESC
+{
+	DXGI_FORMAT Format;
+	UINT ViewDimension;
+	struct { UINT MipSlice; } Texture2D;
+};
+
+struct D3D11_DEPTH_STENCIL_VIEW_DESC
+{
+	DXGI_FORMAT Format;
+	UINT ViewDimension;
+	UINT Flags;
+	struct { UINT MipSlice; } Texture2D;
+};
+
+struct D3D11_VIEWPORT
+{
+	FLOAT TopLeftX;
+	FLOAT TopLeftY;
+	FLOAT Width;
+	FLOAT Height;
+	FLOAT MinDepth;
+	FLOAT MaxDepth;
+};
+
+typedef RECT D3D11_RECT;
+
+struct D3D11_BOX
+{
+	UINT left;
+	UINT top;
+	UINT front;
+	UINT right;
+	UINT bottom;
+	UINT back;
+};
+
+struct D3D11_FEATURE_DATA_THREADING
+{
+	BOOL DriverConcurrentCreates;
+	BOOL DriverCommandLists;
+};
+
+struct D3D11_FEATURE_DATA_D3D11_OPTIONS
+{
+	BOOL OutputMergerLogicOp;
+	BOOL UAVOnlyRenderingForcedSampleCount;
+	BOOL DiscardAPIsSeenByDriver;
+	BOOL FlagsForUpdateAndCopySeenByDriver;
+	BOOL ClearView;
+	BOOL CopyWithOverlap;
+	BOOL ConstantBufferPartialUpdate;
+	BOOL ConstantBufferOffsetting;
+	BOOL MapNoOverwriteOnDynamicConstantBuffer;
+	BOOL MapNoOverwriteOnDynamicBufferSRV;
+	BOOL MultisampleRTVWithForcedSampleCountOne;
+	BOOL SAD4ShaderInstructions;
+	BOOL ExtendedDoublesShaderInstructions;
+	BOOL ExtendedResourceSharing;
+};
+
+struct D3D11_COUNTER_INFO
+{
+	UINT LastDeviceDependentCounter;
+	UINT NumSimultaneousCounters;
+	UINT8 NumDetectableParallelUnits;
+};
+
+struct D3D11_MESSAGE
+{
+	UINT Category;
+	D3D11_MESSAGE_SEVERITY Severity;
+	UINT ID;
+	const char* pDescription;
+	SIZE_T DescriptionByteLength;
+};
+
+struct D3D11_TEXTURE1D_DESC;
+struct D3D11_TEXTURE3D_DESC;
+struct D3D11_SHADER_RESOURCE_VIEW_DESC;
+struct D3D11_UNORDERED_ACCESS_VIEW_DESC;
+struct D3D11_SO_DECLARATION_ENTRY;
+struct D3D11_BLEND_DESC;
+struct D3D11_DEPTH_STENCIL_DESC;
+struct D3D11_RASTERIZER_DESC;
+struct D3D11_SAMPLER_DESC;
+struct D3D11_QUERY_DESC;
+struct D3D11_COUNTER_DESC;
+
+struct ID3D11Device;
+struct ID3D11ClassInstance;
+struct ID3D11ClassLinkage;
+
+// --------------------------------------------------------
+// Device children: resources, views, shaders and states
+// --------------------------------------------------------
+struct ID3D11DeviceChild : IUnknown
+{
+	virtual void STDMETHODCALLTYPE GetDevice(ID3D11Device** device) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) = 0;
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) = 0;
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) = 0;
+};
+
+struct ID3D11Resource : ID3D11DeviceChild
+{
+	virtual void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) = 0;
+	virtual void STDMETHODCALLTYPE SetEvictionPriority(UINT priority) = 0;
+	virtual UINT STDMETHODCALLTYPE GetEvictionPriority() = 0;
+};
+
+struct ID3D11Buffer : ID3D11Resource
+{
+	virtual void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* desc) = 0;
+};
+
+struct ID3D11Texture1D : ID3D11Resource {};
+struct ID3D11Texture3D : ID3D11Resource {};
+
+struct ID3D11Texture2D : ID3D11Resource
+{
+	virtual void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE2D_DESC* desc) = 0;
+};
+
+struct ID3D11View : ID3D11DeviceChild
+{
+	virtual void STDMETHODCALLTYPE GetResource(ID3D11Resource** resource) = 0;
+};
+
+struct ID3D11RenderTargetView : ID3D11View
+{
+	virtual void STDMETHODCALLTYPE GetDesc(D3D11_RENDER_TARGET_VIEW_DESC* desc) = 0;
+};
+
+struct ID3D11DepthStencilView : ID3D11View
+{
+	virtual void STDMETHODCALLTYPE GetDesc(D3D11_DEPTH_STENCIL_VIEW_DESC* desc) = 0;
+};
+
+struct ID3D11ShaderResourceView : ID3D11View {};
+struct ID3D11UnorderedAccessView : ID3D11View {};
+
+struct ID3D11VertexShader : ID3D11DeviceChild {};
+struct ID3D11PixelShader : ID3D11DeviceChild {};
+struct ID3D11GeometryShader : ID3D11DeviceChild {};
+struct ID3D11HullShader : ID3D11DeviceChild {};
+struct ID3D11DomainShader : ID3D11DeviceChild {};
+struct ID3D11ComputeShader : ID3D11DeviceChild {};
+struct ID3D11InputLayout : ID3D11DeviceChild {};
+struct ID3D11BlendState : ID3D11DeviceChild {};
+struct ID3D11DepthStencilState : ID3D11DeviceChild {};
+struct ID3D11RasterizerState : ID3D11DeviceChild {};
+struct ID3D11SamplerState : ID3D11DeviceChild {};
+struct ID3D11CommandList : ID3D11DeviceChild {};
+
+struct ID3D11Asynchronous : ID3D11DeviceChild {};
+struct ID3D11Query : ID3D11Asynchronous {};
+struct ID3D11Predicate : ID3D11Query {};
+struct ID3D11Counter : ID3D11Asynchronous {};
+
+// --------------------------------------------------------
+// The context and device
+// --------------------------------------------------------
+struct ID3D11DeviceContext : ID3D11DeviceChild
+{
+	virtual void STDMETHODCALLTYPE VSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) = 0;
+	virtual void STDMETHODCALLTYPE PSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) = 0;
+	virtual void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE PSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) = 0;
+	virtual void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE DrawIndexed(UINT indexCount, UINT startIndexLocation, INT baseVertexLocation) = 0;
+	virtual void STDMETHODCALLTYPE Draw(UINT vertexCount, UINT startVertexLocation) = 0;
+	virtual HRESULT STDMETHODCALLTYPE Map(ID3D11Resource* resource, UINT subresource, D3D11_MAP mapType, UINT mapFlags, D3D11_MAPPED_SUBRESOURCE* mappedResource) = 0;
+	virtual void STDMETHODCALLTYPE Unmap(ID3D11Resource* resource, UINT subresource) = 0;
+	virtual void STDMETHODCALLTYPE PSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) = 0;
+	virtual void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout* inputLayout) = 0;
+	virtual void STDMETHODCALLTYPE IASetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* vertexBuffers, const UINT* strides, const UINT* offsets) = 0;
+	virtual void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer* indexBuffer, DXGI_FORMAT format, UINT offset) = 0;
+	virtual void STDMETHODCALLTYPE DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation) = 0;
+	virtual void STDMETHODCALLTYPE DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation) = 0;
+	virtual void STDMETHODCALLTYPE GSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) = 0;
+	virtual void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY topology) = 0;
+	virtual void STDMETHODCALLTYPE VSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) = 0;
+	virtual void STDMETHODCALLTYPE VSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) = 0;
+	virtual void STDMETHODCALLTYPE Begin(ID3D11Asynchronous* async) = 0;
+	virtual void STDMETHODCALLTYPE End(ID3D11Asynchronous* async) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous* async, void* data, UINT dataSize, UINT getDataFlags) = 0;
+	virtual void STDMETHODCALLTYPE SetPredication(ID3D11Predicate* predicate, BOOL predicateValue) = 0;
+	virtual void STDMETHODCALLTYPE GSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) = 0;
+	virtual void STDMETHODCALLTYPE GSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) = 0;
+	virtual void STDMETHODCALLTYPE OMSetRenderTargets(UINT numViews, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView) = 0;
+	virtual void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(UINT numRTVs, ID3D11RenderTargetView* const* renderTargetViews, ID3D11DepthStencilView* depthStencilView, UINT uavStartSlot, UINT numUAVs, ID3D11UnorderedAccessView* const* unorderedAccessViews, const UINT* uavInitialCounts) = 0;
+	virtual void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState* blendState, const FLOAT blendFactor[4], UINT sampleMask) = 0;
+	virtual void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState* depthStencilState, UINT stencilRef) = 0;
+	virtual void STDMETHODCALLTYPE SOSetTargets(UINT numBuffers, ID3D11Buffer* const* targets, const UINT* offsets) = 0;
+	virtual void STDMETHODCALLTYPE DrawAuto() = 0;
+	virtual void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer* bufferForArgs, UINT alignedByteOffsetForArgs) = 0;
+	virtual void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer* bufferForArgs, UINT alignedByteOffsetForArgs) = 0;
+	virtual void STDMETHODCALLTYPE Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ) = 0;
+	virtual void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer* bufferForArgs, UINT alignedByteOffsetForArgs) = 0;
+	virtual void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState* rasterizerState) = 0;
+	virtual void STDMETHODCALLTYPE RSSetViewports(UINT numViewports, const D3D11_VIEWPORT* viewports) = 0;
+	virtual void STDMETHODCALLTYPE RSSetScissorRects(UINT numRects, const D3D11_RECT* rects) = 0;
+	virtual void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource* dstResource, UINT dstSubresource, UINT dstX, UINT dstY, UINT dstZ, ID3D11Resource* srcResource, UINT srcSubresource, const D3D11_BOX* srcBox) = 0;
+	virtual void STDMETHODCALLTYPE CopyResource(ID3D11Resource* dstResource, ID3D11Resource* srcResource) = 0;
+	virtual void STDMETHODCALLTYPE UpdateSubresource(ID3D11Resource* dstResource, UINT dstSubresource, const D3D11_BOX* dstBox, const void* srcData, UINT srcRowPitch, UINT srcDepthPitch) = 0;
+	virtual void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer* dstBuffer, UINT dstAlignedByteOffset, ID3D11UnorderedAccessView* srcView) = 0;
+	virtual void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView* renderTargetView, const FLOAT colorRGBA[4]) = 0;
+	virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView* unorderedAccessView, const UINT values[4]) = 0;
+	virtual void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView* unorderedAccessView, const FLOAT values[4]) = 0;
+	virtual void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView* depthStencilView, UINT clearFlags, FLOAT depth, UINT8 stencil) = 0;
+	virtual void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView* shaderResourceView) = 0;
+	virtual void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource* resource, FLOAT minLOD) = 0;
+	virtual FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource* resource) = 0;
+	virtual void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource* dstResource, UINT dstSubresource, ID3D11Resource* srcResource, UINT srcSubresource, DXGI_FORMAT format) = 0;
+	virtual void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList* commandList, BOOL restoreContextState) = 0;
+	virtual void STDMETHODCALLTYPE HSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) = 0;
+	virtual void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE HSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) = 0;
+	virtual void STDMETHODCALLTYPE HSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) = 0;
+	virtual void STDMETHODCALLTYPE DSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) = 0;
+	virtual void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE DSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) = 0;
+	virtual void STDMETHODCALLTYPE DSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) = 0;
+	virtual void STDMETHODCALLTYPE CSSetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView* const* views) = 0;
+	virtual void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT startSlot, UINT numUAVs, ID3D11UnorderedAccessView* const* unorderedAccessViews, const UINT* uavInitialCounts) = 0;
+	virtual void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader* shader, ID3D11ClassInstance* const* classInstances, UINT numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE CSSetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState* const* samplers) = 0;
+	virtual void STDMETHODCALLTYPE CSSetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* buffers) = 0;
+	virtual void STDMETHODCALLTYPE VSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) = 0;
+	virtual void STDMETHODCALLTYPE PSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) = 0;
+	virtual void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE PSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) = 0;
+	virtual void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE PSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) = 0;
+	virtual void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** inputLayout) = 0;
+	virtual void STDMETHODCALLTYPE IAGetVertexBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** vertexBuffers, UINT* strides, UINT* offsets) = 0;
+	virtual void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** indexBuffer, DXGI_FORMAT* format, UINT* offset) = 0;
+	virtual void STDMETHODCALLTYPE GSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) = 0;
+	virtual void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* topology) = 0;
+	virtual void STDMETHODCALLTYPE VSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) = 0;
+	virtual void STDMETHODCALLTYPE VSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) = 0;
+	virtual void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** predicate, BOOL* predicateValue) = 0;
+	virtual void STDMETHODCALLTYPE GSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) = 0;
+	virtual void STDMETHODCALLTYPE GSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) = 0;
+	virtual void STDMETHODCALLTYPE OMGetRenderTargets(UINT numViews, ID3D11RenderTargetView** renderTargetViews, ID3D11DepthStencilView** depthStencilView) = 0;
+	virtual void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(UINT numRTVs, ID3D11RenderTargetView** renderTargetViews, ID3D11DepthStencilView** depthStencilView, UINT uavStartSlot, UINT numUAVs, ID3D11UnorderedAccessView** unorderedAccessViews) = 0;
+	virtual void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** blendState, FLOAT blendFactor[4], UINT* sampleMask) = 0;
+	virtual void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState** depthStencilState, UINT* stencilRef) = 0;
+	virtual void STDMETHODCALLTYPE SOGetTargets(UINT numBuffers, ID3D11Buffer** targets) = 0;
+	virtual void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** rasterizerState) = 0;
+	virtual void STDMETHODCALLTYPE RSGetViewports(UINT* numViewports, D3D11_VIEWPORT* viewports) = 0;
+	virtual void STDMETHODCALLTYPE RSGetScissorRects(UINT* numRects, D3D11_RECT* rects) = 0;
+	virtual void STDMETHODCALLTYPE HSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) = 0;
+	virtual void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE HSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) = 0;
+	virtual void STDMETHODCALLTYPE HSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) = 0;
+	virtual void STDMETHODCALLTYPE DSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) = 0;
+	virtual void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE DSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) = 0;
+	virtual void STDMETHODCALLTYPE DSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) = 0;
+	virtual void STDMETHODCALLTYPE CSGetShaderResources(UINT startSlot, UINT numViews, ID3D11ShaderResourceView** views) = 0;
+	virtual void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT startSlot, UINT numUAVs, ID3D11UnorderedAccessView** unorderedAccessViews) = 0;
+	virtual void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** shader, ID3D11ClassInstance** classInstances, UINT* numClassInstances) = 0;
+	virtual void STDMETHODCALLTYPE CSGetSamplers(UINT startSlot, UINT numSamplers, ID3D11SamplerState** samplers) = 0;
+	virtual void STDMETHODCALLTYPE CSGetConstantBuffers(UINT startSlot, UINT numBuffers, ID3D11Buffer** buffers) = 0;
+	virtual void STDMETHODCALLTYPE ClearState() = 0;
+	virtual void STDMETHODCALLTYPE Flush() = 0;
+	virtual D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() = 0;
+	virtual UINT STDMETHODCALLTYPE GetContextFlags() = 0;
+	virtual HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL restoreDeferredContextState, ID3D11CommandList** commandList) = 0;};
+
+struct ID3D11Device : IUnknown
+{
+	virtual HRESULT STDMETHODCALLTYPE CreateBuffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Buffer** buffer) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateTexture1D(const D3D11_TEXTURE1D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Texture1D** texture) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateTexture2D(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Texture2D** texture) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateTexture3D(const D3D11_TEXTURE3D_DESC* desc, const D3D11_SUBRESOURCE_DATA* initialData, ID3D11Texture3D** texture) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateShaderResourceView(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc, ID3D11ShaderResourceView** view) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateUnorderedAccessView(ID3D11Resource* resource, const D3D11_UNORDERED_ACCESS_VIEW_DESC* desc, ID3D11UnorderedAccessView** view) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateRenderTargetView(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc, ID3D11RenderTargetView** view) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateDepthStencilView(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc, ID3D11DepthStencilView** view) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* elements, UINT numElements, const void* bytecode, SIZE_T bytecodeLength, ID3D11InputLayout** inputLayout) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateVertexShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11VertexShader** shader) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateGeometryShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11GeometryShader** shader) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateGeometryShaderWithStreamOutput(const void* bytecode, SIZE_T bytecodeLength, const D3D11_SO_DECLARATION_ENTRY* declaration, UINT numEntries, const UINT* bufferStrides, UINT numStrides, UINT rasterizedStream, ID3D11ClassLinkage* classLinkage, ID3D11GeometryShader** shader) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreatePixelShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11PixelShader** shader) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateHullShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11HullShader** shader) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateDomainShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11DomainShader** shader) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateComputeShader(const void* bytecode, SIZE_T bytecodeLength, ID3D11ClassLinkage* classLinkage, ID3D11ComputeShader** shader) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateClassLinkage(ID3D11ClassLinkage** linkage) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateBlendState(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateRasterizerState(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateSamplerState(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateQuery(const D3D11_QUERY_DESC* desc, ID3D11Query** query) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreatePredicate(const D3D11_QUERY_DESC* desc, ID3D11Predicate** predicate) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateCounter(const D3D11_COUNTER_DESC* desc, ID3D11Counter** counter) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CreateDeferredContext(UINT contextFlags, ID3D11DeviceContext** deferredContext) = 0;
+	virtual HRESULT STDMETHODCALLTYPE OpenSharedResource(HANDLE resource, REFIID returnedInterface, void** outResource) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CheckFormatSupport(DXGI_FORMAT format, UINT* formatSupport) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CheckMultisampleQualityLevels(DXGI_FORMAT format, UINT sampleCount, UINT* numQualityLevels) = 0;
+	virtual void STDMETHODCALLTYPE CheckCounterInfo(D3D11_COUNTER_INFO* counterInfo) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CheckCounter(const D3D11_COUNTER_DESC* desc, D3D11_COUNTER_TYPE* type, UINT* activeCounters, LPSTR name, UINT* nameLength, LPSTR units, UINT* unitsLength, LPSTR description, UINT* descriptionLength) = 0;
+	virtual HRESULT STDMETHODCALLTYPE CheckFeatureSupport(D3D11_FEATURE feature, void* data, UINT dataSize) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) = 0;
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) = 0;
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) = 0;
+	virtual D3D_FEATURE_LEVEL STDMETHODCALLTYPE GetFeatureLevel() = 0;
+	virtual UINT STDMETHODCALLTYPE GetCreationFlags() = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetDeviceRemovedReason() = 0;
+	virtual void STDMETHODCALLTYPE GetImmediateContext(ID3D11DeviceContext** immediateContext) = 0;
+	virtual HRESULT STDMETHODCALLTYPE SetExceptionMode(UINT raiseFlags) = 0;
+	virtual UINT STDMETHODCALLTYPE GetExceptionMode() = 0;};
+
+// Only what Graphics::PrintDebugMessages() reads
+struct ID3D11InfoQueue : IUnknown
+{
+	virtual HRESULT STDMETHODCALLTYPE GetMessage(UINT64 messageIndex, D3D11_MESSAGE* message, SIZE_T* messageByteLength) = 0;
+	virtual void STDMETHODCALLTYPE ClearStoredMessages() = 0;
+	virtual UINT64 STDMETHODCALLTYPE GetNumStoredMessages() = 0;
+};
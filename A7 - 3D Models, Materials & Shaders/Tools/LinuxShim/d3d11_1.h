@@ -0,0 +1,13 @@
+#pragma once
+
+// --------------------------------------------------------
+// ID3D11DeviceContext1, with only the call the engine makes.
+// The null device never hands one out (see d3d11.h)
+// --------------------------------------------------------
+
+#include <d3d11.h>
+
+struct ID3D11DeviceContext1 : ID3D11DeviceContext
+{
+	virtual void STDMETHODCALLTYPE VSSetConstantBuffers1(UINT startSlot, UINT numBuffers, ID3D11Buffer* const* constantBuffers, const UINT* firstConstant, const UINT* numConstants) = 0;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+// --------------------------------------------------------
+// D3DReadFileToBlob(), see d3d11.h in this folder
+//
+// There is no shader compiler on Linux to make the .cso
+// files, so a missing file gives an empty blob instead of
+// an error.  The null device never looks at bytecode
+// --------------------------------------------------------
+
+#include <Windows.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+struct ID3D10Blob : IUnknown
+{
+	virtual void* STDMETHODCALLTYPE GetBufferPointer() = 0;
+	virtual SIZE_T STDMETHODCALLTYPE GetBufferSize() = 0;
+};
+typedef ID3D10Blob ID3DBlob;
+
+class LinuxShimBlob : public ID3DBlob
+{
+public:
+	LinuxShimBlob(std::vector<char> data) : data(std::move(data)) {}
+	virtual ~LinuxShimBlob() {}
+
+	HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+	{
+		if (riid != __uuidof(IUnknown) && riid != __uuidof(ID3D10Blob))
+		{
+			*object = 0;
+			return E_NOINTERFACE;
+		}
+		*object = static_cast<ID3D10Blob*>(this);
+		AddRef();
+		return S_OK;
+	}
+	ULONG STDMETHODCALLTYPE AddRef() override { return ++refCount; }
+	ULONG STDMETHODCALLTYPE Release() override
+	{
+		ULONG count = --refCount;
+		if (count == 0)
+			delete this;
+		return count;
+	}
+
+	void* STDMETHODCALLTYPE GetBufferPointer() override { return data.data(); }
+	SIZE_T STDMETHODCALLTYPE GetBufferSize() override { return data.size(); }
+
+private:
+	std::atomic<ULONG> refCount{ 1 };
+	std::vector<char> data;
+};
+
+inline HRESULT D3DReadFileToBlob(LPCWSTR fileName, ID3DBlob** contents)
+{
+	std::wstring wide(fileName);
+	std::string path(wide.begin(), wide.end());
+
+	std::ifstream file(path, std::ios::binary);
+	std::vector<char> data;
+	if (file)
+		data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	*contents = new LinuxShimBlob(std::move(data));
+	return S_OK;
+}
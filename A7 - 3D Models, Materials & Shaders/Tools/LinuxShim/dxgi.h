@@ -0,0 +1,116 @@
+#pragma once
+
+// --------------------------------------------------------
+// The DXGI types and interfaces the null device uses, see
+// d3d11.h in this folder
+// --------------------------------------------------------
+
+#include <Windows.h>
+
+#define DXGI_ERROR_INVALID_CALL	((HRESULT)0x887A0001)
+#define DXGI_ERROR_NOT_FOUND	((HRESULT)0x887A0002)
+#define DXGI_ERROR_UNSUPPORTED	((HRESULT)0x887A0004)
+
+#define DXGI_PRESENT_ALLOW_TEARING			0x00000200UL
+#define DXGI_RESOURCE_PRIORITY_NORMAL		0x78000000
+#define DXGI_USAGE_RENDER_TARGET_OUTPUT		0x00000020UL
+#define DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING	2048
+
+typedef UINT DXGI_USAGE;
+
+enum DXGI_FORMAT
+{
+	DXGI_FORMAT_UNKNOWN = 0,
+	DXGI_FORMAT_R32G32B32A32_FLOAT = 2,
+	DXGI_FORMAT_R32G32B32_FLOAT = 6,
+	DXGI_FORMAT_R32G32_FLOAT = 16,
+	DXGI_FORMAT_R8G8B8A8_UNORM = 28,
+	DXGI_FORMAT_D32_FLOAT = 40,
+	DXGI_FORMAT_R32_FLOAT = 41,
+	DXGI_FORMAT_R32_UINT = 42,
+	DXGI_FORMAT_D24_UNORM_S8_UINT = 45,
+	DXGI_FORMAT_R16_UINT = 57,
+};
+
+enum DXGI_MODE_SCANLINE_ORDER { DXGI_MODE_SCANLINE_ORDER_UNSPECIFIED = 0 };
+enum DXGI_MODE_SCALING { DXGI_MODE_SCALING_UNSPECIFIED = 0 };
+
+enum DXGI_SWAP_EFFECT
+{
+	DXGI_SWAP_EFFECT_DISCARD = 0,
+	DXGI_SWAP_EFFECT_SEQUENTIAL = 1,
+	DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL = 3,
+	DXGI_SWAP_EFFECT_FLIP_DISCARD = 4,
+};
+
+struct DXGI_RATIONAL
+{
+	UINT Numerator;
+	UINT Denominator;
+};
+
+struct DXGI_SAMPLE_DESC
+{
+	UINT Count;
+	UINT Quality;
+};
+
+struct DXGI_MODE_DESC
+{
+	UINT Width;
+	UINT Height;
+	DXGI_RATIONAL RefreshRate;
+	DXGI_FORMAT Format;
+	DXGI_MODE_SCANLINE_ORDER ScanlineOrdering;
+	DXGI_MODE_SCALING Scaling;
+};
+
+struct DXGI_SWAP_CHAIN_DESC
+{
+	DXGI_MODE_DESC BufferDesc;
+	DXGI_SAMPLE_DESC SampleDesc;
+	DXGI_USAGE BufferUsage;
+	UINT BufferCount;
+	HWND OutputWindow;
+	BOOL Windowed;
+	DXGI_SWAP_EFFECT SwapEffect;
+	UINT Flags;
+};
+
+struct DXGI_FRAME_STATISTICS
+{
+	UINT PresentCount;
+	UINT PresentRefreshCount;
+	UINT SyncRefreshCount;
+	LARGE_INTEGER SyncQPCTime;
+	LARGE_INTEGER SyncGPUTime;
+};
+
+struct IDXGIOutput;
+
+struct IDXGIObject : IUnknown
+{
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT dataSize, const void* data) = 0;
+	virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* dataSize, void* data) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetParent(REFIID riid, void** parent) = 0;
+};
+
+struct IDXGIDeviceSubObject : IDXGIObject
+{
+	virtual HRESULT STDMETHODCALLTYPE GetDevice(REFIID riid, void** device) = 0;
+};
+
+struct IDXGISwapChain : IDXGIDeviceSubObject
+{
+	virtual HRESULT STDMETHODCALLTYPE Present(UINT syncInterval, UINT flags) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetBuffer(UINT buffer, REFIID riid, void** surface) = 0;
+	virtual HRESULT STDMETHODCALLTYPE SetFullscreenState(BOOL fullscreen, IDXGIOutput* target) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetFullscreenState(BOOL* fullscreen, IDXGIOutput** target) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetDesc(DXGI_SWAP_CHAIN_DESC* desc) = 0;
+	virtual HRESULT STDMETHODCALLTYPE ResizeBuffers(UINT bufferCount, UINT width, UINT height, DXGI_FORMAT newFormat, UINT swapChainFlags) = 0;
+	virtual HRESULT STDMETHODCALLTYPE ResizeTarget(const DXGI_MODE_DESC* newTargetParameters) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetContainingOutput(IDXGIOutput** output) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetFrameStatistics(DXGI_FRAME_STATISTICS* frameStatistics) = 0;
+	virtual HRESULT STDMETHODCALLTYPE GetLastPresentCount(UINT* lastPresentCount) = 0;
+};
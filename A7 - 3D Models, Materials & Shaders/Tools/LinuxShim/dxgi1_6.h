@@ -0,0 +1,5 @@
+#pragma once
+
+// Graphics.cpp only uses the newer DXGI interfaces without
+// GRAPHICS_NULL, see dxgi.h
+#include <dxgi.h>
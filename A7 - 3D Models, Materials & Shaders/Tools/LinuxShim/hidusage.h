@@ -0,0 +1,5 @@
+#pragma once
+
+// See Windows.h in this folder
+#define HID_USAGE_PAGE_GENERIC		((unsigned short)0x01)
+#define HID_USAGE_GENERIC_MOUSE		((unsigned short)0x02)
@@ -0,0 +1,4 @@
+#pragma once
+
+// __rdtsc() for Profiler.cpp, see Windows.h in this folder
+#include <x86intrin.h>
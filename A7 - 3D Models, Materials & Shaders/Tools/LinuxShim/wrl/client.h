@@ -0,0 +1,119 @@
+#pragma once
+
+// --------------------------------------------------------
+// ComPtr, with the members the engine uses.  See Windows.h
+// in the folder above
+// --------------------------------------------------------
+
+#include <Windows.h>
+
+namespace Microsoft
+{
+	namespace WRL
+	{
+		template<typename T>
+		class ComPtr;
+
+		// What &comPtr gives back: usable as the T** out parameter
+		// of a D3D call, or as the ComPtr* that As() takes
+		template<typename T>
+		class ComPtrRef
+		{
+		public:
+			ComPtrRef(ComPtr<T>* ptr) : ptr(ptr) {}
+			operator ComPtr<T>*() const { return ptr; }
+			operator T**() const { return ptr->ReleaseAndGetAddressOf(); }
+			operator void**() const { return reinterpret_cast<void**>(ptr->ReleaseAndGetAddressOf()); }
+
+		private:
+			ComPtr<T>* ptr;
+		};
+
+		template<typename T>
+		class ComPtr
+		{
+		public:
+			ComPtr() : ptr(0) {}
+			ComPtr(decltype(nullptr)) : ptr(0) {}
+			ComPtr(T* other) : ptr(other) { InternalAddRef(); }
+			ComPtr(const ComPtr& other) : ptr(other.ptr) { InternalAddRef(); }
+			ComPtr(ComPtr&& other) noexcept : ptr(other.ptr) { other.ptr = 0; }
+			template<typename U> ComPtr(const ComPtr<U>& other) : ptr(other.Get()) { InternalAddRef(); }
+			~ComPtr() { InternalRelease(); }
+
+			ComPtr& operator=(T* other)
+			{
+				if (ptr != other)
+					ComPtr(other).Swap(*this);
+				return *this;
+			}
+			ComPtr& operator=(const ComPtr& other)
+			{
+				if (ptr != other.ptr)
+					ComPtr(other).Swap(*this);
+				return *this;
+			}
+			ComPtr& operator=(ComPtr&& other) noexcept
+			{
+				ComPtr(static_cast<ComPtr&&>(other)).Swap(*this);
+				return *this;
+			}
+
+			T* Get() const { return ptr; }
+			T* operator->() const { return ptr; }
+			explicit operator bool() const { return ptr != 0; }
+
+			T* const* GetAddressOf() const { return &ptr; }
+			T** GetAddressOf() { return &ptr; }
+			T** ReleaseAndGetAddressOf() { InternalRelease(); return &ptr; }
+			ComPtrRef<T> operator&() { return ComPtrRef<T>(this); }
+
+			void Attach(T* other)
+			{
+				InternalRelease();
+				ptr = other;
+			}
+			T* Detach()
+			{
+				T* detached = ptr;
+				ptr = 0;
+				return detached;
+			}
+			unsigned long Reset() { return InternalRelease(); }
+			void Swap(ComPtr& other)
+			{
+				T* temp = ptr;
+				ptr = other.ptr;
+				other.ptr = temp;
+			}
+
+			template<typename U>
+			HRESULT As(ComPtr<U>* other) const
+			{
+				return ptr->QueryInterface(__uuidof(U), reinterpret_cast<void**>(other->ReleaseAndGetAddressOf()));
+			}
+			template<typename U>
+			HRESULT As(ComPtrRef<U> other) const { return As(static_cast<ComPtr<U>*>(other)); }
+
+		private:
+			void InternalAddRef() const
+			{
+				if (ptr)
+					ptr->AddRef();
+			}
+			unsigned long InternalRelease()
+			{
+				unsigned long count = 0;
+				T* temp = ptr;
+				if (temp)
+				{
+					ptr = 0;
+					count = temp->Release();
+				}
+				return count;
+			}
+
+			T* ptr;
+		};
+	}
+}
@@ -0,0 +1,817 @@
+// --------------------------------------------------------
+// Microbenchmarks for the engine's core classes: Transform,
+// Camera matrices, the mesh BVH built on import, the draw
+// queue's radix sort, the Input key queries and the frame
+// arena against the heap
+//
+// Linux only (it reads hardware counters through
+// perf_event_open).  The engine files need DirectXMath,
+// which is header-only and builds with GCC once sal.h is
+// on the include path, plus the small Windows.h stand-in in
+// LinuxShim.  From this folder:
+//
+//   g++ -std=c++20 -O2 -ILinuxShim -I.. -I<DirectXMath>/Inc
+//       -I<folder with sal.h> MicroBenchmarks.cpp ../Transform.cpp
+//       ../Camera.cpp ../Input.cpp ../MeshBVH.cpp ../RenderQueue.cpp
+//       ../FrameArena.cpp -o MicroBenchmarks
+//
+// Usage:
+//   MicroBenchmarks [--filter <text>] [--reps N] [--min-ms N]
+//                   [--warmup-ms N] [--models <folder>]
+//                   [--json <file>]
+//
+// Each benchmark is first run with more and more operations
+// until one batch takes at least --min-ms, then run for
+// --warmup-ms without measuring, then measured --reps times.
+// The report gives the spread of ns/op across repetitions,
+// throughput, and cache misses per operation when the
+// kernel allows counting them (perf_event_paranoid <= 2).
+// Results also go to MicroBenchmarks.json for comparing
+// runs by script
+// --------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Transform.h"
+#include "Camera.h"
+#include "Input.h"
+#include "MeshBVH.h"
+#include "RenderQueue.h"
+#include "FrameArena.h"
+#include "BufferStructs.h"
+
+using namespace DirectX;
+
+namespace
+{
+	// Keeps the compiler from removing work whose result is
+	// otherwise unused
+	template <typename T>
+	inline void KeepAlive(const T& value)
+	{
+		asm volatile("" : : "g"(&value) : "memory");
+	}
+
+	// --------------------------------------------------------
+	// Cache references and misses for the calling thread, in
+	// user space only.  Opens as a group so both counters
+	// cover exactly the same stretch of code
+	// --------------------------------------------------------
+	class CacheCounters
+	{
+	public:
+		~CacheCounters()
+		{
+			if (referenceFd >= 0) close(referenceFd);
+			if (missFd >= 0) close(missFd);
+		}
+
+		bool Open()
+		{
+			missFd = OpenCounter(PERF_COUNT_HW_CACHE_MISSES, -1);
+			if (missFd < 0)
+				return false;
+
+			referenceFd = OpenCounter(PERF_COUNT_HW_CACHE_REFERENCES, missFd);
+			if (referenceFd < 0)
+			{
+				close(missFd);
+				missFd = -1;
+				return false;
+			}
+			return true;
+		}
+
+		bool IsOpen() const { return missFd >= 0; }
+
+		void Start()
+		{
+			if (!IsOpen())
+				return;
+			ioctl(missFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(missFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+
+		void Stop(unsigned long long& misses, unsigned long long& references)
+		{
+			misses = 0;
+			references = 0;
+			if (!IsOpen())
+				return;
+			ioctl(missFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+			// Group format: the count, then one value per counter
+			unsigned long long values[3] = {};
+			if (read(missFd, values, sizeof(values)) == (ssize_t)sizeof(values))
+			{
+				misses = values[1];
+				references = values[2];
+			}
+		}
+
+	private:
+		static int OpenCounter(unsigned long long config, int groupFd)
+		{
+			perf_event_attr attr = {};
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = config;
+			attr.disabled = groupFd < 0 ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP;
+			return (int)syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+		}
+
+		int missFd = -1;
+		int referenceFd = -1;
+	};
+
+	struct MicroBenchmark
+	{
+		std::string name;
+		double itemsPerOp;		// Triangles, rays, entities... per operation
+		std::function<void(unsigned long long)> run;	// Runs this many operations
+	};
+
+	struct BenchmarkResult
+	{
+		std::string name;
+		unsigned long long opsPerRep;
+		std::vector<double> nsPerOp;	// One per repetition
+		double medianNs;
+		double minNs;
+		double meanNs;
+		double stddevNs;
+		double opsPerSecond;
+		double itemsPerSecond;
+		bool hasCounters;
+		double missesPerOp;
+		double referencesPerOp;
+	};
+
+	struct Options
+	{
+		std::string filter;
+		unsigned int reps = 10;
+		double minBatchMs = 20.0;
+		double warmupMs = 100.0;
+		std::string modelFolder = "../Assets/Models";
+		std::string jsonPath = "MicroBenchmarks.json";
+	};
+
+	double Milliseconds(std::chrono::steady_clock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	double TimeBatch(const MicroBenchmark& benchmark, unsigned long long ops)
+	{
+		auto start = std::chrono::steady_clock::now();
+		benchmark.run(ops);
+		return Milliseconds(std::chrono::steady_clock::now() - start);
+	}
+
+	// --------------------------------------------------------
+	// Sizes the batch, warms up, then measures each repetition
+	// --------------------------------------------------------
+	BenchmarkResult Measure(const MicroBenchmark& benchmark, const Options& options, CacheCounters& counters)
+	{
+		// Grow the batch until it's long enough to time well,
+		// jumping most of the way once there's a usable sample
+		unsigned long long ops = 1;
+		while (true)
+		{
+			double ms = TimeBatch(benchmark, ops);
+			if (ms >= options.minBatchMs || ops >= (1ull << 40))
+				break;
+
+			double scale = ms > options.minBatchMs / 100.0 ? options.minBatchMs * 1.2 / ms : 10.0;
+			ops = (unsigned long long)std::ceil(ops * std::min(scale, 10.0)) + 1;
+		}
+
+		auto warmupStart = std::chrono::steady_clock::now();
+		while (Milliseconds(std::chrono::steady_clock::now() - warmupStart) < options.warmupMs)
+			benchmark.run(ops);
+
+		BenchmarkResult result = {};
+		result.name = benchmark.name;
+		result.opsPerRep = ops;
+		result.hasCounters = counters.IsOpen();
+
+		std::vector<double> misses;
+		std::vector<double> references;
+		for (unsigned int rep = 0; rep < options.reps; rep++)
+		{
+			unsigned long long repMisses = 0;
+			unsigned long long repReferences = 0;
+			counters.Start();
+			double ms = TimeBatch(benchmark, ops);
+			counters.Stop(repMisses, repReferences);
+
+			result.nsPerOp.push_back(ms * 1000000.0 / ops);
+			misses.push_back((double)repMisses / ops);
+			references.push_back((double)repReferences / ops);
+		}
+
+		std::vector<double> sorted = result.nsPerOp;
+		std::sort(sorted.begin(), sorted.end());
+		result.medianNs = sorted[sorted.size() / 2];
+		result.minNs = sorted.front();
+
+		double sum = 0;
+		for (double ns : sorted) sum += ns;
+		result.meanNs = sum / sorted.size();
+		double squares = 0;
+		for (double ns : sorted) squares += (ns - result.meanNs) * (ns - result.meanNs);
+		result.stddevNs = std::sqrt(squares / sorted.size());
+
+		result.opsPerSecond = result.medianNs > 0 ? 1e9 / result.medianNs : 0;
+		result.itemsPerSecond = result.opsPerSecond * benchmark.itemsPerOp;
+
+		// Median of each counter across repetitions
+		std::sort(misses.begin(), misses.end());
+		std::sort(references.begin(), references.end());
+		result.missesPerOp = misses[misses.size() / 2];
+		result.referencesPerOp = references[references.size() / 2];
+		return result;
+	}
+
+	// --------------------------------------------------------
+	// Reads positions and triangulated faces from an OBJ file.
+	// The engine has no importer of its own yet, so this only
+	// exists to feed real models to the BVH build
+	// --------------------------------------------------------
+	bool ReadOBJ(const std::string& path, std::vector<XMFLOAT3>& positions, std::vector<unsigned int>& indices)
+	{
+		std::ifstream file(path);
+		if (!file)
+			return false;
+
+		std::string line;
+		while (std::getline(file, line))
+		{
+			std::istringstream values(line);
+			std::string type;
+			values >> type;
+
+			if (type == "v")
+			{
+				XMFLOAT3 position = {};
+				values >> position.x >> position.y >> position.z;
+				positions.push_back(position);
+			}
+			else if (type == "f")
+			{
+				// "v", "v/vt", "v//vn" or "v/vt/vn", fanned into triangles
+				std::vector<unsigned int> face;
+				std::string corner;
+				while (values >> corner)
+				{
+					int index = atoi(corner.c_str());
+					face.push_back(index < 0 ? (unsigned int)(positions.size() + index) : (unsigned int)(index - 1));
+				}
+				for (size_t i = 2; i < face.size(); i++)
+				{
+					indices.push_back(face[0]);
+					indices.push_back(face[i - 1]);
+					indices.push_back(face[i]);
+				}
+			}
+		}
+		return !indices.empty();
+	}
+
+	void AddTransformBenchmarks(std::vector<MicroBenchmark>& benchmarks)
+	{
+		std::shared_ptr<Transform> transform = std::make_shared<Transform>();
+		transform->SetPosition(1.0f, 2.0f, 3.0f);
+		transform->SetRotation(0.1f, 0.2f, 0.3f);
+
+		benchmarks.push_back({ "Transform/SetPosition", 1, [transform](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				transform->SetPosition((float)i, 1.0f, 2.0f);
+				KeepAlive(*transform);
+			}
+		} });
+		benchmarks.push_back({ "Transform/SetRotation", 1, [transform](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				transform->SetRotation(XMFLOAT3((float)(i & 255) * 0.01f, 0.2f, 0.3f));
+				KeepAlive(*transform);
+			}
+		} });
+		benchmarks.push_back({ "Transform/SetScale", 1, [transform](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				transform->SetScale(1.0f + (float)(i & 7));
+				KeepAlive(*transform);
+			}
+		} });
+		benchmarks.push_back({ "Transform/GetPosition", 1, [transform](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				XMFLOAT3 position = transform->GetPosition();
+				KeepAlive(position);
+			}
+		} });
+		benchmarks.push_back({ "Transform/GetForward", 1, [transform](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				XMFLOAT3 forward = transform->GetForward();
+				KeepAlive(forward);
+			}
+		} });
+		benchmarks.push_back({ "Transform/MoveRelative", 1, [transform](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+				transform->MoveRelative(0.0f, 0.0f, 0.001f);
+			KeepAlive(*transform);
+		} });
+		benchmarks.push_back({ "Transform/GetWorldMatrix", 1, [transform](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				XMFLOAT4X4 world = transform->GetWorldMatrix();
+				KeepAlive(world);
+			}
+		} });
+
+		// The way Game uses them: one per entity, each its own
+		// heap allocation, walked once per frame
+		const unsigned int EntityCount = 4096;
+		auto entities = std::make_shared<std::vector<std::shared_ptr<Transform>>>();
+		std::mt19937 random(42);
+		for (unsigned int i = 0; i < EntityCount; i++)
+		{
+			std::shared_ptr<Transform> entity = std::make_shared<Transform>();
+			entity->SetPosition((float)(i % 64), (float)(i / 64), 0.0f);
+			entity->SetRotation(0.0f, 0.0f, (float)i * 0.37f);
+			entities->push_back(entity);
+		}
+		std::shuffle(entities->begin(), entities->end(), random);
+
+		benchmarks.push_back({ "Transform/GetWorldMatrix/4096 entities", EntityCount, [entities](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				for (const std::shared_ptr<Transform>& entity : *entities)
+				{
+					XMFLOAT4X4 world = entity->GetWorldMatrix();
+					KeepAlive(world);
+				}
+			}
+		} });
+	}
+
+	void AddCameraBenchmarks(std::vector<MicroBenchmark>& benchmarks)
+	{
+		std::shared_ptr<Camera> perspective = std::make_shared<Camera>(
+			XMFLOAT3(0.0f, 0.0f, -5.0f), 5.0f, 0.002f, XM_PIDIV4, 16.0f / 9.0f, 0.01f, 100.0f, CameraProjectionType::Perspective);
+		std::shared_ptr<Camera> orthographic = std::make_shared<Camera>(
+			XMFLOAT3(0.0f, 0.0f, -5.0f), 5.0f, 0.002f, XM_PIDIV4, 16.0f / 9.0f, 0.01f, 100.0f, CameraProjectionType::Orthographic);
+
+		benchmarks.push_back({ "Camera/UpdateViewMatrix", 1, [perspective](unsigned long long ops)
+		{
+			std::shared_ptr<Transform> transform = perspective->GetTransform();
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				transform->SetRotation(0.1f, (float)(i & 1023) * 0.001f, 0.0f);
+				perspective->UpdateViewMatrix();
+			}
+			XMFLOAT4X4 view = perspective->GetView();
+			KeepAlive(view);
+		} });
+		benchmarks.push_back({ "Camera/UpdateProjectionMatrix/Perspective", 1, [perspective](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+				perspective->UpdateProjectionMatrix(1.0f + (float)(i & 1) * 0.5f);
+			XMFLOAT4X4 projection = perspective->GetProjection();
+			KeepAlive(projection);
+		} });
+		benchmarks.push_back({ "Camera/UpdateProjectionMatrix/Orthographic", 1, [orthographic](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+				orthographic->UpdateProjectionMatrix(1.0f + (float)(i & 1) * 0.5f);
+			XMFLOAT4X4 projection = orthographic->GetProjection();
+			KeepAlive(projection);
+		} });
+	}
+
+	// --------------------------------------------------------
+	// The BVH build Mesh runs after creating its buffers, and
+	// picking rays against it, for each model in the folder
+	// --------------------------------------------------------
+	void AddMeshBenchmarks(std::vector<MicroBenchmark>& benchmarks, const std::string& folder)
+	{
+		std::vector<std::string> files;
+		if (DIR* directory = opendir(folder.c_str()))
+		{
+			while (dirent* entry = readdir(directory))
+			{
+				std::string name = entry->d_name;
+				if (name.size() > 4 && name.compare(name.size() - 4, 4, ".obj") == 0)
+					files.push_back(name);
+			}
+			closedir(directory);
+		}
+		std::sort(files.begin(), files.end());
+		if (files.empty())
+			printf("No .obj models in %s, skipping the mesh benchmarks\n", folder.c_str());
+
+		for (const std::string& file : files)
+		{
+			auto positions = std::make_shared<std::vector<XMFLOAT3>>();
+			auto indices = std::make_shared<std::vector<unsigned int>>();
+			if (!ReadOBJ(folder + "/" + file, *positions, *indices))
+				continue;
+
+			std::string model = file.substr(0, file.size() - 4);
+			double triangles = (double)(indices->size() / 3);
+
+			benchmarks.push_back({ "MeshBVH/Build/" + model, triangles, [positions, indices](unsigned long long ops)
+			{
+				for (unsigned long long i = 0; i < ops; i++)
+				{
+					MeshBVH bvh;
+					bvh.Build(*positions, *indices);
+					KeepAlive(bvh);
+				}
+			} });
+
+			// Rays from all around the model, aimed near its middle
+			auto bvh = std::make_shared<MeshBVH>();
+			bvh->Build(*positions, *indices);
+
+			const unsigned int RayCount = 1024;
+			auto rays = std::make_shared<std::vector<XMFLOAT3>>();
+			std::mt19937 random(7);
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+			for (unsigned int i = 0; i < RayCount; i++)
+			{
+				XMFLOAT3 origin(unit(random), unit(random), unit(random));
+				float length = std::sqrt(origin.x * origin.x + origin.y * origin.y + origin.z * origin.z) + 1e-6f;
+				origin = XMFLOAT3(origin.x / length * 10.0f, origin.y / length * 10.0f, origin.z / length * 10.0f);
+				XMFLOAT3 target(unit(random) * 0.25f, unit(random) * 0.25f, unit(random) * 0.25f);
+				rays->push_back(origin);
+				rays->push_back(XMFLOAT3(target.x - origin.x, target.y - origin.y, target.z - origin.z));
+			}
+
+			benchmarks.push_back({ "MeshBVH/Raycast/" + model, 1, [bvh, rays](unsigned long long ops)
+			{
+				unsigned int hits = 0;
+				for (unsigned long long i = 0; i < ops; i++)
+				{
+					size_t ray = (size_t)(i % RayCount) * 2;
+					RayHit hit;
+					hits += bvh->Raycast((*rays)[ray], (*rays)[ray + 1], hit) ? 1 : 0;
+				}
+				KeepAlive(hits);
+			} });
+		}
+	}
+
+	// --------------------------------------------------------
+	// RenderQueue's radix sort on a million keys, against
+	// std::stable_sort on the same input.  Each op copies the
+	// unsorted keys back in first, as a new frame's queue would
+	// be filled, so both sides pay for the same copy
+	//
+	// Random keys change in every byte, so all eight passes
+	// run.  Opaque keys built the way Game does have a pass
+	// nibble and shader field that barely vary, so the sort
+	// skips the bytes every key shares
+	// --------------------------------------------------------
+	void AddRenderQueueBenchmarks(std::vector<MicroBenchmark>& benchmarks)
+	{
+		const unsigned int KeyCount = 1 << 20;
+
+		auto random = std::make_shared<std::vector<DrawItem>>(KeyCount);
+		auto opaque = std::make_shared<std::vector<DrawItem>>(KeyCount);
+		std::mt19937_64 generator(26);
+		for (unsigned int i = 0; i < KeyCount; i++)
+		{
+			(*random)[i] = { generator(), i };
+
+			// A few shaders, a few hundred meshes, any depth
+			unsigned int shader = (unsigned int)(generator() % 4);
+			unsigned int mesh = (unsigned int)(generator() % 300);
+			unsigned int depth = (unsigned int)(generator() & 0xFFFFFF);
+			(*opaque)[i] = { RenderQueue::MakeOpaqueKey(shader, mesh, depth), i };
+		}
+
+		for (auto& [keys, label] : { std::make_pair(random, "Random keys"), std::make_pair(opaque, "Opaque keys") })
+		{
+			auto work = std::make_shared<std::vector<DrawItem>>(KeyCount);
+			auto scratch = std::make_shared<std::vector<DrawItem>>(KeyCount);
+			std::shared_ptr<std::vector<DrawItem>> source = keys;
+
+			benchmarks.push_back({ std::string("RenderQueue/RadixSort/1M ") + label, KeyCount, [source, work, scratch](unsigned long long ops)
+			{
+				for (unsigned long long i = 0; i < ops; i++)
+				{
+					memcpy(work->data(), source->data(), KeyCount * sizeof(DrawItem));
+					RenderQueue::RadixSort(work->data(), scratch->data(), KeyCount);
+					KeepAlive((*work)[KeyCount / 2]);
+				}
+			} });
+			benchmarks.push_back({ std::string("RenderQueue/stable_sort/1M ") + label, KeyCount, [source, work](unsigned long long ops)
+			{
+				for (unsigned long long i = 0; i < ops; i++)
+				{
+					memcpy(work->data(), source->data(), KeyCount * sizeof(DrawItem));
+					std::stable_sort(work->begin(), work->end(),
+						[](const DrawItem& a, const DrawItem& b) { return a.key < b.key; });
+					KeepAlive((*work)[KeyCount / 2]);
+				}
+			} });
+		}
+	}
+
+	// --------------------------------------------------------
+	// Queries against a keyboard with a handful of keys held,
+	// one of them pressed this frame
+	// --------------------------------------------------------
+	void AddInputBenchmarks(std::vector<MicroBenchmark>& benchmarks)
+	{
+		Input::Initialize(0);
+		LinuxShimKeyboardState[VK_SHIFT] = 0x80;
+		LinuxShimKeyboardState['W'] = 0x80;
+		Input::Update();
+		LinuxShimKeyboardState['D'] = 0x80;
+		Input::Update();
+
+		benchmarks.push_back({ "Input/KeyDown", 1, [](unsigned long long ops)
+		{
+			unsigned int down = 0;
+			for (unsigned long long i = 0; i < ops; i++)
+				down += Input::KeyDown((int)(i & 255)) ? 1 : 0;
+			KeepAlive(down);
+		} });
+		benchmarks.push_back({ "Input/KeyPress", 1, [](unsigned long long ops)
+		{
+			unsigned int pressed = 0;
+			for (unsigned long long i = 0; i < ops; i++)
+				pressed += Input::KeyPress((int)(i & 255)) ? 1 : 0;
+			KeepAlive(pressed);
+		} });
+		benchmarks.push_back({ "Input/GetKeyArray", 256, [](unsigned long long ops)
+		{
+			bool keys[256];
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				Input::GetKeyArray(keys, 256);
+				KeepAlive(keys);
+			}
+		} });
+
+		// Camera::Update's checks: a dozen queries for held keys
+		benchmarks.push_back({ "Input/CameraKeys", 12, [](unsigned long long ops)
+		{
+			static const int keys[] = { VK_SHIFT, VK_CONTROL, 'W', 'S', 'A', 'D', 'X', ' ', 'Q', 'E', VK_LBUTTON, VK_RBUTTON };
+			unsigned int down = 0;
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				for (int key : keys)
+					down += Input::KeyDown(key) ? 1 : 0;
+			}
+			KeepAlive(down);
+		} });
+	}
+
+	// --------------------------------------------------------
+	// The same transient allocations from the frame arena and
+	// from the heap.  Each op is one allocation; every frame's
+	// worth is released together, the way the engine uses them
+	// --------------------------------------------------------
+	void AddAllocationBenchmarks(std::vector<MicroBenchmark>& benchmarks)
+	{
+		const unsigned int AllocationsPerFrame = 256;
+		const unsigned int InstanceCount = 4096;
+
+		// Sizes from a sort key to a small staging copy
+		std::shared_ptr<std::vector<size_t>> sizes = std::make_shared<std::vector<size_t>>();
+		std::mt19937 random(7);
+		for (unsigned int i = 0; i < AllocationsPerFrame; i++)
+			sizes->push_back((size_t)16 << (random() % 9));
+
+		std::shared_ptr<FrameArena> arena = std::make_shared<FrameArena>();
+		arena->Initialize(1 << 20, 2, 0, 0);
+		arena->SetPoisonFreedFrames(false);
+
+		benchmarks.push_back({ "Allocation/FrameArena/64 B", 1, [arena](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				if (i % AllocationsPerFrame == 0)
+					arena->BeginFrame();
+				KeepAlive(arena->Allocate(64, 16));
+			}
+		} });
+		benchmarks.push_back({ "Allocation/new+delete/64 B", 1, [](unsigned long long ops)
+		{
+			void* live[AllocationsPerFrame];
+			for (unsigned long long i = 0; i < ops; i += AllocationsPerFrame)
+			{
+				unsigned int count = (unsigned int)std::min<unsigned long long>(AllocationsPerFrame, ops - i);
+				for (unsigned int j = 0; j < count; j++)
+				{
+					live[j] = ::operator new(64);
+					KeepAlive(live[j]);
+				}
+				for (unsigned int j = 0; j < count; j++)
+					::operator delete(live[j]);
+			}
+		} });
+
+		benchmarks.push_back({ "Allocation/FrameArena/Mixed sizes", 1, [arena, sizes](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				if (i % AllocationsPerFrame == 0)
+					arena->BeginFrame();
+				KeepAlive(arena->Allocate((*sizes)[i % AllocationsPerFrame]));
+			}
+		} });
+		benchmarks.push_back({ "Allocation/malloc+free/Mixed sizes", 1, [sizes](unsigned long long ops)
+		{
+			void* live[AllocationsPerFrame];
+			for (unsigned long long i = 0; i < ops; i += AllocationsPerFrame)
+			{
+				unsigned int count = (unsigned int)std::min<unsigned long long>(AllocationsPerFrame, ops - i);
+				for (unsigned int j = 0; j < count; j++)
+				{
+					live[j] = malloc((*sizes)[j]);
+					KeepAlive(live[j]);
+				}
+				for (unsigned int j = 0; j < count; j++)
+					free(live[j]);
+			}
+		} });
+
+		// A frame's instance data, filled in as DrawEntitiesInstanced does
+		benchmarks.push_back({ "Allocation/FrameArena/InstanceData x4096", InstanceCount, [arena](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				arena->BeginFrame();
+				std::span<InstanceData> instances = arena->AllocateSpan<InstanceData>(InstanceCount);
+				for (InstanceData& instance : instances)
+					instance.colorTint = XMFLOAT4(1, 1, 1, 1);
+				KeepAlive(instances[InstanceCount - 1]);
+			}
+		} });
+		benchmarks.push_back({ "Allocation/new[]/InstanceData x4096", InstanceCount, [](unsigned long long ops)
+		{
+			for (unsigned long long i = 0; i < ops; i++)
+			{
+				std::unique_ptr<InstanceData[]> instances(new InstanceData[InstanceCount]);
+				for (unsigned int j = 0; j < InstanceCount; j++)
+					instances[j].colorTint = XMFLOAT4(1, 1, 1, 1);
+				KeepAlive(instances[InstanceCount - 1]);
+			}
+		} });
+	}
+
+	// Escapes a benchmark name for a JSON string
+	std::string JsonString(const std::string& text)
+	{
+		std::string escaped = "\"";
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			escaped += c;
+		}
+		return escaped + "\"";
+	}
+
+	bool WriteJSON(const std::string& path, const std::vector<BenchmarkResult>& results, const Options& options, bool countersAvailable)
+	{
+		std::ofstream json(path);
+		if (!json)
+			return false;
+
+		json.precision(9);
+		json << "{\n";
+		json << "  \"tool\": \"MicroBenchmarks\",\n";
+		json << "  \"reps\": " << options.reps << ",\n";
+		json << "  \"min_batch_ms\": " << options.minBatchMs << ",\n";
+		json << "  \"warmup_ms\": " << options.warmupMs << ",\n";
+		json << "  \"cache_counters\": " << (countersAvailable ? "true" : "false") << ",\n";
+		json << "  \"benchmarks\": [\n";
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const BenchmarkResult& result = results[i];
+			json << "    {\n";
+			json << "      \"name\": " << JsonString(result.name) << ",\n";
+			json << "      \"ops_per_rep\": " << result.opsPerRep << ",\n";
+			json << "      \"ns_per_op\": { \"median\": " << result.medianNs << ", \"min\": " << result.minNs
+				<< ", \"mean\": " << result.meanNs << ", \"stddev\": " << result.stddevNs << " },\n";
+			json << "      \"ns_per_op_reps\": [";
+			for (size_t rep = 0; rep < result.nsPerOp.size(); rep++)
+				json << (rep > 0 ? ", " : "") << result.nsPerOp[rep];
+			json << "],\n";
+			json << "      \"ops_per_second\": " << result.opsPerSecond << ",\n";
+			json << "      \"items_per_second\": " << result.itemsPerSecond << ",\n";
+			if (result.hasCounters)
+			{
+				json << "      \"cache_misses_per_op\": " << result.missesPerOp << ",\n";
+				json << "      \"cache_references_per_op\": " << result.referencesPerOp << "\n";
+			}
+			else
+			{
+				json << "      \"cache_misses_per_op\": null,\n";
+				json << "      \"cache_references_per_op\": null\n";
+			}
+			json << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+		}
+		json << "  ]\n";
+		json << "}\n";
+		return (bool)json;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i < argc; i++)
+	{
+		bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "--filter") == 0 && hasValue) options.filter = argv[++i];
+		else if (strcmp(argv[i], "--reps") == 0 && hasValue) options.reps = (unsigned int)std::max(1, atoi(argv[++i]));
+		else if (strcmp(argv[i], "--min-ms") == 0 && hasValue) options.minBatchMs = std::max(0.1, atof(argv[++i]));
+		else if (strcmp(argv[i], "--warmup-ms") == 0 && hasValue) options.warmupMs = std::max(0.0, atof(argv[++i]));
+		else if (strcmp(argv[i], "--models") == 0 && hasValue) options.modelFolder = argv[++i];
+		else if (strcmp(argv[i], "--json") == 0 && hasValue) options.jsonPath = argv[++i];
+		else
+		{
+			printf("Usage: %s [--filter <text>] [--reps N] [--min-ms N] [--warmup-ms N] [--models <folder>] [--json <file>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	std::vector<MicroBenchmark> benchmarks;
+	AddTransformBenchmarks(benchmarks);
+	AddCameraBenchmarks(benchmarks);
+	AddMeshBenchmarks(benchmarks, options.modelFolder);
+	AddRenderQueueBenchmarks(benchmarks);
+	AddInputBenchmarks(benchmarks);
+	AddAllocationBenchmarks(benchmarks);
+
+	CacheCounters counters;
+	bool countersAvailable = counters.Open();
+	if (!countersAvailable)
+		printf("Cache counters unavailable (perf_event_open failed), timing only\n");
+
+	printf("%-44s %14s %12s %12s %14s %12s\n", "Benchmark", "ns/op", "min", "stddev", "items/s", "misses/op");
+	std::vector<BenchmarkResult> results;
+	for (const MicroBenchmark& benchmark : benchmarks)
+	{
+		if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos)
+			continue;
+
+		BenchmarkResult result = Measure(benchmark, options, counters);
+		results.push_back(result);
+
+		char misses[32] = "-";
+		if (result.hasCounters)
+			snprintf(misses, sizeof(misses), "%.3f", result.missesPerOp);
+		printf("%-44s %14.3f %12.3f %12.3f %14.4g %12s\n", result.name.c_str(),
+			result.medianNs, result.minNs, result.stddevNs, result.itemsPerSecond, misses);
+	}
+
+	Input::ShutDown();
+
+	if (!WriteJSON(options.jsonPath, results, options, countersAvailable))
+	{
+		printf("Could not write %s\n", options.jsonPath.c_str());
+		return 1;
+	}
+	printf("Results written to %s\n", options.jsonPath.c_str());
+	return 0;
+}
@@ -0,0 +1,205 @@
+// --------------------------------------------------------
+// Replays a recorded allocation trace against the pool
+// allocator and against malloc, and reports what each call
+// costs
+//
+// Traces come from the game (the "Record Allocation Trace"
+// button under "ImGui Allocator" in the profiler window) as
+// ImGuiAllocations.trace next to the exe.  Nothing here
+// needs Windows, so it builds on Linux, e.g. from this folder:
+//
+//   g++ -std=c++20 -O2 -I.. ReplayAllocations.cpp ../PoolAllocator.cpp
+//       -pthread -o ReplayAllocations
+//
+// Usage:
+//   ReplayAllocations <file.trace> [passes] [--threads N]
+//
+// Each pass replays every event in the trace once, timed
+// frame by frame, then frees whatever the trace left
+// allocated.  With --threads, that many threads replay the
+// trace at the same time, which is where the pool's thread
+// caches matter against malloc's arenas.  Every block gets
+// its first byte written, the way a constructor would
+// --------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "PoolAllocator.h"
+
+namespace
+{
+	struct Allocator
+	{
+		const char* name;
+		void* (*allocate)(size_t size);
+		void (*free)(void* memory);
+	};
+
+	void* MallocAllocate(size_t size) { return malloc(size); }
+	void MallocFree(void* memory) { free(memory); }
+
+	const Allocator Allocators[] =
+	{
+		{ "malloc", MallocAllocate, MallocFree },
+		{ "PoolAllocator", PoolAllocator::Allocate, PoolAllocator::Free },
+	};
+
+	// --------------------------------------------------------
+	// One pass over the trace.  Frame times (in microseconds)
+	// are appended to frameMicroseconds when it isn't null
+	// --------------------------------------------------------
+	void ReplayPass(
+		const Allocator& allocator,
+		const std::vector<PoolTraceEvent>& events,
+		std::vector<void*>& blocks,
+		std::vector<double>* frameMicroseconds)
+	{
+		auto frameStart = std::chrono::steady_clock::now();
+		for (const PoolTraceEvent& event : events)
+		{
+			switch (event.type)
+			{
+			case PoolTraceEvent::Type::Allocate:
+			{
+				unsigned char* memory = (unsigned char*)allocator.allocate(event.size);
+				if (event.size > 0)
+					memory[0] = (unsigned char)event.id;
+				blocks[event.id] = memory;
+				break;
+			}
+			case PoolTraceEvent::Type::Free:
+				allocator.free(blocks[event.id]);
+				blocks[event.id] = 0;
+				break;
+			case PoolTraceEvent::Type::EndFrame:
+				if (frameMicroseconds)
+				{
+					auto frameEnd = std::chrono::steady_clock::now();
+					frameMicroseconds->push_back(std::chrono::duration<double, std::micro>(frameEnd - frameStart).count());
+					frameStart = frameEnd;
+				}
+				break;
+			}
+		}
+
+		// Whatever was still live when the trace ended
+		for (void*& block : blocks)
+		{
+			if (block)
+				allocator.free(block);
+			block = 0;
+		}
+	}
+
+	double Percentile(std::vector<double> values, double percent)
+	{
+		if (values.empty())
+			return 0.0;
+		std::sort(values.begin(), values.end());
+		size_t index = (size_t)((values.size() - 1) * percent / 100.0 + 0.5);
+		return values[index];
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s <file.trace> [passes] [--threads N]\n", argv[0]);
+		return 1;
+	}
+
+	unsigned int passes = 20;
+	unsigned int threadCount = 1;
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+			threadCount = (unsigned int)std::max(1, atoi(argv[++i]));
+		else
+			passes = (unsigned int)std::max(1, atoi(argv[i]));
+	}
+
+	std::vector<PoolTraceEvent> events;
+	if (!PoolAllocator::LoadTrace(argv[1], events))
+	{
+		printf("Could not load %s\n", argv[1]);
+		return 1;
+	}
+
+	unsigned int allocations = 0;
+	unsigned int frees = 0;
+	unsigned int frames = 0;
+	unsigned long long bytes = 0;
+	for (const PoolTraceEvent& event : events)
+	{
+		if (event.type == PoolTraceEvent::Type::Allocate)
+		{
+			allocations++;
+			bytes += event.size;
+		}
+		else if (event.type == PoolTraceEvent::Type::Free)
+			frees++;
+		else
+			frames++;
+	}
+
+	printf("Trace: %u frames, %u allocations and %u frees (%.1f calls per frame, %.1f bytes on average)\n",
+		frames, allocations, frees, frames > 0 ? (double)(allocations + frees) / frames : 0.0,
+		allocations > 0 ? (double)bytes / allocations : 0.0);
+	printf("Passes: %u  Threads: %u\n\n", passes, threadCount);
+	printf("%-14s %12s %12s %12s %12s\n", "Allocator", "ns/call", "frame p50", "frame p99", "frame max");
+
+	for (const Allocator& allocator : Allocators)
+	{
+		// The first pass on each thread fills the allocator's
+		// caches and isn't timed
+		std::vector<std::vector<double>> frameTimes(threadCount);
+		auto replay = [&](unsigned int thread)
+		{
+			std::vector<void*> blocks(allocations, 0);
+			ReplayPass(allocator, events, blocks, 0);
+			for (unsigned int pass = 0; pass < passes; pass++)
+				ReplayPass(allocator, events, blocks, &frameTimes[thread]);
+		};
+
+		auto start = std::chrono::steady_clock::now();
+		std::vector<std::thread> threads;
+		for (unsigned int thread = 0; thread < threadCount; thread++)
+			threads.emplace_back(replay, thread);
+		for (std::thread& thread : threads)
+			thread.join();
+		auto end = std::chrono::steady_clock::now();
+
+		// Frame times from every thread together
+		std::vector<double> allFrames;
+		double frameTotal = 0.0;
+		for (const std::vector<double>& times : frameTimes)
+		{
+			for (double time : times)
+			{
+				allFrames.push_back(time);
+				frameTotal += time;
+			}
+		}
+
+		// Each thread times its own frames, so this is what one
+		// call costs while the other threads are busy too
+		double calls = (double)(allocations + frees) * passes * threadCount;
+		printf("%-14s %12.2f %12.2f %12.2f %12.2f  (%.1f ms wall)\n",
+			allocator.name,
+			calls > 0 ? frameTotal * 1000.0 / calls : 0.0,
+			Percentile(allFrames, 50.0),
+			Percentile(allFrames, 99.0),
+			Percentile(allFrames, 100.0),
+			std::chrono::duration<double, std::milli>(end - start).count());
+	}
+	printf("\nFrame times in microseconds\n");
+
+	return 0;
+}
@@ -0,0 +1,177 @@
+// --------------------------------------------------------
+// Replays captured command streams through the null backend
+// and reports how long submission takes on the CPU
+//
+// Captures come from the game (F9, or the "Command Stream"
+// node in the UI) as FrameCapture.rcap next to the exe.
+// Nothing here needs Windows or a GPU, so it builds with any
+// C++17 compiler, e.g. from this folder:
+//
+//   g++ -std=c++17 -O2 -I.. ReplayCapture.cpp ../RenderCommands.cpp
+//       ../RenderCapture.cpp ../NullRenderBackend.cpp -o ReplayCapture
+//
+// Usage:
+//   ReplayCapture <file.rcap> [passes]
+//   ReplayCapture --synthetic <entities> [passes]
+//
+// Each pass replays every captured frame once.  The report
+// shows the spread of per-frame times across passes, so a
+// run can be compared against a previous one
+// --------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "RenderCapture.h"
+#include "NullRenderBackend.h"
+
+namespace
+{
+	// Roughly what Game::DrawEntities records: per-frame data,
+	// shared state, then constants and a draw per entity, with
+	// entities sorted so ones sharing a mesh are together
+	void BuildSyntheticCapture(RenderCapture& capture, unsigned int entityCount, unsigned int frameCount)
+	{
+		const unsigned int MeshCount = 7;
+		const unsigned int PerFrameBytes = 208;
+		const unsigned int ObjectBytes = 80;
+
+		unsigned char perFrame[PerFrameBytes] = {};
+		unsigned char object[ObjectBytes] = {};
+
+		RenderCommandStream stream;
+		for (unsigned int frame = 0; frame < frameCount; frame++)
+		{
+			stream.Clear();
+			perFrame[0] = (unsigned char)frame;
+			stream.UploadBuffer(1, perFrame, PerFrameBytes);
+			stream.SetTopology(4);
+			stream.SetPixelShader(1);
+			stream.SetVSConstantBuffer(1, 1);
+			stream.SetInputLayout(1);
+			stream.SetVertexShader(1);
+
+			for (unsigned int i = 0; i < entityCount; i++)
+			{
+				unsigned int mesh = i * MeshCount / (entityCount > 0 ? entityCount : 1);
+				ResourceHandle vb = 2 + mesh * 2;
+				unsigned int stride = 28;
+				unsigned int offset = 0;
+
+				object[0] = (unsigned char)i;
+				stream.SetVSConstants(0, object, ObjectBytes);
+				stream.SetVertexBuffers(0, 1, &vb, &stride, &offset);
+				stream.SetIndexBuffer(vb + 1, 42, 0);
+				stream.DrawIndexed(36 * (mesh + 1), 0, 0);
+			}
+
+			capture.AddFrame(stream);
+		}
+	}
+
+	double Percentile(std::vector<double> values, double percent)
+	{
+		if (values.empty())
+			return 0.0;
+		std::sort(values.begin(), values.end());
+		size_t index = (size_t)(percent / 100.0 * (values.size() - 1) + 0.5);
+		return values[index];
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		printf("Usage: %s <file.rcap> [passes]\n", argv[0]);
+		printf("       %s --synthetic <entities> [passes]\n", argv[0]);
+		return 1;
+	}
+
+	RenderCapture capture;
+	int passArg = 2;
+	if (strcmp(argv[1], "--synthetic") == 0)
+	{
+		unsigned int entities = argc > 2 ? (unsigned int)atoi(argv[2]) : 1000;
+		BuildSyntheticCapture(capture, entities, 60);
+		passArg = 3;
+		printf("Synthetic capture: %u entities\n", entities);
+	}
+	else if (!capture.Load(argv[1]))
+	{
+		printf("Could not load %s\n", argv[1]);
+		return 1;
+	}
+
+	unsigned int passes = argc > passArg ? (unsigned int)atoi(argv[passArg]) : 50;
+	unsigned int frameCount = capture.GetFrameCount();
+	if (frameCount == 0 || passes == 0)
+	{
+		printf("Nothing to replay\n");
+		return 1;
+	}
+
+	unsigned long long commandsPerPass = 0;
+	size_t bytesPerPass = 0;
+	for (unsigned int i = 0; i < frameCount; i++)
+	{
+		commandsPerPass += capture.GetFrame(i).GetCommandCount();
+		bytesPerPass += capture.GetFrame(i).GetSize();
+	}
+
+	NullRenderBackend backend;
+
+	// One untimed pass to warm up caches and the upload memory
+	for (unsigned int i = 0; i < frameCount; i++)
+		backend.Execute(capture.GetFrame(i));
+	backend.ResetStats();
+
+	std::vector<double> frameMicroseconds;
+	frameMicroseconds.reserve((size_t)passes * frameCount);
+
+	for (unsigned int pass = 0; pass < passes; pass++)
+	{
+		for (unsigned int i = 0; i < frameCount; i++)
+		{
+			// Every frame starts from unknown state, the same as
+			// the game after the UI resets the state cache
+			backend.ResetState();
+
+			auto start = std::chrono::steady_clock::now();
+			backend.Execute(capture.GetFrame(i));
+			auto end = std::chrono::steady_clock::now();
+
+			frameMicroseconds.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+		}
+	}
+
+	double total = 0.0;
+	for (double time : frameMicroseconds)
+		total += time;
+	double mean = total / frameMicroseconds.size();
+
+	const NullBackendStats& stats = backend.GetStats();
+	double framesReplayed = (double)passes * frameCount;
+
+	printf("Frames: %u  Passes: %u\n", frameCount, passes);
+	printf("Per frame: %.1f commands, %.1f KB of stream\n", commandsPerPass / (double)frameCount, bytesPerPass / 1024.0 / frameCount);
+	printf("Per frame: %.1f draws, %.1f state changes, %.1f redundant binds, %.1f KB uploaded\n",
+		stats.draws / framesReplayed,
+		stats.stateChanges / framesReplayed,
+		stats.redundantBinds / framesReplayed,
+		stats.bytesUploaded / 1024.0 / framesReplayed);
+	printf("Frame time (us): min %.2f  p50 %.2f  p90 %.2f  p99 %.2f  max %.2f  mean %.2f\n",
+		Percentile(frameMicroseconds, 0.0),
+		Percentile(frameMicroseconds, 50.0),
+		Percentile(frameMicroseconds, 90.0),
+		Percentile(frameMicroseconds, 99.0),
+		Percentile(frameMicroseconds, 100.0),
+		mean);
+	printf("Per command: %.1f ns\n", mean * 1000.0 * frameCount / commandsPerPass);
+
+	return 0;
+}
@@ -0,0 +1,271 @@
+// --------------------------------------------------------
+// Checks RingAllocator against what ConstantBufferRing
+// relies on:
+//
+//  - Offsets are aligned, and AlignUp() rounds up to the
+//    next multiple and leaves multiples alone
+//  - A frame starts where the last one ended, and only
+//    wraps (telling the caller to discard) when it wouldn't
+//    fit before the end of the ring
+//  - A frame larger than the whole ring doesn't Fit(), and
+//    its reservation never runs past the end
+//  - Allocate() stays inside the frame's reservation, and
+//    returns InvalidOffset once it's used up
+//  - Reset() starts over from zero with the new capacity
+//
+// Nothing here needs Windows; from this folder:
+//
+//   g++ -std=c++20 -O2 -I.. RingAllocatorTest.cpp
+//       ../RingAllocator.cpp -o RingAllocatorTest
+//
+// Usage:
+//   RingAllocatorTest [--frames N] [--seed N]
+//
+// Runs a few fixed cases, then --frames (default 200000)
+// random frames over a range of capacities and alignments.
+// Exits with 1 if any check fails
+// --------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "RingAllocator.h"
+
+namespace
+{
+	unsigned int failures = 0;
+
+	// Only the first few are printed, one bad rule tends to
+	// fail thousands of cases
+	void Fail(const char* test, const char* what)
+	{
+		if (failures < 20)
+			printf("  FAIL %s: %s\n", test, what);
+		failures++;
+	}
+
+	void Expect(bool condition, const char* test, const char* what)
+	{
+		if (!condition)
+			Fail(test, what);
+	}
+
+	void CheckAlignment()
+	{
+		const char* test = "alignment";
+		Expect(RingAllocator::AlignUp(0, 256) == 0, test, "AlignUp(0) isn't 0");
+		Expect(RingAllocator::AlignUp(1, 256) == 256, test, "AlignUp(1) isn't 256");
+		Expect(RingAllocator::AlignUp(256, 256) == 256, test, "AlignUp() moved a multiple");
+		Expect(RingAllocator::AlignUp(257, 256) == 512, test, "AlignUp(257) isn't 512");
+		Expect(RingAllocator::AlignUp(17, 16) == 32, test, "AlignUp(17, 16) isn't 32");
+
+		// An alignment of 0 acts as 1
+		RingAllocator unaligned(100, 0);
+		Expect(unaligned.GetAlignment() == 1, test, "alignment of 0 isn't treated as 1");
+
+		RingAllocator ring(4096, 256);
+		ring.BeginFrame(1024);
+		unsigned int a = ring.Allocate(1);
+		unsigned int b = ring.Allocate(100);
+		unsigned int c = ring.Allocate(256);
+		Expect(a == 0 && b == 256 && c == 512, test, "blocks not rounded up to the alignment");
+		Expect(ring.GetFrameUsed() == 768, test, "GetFrameUsed() doesn't count the padding");
+
+		// The next frame's start is aligned even when the last
+		// frame asked for an odd size
+		ring.BeginFrame(300);
+		Expect(ring.GetFrameStart() == 1024, test, "second frame doesn't start after the first");
+		ring.BeginFrame(10);
+		Expect(ring.GetFrameStart() == 1536, test, "odd frame size left the next frame unaligned");
+	}
+
+	void CheckWrap()
+	{
+		const char* test = "wrap";
+		RingAllocator ring(1024, 256);
+
+		// Each frame reserves 512, so two fit and the third wraps
+		Expect(!ring.BeginFrame(300), test, "first frame wrapped");
+		Expect(ring.GetFrameStart() == 0, test, "first frame doesn't start at zero");
+		Expect(!ring.BeginFrame(300), test, "second frame wrapped though it fits");
+		Expect(ring.GetFrameStart() == 512, test, "second frame doesn't start after the first");
+		Expect(ring.BeginFrame(300), test, "third frame didn't wrap");
+		Expect(ring.GetFrameStart() == 0, test, "wrapped frame doesn't start at zero");
+
+		// Filling the ring exactly to the end isn't a wrap
+		RingAllocator exact(1024, 256);
+		exact.BeginFrame(512);
+		Expect(!exact.BeginFrame(512), test, "frame ending exactly at the end wrapped");
+		Expect(exact.Allocate(512) == 512, test, "frame ending exactly at the end can't use its last byte");
+		Expect(exact.BeginFrame(1), test, "frame after a full ring didn't wrap");
+	}
+
+	void CheckTooLarge()
+	{
+		const char* test = "too large";
+		RingAllocator ring(1024, 256);
+		Expect(ring.Fits(1024), test, "frame the size of the ring doesn't fit");
+		Expect(!ring.Fits(1025), test, "frame larger than the ring fits");
+		Expect(!ring.Fits(4096), test, "frame four times the ring fits");
+
+		ring.BeginFrame(256);
+		Expect(ring.BeginFrame(4096), test, "frame larger than the ring didn't report a wrap");
+		Expect(ring.GetFrameStart() == 0, test, "oversized frame doesn't start at zero");
+
+		// Whatever the caller does with it, nothing may land
+		// past the end of the ring
+		unsigned int last = 0;
+		unsigned int offset;
+		while ((offset = ring.Allocate(256)) != RingAllocator::InvalidOffset)
+			last = offset;
+		Expect(last + 256 <= ring.GetCapacity(), test, "oversized frame allocated past the end");
+		Expect(ring.GetFrameUsed() == 1024, test, "oversized frame couldn't use the whole ring");
+	}
+
+	void CheckExhausted()
+	{
+		const char* test = "exhausted";
+		RingAllocator ring(4096, 256);
+		ring.BeginFrame(512);
+		Expect(ring.Allocate(256) == 0, test, "first block not at the frame start");
+		Expect(ring.Allocate(256) == 256, test, "second block not after the first");
+		Expect(ring.Allocate(1) == RingAllocator::InvalidOffset, test, "allocated past the reservation");
+		Expect(ring.GetFrameUsed() == 512, test, "failed allocation changed GetFrameUsed()");
+
+		// A block larger than what's left fails even though
+		// a smaller one would still fit
+		ring.BeginFrame(512);
+		ring.Allocate(256);
+		Expect(ring.Allocate(257) == RingAllocator::InvalidOffset, test, "block larger than what's left allocated");
+		Expect(ring.Allocate(256) == 768, test, "failed allocation used up the rest of the frame");
+
+		// No frame begun yet, so nothing is reserved
+		RingAllocator fresh(4096, 256);
+		Expect(fresh.Allocate(1) == RingAllocator::InvalidOffset, test, "allocated before BeginFrame()");
+	}
+
+	void CheckReset()
+	{
+		const char* test = "reset";
+		RingAllocator ring(1024, 256);
+		ring.BeginFrame(512);
+		ring.Allocate(256);
+		ring.Reset(2048);
+		Expect(ring.GetCapacity() == 2048, test, "capacity not changed");
+		Expect(ring.GetFrameUsed() == 0, test, "old frame still counted");
+		Expect(ring.Allocate(1) == RingAllocator::InvalidOffset, test, "old reservation survived");
+		Expect(!ring.BeginFrame(1536), test, "first frame after Reset() wrapped");
+		Expect(ring.GetFrameStart() == 0, test, "first frame after Reset() doesn't start at zero");
+
+		// Shrinking below where the head was must still wrap
+		// cleanly instead of running past the new end
+		ring.BeginFrame(256);
+		ring.Reset(512);
+		Expect(!ring.BeginFrame(512), test, "frame the size of the shrunk ring wrapped");
+		Expect(ring.BeginFrame(256), test, "full shrunk ring didn't wrap");
+	}
+
+	// Random frames, checked against a simple model of where
+	// each one should start
+	void CheckRandom(unsigned int frameCount, unsigned int seed)
+	{
+		const char* test = "random";
+		const unsigned int capacities[] = { 256, 1000, 4096, 65536, 1024 * 1024 };
+		const unsigned int alignments[] = { 1, 4, 16, 256 };
+		unsigned int framesEach = frameCount / (5 * 4);
+
+		std::mt19937 random(seed);
+		for (unsigned int capacity : capacities)
+		{
+			for (unsigned int alignment : alignments)
+			{
+				RingAllocator ring(capacity, alignment);
+				unsigned int expectedStart = 0;
+				for (unsigned int f = 0; f < framesEach; f++)
+				{
+					// Mostly frames that fit, now and then one that doesn't
+					unsigned int frameBytes = random() % (capacity / 2 + 1);
+					if (random() % 64 == 0)
+						frameBytes = capacity + random() % capacity;
+
+					unsigned int reserve = RingAllocator::AlignUp(frameBytes, alignment);
+					bool shouldWrap = reserve > capacity - expectedStart;
+					bool wrapped = ring.BeginFrame(frameBytes);
+					if (wrapped != shouldWrap)
+						Fail(test, wrapped ? "wrapped though the frame fit" : "didn't wrap though the frame ran past the end");
+					if (shouldWrap)
+						expectedStart = 0;
+					if (ring.GetFrameStart() != expectedStart)
+						Fail(test, "frame doesn't start where the last one ended");
+					if (ring.Fits(frameBytes) != (reserve <= capacity))
+						Fail(test, "Fits() wrong");
+
+					unsigned int frameEnd = reserve <= capacity ? expectedStart + reserve : capacity;
+					expectedStart = frameEnd;
+
+					// Allocate until it fails, then check the blocks
+					// stayed in the frame, aligned and in order
+					unsigned int cursor = ring.GetFrameStart();
+					while (true)
+					{
+						unsigned int size = 1 + random() % (capacity / 8 + 1);
+						unsigned int offset = ring.Allocate(size);
+						unsigned int blockSize = RingAllocator::AlignUp(size, alignment);
+						if (offset == RingAllocator::InvalidOffset)
+						{
+							if (blockSize <= frameEnd - cursor)
+								Fail(test, "allocation failed though it fit the reservation");
+							break;
+						}
+
+						if (offset % alignment != 0)
+							Fail(test, "unaligned offset");
+						if (offset != cursor)
+							Fail(test, "block doesn't follow the last one");
+						if (offset + blockSize > frameEnd)
+							Fail(test, "block runs past the reservation");
+						cursor = offset + blockSize;
+					}
+
+					if (ring.GetFrameUsed() != cursor - ring.GetFrameStart())
+						Fail(test, "GetFrameUsed() doesn't match the blocks");
+				}
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int frameCount = 200000;
+	unsigned int seed = 1;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+			frameCount = (unsigned int)atoi(argv[++i]);
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			seed = (unsigned int)atoi(argv[++i]);
+		else
+		{
+			printf("Usage: %s [--frames N] [--seed N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	CheckAlignment();
+	CheckWrap();
+	CheckTooLarge();
+	CheckExhausted();
+	CheckReset();
+	CheckRandom(frameCount, seed);
+
+	if (failures > 0)
+	{
+		printf("%u checks failed\n", failures);
+		return 1;
+	}
+	printf("All checks passed\n");
+	return 0;
+}
@@ -0,0 +1,184 @@
+// --------------------------------------------------------
+// Times ImFont::RenderText() (through ImDrawList::AddText)
+// emitting about 100k glyphs per frame of profiler-style
+// text, and can dump the vertices and indices it produced
+//
+// imgui_draw.cpp emits glyphs 4 at a time with SSE when
+// IMGUI_ENABLE_SSE_TEXT is defined, so build it both ways to
+// compare.  Nothing here needs Windows; from this folder:
+//
+//   g++ -std=c++20 -O2 -I.. TextBenchmark.cpp ../ImGui/imgui.cpp
+//       ../ImGui/imgui_draw.cpp ../ImGui/imgui_tables.cpp
+//       ../ImGui/imgui_widgets.cpp -o TextBenchmark
+//
+// and again with -DIMGUI_ENABLE_SSE_TEXT -o TextBenchmarkSSE
+//
+// Usage:
+//   TextBenchmark [--frames N] [--glyphs N] [--dump <file>]
+//
+// Each scenario draws the same lines: unclipped, with a CPU
+// fine clip rect cutting through them (as table cells and
+// small frames do), at 1.5x scale, and word wrapped onto
+// several rows.  The dumps from the two builds, or from
+// before and after any change to the text path, should be
+// byte-identical:
+//
+//   TextBenchmark --dump scalar.bin
+//   TextBenchmarkSSE --dump sse.bin
+//   cmp scalar.bin sse.bin
+// --------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ImGui/imgui.h"
+
+namespace
+{
+	struct Scenario
+	{
+		const char* name;
+		float scale;		// Of the font's own size
+		bool fineClip;		// Clip each line to a narrower rect on the CPU
+		float wrapWidth;	// Word wrap each line at this width, 0 for none
+	};
+
+	const Scenario Scenarios[] =
+	{
+		{ "Unclipped", 1.0f, false, 0.0f },
+		{ "Fine Clip", 1.0f, true, 0.0f },
+		{ "Scaled 1.5x", 1.5f, false, 0.0f },
+		{ "Wrapped", 1.0f, false, 150.0f },
+	};
+
+	// Lines like the profiler and stats panels show
+	std::vector<std::string> MakeLines(size_t glyphTarget)
+	{
+		const char* scopes[] = { "Game::Update", "Game::Draw", "BuildRenderQueue", "DrawEntitiesInstanced", "ImGui Render", "Present" };
+		std::vector<std::string> lines;
+		size_t glyphs = 0;
+		for (unsigned int i = 0; glyphs < glyphTarget; i++)
+		{
+			char line[128];
+			snprintf(line, sizeof(line), "%-22s %8.3f ms  calls %5u  min %.3f  max %.3f",
+				scopes[i % 6], (i * 37 % 1000) / 97.0, i % 4096, (i % 13) / 7.0, (i % 29) / 3.0);
+			lines.push_back(line);
+			for (const char* c = line; *c; c++)
+				glyphs += *c != ' ';
+		}
+		return lines;
+	}
+
+	double Percentile(std::vector<double> values, double percent)
+	{
+		std::sort(values.begin(), values.end());
+		return values[(size_t)((values.size() - 1) * percent / 100.0 + 0.5)];
+	}
+}
+
+int main(int argc, char** argv)
+{
+	unsigned int frames = 200;
+	size_t glyphTarget = 100000;
+	const char* dumpPath = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+			frames = (unsigned int)std::max(1, atoi(argv[++i]));
+		else if (strcmp(argv[i], "--glyphs") == 0 && i + 1 < argc)
+			glyphTarget = (size_t)std::max(1, atoi(argv[++i]));
+		else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc)
+			dumpPath = argv[++i];
+		else
+		{
+			printf("Usage: %s [--frames N] [--glyphs N] [--dump <file>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// A context only for the font atlas and the draw list's
+	// shared data, which one NewFrame() sets up
+	ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.IniFilename = 0;
+	io.DisplaySize = ImVec2(1920, 1080);
+	io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;	// 400k vertices won't fit 16-bit indices otherwise
+	ImFont* font = io.Fonts->AddFontDefault();
+	io.Fonts->Build();
+	ImGui::NewFrame();
+
+	std::vector<std::string> lines = MakeLines(glyphTarget);
+	ImDrawList drawList(ImGui::GetDrawListSharedData());
+	FILE* dump = dumpPath ? fopen(dumpPath, "wb") : 0;
+
+	printf("%u frames of %zu lines\n\n", frames, lines.size());
+	printf("%-12s %10s %12s %12s %12s\n", "Scenario", "Glyphs", "frame p50", "frame min", "ns/glyph");
+
+	for (const Scenario& scenario : Scenarios)
+	{
+		float size = font->FontSize * scenario.scale;
+		float lineHeight = size;
+
+		// Columns of lines, wrapping down a tall virtual page so
+		// everything is inside the clip rect
+		const int linesPerColumn = 2000;
+		const float columnWidth = 420.0f * scenario.scale;
+		std::vector<double> frameMs;
+		int glyphs = 0;
+		for (unsigned int frame = 0; frame < frames + 10; frame++)
+		{
+			drawList._ResetForNewFrame();
+			drawList.PushClipRect(ImVec2(0, 0), ImVec2(1e6f, 1e6f));
+			drawList.PushTextureID(io.Fonts->TexID);
+
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < lines.size(); i++)
+			{
+				ImVec2 pos(columnWidth * (i / linesPerColumn), lineHeight * (i % linesPerColumn));
+				const char* text = lines[i].c_str();
+				const char* end = text + lines[i].size();
+				if (scenario.fineClip)
+				{
+					// Cut through the middle of glyphs on both axes
+					ImVec4 clip(pos.x + 3.5f, pos.y + 2.25f, pos.x + 180.5f + (i % 7) * 13.25f, pos.y + lineHeight - 3.75f);
+					drawList.AddText(font, size, pos, IM_COL32_WHITE, text, end, scenario.wrapWidth, &clip);
+				}
+				else
+					drawList.AddText(font, size, pos, IM_COL32_WHITE, text, end, scenario.wrapWidth);
+			}
+			auto end = std::chrono::steady_clock::now();
+
+			// The first few frames grow the buffers and aren't timed
+			if (frame >= 10)
+				frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+			glyphs = drawList.VtxBuffer.Size / 4;
+
+			if (dump && frame == 0)
+			{
+				fwrite(drawList.VtxBuffer.Data, sizeof(ImDrawVert), drawList.VtxBuffer.Size, dump);
+				fwrite(drawList.IdxBuffer.Data, sizeof(ImDrawIdx), drawList.IdxBuffer.Size, dump);
+				for (const ImDrawCmd& command : drawList.CmdBuffer)
+					fwrite(&command.ElemCount, sizeof(command.ElemCount), 1, dump);
+			}
+		}
+
+		double p50 = Percentile(frameMs, 50.0);
+		printf("%-12s %10d %9.3f ms %9.3f ms %12.2f\n",
+			scenario.name, glyphs, p50, Percentile(frameMs, 0.0), p50 * 1000000.0 / glyphs);
+	}
+
+	if (dump)
+	{
+		fclose(dump);
+		printf("\nWrote %s\n", dumpPath);
+	}
+
+	ImGui::EndFrame();
+	ImGui::DestroyContext();
+	return 0;
+}
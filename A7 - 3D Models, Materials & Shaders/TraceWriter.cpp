@@ -0,0 +1,365 @@
+#include "TraceWriter.h"
+
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+// --------------- Basic usage -----------------
+//
+// Writes the profiler's markers as Chrome Trace Event JSON,
+// which chrome://tracing and ui.perfetto.dev both open:
+//
+//   TraceWriter::Start(FixPath("Trace"));
+//
+//   // Each frame, after Profiler::EndFrame()
+//   TraceWriter::SetCounter("Draw Calls", draws);
+//   TraceWriter::WriteFrame(Profiler::GetLastFrame());
+//
+//   TraceWriter::Stop();
+//
+// Events are formatted into memory on the main thread, and
+// every megabyte or so the text is handed to a background
+// thread that does the file writes.  Files are capped in
+// size; a long session rolls over into numbered files and
+// the oldest ones are deleted.  Each Start() adds the date
+// and time to the path, so stopping and starting again (F8)
+// never overwrites an earlier trace.
+//
+// ---------------------------------------------
+
+namespace
+{
+	const size_t FlushBytes = 1024 * 1024;
+	const unsigned int MaxCounters = 16;
+
+	// Work for the background thread, done in order
+	struct WriteJob
+	{
+		enum class Type { Open, Append, Close, Remove } type;
+		std::string text; // File path for Open and Remove
+	};
+
+	struct Counter
+	{
+		const char* name;
+		double value;
+	};
+
+	// Writer thread and its queue
+	std::thread writerThread;
+	std::mutex queueMutex;
+	std::condition_variable queueSignal;
+	std::deque<WriteJob> queue;
+	bool writerQuit = false;
+
+	// Main thread state
+	bool recording = false;
+	std::string basePath;
+	std::string currentPath;
+	unsigned long long maxFileBytes = 0;
+	unsigned int maxFiles = 0;
+	unsigned int fileIndex = 0;
+	unsigned long long fileBytes = 0;
+	unsigned long long totalBytes = 0;
+	bool firstEventInFile = true;
+	unsigned int threadsNamed = 0;
+	std::string buffer;
+	std::string lastStamp;
+	unsigned int stampRepeats = 0;
+
+	Counter counters[MaxCounters];
+	unsigned int counterCount = 0;
+
+	void WriterLoop()
+	{
+		std::ofstream file;
+		std::unique_lock<std::mutex> lock(queueMutex);
+		while (true)
+		{
+			queueSignal.wait(lock, [] { return writerQuit || !queue.empty(); });
+			if (queue.empty())
+				return;
+
+			WriteJob job = std::move(queue.front());
+			queue.pop_front();
+			lock.unlock();
+
+			switch (job.type)
+			{
+			case WriteJob::Type::Open: file.open(job.text, std::ios::binary | std::ios::trunc); break;
+			case WriteJob::Type::Append: file.write(job.text.data(), job.text.size()); break;
+			case WriteJob::Type::Close: file.close(); break;
+			case WriteJob::Type::Remove: std::remove(job.text.c_str()); break;
+			}
+
+			lock.lock();
+		}
+	}
+
+	void Queue(WriteJob::Type type, std::string text)
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			queue.push_back({ type, std::move(text) });
+		}
+		queueSignal.notify_one();
+	}
+
+	std::string FilePath(unsigned int index)
+	{
+		char suffix[16];
+		snprintf(suffix, sizeof(suffix), "_%03u.json", index);
+		return basePath + suffix;
+	}
+
+	// The path plus the local date and time, e.g.
+	// Trace_20240131_154502.  Traces started within the
+	// same second also get a count: Trace_20240131_154502_2
+	std::string SessionPath(const std::string& path)
+	{
+		time_t now = time(0);
+		tm local = {};
+#if defined(_WIN32)
+		localtime_s(&local, &now);
+#else
+		localtime_r(&now, &local);
+#endif
+		char stamp[32];
+		strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &local);
+
+		std::string session = path + "_" + stamp;
+		if (lastStamp == stamp)
+		{
+			stampRepeats++;
+			session += "_" + std::to_string(stampRepeats + 1);
+		}
+		else
+		{
+			lastStamp = stamp;
+			stampRepeats = 0;
+		}
+		return session;
+	}
+
+	// Hands everything formatted so far to the writer thread
+	void Flush()
+	{
+		if (buffer.empty())
+			return;
+
+		Queue(WriteJob::Type::Append, std::move(buffer));
+		buffer = std::string();
+		buffer.reserve(FlushBytes + FlushBytes / 4);
+	}
+
+	void Append(const char* text, int length)
+	{
+		if (length <= 0)
+			return;
+
+		buffer.append(text, length);
+		fileBytes += length;
+		totalBytes += length;
+	}
+
+	// Starts each event with the comma the previous one needs
+	void BeginEvent()
+	{
+		if (!firstEventInFile)
+			Append(",\n", 2);
+		firstEventInFile = false;
+	}
+
+	// Marker names are code literals, but quotes and
+	// backslashes would still break the JSON
+	void AppendName(const char* name)
+	{
+		const char* run = name;
+		for (const char* c = name; ; c++)
+		{
+			if (*c != '"' && *c != '\\' && *c != 0)
+				continue;
+
+			Append(run, (int)(c - run));
+			if (*c == 0)
+				break;
+
+			char escaped[2] = { '\\', *c };
+			Append(escaped, 2);
+			run = c + 1;
+		}
+	}
+
+	void OpenFile()
+	{
+		currentPath = FilePath(fileIndex);
+		Queue(WriteJob::Type::Open, currentPath);
+
+		// Only the newest maxFiles stay on disk
+		if (fileIndex >= maxFiles)
+			Queue(WriteJob::Type::Remove, FilePath(fileIndex - maxFiles));
+
+		fileBytes = 0;
+		firstEventInFile = true;
+		threadsNamed = 0;
+		Append("{\"traceEvents\":[\n", 17);
+	}
+
+	void CloseFile()
+	{
+		Append("\n]}\n", 4);
+		Flush();
+		Queue(WriteJob::Type::Close, std::string());
+	}
+
+	// Thread names are metadata events, written again at the
+	// top of every file so each one opens on its own
+	void NameThreads()
+	{
+		char text[128];
+		unsigned int threadCount = Profiler::GetThreadCount();
+		for (; threadsNamed < threadCount; threadsNamed++)
+		{
+			BeginEvent();
+			Append(text, snprintf(text, sizeof(text), "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", threadsNamed));
+			AppendName(Profiler::GetThreadName(threadsNamed));
+			Append("\"}}", 3);
+		}
+	}
+}
+
+// --------------------------------------------------------
+// Starts a new trace.  Returns false if one is already
+// being recorded
+//
+// path      - Path and file name, without the date, time
+//             or extension
+// fileLimit - Size at which a file is closed and the
+//             next one started
+// fileCount - How many of the newest files to keep
+// --------------------------------------------------------
+bool TraceWriter::Start(const std::string& path, unsigned long long fileLimit, unsigned int fileCount)
+{
+	if (recording)
+		return false;
+
+	if (!writerThread.joinable())
+	{
+		writerQuit = false;
+		writerThread = std::thread(WriterLoop);
+	}
+
+	basePath = SessionPath(path);
+	maxFileBytes = fileLimit > FlushBytes ? fileLimit : FlushBytes;
+	maxFiles = fileCount > 0 ? fileCount : 1;
+	fileIndex = 0;
+	totalBytes = 0;
+	buffer.reserve(FlushBytes + FlushBytes / 4);
+
+	OpenFile();
+	recording = true;
+	return true;
+}
+
+void TraceWriter::Stop()
+{
+	if (!recording)
+		return;
+
+	CloseFile();
+	recording = false;
+}
+
+// --------------------------------------------------------
+// Finishes the current trace and waits for every write
+// to reach the disk
+// --------------------------------------------------------
+void TraceWriter::ShutDown()
+{
+	Stop();
+
+	if (writerThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			writerQuit = true;
+		}
+		queueSignal.notify_one();
+		writerThread.join();
+	}
+}
+
+bool TraceWriter::IsRecording() { return recording; }
+
+void TraceWriter::SetCounter(const char* name, double value)
+{
+	for (unsigned int i = 0; i < counterCount; i++)
+	{
+		if (counters[i].name == name)
+		{
+			counters[i].value = value;
+			return;
+		}
+	}
+
+	if (counterCount < MaxCounters)
+		counters[counterCount++] = { name, value };
+}
+
+// --------------------------------------------------------
+// Formats one collected frame: a "Frame" event around
+// the main thread's markers, every marker as a complete
+// event, and one sample of each counter
+// --------------------------------------------------------
+void TraceWriter::WriteFrame(const ProfileFrame& frame)
+{
+	if (!recording)
+		return;
+
+	NameThreads();
+
+	// Trace timestamps are in microseconds
+	double frameStartUs = frame.startMs * 1000.0;
+	char text[256];
+
+	BeginEvent();
+	Append(text, snprintf(text, sizeof(text),
+		"{\"ph\":\"X\",\"name\":\"Frame\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"index\":%llu}}",
+		frameStartUs, frame.durationMs * 1000.0, frame.index));
+
+	for (const ProfileSample& sample : frame.samples)
+	{
+		BeginEvent();
+		Append("{\"ph\":\"X\",\"name\":\"", 18);
+		AppendName(sample.name);
+		Append(text, snprintf(text, sizeof(text), "\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+			sample.thread, frameStartUs + sample.startMs * 1000.0, sample.durationMs * 1000.0));
+	}
+
+	for (unsigned int i = 0; i < counterCount; i++)
+	{
+		BeginEvent();
+		Append("{\"ph\":\"C\",\"name\":\"", 18);
+		AppendName(counters[i].name);
+		Append(text, snprintf(text, sizeof(text), "\",\"pid\":1,\"ts\":%.3f,\"args\":{\"value\":%g}}",
+			frameStartUs, counters[i].value));
+	}
+
+	if (buffer.size() >= FlushBytes)
+		Flush();
+
+	// Roll over to the next file once this one is full
+	if (fileBytes >= maxFileBytes)
+	{
+		CloseFile();
+		fileIndex++;
+		OpenFile();
+	}
+}
+
+unsigned long long TraceWriter::GetBytesWritten() { return totalBytes; }
+const std::string& TraceWriter::GetCurrentPath() { return currentPath; }
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+#include "Profiler.h"
+
+// See TraceWriter.cpp for usage details
+
+namespace TraceWriter
+{
+	// Starts writing basePath_<date>_<time>_000.json, then
+	// _001.json, ...  Each file is closed at maxFileBytes and
+	// the next one started; only the newest maxFiles of the
+	// trace are kept on disk.  Earlier traces are left alone
+	bool Start(const std::string& basePath, unsigned long long maxFileBytes = 64ull * 1024 * 1024, unsigned int maxFiles = 8);
+	void Stop();
+	void ShutDown();
+
+	bool IsRecording();
+
+	// Counter values are stored until the next WriteFrame(),
+	// which writes one sample of each.  Names are stored by
+	// pointer, so use string literals
+	void SetCounter(const char* name, double value);
+
+	// Call once per frame, after Profiler::EndFrame()
+	void WriteFrame(const ProfileFrame& frame);
+
+	unsigned long long GetBytesWritten();
+	const std::string& GetCurrentPath();
+}
@@ -1,69 +1,69 @@
-#pragma once
-
-#include <DirectXMath.h>
-#include <vector>
-
-class Transform
-{
-public:
-	Transform();
-
-	// Transformers
-	void MoveAbsolute(float x, float y, float z);
-	void MoveAbsolute(DirectX::XMFLOAT3 offset);
-
-	void MoveRelative(float x, float y, float z);
-	void MoveRelative(DirectX::XMFLOAT3 offset);
-
-	void Rotate(float pitch, float yaw, float roll);
-	void Rotate(DirectX::XMFLOAT3 rotation);
-
-	void Scale(float uniformScale);
-	void Scale(float x, float y, float z);
-	void Scale(DirectX::XMFLOAT3 scale);
-
-	// Setters
-	void SetPosition(float x, float y, float z);
-	void SetPosition(DirectX::XMFLOAT3 position);
-
-	void SetRotation(float pitch, float yaw, float roll);
-	void SetRotation(DirectX::XMFLOAT3 rotation);
-	void SetScale(float scale);
-	void SetScale(float x, float y, float z);
-	void SetScale(DirectX::XMFLOAT3 scale);
-
-	void SetTransformsFromMatrix(DirectX::XMFLOAT4X4 worldMatrix);
-
-	// Getters
-	DirectX::XMFLOAT3 GetPosition();
-	DirectX::XMFLOAT3 GetPitchYawRoll();
-	DirectX::XMFLOAT3 GetScale();
-
-	// Local direction vector getters
-	DirectX::XMFLOAT3 GetUp();
-	DirectX::XMFLOAT3 GetRight();
-	DirectX::XMFLOAT3 GetForward();
-
-	// Matrix getters
-	DirectX::XMFLOAT4X4 GetWorldMatrix();
-	DirectX::XMFLOAT4X4 GetWorldInverseTransposeMatrix();
-
-	void UpdateVectors();
-
-private:
-	DirectX::XMFLOAT3 position;
-	DirectX::XMFLOAT3 rotation;
-	DirectX::XMFLOAT3 scale;
-
-	DirectX::XMFLOAT3 up;
-	DirectX::XMFLOAT3 right;
-	DirectX::XMFLOAT3 forward;
-
-	DirectX::XMFLOAT4X4 worldMatrix;
-	DirectX::XMFLOAT4X4 worldInverseTransposeMatrix;
-
-	void UpdateMatrices();
-
-};
-
-
+#pragma once
+
+#include <DirectXMath.h>
+#include <vector>
+
+class Transform
+{
+public:
+	Transform();
+
+	// Transformers
+	void MoveAbsolute(float x, float y, float z);
+	void MoveAbsolute(DirectX::XMFLOAT3 offset);
+
+	void MoveRelative(float x, float y, float z);
+	void MoveRelative(DirectX::XMFLOAT3 offset);
+
+	void Rotate(float pitch, float yaw, float roll);
+	void Rotate(DirectX::XMFLOAT3 rotation);
+
+	void Scale(float uniformScale);
+	void Scale(float x, float y, float z);
+	void Scale(DirectX::XMFLOAT3 scale);
+
+	// Setters
+	void SetPosition(float x, float y, float z);
+	void SetPosition(DirectX::XMFLOAT3 position);
+
+	void SetRotation(float pitch, float yaw, float roll);
+	void SetRotation(DirectX::XMFLOAT3 rotation);
+	void SetScale(float scale);
+	void SetScale(float x, float y, float z);
+	void SetScale(DirectX::XMFLOAT3 scale);
+
+	void SetTransformsFromMatrix(DirectX::XMFLOAT4X4 worldMatrix);
+
+	// Getters
+	DirectX::XMFLOAT3 GetPosition();
+	DirectX::XMFLOAT3 GetPitchYawRoll();
+	DirectX::XMFLOAT3 GetScale();
+
+	// Local direction vector getters
+	DirectX::XMFLOAT3 GetUp();
+	DirectX::XMFLOAT3 GetRight();
+	DirectX::XMFLOAT3 GetForward();
+
+	// Matrix getters
+	DirectX::XMFLOAT4X4 GetWorldMatrix();
+	DirectX::XMFLOAT4X4 GetWorldInverseTransposeMatrix();
+
+	void UpdateVectors();
+
+private:
+	DirectX::XMFLOAT3 position;
+	DirectX::XMFLOAT3 rotation;
+	DirectX::XMFLOAT3 scale;
+
+	DirectX::XMFLOAT3 up;
+	DirectX::XMFLOAT3 right;
+	DirectX::XMFLOAT3 forward;
+
+	DirectX::XMFLOAT4X4 worldMatrix;
+	DirectX::XMFLOAT4X4 worldInverseTransposeMatrix;
+
+	void UpdateMatrices();
+
+};
+
+
@@ -1,14 +1,14 @@
-#pragma once
-
-#include <DirectXMath.h>
-
-// --------------------------------------------------------
-// A custom vertex definition
-//
-// You will eventually ADD TO this, and/or make more of these!
-// --------------------------------------------------------
-struct Vertex
-{
-	DirectX::XMFLOAT3 Position;	    // The local position of the vertex
-	DirectX::XMFLOAT4 Color;        // The color of the vertex
+#pragma once
+
+#include <DirectXMath.h>
+
+// --------------------------------------------------------
+// A custom vertex definition
+//
+// You will eventually ADD TO this, and/or make more of these!
+// --------------------------------------------------------
+struct Vertex
+{
+	DirectX::XMFLOAT3 Position;	    // The local position of the vertex
+	DirectX::XMFLOAT4 Color;        // The color of the vertex
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+
+// Camera data, written and bound once per frame
+// - Same layout as the PerFrame cbuffer in VertexShader.hlsl
+cbuffer PerFrame : register(b1)
+{
+    matrix view;
+    matrix projection;
+    matrix viewProjection;
+    float time;
+}
+
+// Struct representing a single vertex worth of data
+// - The first two elements come from the mesh's vertex buffer (slot 0)
+// - The rest come from the per-frame instance buffer (slot 1), and
+//   only advance once per instance instead of once per vertex
+struct VertexShaderInput
+{
+	// Data type
+	//  |
+	//  |   Name          Semantic
+	//  |    |                |
+	//  v    v                v
+    float3 localPosition : POSITION; // XYZ position
+    float4 color : COLOR; // RGBA color
+
+    float4 worldRow0 : WORLD0; // World matrix, one row at a time
+    float4 worldRow1 : WORLD1;
+    float4 worldRow2 : WORLD2;
+    float4 worldRow3 : WORLD3;
+    float4 colorTint : TINT;
+};
+
+// Struct representing the data we're sending down the pipeline
+// - Should match our pixel shader's input (hence the name: Vertex to Pixel)
+struct VertexToPixel
+{
+    float4 screenPosition : SV_POSITION; // XYZW position (System Value Position)
+    float4 color : COLOR; // RGBA color
+};
+
+// --------------------------------------------------------
+// Instanced version of VertexShader.hlsl
+// - Each instance carries its own world matrix and tint, so
+//   every copy of a mesh can be drawn in one call
+// --------------------------------------------------------
+VertexToPixel main(VertexShaderInput input)
+{
+    VertexToPixel output;
+
+	// The rows come straight from a C++ XMFLOAT4X4 without the
+	// transpose a cbuffer load does, so the vector goes on the left
+    float4x4 world = float4x4(input.worldRow0, input.worldRow1, input.worldRow2, input.worldRow3);
+    float4 worldPosition = mul(float4(input.localPosition, 1.0f), world);
+    output.screenPosition = mul(viewProjection, worldPosition);
+
+    output.color = input.color * input.colorTint;
+    return output;
+}
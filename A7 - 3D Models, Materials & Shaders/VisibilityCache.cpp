@@ -0,0 +1,260 @@
+#include "VisibilityCache.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace
+{
+	// How often the per-entity costs are measured again, and
+	// the fewest entities timed in one batch, so the clock's
+	// own cost disappears into the batch
+	const unsigned int MeasureInterval = 120;
+	const unsigned int MinMeasureBatch = 4096;
+
+	float DistanceSquared(XMFLOAT3 a, XMFLOAT3 b)
+	{
+		float x = a.x - b.x;
+		float y = a.y - b.y;
+		float z = a.z - b.z;
+		return x * x + y * y + z * z;
+	}
+
+	float Dot(XMFLOAT3 a, XMFLOAT3 b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	XMFLOAT3 Cross(XMFLOAT3 a, XMFLOAT3 b)
+	{
+		return XMFLOAT3(
+			a.y * b.z - a.z * b.y,
+			a.z * b.x - a.x * b.z,
+			a.x * b.y - a.y * b.x);
+	}
+
+	// --------------------------------------------------------
+	// Cosine of the angle of the rotation from one camera
+	// orientation to the other.  The trace of the relative
+	// rotation is 1 + 2cos(angle), and with both orientations
+	// as (right, up, forward) bases that trace is just the sum
+	// of the three axes' dot products
+	// --------------------------------------------------------
+	float RotationCosine(XMFLOAT3 forwardA, XMFLOAT3 upA, XMFLOAT3 forwardB, XMFLOAT3 upB)
+	{
+		float trace = Dot(forwardA, forwardB) + Dot(upA, upB) + Dot(Cross(upA, forwardA), Cross(upB, forwardB));
+		return (trace - 1.0f) * 0.5f;
+	}
+}
+
+VisibilityCache::VisibilityCache(
+	float boundsThreshold,
+	float cameraMoveThreshold,
+	float cameraTurnThreshold,
+	unsigned int reverifyInterval) :
+	stats{},
+	cachedCameraPosition(0, 0, 0),
+	cachedCameraForward(0, 0, 1),
+	cachedCameraUp(0, 1, 0),
+	cachedProjection{},
+	cameraStable(false),
+	cameraPosition(0, 0, 0),
+	boundsThreshold(boundsThreshold),
+	cameraMoveThreshold(cameraMoveThreshold),
+	cameraTurnThreshold(cameraTurnThreshold),
+	reverifyInterval(reverifyInterval > 0 ? reverifyInterval : 1),
+	frameNumber(0),
+	enabled(true),
+	plainTestSeconds(0.0),
+	hitSeconds(0.0),
+	missSeconds(0.0),
+	framesUntilMeasure(1),
+	measureSink(0)
+{
+}
+
+// --------------------------------------------------------
+// Rebuilds the frustum and decides whether the camera is
+// still close enough to the one the cached results were
+// made with.  The comparison is always against that
+// original camera (not last frame's) so slow drift can't
+// sneak past the threshold a little at a time
+// --------------------------------------------------------
+void VisibilityCache::BeginFrame(
+	size_t entityCount,
+	DirectX::XMFLOAT3 cameraPosition,
+	DirectX::XMFLOAT3 cameraForward,
+	DirectX::XMFLOAT3 cameraUp,
+	DirectX::XMFLOAT4X4 projection,
+	DirectX::XMFLOAT4X4 viewProjection)
+{
+	frameNumber++;
+	frustum = Frustum(viewProjection);
+	stats = {};
+	this->cameraPosition = cameraPosition;
+
+	if (entries.size() != entityCount)
+		entries.resize(entityCount, Entry{});
+
+	cameraStable = enabled &&
+		DistanceSquared(cameraPosition, cachedCameraPosition) <= cameraMoveThreshold * cameraMoveThreshold &&
+		RotationCosine(cameraForward, cameraUp, cachedCameraForward, cachedCameraUp) >= cosf(cameraTurnThreshold) &&
+		memcmp(&projection, &cachedProjection, sizeof(XMFLOAT4X4)) == 0;
+
+	// Camera moved too far, so everything gets re-tested
+	// this frame against the new camera
+	if (!cameraStable)
+	{
+		cachedCameraPosition = cameraPosition;
+		cachedCameraForward = cameraForward;
+		cachedCameraUp = cameraUp;
+		cachedProjection = projection;
+	}
+
+	if (framesUntilMeasure == 0)
+	{
+		MeasureCosts();
+		framesUntilMeasure = MeasureInterval;
+	}
+	framesUntilMeasure--;
+}
+
+bool VisibilityCache::IsVisible(size_t index, const void* owner, const BoundingSphere& bounds)
+{
+	Entry& entry = entries[index];
+
+	// Can we trust last frame's answer?  Either way, the
+	// saving is against running the plain test
+	bool reverify = (index + frameNumber) % reverifyInterval == 0;
+	if (cameraStable && entry.valid && entry.reusable && entry.owner == owner && !reverify &&
+		DistanceSquared(bounds.center, entry.bounds.center) <= boundsThreshold * boundsThreshold &&
+		fabsf(bounds.radius - entry.bounds.radius) <= boundsThreshold)
+	{
+		stats.reused++;
+		stats.savedSeconds += plainTestSeconds - hitSeconds;
+		if (entry.visible) stats.visible++;
+		return entry.visible;
+	}
+
+	if (reverify && cameraStable && entry.valid)
+		stats.reverified++;
+	else if (cameraStable && entry.valid && !entry.reusable)
+		stats.nearEdge++;
+
+	float margin;
+	bool visible = frustum.Intersects(bounds, margin);
+
+	stats.tested++;
+	stats.testSeconds += missSeconds;
+	stats.savedSeconds += plainTestSeconds - missSeconds;
+	if (visible) stats.visible++;
+
+	entry.owner = owner;
+	entry.bounds = bounds;
+	entry.visible = visible;
+	entry.valid = true;
+	entry.reusable = margin > ReuseMargin(bounds);
+	return visible;
+}
+
+// --------------------------------------------------------
+// How far from every plane an entity must be for its result
+// to hold on any later frame the cache would reuse it.  The
+// camera it was tested with and the one it's reused with
+// are each within the thresholds of the cached camera, so
+// they differ by up to twice the move and twice the turn.
+// In the camera's space that shifts the entity by up to
+//   2 * move + 2 * turn * (distance from the camera)
+// and the entity itself may move its center and change its
+// radius by the bounds threshold each
+// --------------------------------------------------------
+float VisibilityCache::ReuseMargin(const BoundingSphere& bounds)
+{
+	float distance = sqrtf(DistanceSquared(bounds.center, cameraPosition)) + boundsThreshold;
+	return 2.0f * (cameraMoveThreshold + cameraTurnThreshold * distance + boundsThreshold);
+}
+
+// --------------------------------------------------------
+// Times culling last frame's entities three ways, a whole
+// batch per clock read since one test is far shorter than
+// the clock can resolve (short lists are run several times
+// over):
+//  - The plain frustum test, which is all there'd be
+//    without the cache
+//  - IsVisible() with the camera treated as moved, so every
+//    entity runs the cache's own test
+//  - IsVisible() against this frame's camera, where some
+//    entities reuse their result.  Taking out the misses
+//    leaves the cost of a hit
+// IsVisible() changes the entries and stats, so both are
+// put back afterward
+// --------------------------------------------------------
+void VisibilityCache::MeasureCosts()
+{
+	size_t count = entries.size();
+	if (count == 0)
+		return;
+
+	unsigned int passes = (unsigned int)((MinMeasureBatch + count - 1) / count);
+	double tests = (double)passes * count;
+	measureEntries = entries;
+	bool stable = cameraStable;
+	unsigned int sink = 0;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned int pass = 0; pass < passes; pass++)
+		for (size_t i = 0; i < count; i++)
+			sink += frustum.Intersects(measureEntries[i].bounds);
+	auto end = std::chrono::high_resolution_clock::now();
+	plainTestSeconds = std::chrono::duration<double>(end - start).count() / tests;
+
+	cameraStable = false;
+	start = std::chrono::high_resolution_clock::now();
+	for (unsigned int pass = 0; pass < passes; pass++)
+		for (size_t i = 0; i < count; i++)
+			sink += IsVisible(i, measureEntries[i].owner, measureEntries[i].bounds);
+	end = std::chrono::high_resolution_clock::now();
+	missSeconds = std::chrono::duration<double>(end - start).count() / tests;
+
+	// Only possible when the camera hasn't moved too far
+	if (stable)
+	{
+		cameraStable = true;
+		entries = measureEntries;
+		stats = {};
+		start = std::chrono::high_resolution_clock::now();
+		for (unsigned int pass = 0; pass < passes; pass++)
+			for (size_t i = 0; i < count; i++)
+				sink += IsVisible(i, measureEntries[i].owner, measureEntries[i].bounds);
+		end = std::chrono::high_resolution_clock::now();
+
+		double hits = (double)passes * stats.reused;
+		double seconds = std::chrono::duration<double>(end - start).count() - (tests - hits) * missSeconds;
+		if (hits > 0 && seconds > 0.0)
+			hitSeconds = seconds / hits;
+	}
+
+	entries = measureEntries;
+	cameraStable = stable;
+	stats = {};
+	measureSink += sink;
+}
+
+void VisibilityCache::Invalidate()
+{
+	for (Entry& entry : entries)
+		entry.valid = false;
+}
+
+const Frustum& VisibilityCache::GetFrustum() { return frustum; }
+const VisibilityStats& VisibilityCache::GetStats() { return stats; }
+
+void VisibilityCache::SetEnabled(bool enabled)
+{
+	this->enabled = enabled;
+	if (!enabled) Invalidate();
+}
+
+bool VisibilityCache::IsEnabled() { return enabled; }
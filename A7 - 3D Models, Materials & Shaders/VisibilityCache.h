@@ -0,0 +1,112 @@
+#pragma once
+
+#include <DirectXMath.h>
+#include <vector>
+#include <cstddef>
+
+#include "Frustum.h"
+
+// Counters from the most recent frame
+struct VisibilityStats
+{
+	unsigned int tested;		// Full frustum tests actually run
+	unsigned int reused;		// Results taken from last frame
+	unsigned int reverified;	// Tests forced by the rotating subset
+	unsigned int nearEdge;		// Tests of entities too close to a plane to reuse
+	unsigned int visible;
+	double testSeconds;			// Estimated time spent in real tests
+	double savedSeconds;		// Estimated net time saved against testing everything (negative if the cache costs more)
+
+	float HitRate() const { return (tested + reused) > 0 ? (float)reused / (tested + reused) : 0.0f; }
+};
+
+// --------------------------------------------------------
+// Remembers last frame's frustum test result per entity and
+// hands it back when neither the entity's bounds nor the
+// camera have moved more than a small threshold
+//
+// Each result also records how far the entity is from any
+// frustum plane.  Only results further from every plane
+// than the thresholds could shift it are reused, so a
+// reused answer is always the one a real test would give.
+// Entities near the edge of the view are simply re-tested
+//
+// A rotating slice of entities is re-tested as well, in
+// case something changes that the bounds don't show
+// --------------------------------------------------------
+class VisibilityCache
+{
+public:
+	// Thresholds are world units, except the turn, which is
+	// the camera's total rotation in radians (roll included)
+	VisibilityCache(
+		float boundsThreshold = 0.01f,
+		float cameraMoveThreshold = 0.05f,
+		float cameraTurnThreshold = 0.005f,
+		unsigned int reverifyInterval = 8);
+
+	// Call once per frame before any IsVisible() calls
+	void BeginFrame(
+		size_t entityCount,
+		DirectX::XMFLOAT3 cameraPosition,
+		DirectX::XMFLOAT3 cameraForward,
+		DirectX::XMFLOAT3 cameraUp,
+		DirectX::XMFLOAT4X4 projection,
+		DirectX::XMFLOAT4X4 viewProjection);
+
+	// Call for every entity, every frame.  The owner pointer
+	// keys the entry, so reordering the entity list just
+	// looks like a cache miss
+	bool IsVisible(size_t index, const void* owner, const BoundingSphere& bounds);
+
+	void Invalidate();
+
+	const Frustum& GetFrustum();
+	const VisibilityStats& GetStats();
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled();
+
+private:
+	struct Entry
+	{
+		const void* owner;
+		BoundingSphere bounds;
+		bool visible;
+		bool valid;
+		bool reusable;	// Far enough from every plane
+	};
+
+	float ReuseMargin(const BoundingSphere& bounds);
+	void MeasureCosts();
+
+	std::vector<Entry> entries;
+	Frustum frustum;
+	VisibilityStats stats;
+
+	// Camera state the cached results were computed against
+	DirectX::XMFLOAT3 cachedCameraPosition;
+	DirectX::XMFLOAT3 cachedCameraForward;
+	DirectX::XMFLOAT3 cachedCameraUp;
+	DirectX::XMFLOAT4X4 cachedProjection;
+	bool cameraStable;
+
+	DirectX::XMFLOAT3 cameraPosition;
+
+	float boundsThreshold;
+	float cameraMoveThreshold;
+	float cameraTurnThreshold;
+	unsigned int reverifyInterval;
+	unsigned long long frameNumber;
+	bool enabled;
+
+	// Cost per entity of culling with and without the cache,
+	// from timing whole batches every so often (see
+	// MeasureCosts())
+	double plainTestSeconds;	// Frustum test alone, as without the cache
+	double hitSeconds;			// IsVisible() reusing a result
+	double missSeconds;			// IsVisible() running its own test
+	unsigned int framesUntilMeasure;
+	unsigned int measureSink;
+	std::vector<Entry> measureEntries;
+};